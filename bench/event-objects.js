@@ -0,0 +1,170 @@
+// -----------------------------------------------
+// event-objects.js
+//
+// Benchmark for passing events from C++ to javascript handlers
+// Dispatches a million timer events and a million sprite collision
+// events, and reports the time per dispatch and how many garbage
+// collections ran while doing it. Run it on builds from before and
+// after a change to the event objects to compare them
+//
+// usage: node bench/event-objects.js [numEvents]
+//
+// Needs the addon built for a version of node whose V8 the bindings still
+// compile against (they use APIs removed in node 12, such as ToObject()
+// without a context). No baseline numbers are kept here, so build the
+// commits being compared and run this on each with the same numEvents
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+
+var pdg = require('../lib/pdg');
+
+var numEvents = parseInt(process.argv[2]) || 1000000;
+var NUM_TIMERS = 1000;		// all repeating every ms
+var FIRST_ID = 1000;
+var NUM_SPRITES = 400;		// all piled up in one spot, so they collide every tick
+
+var tm = pdg.tm;
+
+// count garbage collections if this version of node can tell us about them
+var gcCount = 0;
+var gcMs = 0;
+try {
+	var perfHooks = require('perf_hooks');
+	new perfHooks.PerformanceObserver(function(list) {
+		list.getEntries().forEach(function(entry) {
+			gcCount++;
+			gcMs += entry.duration;
+		});
+	}).observe({ entryTypes: ['gc'] });
+} catch (e) {
+	gcCount = -1;
+}
+
+function msSince(start) {
+	var t = process.hrtime(start);
+	return t[0] * 1000 + t[1] / 1e6;
+}
+
+// time every pass through the run loop, since that is where the events are dispatched
+var phase = null;
+var idle = pdg.idle;
+pdg.idle = function() {
+	var t = process.hrtime();
+	idle();
+	if (phase) {
+		phase.ms += msSince(t);
+		if (phase.count >= numEvents) {
+			finishPhase();
+		}
+	}
+};
+
+function startPhase(name, start, finish) {
+	phase = { name: name, count: 0, ms: 0, gcCount: gcCount, gcMs: gcMs, finish: finish };
+	start();
+}
+
+function finishPhase() {
+	var done = phase;
+	phase = null;
+	done.finish();
+	// let the gc observer catch up before reporting
+	setImmediate(function() {
+		console.log(done.name + ": " + done.count + " events in " + done.ms.toFixed(1) + " ms, " +
+			(done.ms * 1e6 / done.count).toFixed(1) + " ns per dispatch" +
+			((gcCount < 0) ? "" : ", " + (gcCount - done.gcCount) + " gcs taking " +
+				(gcMs - done.gcMs).toFixed(1) + " ms"));
+		nextPhase();
+	});
+}
+
+// handlers read a few fields the way a game would, so the cost of getting at them counts too
+
+var timerHandler = new pdg.IEventHandler(function(event) {
+	if (phase && event.id >= FIRST_ID && event.msElapsed >= 0) {
+		phase.count++;
+	}
+	return true;
+});
+
+function startTimers() {
+	tm.addHandler(timerHandler, pdg.eventType_Timer);
+	for (var i = 0; i < NUM_TIMERS; i++) {
+		tm.startTimer(FIRST_ID + i, 1, pdg.timer_Repeating);
+	}
+}
+
+function stopTimers() {
+	for (var i = 0; i < NUM_TIMERS; i++) {
+		tm.cancelTimer(FIRST_ID + i);
+	}
+	tm.removeHandler(timerHandler, pdg.eventType_Timer);
+}
+
+var layer = null;
+
+function startCollisions() {
+	layer = pdg.createSpriteLayer();
+	for (var i = 0; i < NUM_SPRITES; i++) {
+		var sprite = layer.createSprite();
+		sprite.setLocation(new pdg.Point(100 + (i % 10), 100 + Math.floor(i / 10) % 10));
+		sprite.setCollisionRadius(50);
+		sprite.enableCollisions(pdg.collide_CollisionRadius);
+	}
+	layer.enableCollisions();
+	layer.onCollideSprite(function(event) {
+		if (phase && event.actingSprite && event.targetSprite && event.inLayer) {
+			phase.count++;
+		}
+		return true;
+	});
+	layer.startAnimations();
+}
+
+function stopCollisions() {
+	layer.stopAnimations();
+	var oldLayer = layer;
+	layer = null;
+	setImmediate(function() {
+		pdg.cleanupSpriteLayer(oldLayer);
+	});
+}
+
+var phases = [
+	function() { startPhase("timer", startTimers, stopTimers); },
+	function() { startPhase("collision", startCollisions, stopCollisions); }
+];
+
+function nextPhase() {
+	if (phases.length) {
+		phases.shift()();
+	} else {
+		pdg.quit();
+	}
+}
+
+console.log("event object benchmark, " + numEvents + " events per phase" +
+	((gcCount < 0) ? " (gc counts not available)" : ""));
+nextPhase();
+pdg.run();
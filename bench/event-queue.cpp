@@ -0,0 +1,166 @@
+// -----------------------------------------------
+// event-queue.cpp
+//
+// Contention benchmark for the EventManager event queue
+// Compares the lock-free EventQueue against the mutex guarded std::queue
+// it replaced, with 1, 4 and 16 producer threads feeding a single consumer
+// that drains the queue the way main_run() does
+//
+// This is a standalone native program since the producers have to be real
+// threads. Build it from the top of the repo with:
+//
+//   g++ -std=gnu++11 -O2 -pthread -I src/inc -DPDG_NO_GUI -DPDG_NO_SOUND -DPDG_NO_NETWORK \
+//       -DPDG_LIBRARY bench/event-queue.cpp -o event-queue-bench
+//
+// usage: ./event-queue-bench [eventsPerProducer]
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+
+#include "pdg_project.h"
+
+#include "pdg/sys/eventqueue.h"
+#include "pdg/sys/mutex.h"
+
+#include <queue>
+#include <cstdio>
+#include <cstdlib>
+#include <pthread.h>
+#include <sys/time.h>
+
+using namespace pdg;
+
+static const int PRODUCER_COUNTS[] = { 1, 4, 16 };
+static const int NUM_PRODUCER_COUNTS = sizeof(PRODUCER_COUNTS) / sizeof(int);
+
+static int gEventsPerProducer = 1000000;
+
+// the entries carry the producer number and a sequence number in place of the
+// emitter and event data pointers, so the consumer can check the ordering
+#define ENTRY_PRODUCER(e)	((long)(size_t)(e).emitter)
+#define ENTRY_SEQUENCE(e)	((long)(size_t)(e).userData)
+
+static double now() {
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+// -----------------------------------------------
+// the old EventManager queue, for comparison
+// -----------------------------------------------
+class MutexQueue {
+public:
+	void push(const EventQueueEntry& entry) {
+		AutoMutex lock(&mMutex);
+		mQueue.push(entry);
+	}
+	int drain(EventQueueEntryListT& outEntries) {
+		// one lock per pop, like the old getQueuedEvent() loop in main_run()
+		int count = 0;
+		for (;;) {
+			AutoMutex lock(&mMutex);
+			if (mQueue.empty()) break;
+			outEntries.push_back(mQueue.front());
+			mQueue.pop();
+			count++;
+		}
+		return count;
+	}
+private:
+	Mutex mMutex;
+	std::queue<EventQueueEntry> mQueue;
+};
+
+template <class Q>
+struct ProducerArgs {
+	Q*			queue;
+	long		producer;
+	volatile int* go;
+};
+
+template <class Q>
+static void* producerMain(void* arg) {
+	ProducerArgs<Q>* args = (ProducerArgs<Q>*)arg;
+	while (!*args->go) {}
+	for (long i = 0; i < gEventsPerProducer; i++) {
+		args->queue->push(EventQueueEntry(1, (UserData*)(size_t)i, (EventEmitter*)(size_t)args->producer));
+	}
+	return 0;
+}
+
+template <class Q>
+static void runBench(const char* name, int numProducers) {
+	Q* queue = new Q();
+	std::vector<pthread_t> threads(numProducers);
+	std::vector< ProducerArgs<Q> > args(numProducers);
+	std::vector<long> nextSequence(numProducers, 0);
+	volatile int go = 0;
+	for (int i = 0; i < numProducers; i++) {
+		args[i].queue = queue;
+		args[i].producer = i;
+		args[i].go = &go;
+		pthread_create(&threads[i], 0, &producerMain<Q>, &args[i]);
+	}
+	long total = (long)numProducers * gEventsPerProducer;
+	long received = 0;
+	long drains = 0;
+	long outOfOrder = 0;
+	EventQueueEntryListT batch;
+	double start = now();
+	go = 1;
+	while (received < total) {
+		batch.clear();
+		int count = queue->drain(batch);
+		if (count == 0) continue;
+		drains++;
+		for (int i = 0; i < count; i++) {
+			long producer = ENTRY_PRODUCER(batch[i]);
+			if (ENTRY_SEQUENCE(batch[i]) != nextSequence[producer]) {
+				outOfOrder++;
+			}
+			nextSequence[producer] = ENTRY_SEQUENCE(batch[i]) + 1;
+		}
+		received += count;
+	}
+	double elapsed = now() - start;
+	for (int i = 0; i < numProducers; i++) {
+		pthread_join(threads[i], 0);
+	}
+	std::printf("%-10s producers: %2d  events: %9ld  ms: %8.1f  Mevents/s: %6.2f  avg batch: %8.1f%s\n",
+		name, numProducers, total, elapsed * 1000.0, total / elapsed / 1e6,
+		(double)received / (drains ? drains : 1), outOfOrder ? "  OUT OF ORDER!" : "");
+	delete queue;
+}
+
+int main(int argc, char** argv) {
+	if (argc > 1) {
+		gEventsPerProducer = std::atoi(argv[1]);
+	}
+	std::printf("event queue contention benchmark, %d events per producer\n", gEventsPerProducer);
+	for (int i = 0; i < NUM_PRODUCER_COUNTS; i++) {
+		runBench<MutexQueue>("mutex", PRODUCER_COUNTS[i]);
+		runBench<EventQueue>("lock-free", PRODUCER_COUNTS[i]);
+	}
+	return 0;
+}
@@ -0,0 +1,325 @@
+// -----------------------------------------------
+// net-epoll.cpp
+//
+// Benchmark for the network worker thread's event loop with lots of connections
+// Runs the loop the POSIX network manager's worker uses, once with select(),
+// rebuilding the fd_set each time round like it always did, and once with
+// edge triggered epoll, over a pile of idle connections and a set of active ones.
+// The ping test bounces one message at a time off a random active connection,
+// to show what each wakeup costs. The stream test has every active connection
+// sending as fast as it can, to show the throughput. select() can't handle
+// descriptors past FD_SETSIZE, so it is only run on a smaller set of connections
+//
+// Linux only. Build and run with:
+//   g++ -O2 -o net-epoll bench/net-epoll.cpp
+//   ./net-epoll [idleConnections] [activeConnections] [messagesPerConnection]
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <vector>
+
+#define MESSAGE_SIZE 64         // about the size of a small game state update
+#define PING_COUNT 20000
+#define MAX_EVENTS 256          // same as the worker
+
+static double msNow() {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+static void setNonBlocking(int fd) {
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+// the server ends of all the connections. The first numActive are the ones the client talks on
+struct Connections {
+	std::vector<int> fds;
+	int numActive;
+	int maxFd;
+};
+
+// read everything waiting on a connection, echoing it back if asked. Returns bytes read
+static long drain(int fd, bool echo) {
+	char buf[16384];
+	long total = 0;
+	for (;;) {
+		long n = read(fd, buf, sizeof(buf));
+		if (n <= 0) {
+			return total;
+		}
+		if (echo) {
+			write(fd, buf, n);
+		}
+		total += n;
+	}
+}
+
+// -----------------------------------------------
+// the two event loops, each reading until it has seen expectedBytes
+// -----------------------------------------------
+
+static long selectLoop(Connections& conns, long expectedBytes, bool echo) {
+	long bytes = 0;
+	long wakeups = 0;
+	while (bytes < expectedBytes) {
+		fd_set inputSet, excSet;
+		FD_ZERO(&inputSet);
+		FD_ZERO(&excSet);
+		for (size_t i = 0; i < conns.fds.size(); i++) {
+			FD_SET(conns.fds[i], &inputSet);
+			FD_SET(conns.fds[i], &excSet);
+		}
+		struct timeval timeout = { 1, 0 };
+		int numEvents = select(conns.maxFd + 1, &inputSet, NULL, &excSet, &timeout);
+		wakeups++;
+		if (numEvents <= 0) {
+			continue;
+		}
+		for (size_t i = 0; i < conns.fds.size(); i++) {
+			if (FD_ISSET(conns.fds[i], &inputSet)) {
+				bytes += drain(conns.fds[i], echo);
+			}
+		}
+	}
+	return wakeups;
+}
+
+static int epollFd = -1;
+
+static void epollWatch(Connections& conns) {
+	epollFd = epoll_create(MAX_EVENTS);
+	for (size_t i = 0; i < conns.fds.size(); i++) {
+		struct epoll_event event;
+		event.events = EPOLLIN | EPOLLOUT | EPOLLPRI | EPOLLET;   // the worker watches for flow clears too
+		event.data.u64 = i;
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, conns.fds[i], &event);
+	}
+}
+
+static long epollLoop(Connections& conns, long expectedBytes, bool echo) {
+	long bytes = 0;
+	long wakeups = 0;
+	struct epoll_event events[MAX_EVENTS];
+	while (bytes < expectedBytes) {
+		int numEvents = epoll_wait(epollFd, events, MAX_EVENTS, 1000);
+		wakeups++;
+		for (int i = 0; i < numEvents; i++) {
+			if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+				bytes += drain(conns.fds[events[i].data.u64], echo);
+			}
+		}
+	}
+	return wakeups;
+}
+
+// -----------------------------------------------
+// the client side, run in a child process so the server only has its own descriptors
+// -----------------------------------------------
+
+static void pingClient(std::vector<int>& clientFds, int numActive) {
+	char msg[MESSAGE_SIZE];
+	memset(msg, 'p', sizeof(msg));
+	unsigned int seed = 1;
+	for (int i = 0; i < PING_COUNT; i++) {
+		int fd = clientFds[rand_r(&seed) % numActive];
+		write(fd, msg, sizeof(msg));
+		long got = 0;
+		while (got < MESSAGE_SIZE) {
+			long n = read(fd, msg, sizeof(msg) - got);
+			if (n <= 0) {
+				return;
+			}
+			got += n;
+		}
+	}
+}
+
+static void streamClient(std::vector<int>& clientFds, int numActive, int messagesPerConnection) {
+	char msg[MESSAGE_SIZE];
+	memset(msg, 's', sizeof(msg));
+	for (int m = 0; m < messagesPerConnection; m++) {
+		for (int i = 0; i < numActive; i++) {
+			write(clientFds[i], msg, sizeof(msg));
+		}
+	}
+}
+
+// -----------------------------------------------
+
+static bool openConnections(int numIdle, int numActive, Connections& conns, std::vector<int>& clientFds) {
+	int total = numIdle + numActive;
+	conns.fds.clear();
+	clientFds.clear();
+	for (int i = 0; i < total; i++) {
+		int sv[2];
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == -1) {
+			printf("socketpair failed after %d connections: %s\n", i, strerror(errno));
+			return false;
+		}
+		conns.fds.push_back(sv[0]);
+		clientFds.push_back(sv[1]);
+	}
+	conns.numActive = numActive;
+	return true;
+}
+
+// after the fork the server closes the client ends, and packs its own into the lowest
+// descriptors so as many as possible fit in an fd_set
+static void serverSide(Connections& conns, std::vector<int>& clientFds) {
+	for (size_t i = 0; i < clientFds.size(); i++) {
+		close(clientFds[i]);
+	}
+	conns.maxFd = 0;
+	for (size_t i = 0; i < conns.fds.size(); i++) {
+		int low = fcntl(conns.fds[i], F_DUPFD, 0);
+		if (low < conns.fds[i]) {
+			close(conns.fds[i]);
+			conns.fds[i] = low;
+		} else {
+			close(low);
+		}
+		setNonBlocking(conns.fds[i]);
+		if (conns.fds[i] > conns.maxFd) {
+			conns.maxFd = conns.fds[i];
+		}
+	}
+}
+
+static void closeConnections(Connections& conns) {
+	for (size_t i = 0; i < conns.fds.size(); i++) {
+		close(conns.fds[i]);
+	}
+	if (epollFd != -1) {
+		close(epollFd);
+		epollFd = -1;
+	}
+}
+
+static void runBench(const char* name, bool useEpoll, int numIdle, int numActive, int messagesPerConnection) {
+	Connections conns;
+	std::vector<int> clientFds;
+	if (!openConnections(numIdle, numActive, conns, clientFds)) {
+		return;
+	}
+	// the client does the ping test and then the stream test. It waits for a go byte from
+	// the server before streaming, so none of the stream gets read by the ping loop
+	pid_t child = fork();
+	if (child == 0) {
+		for (size_t i = 0; i < conns.fds.size(); i++) {
+			close(conns.fds[i]);
+		}
+		char go;
+		pingClient(clientFds, numActive);
+		read(clientFds[0], &go, 1);
+		streamClient(clientFds, numActive, messagesPerConnection);
+		_exit(0);
+	}
+	serverSide(conns, clientFds);
+	if (!useEpoll && (conns.maxFd >= FD_SETSIZE)) {
+		printf("%s  idle: %d  active: %d  skipped, needs descriptors past FD_SETSIZE (%d)\n",
+			name, numIdle, numActive, FD_SETSIZE);
+		kill(child, SIGKILL);
+		waitpid(child, NULL, 0);
+		closeConnections(conns);
+		return;
+	}
+	if (useEpoll) {
+		epollWatch(conns);
+	}
+
+	long expectedBytes = (long)PING_COUNT * MESSAGE_SIZE;
+	double start = msNow();
+	long wakeups = useEpoll ? epollLoop(conns, expectedBytes, true) : selectLoop(conns, expectedBytes, true);
+	double ms = msNow() - start;
+	printf("%s  idle: %d  active: %d  ping    us per round trip: %.1f  wakeups: %ld\n",
+		name, numIdle, numActive, ms * 1000 / PING_COUNT, wakeups);
+
+	long numMessages = (long)numActive * messagesPerConnection;
+	expectedBytes = numMessages * MESSAGE_SIZE;
+	start = msNow();
+	write(conns.fds[0], "g", 1);
+	wakeups = useEpoll ? epollLoop(conns, expectedBytes, false) : selectLoop(conns, expectedBytes, false);
+	ms = msNow() - start;
+	printf("%s  idle: %d  active: %d  stream  ms: %.1f  kmsgs/s: %.1f  us per wakeup: %.1f  msgs per wakeup: %.1f\n",
+		name, numIdle, numActive, ms, numMessages / ms, ms * 1000 / wakeups, (double)numMessages / wakeups);
+
+	waitpid(child, NULL, 0);
+	closeConnections(conns);
+}
+
+int main(int argc, char** argv) {
+	int numIdle = (argc > 1) ? atoi(argv[1]) : 5000;
+	int numActive = (argc > 2) ? atoi(argv[2]) : 500;
+	int messagesPerConnection = (argc > 3) ? atoi(argv[3]) : 1000;
+
+	// both ends of every connection are open until the fork, so make sure we can have that many
+	struct rlimit limit;
+	getrlimit(RLIMIT_NOFILE, &limit);
+	rlim_t needed = (rlim_t)(numIdle + numActive) * 2 + 64;
+	if (limit.rlim_cur < needed) {
+		limit.rlim_cur = (limit.rlim_max < needed) ? limit.rlim_max : needed;
+		setrlimit(RLIMIT_NOFILE, &limit);
+		if (limit.rlim_cur < needed) {
+			printf("warning: can only open %d descriptors, raise the hard limit with ulimit -n\n", (int)limit.rlim_cur);
+		}
+	}
+	signal(SIGPIPE, SIG_IGN);
+	setvbuf(stdout, NULL, _IOLBF, 0);
+
+	// the most idle connections select() can watch alongside the active ones
+	int selectIdle = FD_SETSIZE - numActive - 16;
+	if (selectIdle > numIdle) {
+		selectIdle = numIdle;
+	}
+	if (selectIdle < 0) {
+		selectIdle = 0;
+	}
+
+	printf("network worker event loop benchmark, %d byte messages, %d per active connection\n",
+		MESSAGE_SIZE, messagesPerConnection);
+	int idleCounts[3] = { 0, selectIdle, numIdle };
+	for (int i = 0; i < 3; i++) {
+		if ((i == 0) || (idleCounts[i] != idleCounts[i - 1])) {
+			runBench("select", false, idleCounts[i], numActive, messagesPerConnection);
+			runBench("epoll ", true, idleCounts[i], numActive, messagesPerConnection);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,90 @@
+// -----------------------------------------------
+// serialize-layer.js
+//
+// Benchmark for serializing a large SpriteLayer every tick at ser_Update
+// Compares the two pass Serializer (size then write), the single pass streaming
+// Serializer, and a single streaming Serializer that is reset and reused each tick
+//
+// usage: node bench/serialize-layer.js [numSprites] [numTicks]
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+
+
+var pdg = require('../lib/pdg');
+
+var numSprites = parseInt(process.argv[2]) || 10000;
+var numTicks = parseInt(process.argv[3]) || 200;
+
+function msSince(start) {
+	var t = process.hrtime(start);
+	return t[0] * 1000 + t[1] / 1e6;
+}
+
+function report(what, ms, bytes) {
+	console.log(what + ": " + (ms / numTicks).toFixed(3) + " ms per tick, " + bytes + " bytes");
+}
+
+console.log("layer serialization benchmark, " + numSprites + " sprites, " + numTicks + " ticks");
+
+var layer = pdg.createSpriteLayer();
+for (var i = 0; i < numSprites; i++) {
+	var sprite = layer.createSprite();
+	sprite.setLocation(new pdg.Point(Math.random() * 2000, Math.random() * 2000));
+	sprite.setVelocity(new pdg.Vector(Math.random() * 100 - 50, Math.random() * 100 - 50));
+	sprite.setFacing(Math.random() * Math.PI);
+}
+layer.setSerializationFlags(pdg.ser_Update);
+
+// a new Serializer every tick that sizes the layer before writing it, the old behavior
+var bytes = 0;
+var start = process.hrtime();
+for (var i = 0; i < numTicks; i++) {
+	var ser = new pdg.Serializer();
+	ser.setStreaming(false);
+	ser.serialize_obj(layer);
+	bytes = ser.getDataSize();
+}
+report("two pass", msSince(start), bytes);
+
+// a new Serializer every tick, written in one pass
+start = process.hrtime();
+for (var i = 0; i < numTicks; i++) {
+	var ser = new pdg.Serializer();
+	ser.serialize_obj(layer);
+	bytes = ser.getDataSize();
+}
+report("streaming", msSince(start), bytes);
+
+// one Serializer for every tick, so the buffer only gets allocated once
+var ser = new pdg.Serializer();
+ser.reserve(bytes);
+start = process.hrtime();
+for (var i = 0; i < numTicks; i++) {
+	ser.reset();
+	ser.serialize_obj(layer);
+	bytes = ser.getDataSize();
+}
+report("streaming + reset", msSince(start), bytes);
+
+pdg.cleanupSpriteLayer(layer);
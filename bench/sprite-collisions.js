@@ -0,0 +1,111 @@
+// -----------------------------------------------
+// sprite-collisions.js
+//
+// Benchmark for non-Chipmunk sprite collision detection
+// Compares the pairwise check against the layer collision grid
+// for increasing numbers of sprites
+//
+// usage: node bench/sprite-collisions.js [numTicks]
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+
+var pdg = require('../lib/pdg');
+
+var SPRITE_COUNTS = [1000, 5000, 20000];
+var SPRITE_RADIUS = 8;
+var SPACING = 40;	// keeps the density the same as the sprite count goes up
+var numTicks = parseInt(process.argv[2]) || 20;
+
+// each run is a sprite count with and without the grid
+var runs = [];
+SPRITE_COUNTS.forEach(function(count) {
+	runs.push({ count: count, grid: false });
+	runs.push({ count: count, grid: true });
+});
+
+var layer = null;
+var collisions = 0;
+var tickStart = 0;
+var tickTimes = [];
+
+function startRun(run) {
+	layer = pdg.createSpriteLayer();
+	var side = Math.sqrt(run.count) * SPACING;
+	for (var i = 0; i < run.count; i++) {
+		var sprite = layer.createSprite();
+		sprite.setLocation(new pdg.Point(Math.random() * side, Math.random() * side));
+		sprite.setVelocity(new pdg.Vector(Math.random() * 100 - 50, Math.random() * 100 - 50));
+		sprite.setCollisionRadius(SPRITE_RADIUS);
+		sprite.enableCollisions(pdg.collide_CollisionRadius);
+	}
+	layer.enableCollisions();
+	if (run.grid) {
+		layer.enableCollisionGrid(SPRITE_RADIUS * 8);
+	}
+	collisions = 0;
+	tickTimes = [];
+	layer.onCollideSprite(function() {
+		collisions++;
+		return true;
+	});
+	layer.onPreAnimateLayer(function() {
+		tickStart = process.hrtime();
+		return false;
+	});
+	layer.onPostAnimateLayer(function() {
+		var t = process.hrtime(tickStart);
+		tickTimes.push(t[0] * 1000 + t[1] / 1e6);
+		if (tickTimes.length >= numTicks) {
+			finishRun(run);
+		}
+		return false;
+	});
+	layer.startAnimations();
+}
+
+function finishRun(run) {
+	layer.stopAnimations();
+	var total = tickTimes.reduce(function(a, b) { return a + b; }, 0);
+	var sorted = tickTimes.slice().sort(function(a, b) { return a - b; });
+	console.log(
+		(run.grid ? "grid     " : "pairwise ") +
+		"sprites: " + run.count +
+		"  avg ms/tick: " + (total / tickTimes.length).toFixed(3) +
+		"  median: " + sorted[Math.floor(sorted.length / 2)].toFixed(3) +
+		"  collisions: " + collisions
+	);
+	var oldLayer = layer;
+	setImmediate(function() {
+		pdg.cleanupSpriteLayer(oldLayer);
+		if (runs.length) {
+			startRun(runs.shift());
+		} else {
+			pdg.quit();
+		}
+	});
+}
+
+console.log("sprite collision benchmark, " + numTicks + " ticks per run");
+startRun(runs.shift());
+pdg.run();
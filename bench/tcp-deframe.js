@@ -0,0 +1,163 @@
+// -----------------------------------------------
+// tcp-deframe.js
+//
+// Throughput benchmark for splitting incoming tcp data into NetConnection frames
+// Feeds a stream of 1 byte, 1 KB and 1 MB frames to NetConnection._handleTcpData()
+// in chunks cut at random places, the way reads come off a socket, and compares it
+// with the Buffer.concat based deframer it replaced
+//
+// usage: node bench/tcp-deframe.js [megabytesPerRun] [maxChunkSize]
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+
+var pdg = require('../lib/pdg');
+
+var megabytesPerRun = parseInt(process.argv[2]) || 64;
+var maxChunkSize = parseInt(process.argv[3]) || 65536;
+var FRAME_SIZES = [ 1, 1024, 1024 * 1024 ];
+var MAX_FRAMES = 200000;
+
+// same random chunking every run, so the two deframers see exactly the same reads
+var seed = 1;
+function random() {
+	seed = (seed * 16807) % 2147483647;
+	return (seed - 1) / 2147483646;
+}
+
+function msSince(start) {
+	var t = process.hrtime(start);
+	return t[0] * 1000 + t[1] / 1e6;
+}
+
+function makeStream(payloadSize, numFrames) {
+	var frameSize = payloadSize + 5;
+	var stream = new Buffer(frameSize * numFrames);
+	for (var i = 0; i < numFrames; i++) {
+		var offset = i * frameSize;
+		stream[offset] = 'A'.charCodeAt(0);
+		stream.writeUInt32BE(payloadSize, offset + 1, true);
+		stream.fill(i & 0xff, offset + 5, offset + frameSize);
+	}
+	return stream;
+}
+
+function makeChunks(stream) {
+	var chunks = [];
+	var offset = 0;
+	while (offset < stream.length) {
+		var len = 1 + Math.floor(random() * maxChunkSize);
+		chunks.push(stream.slice(offset, offset + len));
+		offset += len;
+	}
+	return chunks;
+}
+
+// -----------------------------------------------
+// the old deframer, for comparison
+// -----------------------------------------------
+function OldDeframer(handleFrame) {
+	this.pendingData = false;
+	this.pendingDataOffset = 0;
+	this.handleFrame = handleFrame;
+}
+
+OldDeframer.prototype.getNextFrameStart = function(data) {
+	var payloadSize = 0;
+	var frameSize = 0;
+	if (String.fromCharCode(data[0]) == 'A') {
+		if (data.length > 5) {
+			payloadSize = data.readUInt32BE(1, true);
+		}
+		frameSize = 5;
+	} else {
+		if (data.length > 3) {
+			payloadSize = data.readUInt16BE(1, true);
+		}
+		frameSize = 3;
+	}
+	return frameSize + payloadSize;
+};
+
+OldDeframer.prototype.handleTcpData = function(data) {
+	if (this.pendingData === false) {
+		this.pendingData = data;
+		this.pendingDataOffset = 0;
+	} else {
+		this.pendingData = Buffer.concat([this.pendingData, data]);
+	}
+	data = this.pendingData.slice(this.pendingDataOffset);
+	var nextFrameStart = this.getNextFrameStart(data);
+	while (nextFrameStart <= data.length) {
+		var payloadSize = data.readUInt32BE(1, true);
+		this.handleFrame('A', data.slice(5, 5 + payloadSize));
+		this.pendingDataOffset += nextFrameStart;
+		data = this.pendingData.slice(this.pendingDataOffset);
+		nextFrameStart = this.getNextFrameStart(data);
+	}
+	if (this.pendingDataOffset >= this.pendingData.length) {
+		this.pendingData = false;
+	}
+};
+
+// -----------------------------------------------
+
+function runBench(name, payloadSize, numFrames, chunks, makeDeframer) {
+	var framesSeen = 0;
+	var bytesSeen = 0;
+	var handleFrame = function(cmd, payload) {
+		framesSeen++;
+		bytesSeen += payload.length;
+	};
+	var handleTcpData = makeDeframer(handleFrame);
+	var start = process.hrtime();
+	for (var i = 0; i < chunks.length; i++) {
+		handleTcpData(chunks[i]);
+	}
+	var ms = msSince(start);
+	var streamBytes = numFrames * (payloadSize + 5);
+	console.log(name + "  frame: " + payloadSize + " bytes  frames: " + numFrames + "  reads: " + chunks.length +
+		"  ms: " + ms.toFixed(1) + "  MB/s: " + (streamBytes / 1048576 / (ms / 1000)).toFixed(1) +
+		"  kframes/s: " + (numFrames / ms).toFixed(1) +
+		(((framesSeen != numFrames) || (bytesSeen != numFrames * payloadSize)) ? "  WRONG FRAMES!" : ""));
+}
+
+function newDeframer(handleFrame) {
+	var connection = new pdg.NetConnection();
+	connection._alive = true;
+	connection._handleTcpFrame = handleFrame;
+	return connection._handleTcpData.bind(connection);
+}
+
+function oldDeframer(handleFrame) {
+	var deframer = new OldDeframer(handleFrame);
+	return deframer.handleTcpData.bind(deframer);
+}
+
+console.log("tcp deframe benchmark, " + megabytesPerRun + " MB per run, reads of 1 to " + maxChunkSize + " bytes");
+FRAME_SIZES.forEach(function(payloadSize) {
+	var numFrames = Math.min(MAX_FRAMES, Math.ceil(megabytesPerRun * 1048576 / (payloadSize + 5)));
+	var chunks = makeChunks(makeStream(payloadSize, numFrames));
+	runBench("concat", payloadSize, numFrames, chunks, oldDeframer);
+	runBench("ring  ", payloadSize, numFrames, chunks, newDeframer);
+});
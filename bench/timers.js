@@ -0,0 +1,103 @@
+// -----------------------------------------------
+// timers.js
+//
+// Benchmark for the TimerManager with lots of one shot timers, like the
+// per-entity respawn, buff expiry and AI think timers a game room uses
+//
+// usage: node bench/timers.js [numTimers]
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+
+var pdg = require('../lib/pdg');
+
+var numTimers = parseInt(process.argv[2]) || 100000;
+var SPREAD_MS = 2000;	// timers are spread out to fire over this many ms
+var FIRST_ID = 1000;
+
+var tm = pdg.tm;
+
+function msSince(start) {
+	var t = process.hrtime(start);
+	return t[0] * 1000 + t[1] / 1e6;
+}
+
+function report(what, ms, count) {
+	console.log(what + ": " + ms.toFixed(3) + " ms total, " + (ms * 1e6 / count).toFixed(1) + " ns each");
+}
+
+console.log("timer benchmark, " + numTimers + " timers");
+
+var start = process.hrtime();
+for (var i = 0; i < numTimers; i++) {
+	tm.startTimer(FIRST_ID + i, 100 + Math.floor(Math.random() * SPREAD_MS), pdg.timer_OneShot);
+}
+report("startTimer", msSince(start), numTimers);
+
+start = process.hrtime();
+for (var i = 0; i < numTimers; i++) {
+	tm.delayTimer(FIRST_ID + Math.floor(Math.random() * numTimers), 10);
+}
+report("delayTimer", msSince(start), numTimers);
+
+start = process.hrtime();
+for (var i = 0; i < numTimers; i++) {
+	tm.getWhenTimerFiresNext(FIRST_ID + Math.floor(Math.random() * numTimers));
+}
+report("getWhenTimerFiresNext", msSince(start), numTimers);
+
+// cancel and restart a tenth of them, like entities that die before their timer goes off
+var numRestarts = Math.floor(numTimers / 10);
+start = process.hrtime();
+for (var i = 0; i < numRestarts; i++) {
+	var id = FIRST_ID + Math.floor(Math.random() * numTimers);
+	tm.cancelTimer(id);
+	tm.startTimer(id, 100 + Math.floor(Math.random() * SPREAD_MS), pdg.timer_OneShot);
+}
+report("cancelTimer + startTimer", msSince(start), numRestarts);
+
+// now let them all fire, timing each pass through the run loop
+var fired = 0;
+var idleCalls = 0;
+var idleMs = 0;
+var maxIdleMs = 0;
+tm.addHandler(new pdg.IEventHandler(function(event) {
+	fired++;
+	return true;
+}), pdg.eventType_Timer);
+
+var idle = pdg.idle;
+pdg.idle = function() {
+	var t = process.hrtime();
+	idle();
+	var ms = msSince(t);
+	idleCalls++;
+	idleMs += ms;
+	if (ms > maxIdleMs) maxIdleMs = ms;
+	if (fired >= numTimers) {
+		console.log("fired " + fired + " timers in " + idleCalls + " run loop passes, avg " +
+			(idleMs / idleCalls).toFixed(3) + " ms per pass, max " + maxIdleMs.toFixed(3) + " ms");
+		pdg.quit();
+	}
+};
+pdg.run();
@@ -172,6 +172,7 @@
         'src/sys/animated.cpp',
         'src/sys/ConvertUTF.c',
         'src/sys/collisiondetection.cpp',
+        'src/sys/collisiongrid.cpp',
         'src/sys/deserializer.cpp',
         'src/sys/eventemitter.cpp',
         'src/sys/eventmanager.cpp',
@@ -184,11 +185,14 @@
         'src/sys/serializer.cpp',
         #'src/sys/spline.cpp',
         'src/sys/sprite.cpp',
+        'src/sys/spriteindex.cpp',
         'src/sys/spritelayer.cpp',
         'src/sys/spritemanager.cpp',
         'src/sys/tilelayer.cpp',
         'src/sys/timermanager.cpp',
         'src/sys/userdata.cpp',
+        'src/sys/world.cpp',
+        'src/sys/worldthreads.cpp',
         # pdg javascript and node bindings
         'src/bindings/javascript/memblock.cpp',
         'src/bindings/javascript/v8/pdg_v8_support.cpp',
@@ -56,9 +56,60 @@ var dgram = require('dgram');
 
 var NET_CONN_LOG;
 
+// check this before building anything expensive to log, like a dump of the data
+var NET_CONN_LOGGING = false;
+
+// starting size of the buffer that collects incoming tcp data, it grows to fit the largest frame
+var NET_CONN_RECV_BUFFER_SIZE = 16384;
+
+// datagram channels, see sendDgram()
+var dgramChannel_Unreliable = 0;
+var dgramChannel_Sequenced = 1;
+var dgramChannel_ReliableOrdered = 2;
+
+// largest datagram we send, headers included, small enough to get through without IP fragmentation
+var NET_DGRAM_MAX_SIZE = 1400;
+
+// Channel packets start with this header, all numbers big endian:
+//   0  uint8   NET_CHANNEL_PACKET, never the first byte of a plain dgram message
+//   1  uint8   channel, with NET_CHANNEL_HAS_ACK set if the ack fields are valid
+//   2  uint16  sequence number of this packet, counted separately for each channel
+//   4  uint16  ack. Reliable channel: every packet before this one has been received.
+//              Sequenced channel: the newest packet received
+//   6  uint32  ack bits. Bit n set means packet ack+1+n (reliable) or ack-1-n (sequenced)
+//              has been received too
+//  10  uint16  fragment index
+//  12  uint16  fragment count, 0 for a packet that only carries an ack
+// A message that doesn't fit in one packet is sent as consecutively numbered fragments
+var NET_CHANNEL_PACKET = 0xFE;
+var NET_CHANNEL_HAS_ACK = 0x80;
+var NET_CHANNEL_HEADER_SIZE = 14;
+// a quarter of the sequence numbers, so the fragments of one message always compare in order.
+// That's over 20MB, anything bigger can't be sent on a channel
+var NET_CHANNEL_MAX_FRAGMENTS = 0x4000;
+// reliable packets are only sent while they are within this many of the oldest one still unacked,
+// so the ack bits can always cover every packet in flight, even when that oldest one is lost.
+// More wait in the channel's queue
+var NET_CHANNEL_MAX_IN_FLIGHT = 33;
+var NET_CHANNEL_RECV_WINDOW = 1024;   // how far ahead of the next expected reliable packet we'll buffer
+var NET_CHANNEL_SERVICE_INTERVAL = 10;  // ms between checks for resends and acks to send
+var NET_CHANNEL_ACK_DELAY = 20;       // ms we wait for an outgoing packet to carry an ack
+var NET_CHANNEL_ACK_EVERY = 16;       // packets received before we ack without waiting, so the ack bits keep up
+var NET_CHANNEL_INITIAL_RTO = 200;
+var NET_CHANNEL_MIN_RTO = 50;
+var NET_CHANNEL_MAX_RTO = 2000;       // also how long a sequenced packet has to be acked before it counts as lost
+var NET_CHANNEL_LOSS_SMOOTHING = 0.05;
+var NET_CHANNEL_FAST_RESEND = 3;      // later packets acked before a missing reliable one is resent early
+
+// signed distance from sequence number b to a, allowing for wrap around
+function seqDiff(a, b) {
+	return ((a - b + 0x18000) & 0xffff) - 0x8000;
+}
+
 if ((process.env.PDG_DEBUG && process.env.PDG_DEBUG.indexOf('NET_DATA') != -1)
   || (process.env.NODE_DEBUG && process.env.NODE_DEBUG.indexOf('NET_DATA') != -1)) {
 	console.log('Found NODE_DEBUG or PDG_DEBUG=NET_DATA in environment. Logging network data.');
+	NET_CONN_LOGGING = true;
     NET_CONN_LOG = function(msg, data, size) {
 		console.log(msg);
 		if (arguments.length > 2) {
@@ -100,8 +151,9 @@ classify('NetConnection', function() {
 			this._alive = false;
 			this._closeCallback = false;
 			this._messageCallback = false;
-			this._pendingData = false;
-			this._pendingDataOffset = 0;
+			this._recvBuf = false;
+			this._recvStart = 0;
+			this._recvEnd = 0;
 			this._server = false;
 			this._client = false;
 			this._protocolVers = 1;
@@ -115,6 +167,8 @@ classify('NetConnection', function() {
 			this._maxDgramStarts = 100;
 			this._dgramStartInterval = 500; // try sending every 1/2 second
 			this._dgramStartDelayFactor = 100; // wait an extra 10th of a second for each additional attempt
+			this._dgramChannels = [];
+			this._channelTimerPending = false;
 		});
 
 	//! close the connection
@@ -162,35 +216,67 @@ classify('NetConnection', function() {
 			if ((arguments.length == 1) && (arguments[0] == null)) { 
 				return methodSignature("send a message via a reliable transport mechanism", arguments, "undefined", 1, "({string|[object MemBlock]|[object ISerializable]|object} message)");
 			}
-			var data = this._serializeMessage(message);
-			var buf = this._frameTcpData(data);
- 			NET_CONN_LOG((this._client ? 'Client' : 'Server') + ' -> ' + this.remoteAddr+':'+this.remotePort + ' ['+buf.length+' bytes]', buf.toString('binary'), buf.length);
-			var flushed = this.socket.write(buf);  
+			var buf = this._frameMessage(message);
+			var flushed = this._writeFrame(buf);
 			// if not flushed, then it didn't all fit in kernel buffer. May be useful
 			// for flow control or throttling
 			return this;
 		});
 
 	//! send a message via the fastest transport mechanism
-	//! delivery and packet order not guaranteed
-	//! if unreliable transport isn't available, or if the 
-	//! message is larger than 1492 bytes, it will be sent over reliable transport instead
-	def('sendDgram', function(message) {
+	//! on the default channel, dgramChannel_Unreliable, delivery and packet order are not guaranteed.
+	//! dgramChannel_Sequenced also doesn't resend, but drops any message older than the last one
+	//! received. dgramChannel_ReliableOrdered resends until acked and delivers in order.
+	//! Messages larger than one datagram are fragmented on the sequenced and reliable channels,
+	//! and sent over reliable transport on the unreliable channel. A message on the sequenced or
+	//! reliable channel that would need more than 16384 fragments (about 22MB) throws. If unreliable transport isn't
+	//! available at all, everything is sent over reliable transport instead.
+	//! Both ends of the connection must support channels to use them
+	def('sendDgram', function(message, channel) {
 			if ((arguments.length == 1) && (arguments[0] == null)) { 
-				return methodSignature("send a message via the fastest transport mechanism", arguments, "undefined", 1, "({string|[object MemBlock]|[object ISerializable]|object} message )");
+				return methodSignature("send a message via the fastest transport mechanism", arguments, "undefined", 1, "({string|[object MemBlock]|[object ISerializable]|object} message, [number int] channel)");
 			}
+			channel = channel || dgramChannel_Unreliable;
 			if (!this._dgramAlive || !this.hasDgram) {
 				this.send(message);
+				return this;
+			}
+			// the Buffer takes over the serialized data, nothing is copied
+			var buf = this._messageSerializer(message).releaseBuffer();
+			if (channel == dgramChannel_Unreliable) {
+				if (buf.length > NET_DGRAM_MAX_SIZE) {
+					this._writeFrame(this._frameTcpBuffer(buf));
+				} else {
+					this._getDgramChannel(channel).stats.packetsSent++;
+					this._dgramSock.send(buf, 0, buf.length, this.remotePort, this.remoteAddr, this._dgramSendCallback.bind(this));
+				}
 			} else {
-				var memBlock = this._serializeMessage(message);
-				var len = memBlock.getDataSize();
-				var buf = new Buffer(len);
-				buf.write(memBlock.getData(), 0, len, 'binary');
-				this._dgramSock.send(buf, 0, buf.length, this.remotePort, this.remoteAddr, this._dgramSendCallback.bind(this));
+				this._sendChannelMessage(channel, buf);
 			}
 			return this;
 		});
 
+	//! get round trip time and loss statistics for one of this connection's datagram channels
+	//! rtt is the smoothed round trip time in ms, and loss the recent fraction of packets lost.
+	//! Only packet counts are kept for dgramChannel_Unreliable, since nothing there is acked
+	def('getDgramStats', function(channel) {
+			if ((arguments.length == 1) && (arguments[0] == null)) { 
+				return methodSignature("get round trip time and loss statistics for a datagram channel", arguments, "object", 1, "([number int] channel)");
+			}
+			var ch = this._getDgramChannel(channel || dgramChannel_Unreliable);
+			var stats = {
+				rtt: ch.srtt,
+				rttVariance: ch.rttvar,
+				loss: ch.loss,
+				inFlight: ch.unackedCount,
+				queued: ch.sendQueue.length
+			};
+			for (var key in ch.stats) {
+				stats[key] = ch.stats[key];
+			}
+			return stats;
+		});
+
 
 // ==============================================================
 // protected - you shouldn't need to call these directly
@@ -220,7 +306,7 @@ classify('NetConnection', function() {
 			this._startHandshake();
 		});
 
-	def('_serializeMessage', function(message) {
+	def('_messageSerializer', function(message) {
 			var dataType = '';
 			var ser = new pdg.Serializer();
 			if (typeof message == 'string') {
@@ -235,7 +321,7 @@ classify('NetConnection', function() {
 					ser.serialize_mem(message);
 				} else if (Buffer.isBuffer(message)) {
 					ser.serialize_1u('b'.charCodeAt(0));
-					ser.serialize_mem(message.toString('binary'));
+					ser.serialize_mem(message);
 				} else {
 					var json = JSON.stringify(message);
 					ser.serialize_1u('j'.charCodeAt(0));
@@ -248,12 +334,13 @@ classify('NetConnection', function() {
 				};
 				this._handleError(err, true); // this can throw an exception
 			}
-			return ser.getDataPtr();
+			return ser;
 		});
 
-	def('_deserializeMessage', function(memBlock) {
+	def('_deserializeMessage', function(data) {
+			// reads the Buffer in place, no copy
 			var ser = new pdg.Deserializer();
-			ser.setDataPtr(memBlock.toString('binary'));
+			ser.setDataPtr(data);
 			var dataType = String.fromCharCode(ser.deserialize_1u());
 			var message;
 			if (dataType == 's') {
@@ -278,6 +365,15 @@ classify('NetConnection', function() {
 			return message;
 		});
 
+	// frame a payload that is already in a Buffer for the tcp stream
+	def('_frameTcpBuffer', function(payload) {
+			var outBuf = new Buffer(payload.length + 5);
+			outBuf[0] = 'A'.charCodeAt(0);
+			outBuf.writeUInt32BE(payload.length, 1, true);
+			payload.copy(outBuf, 5);
+			return outBuf;
+		});
+
 	def('_frameTcpData', function(memBlock) {
 			// save the packet type and number of bytes in the message
 			var payload = memBlock.getData();
@@ -291,6 +387,31 @@ classify('NetConnection', function() {
 			return outBuf;
 		});
 
+	// serialize a message and frame it for the tcp stream. When the Serializer can copy
+	// into a Buffer the frame is built directly from the native data, so the payload never
+	// has to go through a binary string. The result can be written to any number of
+	// connections, which is how NetServer.broadcast() serializes only once
+	def('_frameMessage', function(message) {
+			var ser = this._messageSerializer(message);
+			if (typeof ser.copyDataTo != 'function') {
+				return this._frameTcpData(ser.getDataPtr());
+			}
+			var payloadSize = ser.getDataSize();
+			var outBuf = new Buffer(payloadSize + 5);
+			outBuf[0] = 'A'.charCodeAt(0);
+			outBuf.writeUInt32BE(payloadSize, 1, true);
+			ser.copyDataTo(outBuf, 5);
+			return outBuf;
+		});
+
+	// write an already framed message, returns false if it didn't all fit in the kernel buffer
+	def('_writeFrame', function(buf) {
+			if (NET_CONN_LOGGING) {
+	 			NET_CONN_LOG((this._client ? 'Client' : 'Server') + ' -> ' + this.remoteAddr+':'+this.remotePort + ' ['+buf.length+' bytes]', buf.toString('binary'), buf.length);
+	 		}
+			return this.socket.write(buf);
+		});
+
 	// for internal use by the protocol
 	def('_frameTcpCommand', function(cmd, cmdDataStr) {
 			if (!this._isLegalForProtocolVersion(cmd)) {
@@ -323,36 +444,39 @@ classify('NetConnection', function() {
 			return (legalCmds[this._protocolVers].indexOf(cmd) != -1);
 		});
 
-	def('_peekTcpCommand', function(data) {
-			return String.fromCharCode(data[0]);
-		});
-
-	def('_getNextFrameStart', function(data) {
-			var payloadSize = 0;
-			var frameSize = 0;
-			if (this._peekTcpCommand(data) == 'A') {
-				if (data.length > 5) {
-					payloadSize = data.readUInt32BE(1, true);
-				}
-				frameSize = 5;
+	// make room for at least needed bytes of unparsed data in _recvBuf, either by sliding
+	// what is there to the front or by growing it
+	def('_reserveTcpData', function(needed) {
+			if (!this._recvBuf) {
+				this._recvBuf = new Buffer(Math.max(needed, NET_CONN_RECV_BUFFER_SIZE));
+				return;
+			}
+			if (this._recvStart + needed <= this._recvBuf.length) {
+				return;
+			}
+			var pending = this._recvEnd - this._recvStart;
+			if (needed <= this._recvBuf.length) {
+				this._recvBuf.copy(this._recvBuf, 0, this._recvStart, this._recvEnd);
 			} else {
-				if (data.length > 3) {
-					payloadSize = data.readUInt16BE(1, true);
+				var size = this._recvBuf.length;
+				while (size < needed) {
+					size *= 2;
 				}
-				frameSize = 3;
+				var newBuf = new Buffer(size);
+				this._recvBuf.copy(newBuf, 0, this._recvStart, this._recvEnd);
+				this._recvBuf = newBuf;
 			}
-			return frameSize + payloadSize;
+			this._recvStart = 0;
+			this._recvEnd = pending;
 		});
 
-	def('_deframeTcpData', function(data) {
-			var payloadSize = data.readUInt32BE(1, true);
-			return data.slice(5, 5 + payloadSize);
-		});
-
-	def('_deframeTcpCmdData', function(data) {
-			var payloadSize = data.readUInt16BE(1, true);
-			var cmdData = data.slice(3, 3 + payloadSize).toString();
-			return cmdData;
+	// size of the frame starting at offset, or 0 if there aren't enough bytes yet to tell
+	def('_getTcpFrameSize', function(buf, offset, end) {
+			if (buf[offset] == 0x41) {  // 'A'
+				return (end - offset < 5) ? 0 : 5 + buf.readUInt32BE(offset + 1, true);
+			} else {
+				return (end - offset < 3) ? 0 : 3 + buf.readUInt16BE(offset + 1, true);
+			}
 		});
 
 	def('_handleError', function(error, canThrow) {
@@ -393,62 +517,57 @@ classify('NetConnection', function() {
 			}
 		});
 
+	// Incoming data goes into _recvBuf, which is kept from one read to the next and only grows
+	// when a frame doesn't fit, and bytes from _recvStart to _recvEnd haven't been parsed yet.
+	// When nothing is left over from the last read, frames are parsed straight out of the new
+	// data and only a partial frame at the end is copied. Frames are handled as slices of
+	// whichever buffer they are in, so they are only good until the next read
 	def('_handleTcpData', function(data) {
 	    try {
-// 			NET_CONN_LOG("got data on connection "+this.localAddr+":"+this.localPort+
-// 				" from "+this.remoteAddr+":"+this.remotePort);
 			// data should always be a buffer
 			if (Buffer.isBuffer(data)) {
-				NET_CONN_LOG((this._client ? 'Client' : 'Server') + ' <- ' + this.remoteAddr+':'+this.remotePort + ' ['+data.length+' bytes]', data.toString('binary'), data.length);
-				if (this._pendingData === false) {
-					this._pendingData = data;
-					this._pendingDataOffset = 0;
-				} else {
-					this._pendingData = Buffer.concat([this._pendingData, data]);
-				}
-				data = this._pendingData.slice(this._pendingDataOffset);
-				var nextFrameStart = this._getNextFrameStart(data);
-				while ( nextFrameStart <= data.length && this._alive) {
-					var packetLen = nextFrameStart;
-					NET_CONN_LOG('(packet @ '+this._pendingDataOffset+' to '+(this._pendingDataOffset+nextFrameStart-1)+') ['+packetLen+' bytes]', data.toString('binary'), packetLen);
-					var cmd = this._peekTcpCommand(data);
-					if (this._requireKey && (cmd != 'K') ) {
-						// expected a key, but didn't get one.
-						this.close(true); // kill the socket
-						var err = {
-							code:"ERR_MISSING_CLIENT_KEY",
-							message:"Remote side did not send client key. Connection killed."
-						}
-						this._handleError(err);
-					}
-					if (cmd == 'A') {
-						if (this._messageCallback) {
-							var memBlock = this._deframeTcpData(data);
-							var message = this._deserializeMessage(memBlock);
-							try {
-								this._messageCallback(message, this, 'tcp');
-							} catch(e) {
- 								console.error((this._client ? 'Client ' : 'Server ') + this.localAddr+':'+this.localPort+'/tcp'
- 									+ ' message callback for message from '+this.remoteAddr+':'+this.remotePort+'/tcp'
- 									+' threw Exception: '+JSON.stringify(e)
- 								);
-								if (this._client) {
-									throw(e);
-								}
-							}
-						}
-					} else {
-						var cmdData = this._deframeTcpCmdData(data);
-						this._handleTcpCommand(cmd, cmdData);
+				if (NET_CONN_LOGGING) {
+					NET_CONN_LOG((this._client ? 'Client' : 'Server') + ' <- ' + this.remoteAddr+':'+this.remotePort + ' ['+data.length+' bytes]', data.toString('binary'), data.length);
+				}
+				var buf = data;
+				var start = 0;
+				var end = data.length;
+				if (this._recvEnd > this._recvStart) {
+					this._reserveTcpData(this._recvEnd - this._recvStart + data.length);
+					data.copy(this._recvBuf, this._recvEnd);
+					this._recvEnd += data.length;
+					buf = this._recvBuf;
+					start = this._recvStart;
+					end = this._recvEnd;
+				}
+				var frameSize = this._getTcpFrameSize(buf, start, end);
+				while ((frameSize != 0) && (frameSize <= end - start) && this._alive) {
+					if (NET_CONN_LOGGING) {
+						NET_CONN_LOG('(packet @ '+start+' to '+(start+frameSize-1)+') ['+frameSize+' bytes]', buf.toString('binary', start, start + frameSize), frameSize);
 					}
-					this._pendingDataOffset += nextFrameStart;
-					data = this._pendingData.slice(this._pendingDataOffset);
-					nextFrameStart = this._getNextFrameStart(data);
+					var cmd = String.fromCharCode(buf[start]);
+					var headerSize = (cmd == 'A') ? 5 : 3;
+					this._handleTcpFrame(cmd, buf.slice(start + headerSize, start + frameSize));
+					start += frameSize;
+					frameSize = this._getTcpFrameSize(buf, start, end);
 				}
-				if (this._pendingDataOffset >= this._pendingData.length) {
-					// all the data has been consumed, delete the Buffer
-					this._pendingData = false;
+				if (start >= end) {
+					// all the data has been consumed
+					this._recvStart = 0;
+					this._recvEnd = 0;
 					NET_CONN_LOG('(buffer empty)');
+				} else if (buf === data) {
+					// keep the partial frame, with room for all of it if we know how big it is
+					this._recvStart = 0;
+					this._recvEnd = 0;
+					this._reserveTcpData(Math.max(end - start, frameSize));
+					data.copy(this._recvBuf, 0, start, end);
+					this._recvEnd = end - start;
+				} else {
+					this._recvStart = start;
+					if (frameSize > end - start) {
+						this._reserveTcpData(frameSize);
+					}
 				}
 			} else {
 				NET_CONN_LOG((this._client ? 'Client' : 'Server') + ' <- ' + this.remoteAddr+':'+this.remotePort + ' ['+data.length+' bytes]', data.toString(), data.length);
@@ -464,6 +583,38 @@ classify('NetConnection', function() {
 	    }
 		});
 
+	// handle one complete frame, payload is the data after the frame header
+	def('_handleTcpFrame', function(cmd, payload) {
+			if (this._requireKey && (cmd != 'K') ) {
+				// expected a key, but didn't get one.
+				this.close(true); // kill the socket
+				var err = {
+					code:"ERR_MISSING_CLIENT_KEY",
+					message:"Remote side did not send client key. Connection killed."
+				}
+				this._handleError(err);
+				return;
+			}
+			if (cmd == 'A') {
+				if (this._messageCallback) {
+					var message = this._deserializeMessage(payload);
+					try {
+						this._messageCallback(message, this, 'tcp');
+					} catch(e) {
+						console.error((this._client ? 'Client ' : 'Server ') + this.localAddr+':'+this.localPort+'/tcp'
+							+ ' message callback for message from '+this.remoteAddr+':'+this.remotePort+'/tcp'
+							+' threw Exception: '+JSON.stringify(e)
+						);
+						if (this._client) {
+							throw(e);
+						}
+					}
+				}
+			} else {
+				this._handleTcpCommand(cmd, payload.toString());
+			}
+		});
+
 	def('_startHandshake', function() {
 			var buf = this._frameTcpCommand('V', this._protocolVers.toString());
 			this.socket.write(buf);
@@ -635,15 +786,20 @@ classify('NetConnection', function() {
 
 	def('_handleDgram', function(msg, rinfo) {
 	    try {
-			NET_CONN_LOG((this._client ? 'Client' : 'Server') + ' dgram from ' + rinfo.address+':'+rinfo.port);
-			if (msg.toString() == '_pdg-dgram-start') {
+			if (NET_CONN_LOGGING) {
+				NET_CONN_LOG((this._client ? 'Client' : 'Server') + ' dgram from ' + rinfo.address+':'+rinfo.port);
+			}
+			if (msg[0] == NET_CHANNEL_PACKET) {
+				this._handleChannelPacket(msg);
+			} else if ((msg.length == 16) && (msg.toString() == '_pdg-dgram-start')) {
 				NET_CONN_LOG((this._client ? 'Client' : 'Server') + ' got dgram start from ' + this.remoteAddr+':'+this.remotePort);
 				this._dgramAlive = true;	// we got our Datagram start
 				this.hasDgram = true;		// and now we know that Datagram communication is possible
 			} else if (this._messageCallback) {
+				this._getDgramChannel(dgramChannel_Unreliable).stats.packetsReceived++;
 				try {
 					var message = this._deserializeMessage(msg);
-					this._messageCallback(message, this, 'udp');
+					this._messageCallback(message, this, 'udp', dgramChannel_Unreliable);
 				} catch(e) {
 					console.error((this._client ? 'Client ' : 'Server ') + this.localAddr+':'+this.localPort+'/udp'
 						+ ' message callback for message from '+this.remoteAddr+':'+this.remotePort+'/udp'
@@ -685,13 +841,414 @@ classify('NetConnection', function() {
 		});
 
 	def('_dgramSendCallback', function(err, bytes) {
-			NET_CONN_LOG((this._client ? 'Client' : 'Server') + ' sent '+bytes+' byte dgram to ' + this.remoteAddr+':'+this.remotePort);
+			if (NET_CONN_LOGGING) {
+				NET_CONN_LOG((this._client ? 'Client' : 'Server') + ' sent '+bytes+' byte dgram to ' + this.remoteAddr+':'+this.remotePort);
+			}
 			if (err) {
 				this._handleDgramError(err);
 			}
 		});
+
+// ==============================================================
+// datagram channels
+
+	def('_getDgramChannel', function(channel) {
+			var ch = this._dgramChannels[channel];
+			if (!ch) {
+				if ((channel !== dgramChannel_Unreliable) && (channel !== dgramChannel_Sequenced)
+				  && (channel !== dgramChannel_ReliableOrdered)) {
+					throw("unknown dgram channel "+channel);
+				}
+				ch = this._dgramChannels[channel] = {
+					channel: channel,
+					reliable: (channel == dgramChannel_ReliableOrdered),
+					// sending
+					nextSeq: 0,
+					unacked: {},         // by sequence number, packets sent but not yet acked
+					unackedCount: 0,
+					sendQueue: [],       // reliable packets waiting for room in flight
+					srtt: 0,
+					rttvar: 0,
+					rto: NET_CHANNEL_INITIAL_RTO,
+					loss: 0,
+					// receiving
+					recvNext: 0,         // reliable: next packet to deliver
+					recvBuffered: {},    // reliable: packets received ahead of recvNext
+					fragments: null,     // reliable: fragments of the message being delivered
+					recvLatest: -1,      // sequenced: newest packet received
+					recvBits: 0,         // sequenced: which of the 32 before it were received
+					partial: null,       // sequenced: the newest message still missing fragments
+					lastDelivered: -1,   // sequenced: first packet of the last message delivered
+					ackDue: 0,           // when we owe the other side an ack, 0 if we don't
+					recvSinceAck: 0,
+					stats: {
+						packetsSent: 0,
+						packetsResent: 0,
+						packetsLost: 0,
+						packetsReceived: 0,
+						packetsStale: 0,
+						messagesSent: 0,
+						messagesReceived: 0
+					}
+				};
+			}
+			return ch;
+		});
+
+	// split a serialized message into channel packets, and send as many as the channel allows
+	def('_sendChannelMessage', function(channel, payload) {
+			var fragSize = NET_DGRAM_MAX_SIZE - NET_CHANNEL_HEADER_SIZE;
+			var fragCount = Math.max(1, Math.ceil(payload.length / fragSize));
+			if (fragCount > NET_CHANNEL_MAX_FRAGMENTS) {
+				// sending it over tcp instead would let it overtake or fall behind the channel's
+				// other messages, which breaks the ordering the channel promises
+				throw("message of "+payload.length+" bytes is too large for dgram channel "+channel);
+			}
+			var ch = this._getDgramChannel(channel);
+			ch.stats.messagesSent++;
+			for (var i = 0; i < fragCount; i++) {
+				var start = i * fragSize;
+				var end = Math.min(start + fragSize, payload.length);
+				var buf = new Buffer(NET_CHANNEL_HEADER_SIZE + end - start);
+				buf[0] = NET_CHANNEL_PACKET;
+				buf.writeUInt16BE(ch.nextSeq, 2, true);
+				buf.writeUInt16BE(i, 10, true);
+				buf.writeUInt16BE(fragCount, 12, true);
+				payload.copy(buf, NET_CHANNEL_HEADER_SIZE, start, end);
+				var entry = { seq: ch.nextSeq, buf: buf, sentAt: 0, sends: 0 };
+				ch.nextSeq = (ch.nextSeq + 1) & 0xffff;
+				if (ch.reliable && (ch.sendQueue.length || !this._channelHasRoom(ch, entry))) {
+					ch.sendQueue.push(entry);
+				} else {
+					this._sendChannelPacket(ch, entry);
+				}
+			}
+		});
+
+	// whether a reliable packet can go out now without getting so far ahead of the oldest unacked
+	// one that the other side's ack bits couldn't reach it, see NET_CHANNEL_MAX_IN_FLIGHT
+	def('_channelHasRoom', function(ch, entry) {
+			for (var key in ch.unacked) {
+				if (seqDiff(entry.seq, ch.unacked[key].seq) >= NET_CHANNEL_MAX_IN_FLIGHT) {
+					return false;
+				}
+			}
+			return true;
+		});
+
+	// send or resend a packet, with the latest ack for its channel
+	def('_sendChannelPacket', function(ch, entry) {
+			this._writeChannelAck(ch, entry.buf);
+			entry.sentAt = pdg.tm.getMilliseconds();
+			entry.sends++;
+			if (entry.sends == 1) {
+				ch.stats.packetsSent++;
+				ch.unacked[entry.seq] = entry;
+				ch.unackedCount++;
+			} else {
+				ch.stats.packetsResent++;
+			}
+			this._dgramSock.send(entry.buf, 0, entry.buf.length, this.remotePort, this.remoteAddr, this._dgramSendCallback.bind(this));
+			this._scheduleChannelService();
+		});
+
+	def('_sendChannelAck', function(ch) {
+			var buf = new Buffer(NET_CHANNEL_HEADER_SIZE);
+			buf.fill(0);
+			buf[0] = NET_CHANNEL_PACKET;
+			this._writeChannelAck(ch, buf);
+			this._dgramSock.send(buf, 0, buf.length, this.remotePort, this.remoteAddr, this._dgramSendCallback.bind(this));
+		});
+
+	def('_writeChannelAck', function(ch, buf) {
+			var hasAck = true;
+			var ack, bits = 0;
+			if (ch.reliable) {
+				ack = ch.recvNext;
+				for (var n = 0; n < 32; n++) {
+					if (((ch.recvNext + 1 + n) & 0xffff) in ch.recvBuffered) {
+						bits |= (1 << n);
+					}
+				}
+			} else {
+				hasAck = (ch.recvLatest >= 0);
+				ack = hasAck ? ch.recvLatest : 0;
+				bits = ch.recvBits;
+			}
+			buf[1] = ch.channel | (hasAck ? NET_CHANNEL_HAS_ACK : 0);
+			buf.writeUInt16BE(ack, 4, true);
+			buf.writeUInt32BE(bits >>> 0, 6, true);
+			ch.ackDue = 0;  // this packet carries it
+			ch.recvSinceAck = 0;
+		});
+
+	def('_handleChannelPacket', function(msg) {
+			if (msg.length < NET_CHANNEL_HEADER_SIZE) {
+				return;
+			}
+			var channel = msg[1] & ~NET_CHANNEL_HAS_ACK;
+			if ((channel != dgramChannel_Sequenced) && (channel != dgramChannel_ReliableOrdered)) {
+				NET_CONN_LOG((this._client ? 'Client' : 'Server') + ' ignoring packet for unknown dgram channel '+channel);
+				return;
+			}
+			var ch = this._getDgramChannel(channel);
+			if (msg[1] & NET_CHANNEL_HAS_ACK) {
+				this._handleChannelAck(ch, msg.readUInt16BE(4, true), msg.readUInt32BE(6, true));
+			}
+			var fragIndex = msg.readUInt16BE(10, true);
+			var fragCount = msg.readUInt16BE(12, true);
+			if ((fragCount == 0) || (fragIndex >= fragCount)) {
+				return;  // only an ack
+			}
+			ch.stats.packetsReceived++;
+			// the Buffer is ours, so fragments can be kept as slices of it
+			var seq = msg.readUInt16BE(2, true);
+			var payload = msg.slice(NET_CHANNEL_HEADER_SIZE);
+			if (ch.reliable) {
+				this._receiveReliablePacket(ch, seq, fragIndex, fragCount, payload);
+			} else {
+				this._receiveSequencedPacket(ch, seq, fragIndex, fragCount, payload);
+			}
+			// even duplicates get acked, our last ack might have been lost
+			if (++ch.recvSinceAck >= NET_CHANNEL_ACK_EVERY) {
+				this._sendChannelAck(ch);
+			} else if (!ch.ackDue) {
+				ch.ackDue = pdg.tm.getMilliseconds() + NET_CHANNEL_ACK_DELAY;
+				this._scheduleChannelService();
+			}
+		});
+
+	def('_handleChannelAck', function(ch, ack, bits) {
+			var now = pdg.tm.getMilliseconds();
+			var ackedAny = false;
+			// on the reliable channel, a packet still missing after several later ones have arrived
+			// is most likely lost, so it is resent right away rather than waiting for a timeout.
+			// sackedAfter[d] is how many packets after ack+d the other side has
+			var sackedAfter = null;
+			if (ch.reliable && bits) {
+				sackedAfter = new Array(33);
+				sackedAfter[32] = 0;
+				for (var n = 31; n >= 0; n--) {
+					sackedAfter[n] = sackedAfter[n + 1] + ((bits & (1 << n)) ? 1 : 0);
+				}
+			}
+			for (var key in ch.unacked) {
+				var entry = ch.unacked[key];
+				var acked = false;
+				var d;
+				if (ch.reliable) {
+					d = seqDiff(entry.seq, ack);
+					acked = (d < 0) || ((d >= 1) && (d <= 32) && ((bits & (1 << (d - 1))) != 0));
+				} else {
+					d = seqDiff(ack, entry.seq);
+					acked = (d == 0) || ((d >= 1) && (d <= 32) && ((bits & (1 << (d - 1))) != 0));
+				}
+				if (acked) {
+					if (entry.sends == 1) {
+						// only packets sent once give a usable round trip time
+						this._addChannelRttSample(ch, now - entry.sentAt);
+						this._addChannelLossSample(ch, false);
+					}
+					delete ch.unacked[key];
+					ch.unackedCount--;
+					ackedAny = true;
+				} else if (!ch.reliable) {
+					if (d > 32) {
+						this._channelPacketLost(ch, entry);  // fell out of the ack window without being seen
+					}
+				} else if (sackedAfter && (d <= 32) && (sackedAfter[d] >= NET_CHANNEL_FAST_RESEND)
+				  && (now - entry.sentAt >= ch.srtt)) {
+					this._resendChannelPacket(ch, entry);
+				}
+			}
+			if (ackedAny) {
+				ch.rto = this._getChannelRto(ch);  // the other side is hearing us again, stop backing off
+			}
+			while (ch.sendQueue.length && this._channelHasRoom(ch, ch.sendQueue[0])) {
+				this._sendChannelPacket(ch, ch.sendQueue.shift());
+			}
+		});
+
+	def('_addChannelRttSample', function(ch, rtt) {
+			if (ch.srtt == 0) {
+				ch.srtt = rtt;
+				ch.rttvar = rtt / 2;
+			} else {
+				ch.rttvar += (Math.abs(ch.srtt - rtt) - ch.rttvar) / 4;
+				ch.srtt += (rtt - ch.srtt) / 8;
+			}
+		});
+
+	def('_getChannelRto', function(ch) {
+			if (ch.srtt == 0) {
+				return NET_CHANNEL_INITIAL_RTO;
+			}
+			return Math.min(Math.max(ch.srtt + 4 * ch.rttvar, NET_CHANNEL_MIN_RTO), NET_CHANNEL_MAX_RTO);
+		});
+
+	def('_addChannelLossSample', function(ch, lost) {
+			ch.loss += ((lost ? 1 : 0) - ch.loss) * NET_CHANNEL_LOSS_SMOOTHING;
+		});
+
+	// a sequenced packet was never acked, it won't be resent
+	def('_channelPacketLost', function(ch, entry) {
+			delete ch.unacked[entry.seq];
+			ch.unackedCount--;
+			ch.stats.packetsLost++;
+			this._addChannelLossSample(ch, true);
+		});
+
+	// a reliable packet wasn't acked, it only counts as lost the first time
+	def('_resendChannelPacket', function(ch, entry) {
+			if (entry.sends == 1) {
+				ch.stats.packetsLost++;
+				this._addChannelLossSample(ch, true);
+			}
+			this._sendChannelPacket(ch, entry);
+		});
+
+	// buffer packets that arrive early, then deliver everything that is now in order
+	def('_receiveReliablePacket', function(ch, seq, fragIndex, fragCount, payload) {
+			var d = seqDiff(seq, ch.recvNext);
+			if ((d < 0) || (d >= NET_CHANNEL_RECV_WINDOW) || (seq in ch.recvBuffered)) {
+				return;  // already delivered, already buffered, or much too early
+			}
+			ch.recvBuffered[seq] = { fragIndex: fragIndex, fragCount: fragCount, payload: payload };
+			while (ch.recvNext in ch.recvBuffered) {
+				var packet = ch.recvBuffered[ch.recvNext];
+				delete ch.recvBuffered[ch.recvNext];
+				ch.recvNext = (ch.recvNext + 1) & 0xffff;
+				if (packet.fragIndex == 0) {
+					ch.fragments = [];
+				}
+				if (!ch.fragments || (ch.fragments.length != packet.fragIndex)) {
+					ch.fragments = null;  // can only happen if the other side is broken
+					continue;
+				}
+				ch.fragments.push(packet.payload);
+				if (ch.fragments.length == packet.fragCount) {
+					var data = (ch.fragments.length == 1) ? ch.fragments[0] : Buffer.concat(ch.fragments);
+					ch.fragments = null;
+					this._deliverChannelMessage(ch, data);
+				}
+			}
+		});
+
+	// deliver the newest message as soon as all its fragments are in, drop anything older
+	def('_receiveSequencedPacket', function(ch, seq, fragIndex, fragCount, payload) {
+			if (ch.recvLatest < 0) {
+				ch.recvLatest = seq;
+			} else {
+				var d = seqDiff(seq, ch.recvLatest);
+				if (d > 0) {
+					ch.recvBits = (d < 32) ? (((ch.recvBits << d) | (1 << (d - 1))) >>> 0) : ((d == 32) ? 0x80000000 : 0);
+					ch.recvLatest = seq;
+				} else if ((d == 0) || (d < -32) || (ch.recvBits & (1 << (-d - 1)))) {
+					return;  // duplicate, or too old to tell
+				} else {
+					ch.recvBits = (ch.recvBits | (1 << (-d - 1))) >>> 0;
+				}
+			}
+			var messageStart = (seq - fragIndex) & 0xffff;
+			if ((ch.lastDelivered >= 0) && (seqDiff(messageStart, ch.lastDelivered) <= 0)) {
+				ch.stats.packetsStale++;
+				return;
+			}
+			if (fragCount == 1) {
+				ch.lastDelivered = messageStart;
+				this._deliverChannelMessage(ch, payload);
+				return;
+			}
+			var partial = ch.partial;
+			if (!partial || (partial.start != messageStart)) {
+				if (partial && (seqDiff(messageStart, partial.start) < 0)) {
+					ch.stats.packetsStale++;
+					return;
+				}
+				// a newer message replaces whatever we had of an older one
+				partial = ch.partial = { start: messageStart, count: fragCount, have: 0, fragments: new Array(fragCount) };
+			}
+			if (!partial.fragments[fragIndex]) {
+				partial.fragments[fragIndex] = payload;
+				partial.have++;
+			}
+			if (partial.have == partial.count) {
+				ch.partial = null;
+				ch.lastDelivered = messageStart;
+				this._deliverChannelMessage(ch, Buffer.concat(partial.fragments));
+			}
+		});
+
+	def('_deliverChannelMessage', function(ch, data) {
+			ch.stats.messagesReceived++;
+			if (this._messageCallback) {
+				var message = this._deserializeMessage(data);
+				try {
+					this._messageCallback(message, this, 'udp', ch.channel);
+				} catch(e) {
+					console.error((this._client ? 'Client ' : 'Server ') + this.localAddr+':'+this.localPort+'/udp'
+						+ ' message callback for message from '+this.remoteAddr+':'+this.remotePort+'/udp'
+						+' threw Exception: '+JSON.stringify(e)
+					);
+					if (this._client) {
+						throw(e);
+					}
+				}
+			}
+		});
+
+	def('_scheduleChannelService', function() {
+			if (!this._channelTimerPending) {
+				this._channelTimerPending = true;
+				pdg.tm.onTimeout(function(evt) {
+					this._channelTimerPending = false;
+					this._serviceChannels();
+				}.bind(this), NET_CHANNEL_SERVICE_INTERVAL);
+			}
+		});
+
+	// resend reliable packets that weren't acked in time, give up on sequenced ones, and send
+	// acks that nothing else went out to carry. Keeps itself scheduled while there is work left
+	def('_serviceChannels', function() {
+			if (!this._dgramAlive || !this._dgramSock) {
+				return;  // connection is gone
+			}
+			var now = pdg.tm.getMilliseconds();
+			var busy = false;
+			for (var i = 0; i < this._dgramChannels.length; i++) {
+				var ch = this._dgramChannels[i];
+				if (!ch || (ch.channel == dgramChannel_Unreliable)) {
+					continue;
+				}
+				var timedOut = false;
+				for (var key in ch.unacked) {
+					var entry = ch.unacked[key];
+					if (ch.reliable) {
+						if (now - entry.sentAt >= ch.rto) {
+							this._resendChannelPacket(ch, entry);
+							timedOut = true;
+						}
+					} else if (now - entry.sentAt >= NET_CHANNEL_MAX_RTO) {
+						this._channelPacketLost(ch, entry);
+					}
+				}
+				if (timedOut) {
+					ch.rto = Math.min(ch.rto * 2, NET_CHANNEL_MAX_RTO);  // back off
+				}
+				if (ch.ackDue && (now >= ch.ackDue)) {
+					this._sendChannelAck(ch);
+				}
+				busy = busy || (ch.unackedCount > 0) || (ch.ackDue != 0);
+			}
+			if (busy) {
+				this._scheduleChannelService();
+			}
+		});
 });
 
 if(!(typeof exports === 'undefined')) {
     exports.NetConnection = NetConnection;
+    exports.dgramChannel_Unreliable = dgramChannel_Unreliable;
+    exports.dgramChannel_Sequenced = dgramChannel_Sequenced;
+    exports.dgramChannel_ReliableOrdered = dgramChannel_ReliableOrdered;
 }
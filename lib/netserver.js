@@ -123,28 +123,32 @@ classify('NetServer', function() {
 	//! send a message to all 
 	//! returns number of connections the message was sent to
 	//! filter - bool filter([object NetConnection] connection)
+	//! the message is serialized only once, no matter how many connections it goes to
 	def('broadcast', function(message, filter) {
 			if ((arguments.length == 1) && (arguments[0] == null)) { 
 				return methodSignature("send a message to all connections, with optional filter", arguments, "number", 2, "(object message, function filter = null)");
 			}
-			var msgCount = 0;
-			if (typeof filter != 'function') {
-				// send the message to everyone, no exceptions
-				for (var i = 0; i < connections.length; i++) {
-					connections[i].send(message);
-				}
-				msgCount = connections.length;
-			} else {
+			var recipients = this.connections;
+			if (typeof filter == 'function') {
 				// send the message only to connections for which the filter func returns true
-				for (var i = 0; i < connections.length; i++) {
-					var connection = connections[i];
-					if (filterFunc(connection)) {
-						connection.send(message);
-						msgCount++;
+				recipients = [];
+				for (var i = 0; i < this.connections.length; i++) {
+					var connection = this.connections[i];
+					if (filter(connection)) {
+						recipients.push(connection);
 					}
 				}
 			}
-			return msgCount;
+			if (recipients.length == 0) {
+				return 0;
+			}
+			// every connection frames tcp data the same way, so one framed Buffer can be
+			// written to all of them
+			var buf = recipients[0]._frameMessage(message);
+			for (var i = 0; i < recipients.length; i++) {
+				recipients[i]._writeFrame(buf);
+			}
+			return recipients.length;
 		});
 
 	//! expect a client with a particular key to connect
@@ -131,6 +131,8 @@ exports.action_FadeComplete = 10;
 exports.action_FadeInComplete = 11;
 exports.action_FadeOutComplete = 12;
 exports.action_JointBreak = 13;
+exports.action_EnterObserver = 14;
+exports.action_ExitObserver = 15;
 exports.touch_MouseEnter = 20;
 exports.touch_MouseLeave = 21;
 exports.touch_MouseDown = 22;
@@ -353,16 +353,14 @@ if (!jsc && !inbrowser) { // not supported on iOS/JavaScriptCore currently
 	module.exports.NetConnection = netconnection.NetConnection;
 	module.exports.NetClient = netclient.NetClient;
 	module.exports.NetServer = netserver.NetServer;
+	module.exports.dgramChannel_Unreliable = netconnection.dgramChannel_Unreliable;
+	module.exports.dgramChannel_Sequenced = netconnection.dgramChannel_Sequenced;
+	module.exports.dgramChannel_ReliableOrdered = netconnection.dgramChannel_ReliableOrdered;
 
 	process._pdgScriptClasses['NetConnection'] = (new netconnection.NetConnection).__proto__;
 	process._pdgScriptClasses['NetClient'] = (new netclient.NetClient).__proto__;
 	process._pdgScriptClasses['NetServer'] = (new netserver.NetServer).__proto__;
 
-	module.exports.MemBlock.prototype.toBuffer = function() {
-		var _sig = methodSignature("", arguments, "[object Buffer]", 0, "()"); if (_sig != null) return _sig;
-		return new Buffer(this.getData(), 'binary');
-	}
-
 	module.exports.openCommandPort = bindings.openCommandPort;
 	module.exports.hasNetwork = true;
 } else {
@@ -617,6 +615,8 @@ module.exports.Sprite.prototype.on = function(eventCode, func) {
 		evtCode = bindings.eventType_SpriteCollide;
 	} else if (eventCode <= bindings.action_FadeOutComplete) {
 		evtCode = bindings.eventType_SpriteAnimate;
+	} else if (eventCode == bindings.action_EnterObserver || eventCode == bindings.action_ExitObserver) {
+		evtCode = bindings.eventType_SpriteAnimate;
 	} else {
 		evtCode = bindings.eventType_SpriteTouch;
 	}
@@ -677,6 +677,16 @@ module.exports.Sprite.prototype.onFadeOutComplete = function(func) {
 	var _sig = methodSignature("", arguments, "[object IEventHandler]", 1, "(function func)"); if (_sig != null) return _sig;
 	return this.on(bindings.action_FadeOutComplete, func);
 }
+// Sprite.onEnterObserver(function)
+module.exports.Sprite.prototype.onEnterObserver = function(func) {
+	var _sig = methodSignature("", arguments, "[object IEventHandler]", 1, "(function func)"); if (_sig != null) return _sig;
+	return this.on(bindings.action_EnterObserver, func);
+}
+// Sprite.onExitObserver(function)
+module.exports.Sprite.prototype.onExitObserver = function(func) {
+	var _sig = methodSignature("", arguments, "[object IEventHandler]", 1, "(function func)"); if (_sig != null) return _sig;
+	return this.on(bindings.action_ExitObserver, func);
+}
 // Sprite.onMouseEnter(function)
 module.exports.Sprite.prototype.onMouseEnter = function(func) {
 	var _sig = methodSignature("", arguments, "[object IEventHandler]", 1, "(function func)"); if (_sig != null) return _sig;
@@ -723,6 +733,8 @@ module.exports.SpriteLayer.prototype.on = function(eventCode, func) {
 		evtCode = bindings.eventType_SpriteCollide;
 	} else if (eventCode <= bindings.action_FadeOutComplete) {
 		evtCode = bindings.eventType_SpriteAnimate;
+	} else if (eventCode == bindings.action_EnterObserver || eventCode == bindings.action_ExitObserver) {
+		evtCode = bindings.eventType_SpriteAnimate;
 	} else if (eventCode >= bindings.action_ErasePort) {
 		evtCode = bindings.eventType_SpriteLayer;
 	} else {
@@ -796,6 +808,18 @@ module.exports.SpriteLayer.prototype.onFadeOutComplete = function(func) {
 	return this.on(bindings.action_FadeOutComplete, func);
 }
 module.exports.TileLayer.prototype.onFadeOutComplete = module.exports.SpriteLayer.prototype.onFadeOutComplete;
+// SpriteLayer.onEnterObserver(function)
+module.exports.SpriteLayer.prototype.onEnterObserver = function(func) {
+	var _sig = methodSignature("", arguments, "[object IEventHandler]", 1, "(function func)"); if (_sig != null) return _sig;
+	return this.on(bindings.action_EnterObserver, func);
+}
+module.exports.TileLayer.prototype.onEnterObserver = module.exports.SpriteLayer.prototype.onEnterObserver;
+// SpriteLayer.onExitObserver(function)
+module.exports.SpriteLayer.prototype.onExitObserver = function(func) {
+	var _sig = methodSignature("", arguments, "[object IEventHandler]", 1, "(function func)"); if (_sig != null) return _sig;
+	return this.on(bindings.action_ExitObserver, func);
+}
+module.exports.TileLayer.prototype.onExitObserver = module.exports.SpriteLayer.prototype.onExitObserver;
 // SpriteLayer.onMouseEnter(function)
 module.exports.SpriteLayer.prototype.onMouseEnter = function(func) {
 	var _sig = methodSignature("", arguments, "[object IEventHandler]", 1, "(function func)"); if (_sig != null) return _sig;
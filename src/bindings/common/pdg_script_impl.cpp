@@ -59,6 +59,7 @@ BINDING_INITIALIZER_IMPL(MemBlock)
 		HAS_METHOD(MemBlock, "getDataSize", GetDataSize)
 		HAS_METHOD(MemBlock, "getByte", GetByte)
 		HAS_METHOD(MemBlock, "getBytes", GetBytes)
+		HAS_METHOD(MemBlock, "toBuffer", ToBuffer)
     );
 	END
 METHOD_IMPL(MemBlock, GetData)
@@ -86,6 +87,12 @@ METHOD_IMPL(MemBlock, GetBytes)
 	VALUE resultVal = EncodeBinary(self->ptr + start, len);
 	RETURN(resultVal);
 	END
+METHOD_IMPL(MemBlock, ToBuffer)
+	METHOD_SIGNATURE("", [object Buffer], 0, ())
+    REQUIRE_ARG_COUNT(0);
+    // a straight copy, the MemBlock may not own its memory so the Buffer can't share it
+	RETURN(BUFFER2VAL(self->ptr, self->bytes));
+	END
 
 CLEANUP_IMPL(MemBlock)
 
@@ -610,6 +617,12 @@ BINDING_INITIALIZER_IMPL(Serializer)
 		HAS_METHOD(Serializer, "sizeof_ref", Sizeof_ref)
 		HAS_METHOD(Serializer, "getDataSize", GetDataSize)
 		HAS_METHOD(Serializer, "getDataPtr", GetDataPtr)
+		HAS_METHOD(Serializer, "copyDataTo", CopyDataTo)
+		HAS_METHOD(Serializer, "releaseBuffer", ReleaseBuffer)
+		HAS_METHOD(Serializer, "getCapacity", GetCapacity)
+		HAS_METHOD(Serializer, "reserve", Reserve)
+		HAS_METHOD(Serializer, "reset", Reset)
+		HAS_METHOD(Serializer, "setStreaming", SetStreaming)
     );
 	END
 METHOD_IMPL(Serializer, Serialize_d)
@@ -762,16 +775,20 @@ METHOD_IMPL(Serializer, Serialize_str)
 	NO_RETURN;
 	END
 METHOD_IMPL(Serializer, Serialize_mem)
-	METHOD_SIGNATURE("", undefined, 1, ({[string Binary]|[object MemBlock]} mem));
+	METHOD_SIGNATURE("", undefined, 1, ({[string Binary]|[object MemBlock]|[object Buffer]} mem));
     REQUIRE_ARG_COUNT(1);
     bool isStr = VALUE_IS_STRING(ARGV[0]);
     if (!isStr && !VALUE_IS_OBJECT(ARGV[0])) {
-    	THROW_TYPE_ERR("argument 1 (mem) must be either a binary string or an object of type MemBlock");
+    	THROW_TYPE_ERR("argument 1 (mem) must be a binary string, a Buffer or an object of type MemBlock");
     }
     if (isStr) {
     	size_t bytes = 0;
     	uint8* ptr = (uint8*) DecodeBinary(ARGV[0], &bytes);
 		self->serialize_mem(ptr, bytes);
+		std::free(ptr);
+	} else if (VALUE_IS_BUFFER(ARGV[0])) {
+		REQUIRE_UINT8_ARRAY_ARG(1, buffer);
+		self->serialize_mem(buffer, bufferLength);
 	} else {
     	REQUIRE_CPP_OBJECT_ARG(1, memBlock, MemBlock);
     	self->serialize_mem(memBlock->ptr, memBlock->bytes);
@@ -798,6 +815,55 @@ METHOD_IMPL(Serializer, GetDataPtr)
  	MemBlock* memBlock = new MemBlock((char*)self->getDataPtr(), self->getDataSize(), false);
 	RETURN_CPP_OBJECT(memBlock, MemBlock);
 	END
+METHOD_IMPL(Serializer, CopyDataTo)
+	METHOD_SIGNATURE("", number, 1, ([object Buffer] out, number offset = 0));
+    REQUIRE_ARG_MIN_COUNT(1);
+	REQUIRE_UINT8_ARRAY_ARG(1, out);
+	OPTIONAL_UINT32_ARG(2, offset, 0);
+	// copy straight into the caller's buffer, so the data never has to become a binary string
+	uint32 dataSize = self->getDataSize();
+	if ((offset > outLength) || (dataSize > outLength - offset)) {
+		THROW_RANGE_ERR("serialized data ("<<dataSize<<" bytes) doesn't fit in the buffer ("<<outLength<<" bytes) at offset "<<offset);
+		dataSize = 0;
+	} else {
+		std::memcpy(out + offset, self->getDataPtr(), dataSize);
+	}
+	RETURN_UINT32(dataSize);
+	END
+METHOD_IMPL(Serializer, ReleaseBuffer)
+	METHOD_SIGNATURE("", [object Buffer], 0, ());
+    REQUIRE_ARG_COUNT(0);
+    // the Buffer takes over the serialized data without copying it, and the Serializer starts over
+    size_t dataSize = 0;
+    uint8* data = self->releaseData(dataSize);
+	RETURN(OWNED_BUFFER2VAL(data, dataSize));
+	END
+METHOD_IMPL(Serializer, GetCapacity)
+	METHOD_SIGNATURE("", number, 0, ());
+    REQUIRE_ARG_COUNT(0);
+ 	uint32 capacity = self->getCapacity();
+	RETURN_UINT32(capacity);
+	END
+METHOD_IMPL(Serializer, Reserve)
+	METHOD_SIGNATURE("", undefined, 1, (number bytes));
+    REQUIRE_ARG_COUNT(1);
+	REQUIRE_UINT32_ARG(1, bytes);
+	self->reserve(bytes);
+	NO_RETURN;
+	END
+METHOD_IMPL(Serializer, Reset)
+	METHOD_SIGNATURE("", undefined, 0, ());
+    REQUIRE_ARG_COUNT(0);
+	self->reset();
+	NO_RETURN;
+	END
+METHOD_IMPL(Serializer, SetStreaming)
+	METHOD_SIGNATURE("", Serializer, 1, (boolean streamIt));
+    REQUIRE_ARG_COUNT(1);
+    REQUIRE_BOOL_ARG(1, streamIt);
+	self->setStreaming(streamIt);
+	RETURN_THIS;
+	END
 SERIALIZER_SIZE_OF_METHOD_IMPL(1)
 SERIALIZER_SIZE_OF_METHOD_IMPL(1u)
 SERIALIZER_SIZE_OF_METHOD_IMPL(2)
@@ -827,17 +893,21 @@ CUSTOM_SERIALIZER_SIZE_OF_METHOD_IMPL(obj,
     size_t n = 0 )
 
 METHOD_IMPL(Serializer, Sizeof_mem)
-	METHOD_SIGNATURE("", [number uint], 1, ({[string Binary]|[object MemBlock]} mem));
+	METHOD_SIGNATURE("", [number uint], 1, ({[string Binary]|[object MemBlock]|[object Buffer]} mem));
     REQUIRE_ARG_COUNT(1);
     bool isStr = VALUE_IS_STRING(ARGV[0]);
     if (!isStr && !VALUE_IS_OBJECT(ARGV[0])) {
-    	THROW_TYPE_ERR("argument 1 (mem) must be either a binary string or an object of type MemBlock");
+    	THROW_TYPE_ERR("argument 1 (mem) must be a binary string, a Buffer or an object of type MemBlock");
     }
     size_t n = 0;
     if (isStr) {
     	size_t bytes = 0;
     	uint8* ptr = (uint8*) DecodeBinary(ARGV[0], &bytes);
 		n = self->sizeof_mem(ptr, bytes);
+		std::free(ptr);
+	} else if (VALUE_IS_BUFFER(ARGV[0])) {
+		REQUIRE_UINT8_ARRAY_ARG(1, buffer);
+		n = self->sizeof_mem(buffer, bufferLength);
 	} else {
     	REQUIRE_CPP_OBJECT_ARG(1, memBlock, MemBlock);
     	n = self->sizeof_mem(memBlock->ptr, memBlock->bytes);
@@ -1164,18 +1234,25 @@ METHOD_IMPL(Deserializer, Deserialize_memGetLen)
 	}
 	END
 METHOD_IMPL(Deserializer, SetDataPtr)
-	METHOD_SIGNATURE("", undefined, 1, ({[string Binary]|[object MemBlock]} data));
+	METHOD_SIGNATURE("", undefined, 1, ({[string Binary]|[object MemBlock]|[object Buffer]} data));
     REQUIRE_ARG_COUNT(1);
     if (!VALUE_IS_STRING(ARGV[0]) && !VALUE_IS_OBJECT(ARGV[0])) {
-    	THROW_TYPE_ERR("argument 1 (mem) must be either a binary string or an object of type MemBlock");
+    	THROW_TYPE_ERR("argument 1 (mem) must be a binary string, a Buffer or an object of type MemBlock");
     }
     if (VALUE_IS_STRING(ARGV[0])) {
+    	// the Deserializer owns the decoded copy
     	size_t bytes = 0;
     	uint8* ptr = (uint8*) DecodeBinary(ARGV[0], &bytes);
 		self->setDataPtr(ptr, bytes);
+	} else if (VALUE_IS_BUFFER(ARGV[0])) {
+		// read the Buffer in place, it's kept alive for as long as this Deserializer is
+		REQUIRE_UINT8_ARRAY_ARG(1, buffer);
+		HIDDEN_REF_SAVE(THIS, _data, ARGV[0]);
+		self->setDataPtr(buffer, bufferLength, false);
 	} else {
     	REQUIRE_CPP_OBJECT_ARG(1, memBlock, MemBlock);
-    	self->setDataPtr(memBlock->ptr, memBlock->bytes);
+		HIDDEN_REF_SAVE(THIS, _data, ARGV[0]);
+    	self->setDataPtr(memBlock->ptr, memBlock->bytes, false);
     }
 	NO_RETURN;
 	END
@@ -2460,7 +2537,12 @@ CLEANUP_IMPL(IAnimationHelper)
 
 
 #define ANIMATED_BASE_CLASS_IMPL(klass) CR \
-PROPERTY_IMPL(klass, Location, POINT) CR \
+METHOD_IMPL(klass, GetLocation) CR \
+ 	METHOD_SIGNATURE("", [object Point], 2, ({[object Point]|[object Float32Array]} out, [number int] outIndex = 0)); CR \
+    pdg::Point theLocation = self->getLocation(); CR \
+	RETURN_POINT_INTO(theLocation, 1); CR \
+	END CR \
+SETTER_IMPL(klass, Location, POINT) CR \
 PROPERTY_IMPL(klass, Speed, NUMBER) CR \
 PROPERTY_IMPL(klass, Width, NUMBER) CR \
 PROPERTY_IMPL(klass, Height, NUMBER) CR \
@@ -2472,10 +2554,9 @@ PROPERTY_IMPL(klass, MoveFriction, NUMBER) CR \
 PROPERTY_IMPL(klass, SpinFriction, NUMBER) CR \
 PROPERTY_IMPL(klass, SizeFriction, NUMBER) CR \
 METHOD_IMPL(klass, GetBoundingBox) CR \
- 	METHOD_SIGNATURE("", [object Rect], 0, ()); CR \
-    REQUIRE_ARG_COUNT(0); CR \
+ 	METHOD_SIGNATURE("", [object Rect], 2, ({[object Rect]|[object Float32Array]} out, [number int] outIndex = 0)); CR \
     pdg::Rect r = self->getBoundingBox(); CR \
-	RETURN( RECT2VAL(r) ); CR \
+	RETURN_RECT_INTO(r, 1); CR \
 	END CR \
 METHOD_IMPL(klass, GetRotatedBounds) CR \
  	METHOD_SIGNATURE("", [object RotatedRect], 0, ()); CR \
@@ -2577,7 +2658,11 @@ METHOD_IMPL(klass, SetVelocity) CR \
     } CR \
 	RETURN_THIS; CR \
 	END CR \
-GETTER_IMPL(klass, Velocity, VECTOR) CR \
+METHOD_IMPL(klass, GetVelocity) CR \
+ 	METHOD_SIGNATURE("", [object Vector], 2, ({[object Vector]|[object Float32Array]} out, [number int] outIndex = 0)); CR \
+    pdg::Vector theVelocity = self->getVelocity(); CR \
+	RETURN_VECTOR_INTO(theVelocity, 1); CR \
+	END CR \
 METHOD_IMPL(klass, StopMoving) CR \
 	METHOD_SIGNATURE("", undefined, 0, ()); CR \
     REQUIRE_ARG_COUNT(0); CR \
@@ -3847,6 +3932,14 @@ CPP_CONSTRUCTOR_IMPL(Sprite)
 
 #define HAS_SPRITE_LAYER_METHODS(klass) \
 	HAS_METHOD(klass, "setSerializationFlags", SetSerializationFlags) \
+	HAS_METHOD(klass, "takeSnapshot", TakeSnapshot) \
+	HAS_METHOD(klass, "setSerializationBaseline", SetSerializationBaseline) \
+	HAS_METHOD(klass, "getLastSnapshotId", GetLastSnapshotId) \
+	HAS_METHOD(klass, "addObserver", AddObserver) \
+	HAS_METHOD(klass, "removeObserver", RemoveObserver) \
+	HAS_METHOD(klass, "setObserverArea", SetObserverArea) \
+	HAS_METHOD(klass, "setObserverRadius", SetObserverRadius) \
+	HAS_METHOD(klass, "setSerializationObserver", SetSerializationObserver) \
 	HAS_METHOD(klass, "startAnimations", StartAnimations)  \
 	HAS_METHOD(klass, "stopAnimations", StopAnimations)  \
 	HAS_METHOD(klass, "hide", Hide)  \
@@ -3859,12 +3952,17 @@ CPP_CONSTRUCTOR_IMPL(Sprite)
 	HAS_METHOD(klass, "moveToFront", MoveToFront)  \
 	HAS_METHOD(klass, "moveToBack", MoveToBack)  \
 	HAS_METHOD(klass, "getZOrder", GetZOrder)  \
+	HAS_METHOD(klass, "getWorld", GetWorld)  \
 	HAS_METHOD(klass, "moveWith", MoveWith)  \
 	HAS_METHOD(klass, "findSprite", FindSprite)  \
 	HAS_METHOD(klass, "getNthSprite", GetNthSprite)  \
 	HAS_METHOD(klass, "getSpriteZOrder", GetSpriteZOrder)  \
 	HAS_METHOD(klass, "isSpriteBehind", IsSpriteBehind)  \
 	HAS_METHOD(klass, "hasSprite", HasSprite)  \
+	HAS_METHOD(klass, "getSpriteStates", GetSpriteStates)  \
+	HAS_METHOD(klass, "getSpriteStatesById", GetSpriteStatesById)  \
+	HAS_METHOD(klass, "setSpriteStates", SetSpriteStates)  \
+	HAS_METHOD(klass, "setSpriteStatesById", SetSpriteStatesById)  \
 	HAS_METHOD(klass, "addSprite", AddSprite)  \
 	HAS_METHOD(klass, "removeSprite", RemoveSprite)  \
 	HAS_METHOD(klass, "removeAllSprites", RemoveAllSprites)  \
@@ -3872,7 +3970,10 @@ CPP_CONSTRUCTOR_IMPL(Sprite)
 	HAS_METHOD(klass, "disableCollisions", DisableCollisions)  \
 	HAS_METHOD(klass, "enableCollisionsWithLayer", EnableCollisionsWithLayer)  \
 	HAS_METHOD(klass, "disableCollisionsWithLayer", DisableCollisionsWithLayer)  \
+	HAS_METHOD(klass, "enableCollisionGrid", EnableCollisionGrid)  \
+	HAS_METHOD(klass, "disableCollisionGrid", DisableCollisionGrid)  \
 	HAS_METHOD(klass, "createSprite", CreateSprite)  \
+	HAS_METHOD(klass, "cloneSprite", CloneSprite)  \
 
 #define HAS_SPRITE_LAYER_GUI_METHODS(klass) \
 	HAS_METHOD(klass, "getSpritePort", GetSpritePort)  \
@@ -3902,6 +4003,13 @@ CPP_CONSTRUCTOR_IMPL(Sprite)
 	HAS_METHOD(klass, "setStaticLayer", SetStaticLayer)  \
 	HAS_METHOD(klass, "setKeepGravityDownward", SetKeepGravityDownward)  \
 	HAS_METHOD(klass, "setDamping", SetDamping)  \
+	HAS_METHOD(klass, "setPhysicsThreads", SetPhysicsThreads)  \
+	HAS_METHOD(klass, "getPhysicsThreads", GetPhysicsThreads)  \
+	HAS_METHOD(klass, "getPhysicsStepTime", GetPhysicsStepTime)  \
+	HAS_METHOD(klass, "setFixedPhysicsStep", SetFixedPhysicsStep)  \
+	HAS_METHOD(klass, "getFixedPhysicsStep", GetFixedPhysicsStep)  \
+	HAS_METHOD(klass, "setPhysicsInterpolation", SetPhysicsInterpolation)  \
+	HAS_METHOD(klass, "getPhysicsAlpha", GetPhysicsAlpha)  \
 	HAS_METHOD(klass, "getSpace", GetSpace)  \
 
 #define SPRITE_LAYER_BASE_CLASS_GUI_IMPL(klass) CR \
@@ -4067,6 +4175,62 @@ METHOD_IMPL(klass, SetSerializationFlags) CR \
 	self->setSerializationFlags(flags); CR \
 	RETURN_THIS; CR \
 	END CR \
+METHOD_IMPL(klass, TakeSnapshot) CR \
+	METHOD_SIGNATURE("", number, 0, ()); CR \
+    REQUIRE_ARG_COUNT(0); CR \
+	uint32 snapshotId = self->takeSnapshot(); CR \
+	RETURN_UNSIGNED(snapshotId); CR \
+	END CR \
+METHOD_IMPL(klass, SetSerializationBaseline) CR \
+	METHOD_SIGNATURE("", [object SpriteLayer], 0, ([number uint] baselineId)); CR \
+    REQUIRE_ARG_COUNT(1); CR \
+    REQUIRE_UINT32_ARG(1, baselineId); CR \
+	self->setSerializationBaseline(baselineId); CR \
+	RETURN_THIS; CR \
+	END CR \
+METHOD_IMPL(klass, GetLastSnapshotId) CR \
+	METHOD_SIGNATURE("", number, 0, ()); CR \
+    REQUIRE_ARG_COUNT(0); CR \
+	uint32 snapshotId = self->getLastSnapshotId(); CR \
+	RETURN_UNSIGNED(snapshotId); CR \
+	END CR \
+METHOD_IMPL(klass, AddObserver) CR \
+	METHOD_SIGNATURE("", number, 0, ()); CR \
+    REQUIRE_ARG_COUNT(0); CR \
+	uint32 observerId = self->addObserver(); CR \
+	RETURN_UNSIGNED(observerId); CR \
+	END CR \
+METHOD_IMPL(klass, RemoveObserver) CR \
+	METHOD_SIGNATURE("", undefined, 0, ([number uint] observerId)); CR \
+    REQUIRE_ARG_COUNT(1); CR \
+    REQUIRE_UINT32_ARG(1, observerId); CR \
+	self->removeObserver(observerId); CR \
+	NO_RETURN; CR \
+	END CR \
+METHOD_IMPL(klass, SetObserverArea) CR \
+	METHOD_SIGNATURE("", [object SpriteLayer], 0, ([number uint] observerId, [object Rect] area)); CR \
+    REQUIRE_ARG_COUNT(2); CR \
+    REQUIRE_UINT32_ARG(1, observerId); CR \
+    REQUIRE_RECT_ARG(2, area); CR \
+	self->setObserverArea(observerId, area); CR \
+	RETURN_THIS; CR \
+	END CR \
+METHOD_IMPL(klass, SetObserverRadius) CR \
+	METHOD_SIGNATURE("", [object SpriteLayer], 0, ([number uint] observerId, [object Point] center, number radius)); CR \
+    REQUIRE_ARG_COUNT(3); CR \
+    REQUIRE_UINT32_ARG(1, observerId); CR \
+    REQUIRE_POINT_ARG(2, center); CR \
+    REQUIRE_NUMBER_ARG(3, radius); CR \
+	self->setObserverRadius(observerId, center, radius); CR \
+	RETURN_THIS; CR \
+	END CR \
+METHOD_IMPL(klass, SetSerializationObserver) CR \
+	METHOD_SIGNATURE("", [object SpriteLayer], 0, ([number uint] observerId)); CR \
+    REQUIRE_ARG_COUNT(1); CR \
+    REQUIRE_UINT32_ARG(1, observerId); CR \
+	self->setSerializationObserver(observerId); CR \
+	RETURN_THIS; CR \
+	END CR \
 METHOD_IMPL(klass, StartAnimations) CR \
 	METHOD_SIGNATURE("", undefined, 0, ()); CR \
     REQUIRE_ARG_COUNT(0); CR \
@@ -4170,6 +4334,12 @@ METHOD_IMPL(klass, GetZOrder) CR \
 	int zorder = self->getZOrder(); CR \
 	RETURN_INTEGER(zorder); CR \
 	END CR \
+METHOD_IMPL(klass, GetWorld) CR \
+	METHOD_SIGNATURE("", [object World], 0, ()); CR \
+    REQUIRE_ARG_COUNT(0); CR \
+	World* world = self->getWorld(); CR \
+	RETURN_CPP_OBJECT(world, World); CR \
+	END CR \
 METHOD_IMPL(klass, GetSpriteZOrder) CR \
 	METHOD_SIGNATURE("", [number int], 0, ([object Sprite] sprite)); CR \
     REQUIRE_ARG_COUNT(1); CR \
@@ -4198,6 +4368,43 @@ METHOD_IMPL(klass, HasSprite) CR \
 	bool found = self->hasSprite(sprite); CR \
 	RETURN_BOOL(found); CR \
 	END CR \
+METHOD_IMPL(klass, GetSpriteStates) CR \
+	METHOD_SIGNATURE("", number, 2, ([object Float32Array] outStates, [object Uint32Array] outIids)); CR \
+    REQUIRE_ARG_MIN_COUNT(1); CR \
+    REQUIRE_FLOAT32_ARRAY_ARG(1, outStates); CR \
+    OPTIONAL_UINT32_ARRAY_ARG(2, outIids); CR \
+	uint32 maxSprites = outStatesLength / spriteState_Size; CR \
+	if (outIids && (outIidsLength < maxSprites)) maxSprites = outIidsLength; CR \
+	uint32 count = self->getSpriteStates(outStates, maxSprites, outIids); CR \
+	RETURN_UNSIGNED(count); CR \
+	END CR \
+METHOD_IMPL(klass, GetSpriteStatesById) CR \
+	METHOD_SIGNATURE("", number, 2, ([object Uint32Array] iids, [object Float32Array] outStates)); CR \
+    REQUIRE_ARG_COUNT(2); CR \
+    REQUIRE_UINT32_ARRAY_ARG(1, iids); CR \
+    REQUIRE_FLOAT32_ARRAY_ARG(2, outStates); CR \
+	uint32 numIids = iidsLength; CR \
+	if (numIids > outStatesLength / spriteState_Size) numIids = outStatesLength / spriteState_Size; CR \
+	uint32 count = self->getSpriteStates(iids, numIids, outStates); CR \
+	RETURN_UNSIGNED(count); CR \
+	END CR \
+METHOD_IMPL(klass, SetSpriteStates) CR \
+	METHOD_SIGNATURE("", number, 1, ([object Float32Array] states)); CR \
+    REQUIRE_ARG_COUNT(1); CR \
+    REQUIRE_FLOAT32_ARRAY_ARG(1, states); CR \
+	uint32 count = self->setSpriteStates(states, statesLength / spriteState_Size); CR \
+	RETURN_UNSIGNED(count); CR \
+	END CR \
+METHOD_IMPL(klass, SetSpriteStatesById) CR \
+	METHOD_SIGNATURE("", number, 2, ([object Uint32Array] iids, [object Float32Array] states)); CR \
+    REQUIRE_ARG_COUNT(2); CR \
+    REQUIRE_UINT32_ARRAY_ARG(1, iids); CR \
+    REQUIRE_FLOAT32_ARRAY_ARG(2, states); CR \
+	uint32 numIids = iidsLength; CR \
+	if (numIids > statesLength / spriteState_Size) numIids = statesLength / spriteState_Size; CR \
+	uint32 count = self->setSpriteStates(iids, numIids, states); CR \
+	RETURN_UNSIGNED(count); CR \
+	END CR \
 METHOD_IMPL(klass, AddSprite) CR \
 	METHOD_SIGNATURE("", undefined, 1, ([object Sprite] newSprite)); CR \
     REQUIRE_ARG_COUNT(1); CR \
@@ -4244,12 +4451,32 @@ METHOD_IMPL(klass, DisableCollisionsWithLayer) CR \
 	self->disableCollisionsWithLayer(otherLayer); CR \
 	NO_RETURN; CR \
 	END CR \
+METHOD_IMPL(klass, EnableCollisionGrid) CR \
+	METHOD_SIGNATURE("use a grid to find potential sprite collisions", undefined, 1, (number cellSize = 64)); CR \
+	OPTIONAL_NUMBER_ARG(1, cellSize, 64.0f); CR \
+	self->enableCollisionGrid(cellSize); CR \
+	NO_RETURN; CR \
+	END CR \
+METHOD_IMPL(klass, DisableCollisionGrid) CR \
+	METHOD_SIGNATURE("", undefined, 0, ()); CR \
+    REQUIRE_ARG_COUNT(0); CR \
+	self->disableCollisionGrid(); CR \
+	NO_RETURN; CR \
+	END CR \
 METHOD_IMPL(klass, CreateSprite) CR \
 	METHOD_SIGNATURE("", [object Sprite], 0, ()); CR \
     REQUIRE_ARG_COUNT(0); CR \
 	Sprite* sprite = self->createSprite(); CR \
 	RETURN_CPP_OBJECT(sprite, Sprite); CR \
 	END CR \
+METHOD_IMPL(klass, CloneSprite) CR \
+	METHOD_SIGNATURE("make a new sprite with the same frames and settings as another", CR \
+		[object Sprite], 1, ([object Sprite] originalSprite)); CR \
+    REQUIRE_ARG_COUNT(1); CR \
+    REQUIRE_CPP_OBJECT_ARG(1, originalSprite, Sprite); CR \
+	Sprite* sprite = self->cloneSprite(originalSprite); CR \
+	RETURN_CPP_OBJECT(sprite, Sprite); CR \
+	END CR \
 
 #define SPRITE_LAYER_CHIPMUNK_IMPL(klass) CR \
 METHOD_IMPL(klass, SetKeepGravityDownward) CR \
@@ -4273,6 +4500,47 @@ METHOD_IMPL(klass, SetDamping) CR \
 	self->setDamping(damping); CR \
 	NO_RETURN; CR \
 	END CR \
+METHOD_IMPL(klass, SetPhysicsThreads) CR \
+	METHOD_SIGNATURE("applies to all layers in the world", undefined, 1, (number numThreads)); CR \
+    REQUIRE_ARG_COUNT(1); CR \
+	REQUIRE_UINT32_ARG(1, numThreads); CR \
+	self->setPhysicsThreads(numThreads); CR \
+	NO_RETURN; CR \
+	END CR \
+METHOD_IMPL(klass, GetPhysicsThreads) CR \
+	METHOD_SIGNATURE("", number, 0, ()); CR \
+    REQUIRE_ARG_COUNT(0); CR \
+	RETURN_UNSIGNED(self->getPhysicsThreads()); CR \
+	END CR \
+METHOD_IMPL(klass, GetPhysicsStepTime) CR \
+	METHOD_SIGNATURE("how long the last physics step took, in milliseconds", number, 0, ()); CR \
+    REQUIRE_ARG_COUNT(0); CR \
+	RETURN_NUMBER(self->getPhysicsStepTime()); CR \
+	END CR \
+METHOD_IMPL(klass, SetFixedPhysicsStep) CR \
+	METHOD_SIGNATURE("0 to step once per tick, applies to all layers in the world", undefined, 2, (number stepMs, number maxStepsPerTick = 8)); CR \
+    REQUIRE_ARG_MIN_COUNT(1); CR \
+	REQUIRE_NUMBER_ARG(1, stepMs); CR \
+	OPTIONAL_UINT32_ARG(2, maxStepsPerTick, 8); CR \
+	self->setFixedPhysicsStep(stepMs, maxStepsPerTick); CR \
+	NO_RETURN; CR \
+	END CR \
+METHOD_IMPL(klass, GetFixedPhysicsStep) CR \
+	METHOD_SIGNATURE("", number, 0, ()); CR \
+    REQUIRE_ARG_COUNT(0); CR \
+	RETURN_NUMBER(self->getFixedPhysicsStep()); CR \
+	END CR \
+METHOD_IMPL(klass, SetPhysicsInterpolation) CR \
+	METHOD_SIGNATURE("", undefined, 1, (boolean interpolate = true)); CR \
+    OPTIONAL_BOOL_ARG(1, interpolate, true); CR \
+	self->setPhysicsInterpolation(interpolate); CR \
+	NO_RETURN; CR \
+	END CR \
+METHOD_IMPL(klass, GetPhysicsAlpha) CR \
+	METHOD_SIGNATURE("how far the physics is toward its next fixed step, 0 to 1", number, 0, ()); CR \
+    REQUIRE_ARG_COUNT(0); CR \
+	RETURN_NUMBER(self->getPhysicsAlpha()); CR \
+	END CR \
 METHOD_IMPL(klass, SetStaticLayer) CR \
 	METHOD_SIGNATURE("", undefined, 1, (boolean isStatic = true)); CR \
     OPTIONAL_BOOL_ARG(1, isStatic, true); CR \
@@ -4309,7 +4577,6 @@ WRAPPER_INITIALIZER_IMPL_CUSTOM(SpriteLayer,
 	  %#ifdef PDG_USE_CHIPMUNK_PHYSICS  CR
 		HAS_SPRITE_LAYER_CHIPMUNK_METHODS(SpriteLayer)
 	  %#endif  CR
-	//	HAS_METHOD(SpriteLayer, "cloneSprite", CloneSprite);
 	  %#ifdef PDG_SCML_SUPPORT CR
 		HAS_METHOD(SpriteLayer, "createSpriteFromSCML", CreateSpriteFromSCML) 
 		HAS_METHOD(SpriteLayer, "createSpriteFromSCMLFile", CreateSpriteFromSCMLFile) 
@@ -4329,12 +4596,6 @@ SPRITE_LAYER_BASE_CLASS_IMPL(SpriteLayer)
 SPRITE_LAYER_CHIPMUNK_IMPL(SpriteLayer)
 %#endif
 
-// METHOD_IMPL(SpriteLayer, CloneSprite)
-//    REQUIRE_ARG_COUNT(1);
-//    REQUIRE_CPP_OBJECT_ARG(1, originalSprite, Sprite);
-// 	  Sprite* newSprite = self->cloneSprite(originalSprite);
-//    RETURN_CPP_OBJECT(newSprite, Sprite);
-// 	END
 METHOD_IMPL(SpriteLayer, CreateSpriteFromSCML)
 	METHOD_SIGNATURE("", [object Sprite], 1, (string inSCML, string inEntityName = null));
 	REQUIRE_ARG_MIN_COUNT(1);
@@ -4422,6 +4683,42 @@ FUNCTION_IMPL(CreateTileLayer)
     RETURN_CPP_OBJECT(layer, TileLayer);
     END
 
+FUNCTION_IMPL(CreateWorld)
+	METHOD_SIGNATURE("", [object World], 1, ([number uint] tickIntervalMs = 10)); 
+	OPTIONAL_UINT32_ARG(1, tickIntervalMs, WORLD_DEFAULT_TICK_INTERVAL_MS);
+ 	World* world = createWorld(tickIntervalMs);
+    RETURN_CPP_OBJECT(world, World);
+    END
+
+FUNCTION_IMPL(GetDefaultWorld)
+	METHOD_SIGNATURE("", [object World], 0, ()); 
+	REQUIRE_ARG_COUNT(0);
+ 	World* world = getDefaultWorld();
+    RETURN_CPP_OBJECT(world, World);
+    END
+
+FUNCTION_IMPL(CleanupWorld)
+	METHOD_SIGNATURE("also cleans up every layer in the world", undefined, 1, ([object World] world)); 
+	REQUIRE_ARG_COUNT(1);
+	REQUIRE_CPP_OBJECT_ARG(1, world, World);
+	cleanupWorld(world);
+	NO_RETURN;
+	END
+
+FUNCTION_IMPL(SetWorldThreads)
+	METHOD_SIGNATURE("threads besides the main one that tick threaded worlds, 0 for one per core", undefined, 1, ([number uint] numThreads));
+	REQUIRE_ARG_COUNT(1);
+	REQUIRE_UINT32_ARG(1, numThreads);
+	setWorldThreads(numThreads);
+	NO_RETURN;
+	END
+
+FUNCTION_IMPL(GetWorldThreads)
+	METHOD_SIGNATURE("", [number uint], 0, ());
+	REQUIRE_ARG_COUNT(0);
+	RETURN_UINT32(getWorldThreads());
+	END
+
 
 
 // ========================================================================================
@@ -4459,6 +4756,12 @@ WRAPPER_INITIALIZER_IMPL_CUSTOM(TileLayer,
 		HAS_METHOD(TileLayer, "getTileTypeAndFacingAt", GetTileTypeAndFacingAt)
 		HAS_METHOD(TileLayer, "setTileTypeAt", SetTileTypeAt)
 		HAS_METHOD(TileLayer, "checkCollision", CheckCollision)
+	  %#ifdef PDG_USE_CHIPMUNK_PHYSICS CR
+		HAS_METHOD(TileLayer, "enableStaticCollisions", EnableStaticCollisions)
+		HAS_METHOD(TileLayer, "disableStaticCollisions", DisableStaticCollisions)
+		HAS_METHOD(TileLayer, "updateStaticCollisions", UpdateStaticCollisions)
+		HAS_METHOD(TileLayer, "getStaticShapeCount", GetStaticShapeCount)
+	  %#endif CR
     );
 	END
 	
@@ -4628,6 +4931,36 @@ METHOD_IMPL(TileLayer, CheckCollision)
     uint32 overlapPx = self->checkCollision(movingSprite, alphaThreshold, shortCircuit);
     RETURN_UNSIGNED(overlapPx);
 	END
+%#ifdef PDG_USE_CHIPMUNK_PHYSICS
+METHOD_IMPL(TileLayer, EnableStaticCollisions)
+	METHOD_SIGNATURE("build static physics shapes from the tiles", undefined, 6, ([number uint] alphaThreshold = 128, number tolerance = 1.0, number radius = 1.0, number friction = 1.0, number elasticity = 0.0, [number int] chunkSize = 16));
+    OPTIONAL_UINT32_ARG(1, alphaThreshold, 128);
+    OPTIONAL_NUMBER_ARG(2, tolerance, 1.0f);
+    OPTIONAL_NUMBER_ARG(3, radius, 1.0f);
+    OPTIONAL_NUMBER_ARG(4, friction, 1.0f);
+    OPTIONAL_NUMBER_ARG(5, elasticity, 0.0f);
+    OPTIONAL_INT32_ARG(6, chunkSize, 16);
+	self->enableStaticCollisions(alphaThreshold, tolerance, radius, friction, elasticity, chunkSize);
+	NO_RETURN;
+	END
+METHOD_IMPL(TileLayer, DisableStaticCollisions)
+	METHOD_SIGNATURE("", undefined, 0, ());
+    REQUIRE_ARG_COUNT(0);
+	self->disableStaticCollisions();
+	NO_RETURN;
+	END
+METHOD_IMPL(TileLayer, UpdateStaticCollisions)
+	METHOD_SIGNATURE("rebuild shapes for changed tiles now instead of next animation step", undefined, 0, ());
+    REQUIRE_ARG_COUNT(0);
+	self->updateStaticCollisions();
+	NO_RETURN;
+	END
+METHOD_IMPL(TileLayer, GetStaticShapeCount)
+	METHOD_SIGNATURE("", number, 0, ());
+    REQUIRE_ARG_COUNT(0);
+	RETURN_UNSIGNED(self->getStaticShapeCount());
+	END
+%#endif
 
 CLEANUP_IMPL(TileLayer)
 
@@ -4635,6 +4968,108 @@ CPP_CONSTRUCTOR_IMPL(TileLayer)
 	return 0; //new TileLayer();
 	END
 
+// ========================================================================================
+//MARK: World
+// ========================================================================================
+
+WRAPPER_INITIALIZER_IMPL(World)
+    EXPORT_CLASS_SYMBOLS("World", World, , ,
+    	// method section
+		HAS_METHOD(World, "createSpriteLayer", CreateSpriteLayer)
+		HAS_METHOD(World, "createTileLayer", CreateTileLayer)
+		HAS_METHOD(World, "getLayerCount", GetLayerCount)
+		HAS_METHOD(World, "setTickInterval", SetTickInterval)
+		HAS_METHOD(World, "getTickInterval", GetTickInterval)
+		HAS_METHOD(World, "pause", Pause)
+		HAS_METHOD(World, "unpause", Unpause)
+		HAS_METHOD(World, "isPaused", IsPaused)
+		HAS_METHOD(World, "step", Step)
+		HAS_METHOD(World, "setThreaded", SetThreaded)
+		HAS_METHOD(World, "isThreaded", IsThreaded)
+    );
+	END
+METHOD_IMPL(World, CreateSpriteLayer)
+	METHOD_SIGNATURE("", [object SpriteLayer], 1, ([object Port] port = null)); 
+  %#ifndef PDG_NO_GUI
+	OPTIONAL_CPP_OBJECT_ARG(1, port, Port, 0);
+ 	SpriteLayer* layer = self->createSpriteLayer(port);
+  %#else
+ 	SpriteLayer* layer = self->createSpriteLayer();
+  %#endif
+    RETURN_CPP_OBJECT(layer, SpriteLayer);
+    END
+METHOD_IMPL(World, CreateTileLayer)
+	METHOD_SIGNATURE("", [object TileLayer], 1, ([object Port] port = null)); 
+  %#ifndef PDG_NO_GUI
+	OPTIONAL_CPP_OBJECT_ARG(1, port, Port, 0);
+ 	TileLayer* layer = self->createTileLayer(port);
+  %#else
+ 	TileLayer* layer = self->createTileLayer();
+  %#endif
+    RETURN_CPP_OBJECT(layer, TileLayer);
+    END
+METHOD_IMPL(World, GetLayerCount)
+	METHOD_SIGNATURE("", [number uint], 0, ());
+    REQUIRE_ARG_COUNT(0);
+	RETURN_UINT32(self->getLayerCount());
+	END
+METHOD_IMPL(World, SetTickInterval)
+	METHOD_SIGNATURE("", undefined, 1, ([number uint] msInterval));
+    REQUIRE_ARG_COUNT(1);
+    REQUIRE_UINT32_ARG(1, msInterval);
+	self->setTickInterval(msInterval);
+	NO_RETURN;
+	END
+METHOD_IMPL(World, GetTickInterval)
+	METHOD_SIGNATURE("", [number uint], 0, ());
+    REQUIRE_ARG_COUNT(0);
+	RETURN_UINT32(self->getTickInterval());
+	END
+METHOD_IMPL(World, Pause)
+	METHOD_SIGNATURE("stop animating the world until unpause() is called", undefined, 0, ());
+    REQUIRE_ARG_COUNT(0);
+	self->pause();
+	NO_RETURN;
+	END
+METHOD_IMPL(World, Unpause)
+	METHOD_SIGNATURE("", undefined, 0, ());
+    REQUIRE_ARG_COUNT(0);
+	self->unpause();
+	NO_RETURN;
+	END
+METHOD_IMPL(World, IsPaused)
+	METHOD_SIGNATURE("", boolean, 0, ());
+    REQUIRE_ARG_COUNT(0);
+	bool paused = self->isPaused();
+	RETURN_BOOL(paused);
+	END
+METHOD_IMPL(World, Step)
+	METHOD_SIGNATURE("animate the world by msElapsed right now", undefined, 1, ([number uint] msElapsed));
+    REQUIRE_ARG_COUNT(1);
+    REQUIRE_UINT32_ARG(1, msElapsed);
+	self->step(msElapsed);
+	NO_RETURN;
+	END
+METHOD_IMPL(World, SetThreaded)
+	METHOD_SIGNATURE("tick on the world threads, only C++ animation and collision helpers can be used", undefined, 1, (boolean threaded = true));
+    OPTIONAL_BOOL_ARG(1, threaded, true);
+	self->setThreaded(threaded);
+	NO_RETURN;
+	END
+METHOD_IMPL(World, IsThreaded)
+	METHOD_SIGNATURE("", boolean, 0, ());
+    REQUIRE_ARG_COUNT(0);
+	bool threaded = self->isThreaded();
+	RETURN_BOOL(threaded);
+	END
+
+CLEANUP_IMPL(World)
+
+CPP_CONSTRUCTOR_IMPL(World)
+    SAVE_ERR("World cannot be created directly, use pdg.createWorld()");
+    return 0;
+    END
+
 // ========================================================================================
 //MARK: Script Serializable
 // ========================================================================================
@@ -4706,6 +5141,20 @@ FUNCTION_IMPL(SetSerializationDebugMode)
  	ISerializer::s_DebugMode = debugMode;
  	NO_RETURN;
  	END
+FUNCTION_IMPL(GetUserDataStats)
+	METHOD_SIGNATURE("", object, 0, ()); 
+	REQUIRE_ARG_COUNT(0);
+	MemStats stats;
+	uint32 pooledInUse;
+	UserData::getAllocationStats(stats, &pooledInUse);
+	OBJECT_REF jsStats = OBJECT_CREATE_EMPTY(0);
+	OBJECT_SET_PROPERTY_VALUE(jsStats, SYMBOL(objectsAllocated), UINT2VAL(stats.cxxObjsAllocated));
+	OBJECT_SET_PROPERTY_VALUE(jsStats, SYMBOL(objectsFreed), UINT2VAL(stats.cxxObjsFreed));
+	OBJECT_SET_PROPERTY_VALUE(jsStats, SYMBOL(blocksAllocated), UINT2VAL(stats.blocksAllocated));
+	OBJECT_SET_PROPERTY_VALUE(jsStats, SYMBOL(blocksFreed), UINT2VAL(stats.blocksFreed));
+	OBJECT_SET_PROPERTY_VALUE(jsStats, SYMBOL(pooledInUse), UINT2VAL(pooledInUse));
+	RETURN_OBJECT(jsStats);
+	END
 
 
 
@@ -74,6 +74,7 @@ BINDING_CLASS(MemBlock)
   METHOD(MemBlock, GetDataSize)
   METHOD(MemBlock, GetByte)
   METHOD(MemBlock, GetBytes)
+  METHOD(MemBlock, ToBuffer)
 DECL_END
 
 SINGLETON_CLASS(ConfigManager)
@@ -192,6 +193,12 @@ BINDING_CLASS(Serializer)
   METHOD(Serializer, Sizeof_ref)
   METHOD(Serializer, GetDataSize)
   METHOD(Serializer, GetDataPtr)
+  METHOD(Serializer, CopyDataTo)
+  METHOD(Serializer, ReleaseBuffer)
+  METHOD(Serializer, GetCapacity)
+  METHOD(Serializer, Reserve)
+  METHOD(Serializer, Reset)
+  METHOD(Serializer, SetStreaming)
 DECL_END
 
 BINDING_CLASS(Deserializer)
@@ -567,6 +574,14 @@ DECL_END
 
 #define SPRITE_LAYER_METHODS(klass) \
 	METHOD(klass, SetSerializationFlags) CR \
+	METHOD(klass, TakeSnapshot) CR \
+	METHOD(klass, SetSerializationBaseline) CR \
+	METHOD(klass, GetLastSnapshotId) CR \
+	METHOD(klass, AddObserver) CR \
+	METHOD(klass, RemoveObserver) CR \
+	METHOD(klass, SetObserverArea) CR \
+	METHOD(klass, SetObserverRadius) CR \
+	METHOD(klass, SetSerializationObserver) CR \
 	METHOD(klass, StartAnimations) CR \
 	METHOD(klass, StopAnimations) CR \
 	METHOD(klass, Hide) CR \
@@ -579,12 +594,17 @@ DECL_END
 	METHOD(klass, MoveToFront) CR \
 	METHOD(klass, MoveToBack) CR \
 	METHOD(klass, GetZOrder) CR \
+	METHOD(klass, GetWorld) CR \
 	METHOD(klass, MoveWith) CR \
 	METHOD(klass, FindSprite) CR \
 	METHOD(klass, GetNthSprite) CR \
 	METHOD(klass, GetSpriteZOrder) CR \
 	METHOD(klass, IsSpriteBehind) CR \
 	METHOD(klass, HasSprite) CR \
+	METHOD(klass, GetSpriteStates) CR \
+	METHOD(klass, GetSpriteStatesById) CR \
+	METHOD(klass, SetSpriteStates) CR \
+	METHOD(klass, SetSpriteStatesById) CR \
 	METHOD(klass, AddSprite) CR \
 	METHOD(klass, RemoveSprite) CR \
 	METHOD(klass, RemoveAllSprites) CR \
@@ -592,8 +612,10 @@ DECL_END
 	METHOD(klass, DisableCollisions) CR \
 	METHOD(klass, EnableCollisionsWithLayer) CR \
 	METHOD(klass, DisableCollisionsWithLayer) CR \
-	METHOD(klass, CreateSprite)
-//	METHOD(klass, CloneSprite)
+	METHOD(klass, EnableCollisionGrid) CR \
+	METHOD(klass, DisableCollisionGrid) CR \
+	METHOD(klass, CreateSprite) CR \
+	METHOD(klass, CloneSprite)
 
 %#ifndef PDG_NO_GUI
 #define SPRITE_LAYER_GUI_METHODS(klass) \
@@ -622,6 +644,13 @@ DECL_END
 	METHOD(klass, SetGravity) CR \
 	METHOD(klass, SetKeepGravityDownward) CR \
 	METHOD(klass, SetDamping) CR \
+	METHOD(klass, SetPhysicsThreads) CR \
+	METHOD(klass, GetPhysicsThreads) CR \
+	METHOD(klass, GetPhysicsStepTime) CR \
+	METHOD(klass, SetFixedPhysicsStep) CR \
+	METHOD(klass, GetFixedPhysicsStep) CR \
+	METHOD(klass, SetPhysicsInterpolation) CR \
+	METHOD(klass, GetPhysicsAlpha) CR \
 	METHOD(klass, GetSpace)
 
 BINDING_CLASS(SpriteLayer)
@@ -664,6 +693,26 @@ BINDING_CLASS(TileLayer)
 	METHOD(TileLayer, GetTileTypeAndFacingAt)
 	METHOD(TileLayer, SetTileTypeAt)
 	METHOD(TileLayer, CheckCollision)
+%#ifdef PDG_USE_CHIPMUNK_PHYSICS
+	METHOD(TileLayer, EnableStaticCollisions)
+	METHOD(TileLayer, DisableStaticCollisions)
+	METHOD(TileLayer, UpdateStaticCollisions)
+	METHOD(TileLayer, GetStaticShapeCount)
+%#endif
+DECL_END
+
+BINDING_CLASS(World)
+	METHOD(World, CreateSpriteLayer)
+	METHOD(World, CreateTileLayer)
+	METHOD(World, GetLayerCount)
+	METHOD(World, SetTickInterval)
+	METHOD(World, GetTickInterval)
+	METHOD(World, Pause)
+	METHOD(World, Unpause)
+	METHOD(World, IsPaused)
+	METHOD(World, Step)
+	METHOD(World, SetThreaded)
+	METHOD(World, IsThreaded)
 DECL_END
 
 
@@ -672,6 +721,7 @@ FUNCTION_DECL(GetLogManager)
 FUNCTION_DECL(GetEventManager)
 FUNCTION_DECL(GetResourceManager)
 FUNCTION_DECL(SetSerializationDebugMode)
+FUNCTION_DECL(GetUserDataStats)
 FUNCTION_DECL(RegisterSerializableClass)
 FUNCTION_DECL(RegisterSerializableObject)
 FUNCTION_DECL(GetGraphicsManager)
@@ -684,6 +734,11 @@ FUNCTION_DECL(CreateSpriteLayerFromSCMLFile)
 %#endif
 FUNCTION_DECL(CleanupSpriteLayer)
 FUNCTION_DECL(CreateTileLayer)
+FUNCTION_DECL(CreateWorld)
+FUNCTION_DECL(GetDefaultWorld)
+FUNCTION_DECL(CleanupWorld)
+FUNCTION_DECL(SetWorldThreads)
+FUNCTION_DECL(GetWorldThreads)
 FUNCTION_DECL(Rand)
 FUNCTION_DECL(GameCriticalRandom)
 FUNCTION_DECL(Srand)
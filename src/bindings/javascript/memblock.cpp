@@ -42,15 +42,9 @@
 namespace pdg {
 
 
-std::string&    
+std::string
 MemBlock::getData() { 
-    static std::string _workstr;
-    _workstr.resize(bytes);
-    char* p = const_cast<char*>(_workstr.data());
-    for (size_t i = 0; i < bytes; i++) {
-        p[i] = ptr[i];
-    }
-    return _workstr;
+    return std::string(ptr, bytes);
 }
 
 size_t  
@@ -90,16 +84,12 @@ MemBlock::~MemBlock() {
   #endif
 }
 
-// Not thread safe -- runs in a single threaded JavaScript environment
-std::string& 
+std::string
 MemBlock::getBytes(size_t start, size_t len) {
-    static std::string _workstr;
-    _workstr.resize((start > bytes) ? 0 : (start + len > bytes) ? bytes - start : len);
-    char* p = const_cast<char*>(_workstr.data());
-    for (size_t i = 0; i < len; i++) {
-        p[i] = ptr[start+i];
-    } 
-    return _workstr;
+    if (start > bytes) {
+        return std::string();
+    }
+    return std::string(ptr + start, (start + len > bytes) ? bytes - start : len);
 }
 
 
@@ -50,10 +50,10 @@ struct MemBlock {
 	bool	owned;
     MemBlock(char* p, size_t n, bool own);
     MemBlock(size_t n);
-    std::string& getData();
+    std::string getData();
     size_t  getDataSize();
     unsigned char getByte(size_t i);
-    std::string& getBytes(size_t start, size_t len);
+    std::string getBytes(size_t start, size_t len);
     ~MemBlock();
   #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 	SCRIPT_OBJECT_REF mMemBlockScriptObj;
@@ -933,6 +933,128 @@ namespace pdg
         return resVal->Uint32Value();
     }
 
+    enum {
+        eventKey_emitter, eventKey_eventType, eventKey_startupReason, eventKey_exitReason, eventKey_exitCode, eventKey_id,
+        eventKey_millisec, eventKey_msElapsed, eventKey_keyCode, eventKey_shift, eventKey_ctrl, eventKey_alt,
+        eventKey_meta, eventKey_unicode, eventKey_isRepeating, eventKey_touchType, eventKey_touchedSprite, eventKey_inLayer,
+        eventKey_mousePos, eventKey_leftButton, eventKey_rightButton, eventKey_buttonNumber, eventKey_lastClickPos, eventKey_lastClickElapsed,
+        eventKey_horizDelta, eventKey_vertDelta, eventKey_eventCode, eventKey_sound, eventKey_port, eventKey_screenPos,
+        eventKey_oldScreenPos, eventKey_oldWidth, eventKey_oldHeight, eventKey_frameNum, eventKey_targetSprite, eventKey_normal,
+        eventKey_impulse, eventKey_force, eventKey_kineticEnergy, eventKey_arbiter, eventKey_breakForce, eventKey_joint,
+        eventKey_action, eventKey_actingSprite, eventKey_observerId, eventKey_actingLayer,
+        eventKey_Count
+    };
+
+    static const char* s_EventKeyNames[eventKey_Count] = {
+        "emitter", "eventType", "startupReason", "exitReason", "exitCode", "id",
+        "millisec", "msElapsed", "keyCode", "shift", "ctrl", "alt",
+        "meta", "unicode", "isRepeating", "touchType", "touchedSprite", "inLayer",
+        "mousePos", "leftButton", "rightButton", "buttonNumber", "lastClickPos", "lastClickElapsed",
+        "horizDelta", "vertDelta", "eventCode", "sound", "port", "screenPos",
+        "oldScreenPos", "oldWidth", "oldHeight", "frameNum", "targetSprite", "normal",
+        "impulse", "force", "kineticEnergy", "arbiter", "breakForce", "joint",
+        "action", "actingSprite", "observerId", "actingLayer"
+    };
+
+    enum {
+        eventObj_Startup, eventObj_Shutdown, eventObj_Timer, eventObj_Key, eventObj_KeyPress,
+        eventObj_SpriteTouch, eventObj_Mouse, eventObj_ScrollWheel, eventObj_Sound, eventObj_PortResized,
+        eventObj_PortDraw, eventObj_SpriteCollide, eventObj_SpriteBreak, eventObj_SpriteAnimate, eventObj_SpriteLayer,
+        eventObj_Count
+    };
+
+    static const int s_EventObjectKeys[eventObj_Count][14] = {
+        { eventKey_startupReason, -1 },
+        { eventKey_exitReason, eventKey_exitCode, -1 },
+        { eventKey_id, eventKey_millisec, eventKey_msElapsed, -1 },
+        { eventKey_keyCode, -1 },
+        { eventKey_shift, eventKey_ctrl, eventKey_alt, eventKey_meta, eventKey_unicode, eventKey_isRepeating, -1 },
+        { eventKey_touchType, eventKey_touchedSprite, eventKey_inLayer, eventKey_shift, eventKey_ctrl, eventKey_alt, eventKey_meta, eventKey_mousePos, eventKey_leftButton, eventKey_rightButton, eventKey_buttonNumber, eventKey_lastClickPos, eventKey_lastClickElapsed, -1 },
+        { eventKey_shift, eventKey_ctrl, eventKey_alt, eventKey_meta, eventKey_mousePos, eventKey_leftButton, eventKey_rightButton, eventKey_buttonNumber, eventKey_lastClickPos, eventKey_lastClickElapsed, -1 },
+        { eventKey_shift, eventKey_ctrl, eventKey_alt, eventKey_meta, eventKey_horizDelta, eventKey_vertDelta, -1 },
+        { eventKey_eventCode, eventKey_sound, -1 },
+        { eventKey_port, eventKey_screenPos, eventKey_oldScreenPos, eventKey_oldWidth, eventKey_oldHeight, -1 },
+        { eventKey_port, eventKey_frameNum, -1 },
+        { eventKey_targetSprite, eventKey_normal, eventKey_impulse, eventKey_force, eventKey_kineticEnergy, eventKey_arbiter, eventKey_action, eventKey_actingSprite, eventKey_inLayer, eventKey_observerId, -1 },
+        { eventKey_targetSprite, eventKey_impulse, eventKey_force, eventKey_breakForce, eventKey_joint, eventKey_action, eventKey_actingSprite, eventKey_inLayer, eventKey_observerId, -1 },
+        { eventKey_action, eventKey_actingSprite, eventKey_inLayer, eventKey_observerId, -1 },
+        { eventKey_action, eventKey_actingLayer, eventKey_millisec, -1 }
+    };
+
+    static v8::Eternal<v8::String> s_EventKeys[eventKey_Count];
+    static v8::Eternal<v8::ObjectTemplate> s_EventObjectTemplates[eventObj_Count];
+    static bool s_EventObjectTemplatesReady = false;
+
+#define EVENT_KEY(_name) s_EventKeys[eventKey_##_name].Get(isolate)
+
+    static void initEventObjectTemplates(v8::Isolate* isolate)
+    {
+        for (int i = 0; i < eventKey_Count; i++)
+        {
+            s_EventKeys[i].Set(isolate, v8::String::NewFromUtf8(isolate, s_EventKeyNames[i], v8::String::kInternalizedString));
+        }
+        for (int i = 0; i < eventObj_Count; i++)
+        {
+            v8::Local<v8::ObjectTemplate> objTemplate = v8::ObjectTemplate::New(isolate);
+            objTemplate->Set(EVENT_KEY(emitter), v8::Undefined(isolate));
+            objTemplate->Set(EVENT_KEY(eventType), v8::Undefined(isolate));
+            for (const int* key = s_EventObjectKeys[i]; *key >= 0; key++)
+            {
+                objTemplate->Set(s_EventKeys[*key].Get(isolate), v8::Undefined(isolate));
+            }
+            s_EventObjectTemplates[i].Set(isolate, objTemplate);
+        }
+        s_EventObjectTemplatesReady = true;
+    }
+
+    static int getEventObjectTemplate(long inEventType)
+    {
+        switch (inEventType)
+        {
+            case pdg::eventType_Startup:
+                return eventObj_Startup;
+            case pdg::eventType_Shutdown:
+                return eventObj_Shutdown;
+            case pdg::eventType_Timer:
+                return eventObj_Timer;
+#ifndef PDG_NO_GUI
+            case pdg::eventType_KeyDown:
+            case pdg::eventType_KeyUp:
+                return eventObj_Key;
+            case pdg::eventType_KeyPress:
+                return eventObj_KeyPress;
+            case pdg::eventType_SpriteTouch:
+                return eventObj_SpriteTouch;
+            case pdg::eventType_MouseDown:
+            case pdg::eventType_MouseUp:
+            case pdg::eventType_MouseMove:
+                return eventObj_Mouse;
+            case pdg::eventType_ScrollWheel:
+                return eventObj_ScrollWheel;
+#endif
+#ifndef PDG_NO_SOUND
+            case pdg::eventType_SoundEvent:
+                return eventObj_Sound;
+#endif
+#ifndef PDG_NO_GUI
+            case pdg::eventType_PortResized:
+                return eventObj_PortResized;
+            case pdg::eventType_PortDraw:
+                return eventObj_PortDraw;
+#endif
+            case pdg::eventType_SpriteCollide:
+                return eventObj_SpriteCollide;
+            case pdg::eventType_SpriteBreak:
+                return eventObj_SpriteBreak;
+            case pdg::eventType_SpriteAnimate:
+                return eventObj_SpriteAnimate;
+            case pdg::eventType_SpriteLayer:
+                return eventObj_SpriteLayer;
+            default:
+                return -1;
+        }
+    }
+
     ScriptEventHandler::ScriptEventHandler(v8::Local<v8::Function> func)
     {
         v8::Isolate* isolate = v8::Isolate::GetCurrent();
@@ -942,74 +1064,87 @@ namespace pdg
     bool ScriptEventHandler::handleEvent(EventEmitter* emitter, long inEventType, void* inEventData) throw()
     {
         v8::Isolate* isolate = v8::Isolate::GetCurrent();
-        v8::Local<v8::Object> jsEvent = v8::Object::New(isolate);
+        if ((inEventType == pdg::eventType_Timer) && (static_cast<TimerInfo*>(inEventData)->id <= 0))
+        {
+
+            return false;
+        }
+        if (!s_EventObjectTemplatesReady)
+        {
+            initEventObjectTemplates(isolate);
+        }
+        int eventObj = getEventObjectTemplate(inEventType);
+        v8::Local<v8::Object> jsEvent;
+        if (eventObj >= 0)
+        {
+            jsEvent = s_EventObjectTemplates[eventObj].Get(isolate)->NewInstance();
+        }
+        else
+        {
+            jsEvent = v8::Object::New(isolate);
+        }
         v8::Local<v8::Object> emitter_ = v8::Local<v8::Object>::New(isolate, emitter->mEventEmitterScriptObj);
         v8::Local<v8::Object> obj1_;
         v8::Local<v8::Object> obj2_;
-        jsEvent->Set(v8::String::NewFromUtf8(isolate, "emitter"), emitter_);
-        jsEvent->Set(v8::String::NewFromUtf8(isolate, "eventType"),v8::Integer::New(isolate, inEventType));
+        jsEvent->Set(EVENT_KEY(emitter), emitter_);
+        jsEvent->Set(EVENT_KEY(eventType),v8::Integer::New(isolate, inEventType));
         switch (inEventType)
         {
             case pdg::eventType_Startup:
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "startupReason"),v8::Integer::New(isolate, static_cast<StartupInfo*>(inEventData)->startupReason));
+                jsEvent->Set(EVENT_KEY(startupReason),v8::Integer::New(isolate, static_cast<StartupInfo*>(inEventData)->startupReason));
 
                 break;
             case pdg::eventType_Shutdown:
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "exitReason"),v8::Integer::New(isolate, static_cast<ShutdownInfo*>(inEventData)->exitReason));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "exitCode"),v8::Integer::New(isolate, static_cast<ShutdownInfo*>(inEventData)->exitCode));
+                jsEvent->Set(EVENT_KEY(exitReason),v8::Integer::New(isolate, static_cast<ShutdownInfo*>(inEventData)->exitReason));
+                jsEvent->Set(EVENT_KEY(exitCode),v8::Integer::New(isolate, static_cast<ShutdownInfo*>(inEventData)->exitCode));
                 break;
             case pdg::eventType_Timer:
-                if (static_cast<TimerInfo*>(inEventData)->id <= 0)
-                {
-
-                    return false;
-                }
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "id"),v8::Integer::New(isolate, static_cast<TimerInfo*>(inEventData)->id));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "millisec"),v8::Integer::NewFromUnsigned(isolate, static_cast<TimerInfo*>(inEventData)->millisec));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "msElapsed"),v8::Integer::NewFromUnsigned(isolate, static_cast<TimerInfo*>(inEventData)->msElapsed));
+                jsEvent->Set(EVENT_KEY(id),v8::Integer::New(isolate, static_cast<TimerInfo*>(inEventData)->id));
+                jsEvent->Set(EVENT_KEY(millisec),v8::Integer::NewFromUnsigned(isolate, static_cast<TimerInfo*>(inEventData)->millisec));
+                jsEvent->Set(EVENT_KEY(msElapsed),v8::Integer::NewFromUnsigned(isolate, static_cast<TimerInfo*>(inEventData)->msElapsed));
 
                 break;
 #ifndef PDG_NO_GUI
             case pdg::eventType_KeyDown:
             case pdg::eventType_KeyUp:
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "keyCode"),v8::Integer::New(isolate, static_cast<KeyInfo*>(inEventData)->keyCode));
+                jsEvent->Set(EVENT_KEY(keyCode),v8::Integer::New(isolate, static_cast<KeyInfo*>(inEventData)->keyCode));
                 break;
             case pdg::eventType_KeyPress:
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "shift"),v8::Boolean::New(isolate, static_cast<KeyPressInfo*>(inEventData)->shift));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "ctrl"),v8::Boolean::New(isolate, static_cast<KeyPressInfo*>(inEventData)->ctrl));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "alt"),v8::Boolean::New(isolate, static_cast<KeyPressInfo*>(inEventData)->alt));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "meta"),v8::Boolean::New(isolate, static_cast<KeyPressInfo*>(inEventData)->meta));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "unicode"),v8::Integer::New(isolate, static_cast<KeyPressInfo*>(inEventData)->unicode));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "isRepeating"),v8::Boolean::New(isolate, static_cast<KeyPressInfo*>(inEventData)->isRepeating));
+                jsEvent->Set(EVENT_KEY(shift),v8::Boolean::New(isolate, static_cast<KeyPressInfo*>(inEventData)->shift));
+                jsEvent->Set(EVENT_KEY(ctrl),v8::Boolean::New(isolate, static_cast<KeyPressInfo*>(inEventData)->ctrl));
+                jsEvent->Set(EVENT_KEY(alt),v8::Boolean::New(isolate, static_cast<KeyPressInfo*>(inEventData)->alt));
+                jsEvent->Set(EVENT_KEY(meta),v8::Boolean::New(isolate, static_cast<KeyPressInfo*>(inEventData)->meta));
+                jsEvent->Set(EVENT_KEY(unicode),v8::Integer::New(isolate, static_cast<KeyPressInfo*>(inEventData)->unicode));
+                jsEvent->Set(EVENT_KEY(isRepeating),v8::Boolean::New(isolate, static_cast<KeyPressInfo*>(inEventData)->isRepeating));
                 break;
             case pdg::eventType_SpriteTouch:
                 obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<SpriteTouchInfo*>(inEventData)->touchedSprite->mSpriteScriptObj);
                 obj2_ = v8::Local<v8::Object>::New(isolate, static_cast<SpriteTouchInfo*>(inEventData)->inLayer->mSpriteLayerScriptObj);
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "touchType"),v8::Integer::New(isolate, static_cast<SpriteTouchInfo*>(inEventData)->touchType));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "touchedSprite"), obj1_);
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "inLayer"), obj2_);
+                jsEvent->Set(EVENT_KEY(touchType),v8::Integer::New(isolate, static_cast<SpriteTouchInfo*>(inEventData)->touchType));
+                jsEvent->Set(EVENT_KEY(touchedSprite), obj1_);
+                jsEvent->Set(EVENT_KEY(inLayer), obj2_);
 
             case pdg::eventType_MouseDown:
             case pdg::eventType_MouseUp:
             case pdg::eventType_MouseMove:
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "shift"),v8::Boolean::New(isolate, static_cast<MouseInfo*>(inEventData)->shift));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "ctrl"),v8::Boolean::New(isolate, static_cast<MouseInfo*>(inEventData)->ctrl));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "alt"),v8::Boolean::New(isolate, static_cast<MouseInfo*>(inEventData)->alt));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "meta"),v8::Boolean::New(isolate, static_cast<MouseInfo*>(inEventData)->meta));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "mousePos"),v8_MakeJavascriptPoint(isolate, static_cast<MouseInfo*>(inEventData)->mousePos));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "leftButton"),v8::Boolean::New(isolate, static_cast<MouseInfo*>(inEventData)->leftButton));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "rightButton"),v8::Boolean::New(isolate, static_cast<MouseInfo*>(inEventData)->rightButton));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "buttonNumber"),v8::Integer::NewFromUnsigned(isolate, static_cast<MouseInfo*>(inEventData)->buttonNumber));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "lastClickPos"),v8_MakeJavascriptPoint(isolate, static_cast<MouseInfo*>(inEventData)->lastClickPos));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "lastClickElapsed"),v8::Integer::NewFromUnsigned(isolate, static_cast<MouseInfo*>(inEventData)->lastClickElapsed));
+                jsEvent->Set(EVENT_KEY(shift),v8::Boolean::New(isolate, static_cast<MouseInfo*>(inEventData)->shift));
+                jsEvent->Set(EVENT_KEY(ctrl),v8::Boolean::New(isolate, static_cast<MouseInfo*>(inEventData)->ctrl));
+                jsEvent->Set(EVENT_KEY(alt),v8::Boolean::New(isolate, static_cast<MouseInfo*>(inEventData)->alt));
+                jsEvent->Set(EVENT_KEY(meta),v8::Boolean::New(isolate, static_cast<MouseInfo*>(inEventData)->meta));
+                jsEvent->Set(EVENT_KEY(mousePos),v8_MakeJavascriptPoint(isolate, static_cast<MouseInfo*>(inEventData)->mousePos));
+                jsEvent->Set(EVENT_KEY(leftButton),v8::Boolean::New(isolate, static_cast<MouseInfo*>(inEventData)->leftButton));
+                jsEvent->Set(EVENT_KEY(rightButton),v8::Boolean::New(isolate, static_cast<MouseInfo*>(inEventData)->rightButton));
+                jsEvent->Set(EVENT_KEY(buttonNumber),v8::Integer::NewFromUnsigned(isolate, static_cast<MouseInfo*>(inEventData)->buttonNumber));
+                jsEvent->Set(EVENT_KEY(lastClickPos),v8_MakeJavascriptPoint(isolate, static_cast<MouseInfo*>(inEventData)->lastClickPos));
+                jsEvent->Set(EVENT_KEY(lastClickElapsed),v8::Integer::NewFromUnsigned(isolate, static_cast<MouseInfo*>(inEventData)->lastClickElapsed));
                 break;
             case pdg::eventType_ScrollWheel:
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "shift"),v8::Boolean::New(isolate, static_cast<ScrollWheelInfo*>(inEventData)->shift));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "ctrl"),v8::Boolean::New(isolate, static_cast<ScrollWheelInfo*>(inEventData)->ctrl));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "alt"),v8::Boolean::New(isolate, static_cast<ScrollWheelInfo*>(inEventData)->alt));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "meta"),v8::Boolean::New(isolate, static_cast<ScrollWheelInfo*>(inEventData)->meta));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "horizDelta"),v8::Integer::New(isolate, static_cast<ScrollWheelInfo*>(inEventData)->horizDelta));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "vertDelta"),v8::Integer::New(isolate, static_cast<ScrollWheelInfo*>(inEventData)->vertDelta));
+                jsEvent->Set(EVENT_KEY(shift),v8::Boolean::New(isolate, static_cast<ScrollWheelInfo*>(inEventData)->shift));
+                jsEvent->Set(EVENT_KEY(ctrl),v8::Boolean::New(isolate, static_cast<ScrollWheelInfo*>(inEventData)->ctrl));
+                jsEvent->Set(EVENT_KEY(alt),v8::Boolean::New(isolate, static_cast<ScrollWheelInfo*>(inEventData)->alt));
+                jsEvent->Set(EVENT_KEY(meta),v8::Boolean::New(isolate, static_cast<ScrollWheelInfo*>(inEventData)->meta));
+                jsEvent->Set(EVENT_KEY(horizDelta),v8::Integer::New(isolate, static_cast<ScrollWheelInfo*>(inEventData)->horizDelta));
+                jsEvent->Set(EVENT_KEY(vertDelta),v8::Integer::New(isolate, static_cast<ScrollWheelInfo*>(inEventData)->vertDelta));
                 break;
 #endif
 #ifndef PDG_NO_NETWORK
@@ -1030,23 +1165,23 @@ namespace pdg
 #ifndef PDG_NO_SOUND
             case pdg::eventType_SoundEvent:
                 obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<SoundEventInfo*>(inEventData)->sound->mSoundScriptObj);
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "eventCode"),v8::Integer::New(isolate, static_cast<SoundEventInfo*>(inEventData)->eventCode));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "sound"), obj1_);
+                jsEvent->Set(EVENT_KEY(eventCode),v8::Integer::New(isolate, static_cast<SoundEventInfo*>(inEventData)->eventCode));
+                jsEvent->Set(EVENT_KEY(sound), obj1_);
                 break;
 #endif
 #ifndef PDG_NO_GUI
             case pdg::eventType_PortResized:
                 obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<PortResizeInfo*>(inEventData)->port->mPortScriptObj);
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "port"), obj1_);
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "screenPos"), v8::Integer::New(isolate, static_cast<PortResizeInfo*>(inEventData)->screenPos));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "oldScreenPos"), v8::Integer::New(isolate, static_cast<PortResizeInfo*>(inEventData)->oldScreenPos));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "oldWidth"), v8::Integer::New(isolate, static_cast<PortResizeInfo*>(inEventData)->oldWidth));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "oldHeight"), v8::Integer::New(isolate, static_cast<PortResizeInfo*>(inEventData)->oldHeight));
+                jsEvent->Set(EVENT_KEY(port), obj1_);
+                jsEvent->Set(EVENT_KEY(screenPos), v8::Integer::New(isolate, static_cast<PortResizeInfo*>(inEventData)->screenPos));
+                jsEvent->Set(EVENT_KEY(oldScreenPos), v8::Integer::New(isolate, static_cast<PortResizeInfo*>(inEventData)->oldScreenPos));
+                jsEvent->Set(EVENT_KEY(oldWidth), v8::Integer::New(isolate, static_cast<PortResizeInfo*>(inEventData)->oldWidth));
+                jsEvent->Set(EVENT_KEY(oldHeight), v8::Integer::New(isolate, static_cast<PortResizeInfo*>(inEventData)->oldHeight));
                 break;
             case pdg::eventType_PortDraw:
                 obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<PortDrawInfo*>(inEventData)->port->mPortScriptObj);
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "port"), obj1_);
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "frameNum"), v8::Integer::New(isolate, static_cast<PortDrawInfo*>(inEventData)->frameNum));
+                jsEvent->Set(EVENT_KEY(port), obj1_);
+                jsEvent->Set(EVENT_KEY(frameNum), v8::Integer::New(isolate, static_cast<PortDrawInfo*>(inEventData)->frameNum));
                 break;
 #endif
             case pdg::eventType_SpriteCollide:
@@ -1056,16 +1191,16 @@ namespace pdg
                     if (static_cast<SpriteCollideInfo*>(inEventData)->targetSprite)
                     {
                         obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<SpriteCollideInfo*>(inEventData)->targetSprite->mSpriteScriptObj);
-                        jsEvent->Set(v8::String::NewFromUtf8(isolate, "targetSprite"), obj1_);
+                        jsEvent->Set(EVENT_KEY(targetSprite), obj1_);
                     }
-                    jsEvent->Set(v8::String::NewFromUtf8(isolate, "normal"), v8_MakeJavascriptVector(isolate, static_cast<SpriteCollideInfo*>(inEventData)->normal));
-                    jsEvent->Set(v8::String::NewFromUtf8(isolate, "impulse"), v8_MakeJavascriptVector(isolate, static_cast<SpriteCollideInfo*>(inEventData)->impulse));
-                    jsEvent->Set(v8::String::NewFromUtf8(isolate, "force"),v8::Number::New(isolate, static_cast<SpriteCollideInfo*>(inEventData)->force));
-                    jsEvent->Set(v8::String::NewFromUtf8(isolate, "kineticEnergy"),v8::Number::New(isolate, static_cast<SpriteCollideInfo*>(inEventData)->kineticEnergy));
+                    jsEvent->Set(EVENT_KEY(normal), v8_MakeJavascriptVector(isolate, static_cast<SpriteCollideInfo*>(inEventData)->normal));
+                    jsEvent->Set(EVENT_KEY(impulse), v8_MakeJavascriptVector(isolate, static_cast<SpriteCollideInfo*>(inEventData)->impulse));
+                    jsEvent->Set(EVENT_KEY(force),v8::Number::New(isolate, static_cast<SpriteCollideInfo*>(inEventData)->force));
+                    jsEvent->Set(EVENT_KEY(kineticEnergy),v8::Number::New(isolate, static_cast<SpriteCollideInfo*>(inEventData)->kineticEnergy));
 #ifdef PDG_USE_CHIPMUNK_PHYSICS
                     if (static_cast<SpriteCollideInfo*>(inEventData)->arbiter)
                     {
-                        jsEvent->Set(v8::String::NewFromUtf8(isolate, "arbiter"), cpArbiterWrap::NewFromCpp(isolate, static_cast<SpriteCollideInfo*>(inEventData)->arbiter));
+                        jsEvent->Set(EVENT_KEY(arbiter), cpArbiterWrap::NewFromCpp(isolate, static_cast<SpriteCollideInfo*>(inEventData)->arbiter));
                     }
 #endif
                 }
@@ -1073,26 +1208,31 @@ namespace pdg
                 {
 #ifdef PDG_USE_CHIPMUNK_PHYSICS
                     obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<SpriteJointBreakInfo*>(inEventData)->targetSprite->mSpriteScriptObj);
-                    jsEvent->Set(v8::String::NewFromUtf8(isolate, "targetSprite"), obj1_);
-                    jsEvent->Set(v8::String::NewFromUtf8(isolate, "impulse"),v8::Number::New(isolate, static_cast<SpriteJointBreakInfo*>(inEventData)->impulse));
-                    jsEvent->Set(v8::String::NewFromUtf8(isolate, "force"),v8::Number::New(isolate, static_cast<SpriteJointBreakInfo*>(inEventData)->force));
-                    jsEvent->Set(v8::String::NewFromUtf8(isolate, "breakForce"),v8::Number::New(isolate, static_cast<SpriteJointBreakInfo*>(inEventData)->breakForce));
-                    jsEvent->Set(v8::String::NewFromUtf8(isolate, "joint"), cpConstraintWrap::NewFromCpp(isolate, static_cast<SpriteJointBreakInfo*>(inEventData)->joint));
+                    jsEvent->Set(EVENT_KEY(targetSprite), obj1_);
+                    jsEvent->Set(EVENT_KEY(impulse),v8::Number::New(isolate, static_cast<SpriteJointBreakInfo*>(inEventData)->impulse));
+                    jsEvent->Set(EVENT_KEY(force),v8::Number::New(isolate, static_cast<SpriteJointBreakInfo*>(inEventData)->force));
+                    jsEvent->Set(EVENT_KEY(breakForce),v8::Number::New(isolate, static_cast<SpriteJointBreakInfo*>(inEventData)->breakForce));
+                    jsEvent->Set(EVENT_KEY(joint), cpConstraintWrap::NewFromCpp(isolate, static_cast<SpriteJointBreakInfo*>(inEventData)->joint));
 #endif
                 }
 
             case pdg::eventType_SpriteAnimate:
                 obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<SpriteAnimateInfo*>(inEventData)->actingSprite->mSpriteScriptObj);
                 obj2_ = v8::Local<v8::Object>::New(isolate, static_cast<SpriteAnimateInfo*>(inEventData)->inLayer->mSpriteLayerScriptObj);
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "action"),v8::Integer::New(isolate, static_cast<SpriteAnimateInfo*>(inEventData)->action));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "actingSprite"), obj1_);
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "inLayer"), obj2_);
+                jsEvent->Set(EVENT_KEY(action),v8::Integer::New(isolate, static_cast<SpriteAnimateInfo*>(inEventData)->action));
+                jsEvent->Set(EVENT_KEY(actingSprite), obj1_);
+                jsEvent->Set(EVENT_KEY(inLayer), obj2_);
+                if ( (static_cast<SpriteAnimateInfo*>(inEventData)->action == Sprite::action_EnterObserver) ||
+                     (static_cast<SpriteAnimateInfo*>(inEventData)->action == Sprite::action_ExitObserver) )
+                {
+                    jsEvent->Set(EVENT_KEY(observerId), v8::Integer::NewFromUnsigned(isolate, static_cast<SpriteObserverInfo*>(inEventData)->observerId));
+                }
                 break;
             case pdg::eventType_SpriteLayer:
                 obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<SpriteLayerInfo*>(inEventData)->actingLayer->mSpriteLayerScriptObj);
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "action"),v8::Integer::New(isolate, static_cast<SpriteLayerInfo*>(inEventData)->action));
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "actingLayer"), obj1_);
-                jsEvent->Set(v8::String::NewFromUtf8(isolate, "millisec"),v8::Integer::NewFromUnsigned(isolate, static_cast<SpriteLayerInfo*>(inEventData)->millisec));
+                jsEvent->Set(EVENT_KEY(action),v8::Integer::New(isolate, static_cast<SpriteLayerInfo*>(inEventData)->action));
+                jsEvent->Set(EVENT_KEY(actingLayer), obj1_);
+                jsEvent->Set(EVENT_KEY(millisec),v8::Integer::NewFromUnsigned(isolate, static_cast<SpriteLayerInfo*>(inEventData)->millisec));
                 break;
             default:
             {
@@ -1827,6 +1967,7 @@ namespace pdg
         SpriteWrap::Init(isolate, target);;
         SpriteLayerWrap::Init(isolate, target);;
         TileLayerWrap::Init(isolate, target);;
+        WorldWrap::Init(isolate, target);;
         ImageWrap::Init(isolate, target);;
         ImageStripWrap::Init(isolate, target);;
 #ifndef PDG_NO_GUI
@@ -1849,6 +1990,7 @@ namespace pdg
         target->Set(v8::String::NewFromUtf8(isolate, "srand", v8::String::kInternalizedString), v8::FunctionTemplate::New(isolate, Srand)->GetFunction());;
 
         target->Set(v8::String::NewFromUtf8(isolate, "setSerializationDebugMode", v8::String::kInternalizedString), v8::FunctionTemplate::New(isolate, SetSerializationDebugMode)->GetFunction());;
+        target->Set(v8::String::NewFromUtf8(isolate, "getUserDataStats", v8::String::kInternalizedString), v8::FunctionTemplate::New(isolate, GetUserDataStats)->GetFunction());;
 
         target->Set(v8::String::NewFromUtf8(isolate, "registerEasingFunction", v8::String::kInternalizedString), v8::FunctionTemplate::New(isolate, RegisterEasingFunction)->GetFunction());;
 
@@ -1873,6 +2015,11 @@ namespace pdg
 #endif
         target->Set(v8::String::NewFromUtf8(isolate, "cleanupSpriteLayer", v8::String::kInternalizedString), v8::FunctionTemplate::New(isolate, CleanupSpriteLayer)->GetFunction());;
         target->Set(v8::String::NewFromUtf8(isolate, "createTileLayer", v8::String::kInternalizedString), v8::FunctionTemplate::New(isolate, CreateTileLayer)->GetFunction());;
+        target->Set(v8::String::NewFromUtf8(isolate, "createWorld", v8::String::kInternalizedString), v8::FunctionTemplate::New(isolate, CreateWorld)->GetFunction());;
+        target->Set(v8::String::NewFromUtf8(isolate, "getDefaultWorld", v8::String::kInternalizedString), v8::FunctionTemplate::New(isolate, GetDefaultWorld)->GetFunction());;
+        target->Set(v8::String::NewFromUtf8(isolate, "cleanupWorld", v8::String::kInternalizedString), v8::FunctionTemplate::New(isolate, CleanupWorld)->GetFunction());;
+        target->Set(v8::String::NewFromUtf8(isolate, "setWorldThreads", v8::String::kInternalizedString), v8::FunctionTemplate::New(isolate, SetWorldThreads)->GetFunction());;
+        target->Set(v8::String::NewFromUtf8(isolate, "getWorldThreads", v8::String::kInternalizedString), v8::FunctionTemplate::New(isolate, GetWorldThreads)->GetFunction());;
 
         target->ForceSet(v8::String::NewFromUtf8(isolate, "all_events", v8::String::kInternalizedString), v8::Integer::New(isolate, all_events), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
 
@@ -1992,6 +2139,8 @@ namespace pdg
         target->ForceSet(v8::String::NewFromUtf8(isolate, "action_FadeInComplete", v8::String::kInternalizedString), v8::Integer::New(isolate, Sprite::action_FadeInComplete), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
         target->ForceSet(v8::String::NewFromUtf8(isolate, "action_FadeOutComplete", v8::String::kInternalizedString), v8::Integer::New(isolate, Sprite::action_FadeOutComplete), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
         target->ForceSet(v8::String::NewFromUtf8(isolate, "action_JointBreak", v8::String::kInternalizedString), v8::Integer::New(isolate, Sprite::action_JointBreak), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
+        target->ForceSet(v8::String::NewFromUtf8(isolate, "action_EnterObserver", v8::String::kInternalizedString), v8::Integer::New(isolate, Sprite::action_EnterObserver), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
+        target->ForceSet(v8::String::NewFromUtf8(isolate, "action_ExitObserver", v8::String::kInternalizedString), v8::Integer::New(isolate, Sprite::action_ExitObserver), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
 
         target->ForceSet(v8::String::NewFromUtf8(isolate, "touch_MouseEnter", v8::String::kInternalizedString), v8::Integer::New(isolate, Sprite::touch_MouseEnter), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
         target->ForceSet(v8::String::NewFromUtf8(isolate, "touch_MouseLeave", v8::String::kInternalizedString), v8::Integer::New(isolate, Sprite::touch_MouseLeave), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
@@ -2075,9 +2224,18 @@ namespace pdg
         target->ForceSet(v8::String::NewFromUtf8(isolate, "ser_HelperRefs", v8::String::kInternalizedString), v8::Integer::New(isolate, ser_HelperRefs), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
         target->ForceSet(v8::String::NewFromUtf8(isolate, "ser_HelperObjs", v8::String::kInternalizedString), v8::Integer::New(isolate, ser_HelperObjs), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
         target->ForceSet(v8::String::NewFromUtf8(isolate, "ser_InitialData", v8::String::kInternalizedString), v8::Integer::New(isolate, ser_InitialData), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
+        target->ForceSet(v8::String::NewFromUtf8(isolate, "ser_Delta", v8::String::kInternalizedString), v8::Integer::New(isolate, ser_Delta), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
         target->ForceSet(v8::String::NewFromUtf8(isolate, "ser_Micro", v8::String::kInternalizedString), v8::Integer::New(isolate, ser_Micro), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
         target->ForceSet(v8::String::NewFromUtf8(isolate, "ser_Update", v8::String::kInternalizedString), v8::Integer::New(isolate, ser_Update), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
         target->ForceSet(v8::String::NewFromUtf8(isolate, "ser_Full", v8::String::kInternalizedString), v8::Integer::New(isolate, ser_Full), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
+
+        target->ForceSet(v8::String::NewFromUtf8(isolate, "spriteState_X", v8::String::kInternalizedString), v8::Integer::New(isolate, spriteState_X), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
+        target->ForceSet(v8::String::NewFromUtf8(isolate, "spriteState_Y", v8::String::kInternalizedString), v8::Integer::New(isolate, spriteState_Y), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
+        target->ForceSet(v8::String::NewFromUtf8(isolate, "spriteState_VelocityX", v8::String::kInternalizedString), v8::Integer::New(isolate, spriteState_VelocityX), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
+        target->ForceSet(v8::String::NewFromUtf8(isolate, "spriteState_VelocityY", v8::String::kInternalizedString), v8::Integer::New(isolate, spriteState_VelocityY), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
+        target->ForceSet(v8::String::NewFromUtf8(isolate, "spriteState_Facing", v8::String::kInternalizedString), v8::Integer::New(isolate, spriteState_Facing), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
+        target->ForceSet(v8::String::NewFromUtf8(isolate, "spriteState_Frame", v8::String::kInternalizedString), v8::Integer::New(isolate, spriteState_Frame), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
+        target->ForceSet(v8::String::NewFromUtf8(isolate, "spriteState_Size", v8::String::kInternalizedString), v8::Integer::New(isolate, spriteState_Size), static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontDelete));
     }
 
     void CreateSingletons()
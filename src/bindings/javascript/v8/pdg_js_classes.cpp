@@ -631,6 +631,130 @@ ScriptSerializable::getMyClassTag() const {
 //MARK: Script Event Handler
 // ========================================================================================
 
+// Every event of a given type is made from the same ObjectTemplate, which already has all
+// the fields that type of event can carry, so the objects all share one hidden class and
+// handlers that read them stay monomorphic. The field names are internalized once and kept
+// for the life of the isolate rather than being made again for every event. A field an
+// event doesn't have this time (a collision with no target sprite, say) is left undefined
+
+enum {
+	eventKey_emitter, eventKey_eventType, eventKey_startupReason, eventKey_exitReason, eventKey_exitCode, eventKey_id,
+	eventKey_millisec, eventKey_msElapsed, eventKey_keyCode, eventKey_shift, eventKey_ctrl, eventKey_alt,
+	eventKey_meta, eventKey_unicode, eventKey_isRepeating, eventKey_touchType, eventKey_touchedSprite, eventKey_inLayer,
+	eventKey_mousePos, eventKey_leftButton, eventKey_rightButton, eventKey_buttonNumber, eventKey_lastClickPos, eventKey_lastClickElapsed,
+	eventKey_horizDelta, eventKey_vertDelta, eventKey_eventCode, eventKey_sound, eventKey_port, eventKey_screenPos,
+	eventKey_oldScreenPos, eventKey_oldWidth, eventKey_oldHeight, eventKey_frameNum, eventKey_targetSprite, eventKey_normal,
+	eventKey_impulse, eventKey_force, eventKey_kineticEnergy, eventKey_arbiter, eventKey_breakForce, eventKey_joint,
+	eventKey_action, eventKey_actingSprite, eventKey_observerId, eventKey_actingLayer,
+	eventKey_Count
+};
+
+static const char* s_EventKeyNames[eventKey_Count] = {
+	"emitter", "eventType", "startupReason", "exitReason", "exitCode", "id",
+	"millisec", "msElapsed", "keyCode", "shift", "ctrl", "alt",
+	"meta", "unicode", "isRepeating", "touchType", "touchedSprite", "inLayer",
+	"mousePos", "leftButton", "rightButton", "buttonNumber", "lastClickPos", "lastClickElapsed",
+	"horizDelta", "vertDelta", "eventCode", "sound", "port", "screenPos",
+	"oldScreenPos", "oldWidth", "oldHeight", "frameNum", "targetSprite", "normal",
+	"impulse", "force", "kineticEnergy", "arbiter", "breakForce", "joint",
+	"action", "actingSprite", "observerId", "actingLayer"
+};
+
+enum {
+	eventObj_Startup, eventObj_Shutdown, eventObj_Timer, eventObj_Key, eventObj_KeyPress,
+	eventObj_SpriteTouch, eventObj_Mouse, eventObj_ScrollWheel, eventObj_Sound, eventObj_PortResized,
+	eventObj_PortDraw, eventObj_SpriteCollide, eventObj_SpriteBreak, eventObj_SpriteAnimate, eventObj_SpriteLayer,
+	eventObj_Count
+};
+
+// the fields of each type of event after emitter and eventType, in the order they are set, -1 ends each list
+static const int s_EventObjectKeys[eventObj_Count][14] = {
+	{ eventKey_startupReason, -1 },  // Startup
+	{ eventKey_exitReason, eventKey_exitCode, -1 },  // Shutdown
+	{ eventKey_id, eventKey_millisec, eventKey_msElapsed, -1 },  // Timer
+	{ eventKey_keyCode, -1 },  // Key
+	{ eventKey_shift, eventKey_ctrl, eventKey_alt, eventKey_meta, eventKey_unicode, eventKey_isRepeating, -1 },  // KeyPress
+	{ eventKey_touchType, eventKey_touchedSprite, eventKey_inLayer, eventKey_shift, eventKey_ctrl, eventKey_alt, eventKey_meta, eventKey_mousePos, eventKey_leftButton, eventKey_rightButton, eventKey_buttonNumber, eventKey_lastClickPos, eventKey_lastClickElapsed, -1 },  // SpriteTouch
+	{ eventKey_shift, eventKey_ctrl, eventKey_alt, eventKey_meta, eventKey_mousePos, eventKey_leftButton, eventKey_rightButton, eventKey_buttonNumber, eventKey_lastClickPos, eventKey_lastClickElapsed, -1 },  // Mouse
+	{ eventKey_shift, eventKey_ctrl, eventKey_alt, eventKey_meta, eventKey_horizDelta, eventKey_vertDelta, -1 },  // ScrollWheel
+	{ eventKey_eventCode, eventKey_sound, -1 },  // Sound
+	{ eventKey_port, eventKey_screenPos, eventKey_oldScreenPos, eventKey_oldWidth, eventKey_oldHeight, -1 },  // PortResized
+	{ eventKey_port, eventKey_frameNum, -1 },  // PortDraw
+	{ eventKey_targetSprite, eventKey_normal, eventKey_impulse, eventKey_force, eventKey_kineticEnergy, eventKey_arbiter, eventKey_action, eventKey_actingSprite, eventKey_inLayer, eventKey_observerId, -1 },  // SpriteCollide
+	{ eventKey_targetSprite, eventKey_impulse, eventKey_force, eventKey_breakForce, eventKey_joint, eventKey_action, eventKey_actingSprite, eventKey_inLayer, eventKey_observerId, -1 },  // SpriteBreak
+	{ eventKey_action, eventKey_actingSprite, eventKey_inLayer, eventKey_observerId, -1 },  // SpriteAnimate
+	{ eventKey_action, eventKey_actingLayer, eventKey_millisec, -1 }  // SpriteLayer
+};
+
+static v8::Eternal<v8::String> s_EventKeys[eventKey_Count];
+static v8::Eternal<v8::ObjectTemplate> s_EventObjectTemplates[eventObj_Count];
+static bool s_EventObjectTemplatesReady = false;
+
+%#define EVENT_KEY(_name) s_EventKeys[eventKey_##_name].Get(isolate)
+
+static void initEventObjectTemplates(v8::Isolate* isolate) {
+	for (int i = 0; i < eventKey_Count; i++) {
+		s_EventKeys[i].Set(isolate, v8::String::NewFromUtf8(isolate, s_EventKeyNames[i], v8::String::kInternalizedString));
+	}
+	for (int i = 0; i < eventObj_Count; i++) {
+		v8::Local<v8::ObjectTemplate> objTemplate = v8::ObjectTemplate::New(isolate);
+		objTemplate->Set(EVENT_KEY(emitter), v8::Undefined(isolate));
+		objTemplate->Set(EVENT_KEY(eventType), v8::Undefined(isolate));
+		for (const int* key = s_EventObjectKeys[i]; *key >= 0; key++) {
+			objTemplate->Set(s_EventKeys[*key].Get(isolate), v8::Undefined(isolate));
+		}
+		s_EventObjectTemplates[i].Set(isolate, objTemplate);
+	}
+	s_EventObjectTemplatesReady = true;
+}
+
+// which template an event is made from, or -1 if it is never passed to a script
+static int getEventObjectTemplate(long inEventType) {
+	switch (inEventType) {
+		case pdg::eventType_Startup:
+			return eventObj_Startup;
+		case pdg::eventType_Shutdown:
+			return eventObj_Shutdown;
+		case pdg::eventType_Timer:
+			return eventObj_Timer;
+%#ifndef PDG_NO_GUI
+		case pdg::eventType_KeyDown:
+		case pdg::eventType_KeyUp:
+			return eventObj_Key;
+		case pdg::eventType_KeyPress:
+			return eventObj_KeyPress;
+		case pdg::eventType_SpriteTouch:
+			return eventObj_SpriteTouch;
+		case pdg::eventType_MouseDown:
+		case pdg::eventType_MouseUp:
+		case pdg::eventType_MouseMove:
+			return eventObj_Mouse;
+		case pdg::eventType_ScrollWheel:
+			return eventObj_ScrollWheel;
+%#endif // PDG_NO_GUI
+%#ifndef PDG_NO_SOUND
+		case pdg::eventType_SoundEvent:
+			return eventObj_Sound;
+%#endif // PDG_NO_SOUND
+%#ifndef PDG_NO_GUI
+		case pdg::eventType_PortResized:
+			return eventObj_PortResized;
+		case pdg::eventType_PortDraw:
+			return eventObj_PortDraw;
+%#endif // PDG_NO_GUI
+		case pdg::eventType_SpriteCollide:
+			return eventObj_SpriteCollide;
+		case pdg::eventType_SpriteBreak:
+			return eventObj_SpriteBreak;
+		case pdg::eventType_SpriteAnimate:
+			return eventObj_SpriteAnimate;
+		case pdg::eventType_SpriteLayer:
+			return eventObj_SpriteLayer;
+		default:
+			return -1;
+	}
+}
+
 ScriptEventHandler::ScriptEventHandler(FUNCTION_REF func) {
     v8::Isolate* isolate = v8::Isolate::GetCurrent();
 	mScriptHandlerFunc.Reset(isolate, func);
@@ -638,74 +762,83 @@ ScriptEventHandler::ScriptEventHandler(FUNCTION_REF func) {
 
 bool ScriptEventHandler::handleEvent(EventEmitter* emitter, long inEventType, void* inEventData) throw() {
     v8::Isolate* isolate = v8::Isolate::GetCurrent();
-  	v8::Local<v8::Object> jsEvent = v8::Object::New(isolate);
+	if ((inEventType == pdg::eventType_Timer) && (static_cast<TimerInfo*>(inEventData)->id <= 0)) {
+		// do not send internal timer events to javascript
+		return false;
+	}
+	if (!s_EventObjectTemplatesReady) {
+		initEventObjectTemplates(isolate);
+	}
+	int eventObj = getEventObjectTemplate(inEventType);
+  	v8::Local<v8::Object> jsEvent;
+	if (eventObj >= 0) {
+		jsEvent = s_EventObjectTemplates[eventObj].Get(isolate)->NewInstance();
+	} else {
+		jsEvent = v8::Object::New(isolate);  // turned away by the switch below
+	}
     v8::Local<v8::Object> emitter_ = v8::Local<v8::Object>::New(isolate, emitter->mEventEmitterScriptObj);
     v8::Local<v8::Object> obj1_;
     v8::Local<v8::Object> obj2_;
-  	jsEvent->Set(STR2VAL("emitter"), emitter_);
-	jsEvent->Set(STR2VAL("eventType"),INT2VAL(inEventType));
+  	jsEvent->Set(EVENT_KEY(emitter), emitter_);
+	jsEvent->Set(EVENT_KEY(eventType),INT2VAL(inEventType));
 	switch (inEventType) {
 		case pdg::eventType_Startup:
-			jsEvent->Set(STR2VAL("startupReason"),INT2VAL(static_cast<StartupInfo*>(inEventData)->startupReason));
+			jsEvent->Set(EVENT_KEY(startupReason),INT2VAL(static_cast<StartupInfo*>(inEventData)->startupReason));
 // TODO: startup params converted to an array
-//			jsEvent->Set(STR2VAL("startupParams"),INT2VAL(static_cast<StartupInfo*>(inEventData)->startupParam));
+//			jsEvent->Set(EVENT_KEY(startupParams),INT2VAL(static_cast<StartupInfo*>(inEventData)->startupParam));
 			break;
 		case pdg::eventType_Shutdown:
-			jsEvent->Set(STR2VAL("exitReason"),INT2VAL(static_cast<ShutdownInfo*>(inEventData)->exitReason));
-			jsEvent->Set(STR2VAL("exitCode"),INT2VAL(static_cast<ShutdownInfo*>(inEventData)->exitCode));
+			jsEvent->Set(EVENT_KEY(exitReason),INT2VAL(static_cast<ShutdownInfo*>(inEventData)->exitReason));
+			jsEvent->Set(EVENT_KEY(exitCode),INT2VAL(static_cast<ShutdownInfo*>(inEventData)->exitCode));
 			break;
 		case pdg::eventType_Timer:
-			if (static_cast<TimerInfo*>(inEventData)->id <= 0) {
-				// do not send internal timer events to javascript
-				return false;
-			}
-			jsEvent->Set(STR2VAL("id"),INT2VAL(static_cast<TimerInfo*>(inEventData)->id));
-			jsEvent->Set(STR2VAL("millisec"),UINT2VAL(static_cast<TimerInfo*>(inEventData)->millisec));
-			jsEvent->Set(STR2VAL("msElapsed"),UINT2VAL(static_cast<TimerInfo*>(inEventData)->msElapsed));
+			jsEvent->Set(EVENT_KEY(id),INT2VAL(static_cast<TimerInfo*>(inEventData)->id));
+			jsEvent->Set(EVENT_KEY(millisec),UINT2VAL(static_cast<TimerInfo*>(inEventData)->millisec));
+			jsEvent->Set(EVENT_KEY(msElapsed),UINT2VAL(static_cast<TimerInfo*>(inEventData)->msElapsed));
 // TODO: user data as an object
-//			jsEvent->Set(STR2VAL("userData"),INT2VAL(static_cast<TimerInfo*>(inEventData)->userData));
+//			jsEvent->Set(EVENT_KEY(userData),INT2VAL(static_cast<TimerInfo*>(inEventData)->userData));
 			break;
 %#ifndef PDG_NO_GUI
 		case pdg::eventType_KeyDown:
 		case pdg::eventType_KeyUp:
-			jsEvent->Set(STR2VAL("keyCode"),INT2VAL(static_cast<KeyInfo*>(inEventData)->keyCode));
+			jsEvent->Set(EVENT_KEY(keyCode),INT2VAL(static_cast<KeyInfo*>(inEventData)->keyCode));
 			break;
 		case pdg::eventType_KeyPress:
-			jsEvent->Set(STR2VAL("shift"),BOOL2VAL(static_cast<KeyPressInfo*>(inEventData)->shift));
-			jsEvent->Set(STR2VAL("ctrl"),BOOL2VAL(static_cast<KeyPressInfo*>(inEventData)->ctrl));
-			jsEvent->Set(STR2VAL("alt"),BOOL2VAL(static_cast<KeyPressInfo*>(inEventData)->alt));
-			jsEvent->Set(STR2VAL("meta"),BOOL2VAL(static_cast<KeyPressInfo*>(inEventData)->meta));
-			jsEvent->Set(STR2VAL("unicode"),INT2VAL(static_cast<KeyPressInfo*>(inEventData)->unicode));
-			jsEvent->Set(STR2VAL("isRepeating"),BOOL2VAL(static_cast<KeyPressInfo*>(inEventData)->isRepeating));
+			jsEvent->Set(EVENT_KEY(shift),BOOL2VAL(static_cast<KeyPressInfo*>(inEventData)->shift));
+			jsEvent->Set(EVENT_KEY(ctrl),BOOL2VAL(static_cast<KeyPressInfo*>(inEventData)->ctrl));
+			jsEvent->Set(EVENT_KEY(alt),BOOL2VAL(static_cast<KeyPressInfo*>(inEventData)->alt));
+			jsEvent->Set(EVENT_KEY(meta),BOOL2VAL(static_cast<KeyPressInfo*>(inEventData)->meta));
+			jsEvent->Set(EVENT_KEY(unicode),INT2VAL(static_cast<KeyPressInfo*>(inEventData)->unicode));
+			jsEvent->Set(EVENT_KEY(isRepeating),BOOL2VAL(static_cast<KeyPressInfo*>(inEventData)->isRepeating));
 			break;
 		case pdg::eventType_SpriteTouch:
             obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<SpriteTouchInfo*>(inEventData)->touchedSprite->mSpriteScriptObj);
             obj2_ = v8::Local<v8::Object>::New(isolate, static_cast<SpriteTouchInfo*>(inEventData)->inLayer->mSpriteLayerScriptObj);
-			jsEvent->Set(STR2VAL("touchType"),INT2VAL(static_cast<SpriteTouchInfo*>(inEventData)->touchType));
-			jsEvent->Set(STR2VAL("touchedSprite"), obj1_);
-			jsEvent->Set(STR2VAL("inLayer"), obj2_);
+			jsEvent->Set(EVENT_KEY(touchType),INT2VAL(static_cast<SpriteTouchInfo*>(inEventData)->touchType));
+			jsEvent->Set(EVENT_KEY(touchedSprite), obj1_);
+			jsEvent->Set(EVENT_KEY(inLayer), obj2_);
 			// break; fall through
 		case pdg::eventType_MouseDown:
 		case pdg::eventType_MouseUp:
 		case pdg::eventType_MouseMove:
-			jsEvent->Set(STR2VAL("shift"),BOOL2VAL(static_cast<MouseInfo*>(inEventData)->shift));
-			jsEvent->Set(STR2VAL("ctrl"),BOOL2VAL(static_cast<MouseInfo*>(inEventData)->ctrl));
-			jsEvent->Set(STR2VAL("alt"),BOOL2VAL(static_cast<MouseInfo*>(inEventData)->alt));
-			jsEvent->Set(STR2VAL("meta"),BOOL2VAL(static_cast<MouseInfo*>(inEventData)->meta));
-			jsEvent->Set(STR2VAL("mousePos"),POINT2VAL(static_cast<MouseInfo*>(inEventData)->mousePos));
-			jsEvent->Set(STR2VAL("leftButton"),BOOL2VAL(static_cast<MouseInfo*>(inEventData)->leftButton));
-			jsEvent->Set(STR2VAL("rightButton"),BOOL2VAL(static_cast<MouseInfo*>(inEventData)->rightButton));
-			jsEvent->Set(STR2VAL("buttonNumber"),UINT2VAL(static_cast<MouseInfo*>(inEventData)->buttonNumber));
-			jsEvent->Set(STR2VAL("lastClickPos"),POINT2VAL(static_cast<MouseInfo*>(inEventData)->lastClickPos));
-			jsEvent->Set(STR2VAL("lastClickElapsed"),UINT2VAL(static_cast<MouseInfo*>(inEventData)->lastClickElapsed));
+			jsEvent->Set(EVENT_KEY(shift),BOOL2VAL(static_cast<MouseInfo*>(inEventData)->shift));
+			jsEvent->Set(EVENT_KEY(ctrl),BOOL2VAL(static_cast<MouseInfo*>(inEventData)->ctrl));
+			jsEvent->Set(EVENT_KEY(alt),BOOL2VAL(static_cast<MouseInfo*>(inEventData)->alt));
+			jsEvent->Set(EVENT_KEY(meta),BOOL2VAL(static_cast<MouseInfo*>(inEventData)->meta));
+			jsEvent->Set(EVENT_KEY(mousePos),POINT2VAL(static_cast<MouseInfo*>(inEventData)->mousePos));
+			jsEvent->Set(EVENT_KEY(leftButton),BOOL2VAL(static_cast<MouseInfo*>(inEventData)->leftButton));
+			jsEvent->Set(EVENT_KEY(rightButton),BOOL2VAL(static_cast<MouseInfo*>(inEventData)->rightButton));
+			jsEvent->Set(EVENT_KEY(buttonNumber),UINT2VAL(static_cast<MouseInfo*>(inEventData)->buttonNumber));
+			jsEvent->Set(EVENT_KEY(lastClickPos),POINT2VAL(static_cast<MouseInfo*>(inEventData)->lastClickPos));
+			jsEvent->Set(EVENT_KEY(lastClickElapsed),UINT2VAL(static_cast<MouseInfo*>(inEventData)->lastClickElapsed));
 			break;
 		case pdg::eventType_ScrollWheel:
-			jsEvent->Set(STR2VAL("shift"),BOOL2VAL(static_cast<ScrollWheelInfo*>(inEventData)->shift));
-			jsEvent->Set(STR2VAL("ctrl"),BOOL2VAL(static_cast<ScrollWheelInfo*>(inEventData)->ctrl));
-			jsEvent->Set(STR2VAL("alt"),BOOL2VAL(static_cast<ScrollWheelInfo*>(inEventData)->alt));
-			jsEvent->Set(STR2VAL("meta"),BOOL2VAL(static_cast<ScrollWheelInfo*>(inEventData)->meta));
-			jsEvent->Set(STR2VAL("horizDelta"),INT2VAL(static_cast<ScrollWheelInfo*>(inEventData)->horizDelta));
-			jsEvent->Set(STR2VAL("vertDelta"),INT2VAL(static_cast<ScrollWheelInfo*>(inEventData)->vertDelta));
+			jsEvent->Set(EVENT_KEY(shift),BOOL2VAL(static_cast<ScrollWheelInfo*>(inEventData)->shift));
+			jsEvent->Set(EVENT_KEY(ctrl),BOOL2VAL(static_cast<ScrollWheelInfo*>(inEventData)->ctrl));
+			jsEvent->Set(EVENT_KEY(alt),BOOL2VAL(static_cast<ScrollWheelInfo*>(inEventData)->alt));
+			jsEvent->Set(EVENT_KEY(meta),BOOL2VAL(static_cast<ScrollWheelInfo*>(inEventData)->meta));
+			jsEvent->Set(EVENT_KEY(horizDelta),INT2VAL(static_cast<ScrollWheelInfo*>(inEventData)->horizDelta));
+			jsEvent->Set(EVENT_KEY(vertDelta),INT2VAL(static_cast<ScrollWheelInfo*>(inEventData)->vertDelta));
 			break;
 %#endif // PDG_NO_GUI
 %#ifndef PDG_NO_NETWORK
@@ -726,23 +859,23 @@ bool ScriptEventHandler::handleEvent(EventEmitter* emitter, long inEventType, vo
 %#ifndef PDG_NO_SOUND
 		case pdg::eventType_SoundEvent:
             obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<SoundEventInfo*>(inEventData)->sound->mSoundScriptObj);
-			jsEvent->Set(STR2VAL("eventCode"),INT2VAL(static_cast<SoundEventInfo*>(inEventData)->eventCode));
-			jsEvent->Set(STR2VAL("sound"), obj1_);
+			jsEvent->Set(EVENT_KEY(eventCode),INT2VAL(static_cast<SoundEventInfo*>(inEventData)->eventCode));
+			jsEvent->Set(EVENT_KEY(sound), obj1_);
 			break;
 %#endif // PDG_NO_SOUND
 %#ifndef PDG_NO_GUI
 		case pdg::eventType_PortResized:
             obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<PortResizeInfo*>(inEventData)->port->mPortScriptObj);
-			jsEvent->Set(STR2VAL("port"), obj1_);
-			jsEvent->Set(STR2VAL("screenPos"), INT2VAL(static_cast<PortResizeInfo*>(inEventData)->screenPos));
-			jsEvent->Set(STR2VAL("oldScreenPos"), INT2VAL(static_cast<PortResizeInfo*>(inEventData)->oldScreenPos));
-			jsEvent->Set(STR2VAL("oldWidth"), INT2VAL(static_cast<PortResizeInfo*>(inEventData)->oldWidth));
-			jsEvent->Set(STR2VAL("oldHeight"), INT2VAL(static_cast<PortResizeInfo*>(inEventData)->oldHeight));
+			jsEvent->Set(EVENT_KEY(port), obj1_);
+			jsEvent->Set(EVENT_KEY(screenPos), INT2VAL(static_cast<PortResizeInfo*>(inEventData)->screenPos));
+			jsEvent->Set(EVENT_KEY(oldScreenPos), INT2VAL(static_cast<PortResizeInfo*>(inEventData)->oldScreenPos));
+			jsEvent->Set(EVENT_KEY(oldWidth), INT2VAL(static_cast<PortResizeInfo*>(inEventData)->oldWidth));
+			jsEvent->Set(EVENT_KEY(oldHeight), INT2VAL(static_cast<PortResizeInfo*>(inEventData)->oldHeight));
 			break;
 		case pdg::eventType_PortDraw:
             obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<PortDrawInfo*>(inEventData)->port->mPortScriptObj);
-			jsEvent->Set(STR2VAL("port"), obj1_);
-			jsEvent->Set(STR2VAL("frameNum"), INT2VAL(static_cast<PortDrawInfo*>(inEventData)->frameNum));
+			jsEvent->Set(EVENT_KEY(port), obj1_);
+			jsEvent->Set(EVENT_KEY(frameNum), INT2VAL(static_cast<PortDrawInfo*>(inEventData)->frameNum));
 			break;
 %#endif // PDG_NO_GUI
 		case pdg::eventType_SpriteCollide:
@@ -750,40 +883,44 @@ bool ScriptEventHandler::handleEvent(EventEmitter* emitter, long inEventType, vo
 			if (inEventType == pdg::eventType_SpriteCollide) {
 				if (static_cast<SpriteCollideInfo*>(inEventData)->targetSprite) {
                     obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<SpriteCollideInfo*>(inEventData)->targetSprite->mSpriteScriptObj);
-					jsEvent->Set(STR2VAL("targetSprite"), obj1_);
+					jsEvent->Set(EVENT_KEY(targetSprite), obj1_);
 				}
-				jsEvent->Set(STR2VAL("normal"), VECTOR2VAL(static_cast<SpriteCollideInfo*>(inEventData)->normal));
-				jsEvent->Set(STR2VAL("impulse"), VECTOR2VAL(static_cast<SpriteCollideInfo*>(inEventData)->impulse));
-				jsEvent->Set(STR2VAL("force"),NUM2VAL(static_cast<SpriteCollideInfo*>(inEventData)->force));
-				jsEvent->Set(STR2VAL("kineticEnergy"),NUM2VAL(static_cast<SpriteCollideInfo*>(inEventData)->kineticEnergy));
+				jsEvent->Set(EVENT_KEY(normal), VECTOR2VAL(static_cast<SpriteCollideInfo*>(inEventData)->normal));
+				jsEvent->Set(EVENT_KEY(impulse), VECTOR2VAL(static_cast<SpriteCollideInfo*>(inEventData)->impulse));
+				jsEvent->Set(EVENT_KEY(force),NUM2VAL(static_cast<SpriteCollideInfo*>(inEventData)->force));
+				jsEvent->Set(EVENT_KEY(kineticEnergy),NUM2VAL(static_cast<SpriteCollideInfo*>(inEventData)->kineticEnergy));
 			  %#ifdef PDG_USE_CHIPMUNK_PHYSICS
 			    if (static_cast<SpriteCollideInfo*>(inEventData)->arbiter) {
-					jsEvent->Set(STR2VAL("arbiter"), cpArbiterWrap::NewFromCpp(isolate, static_cast<SpriteCollideInfo*>(inEventData)->arbiter));
+					jsEvent->Set(EVENT_KEY(arbiter), cpArbiterWrap::NewFromCpp(isolate, static_cast<SpriteCollideInfo*>(inEventData)->arbiter));
 				}
 			  %#endif
  			} else {
 			  %#ifdef PDG_USE_CHIPMUNK_PHYSICS
                 obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<SpriteJointBreakInfo*>(inEventData)->targetSprite->mSpriteScriptObj);
-				jsEvent->Set(STR2VAL("targetSprite"), obj1_);
-				jsEvent->Set(STR2VAL("impulse"),NUM2VAL(static_cast<SpriteJointBreakInfo*>(inEventData)->impulse));
-				jsEvent->Set(STR2VAL("force"),NUM2VAL(static_cast<SpriteJointBreakInfo*>(inEventData)->force));
-				jsEvent->Set(STR2VAL("breakForce"),NUM2VAL(static_cast<SpriteJointBreakInfo*>(inEventData)->breakForce));
-				jsEvent->Set(STR2VAL("joint"), cpConstraintWrap::NewFromCpp(isolate, static_cast<SpriteJointBreakInfo*>(inEventData)->joint));
+				jsEvent->Set(EVENT_KEY(targetSprite), obj1_);
+				jsEvent->Set(EVENT_KEY(impulse),NUM2VAL(static_cast<SpriteJointBreakInfo*>(inEventData)->impulse));
+				jsEvent->Set(EVENT_KEY(force),NUM2VAL(static_cast<SpriteJointBreakInfo*>(inEventData)->force));
+				jsEvent->Set(EVENT_KEY(breakForce),NUM2VAL(static_cast<SpriteJointBreakInfo*>(inEventData)->breakForce));
+				jsEvent->Set(EVENT_KEY(joint), cpConstraintWrap::NewFromCpp(isolate, static_cast<SpriteJointBreakInfo*>(inEventData)->joint));
 			  %#endif
  			}
 			// break; fall through
 		case pdg::eventType_SpriteAnimate:
             obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<SpriteAnimateInfo*>(inEventData)->actingSprite->mSpriteScriptObj);
             obj2_ = v8::Local<v8::Object>::New(isolate, static_cast<SpriteAnimateInfo*>(inEventData)->inLayer->mSpriteLayerScriptObj);
-			jsEvent->Set(STR2VAL("action"),INT2VAL(static_cast<SpriteAnimateInfo*>(inEventData)->action));
-			jsEvent->Set(STR2VAL("actingSprite"), obj1_);
-			jsEvent->Set(STR2VAL("inLayer"), obj2_);
+			jsEvent->Set(EVENT_KEY(action),INT2VAL(static_cast<SpriteAnimateInfo*>(inEventData)->action));
+			jsEvent->Set(EVENT_KEY(actingSprite), obj1_);
+			jsEvent->Set(EVENT_KEY(inLayer), obj2_);
+			if ( (static_cast<SpriteAnimateInfo*>(inEventData)->action == Sprite::action_EnterObserver) ||
+				 (static_cast<SpriteAnimateInfo*>(inEventData)->action == Sprite::action_ExitObserver) ) {
+				jsEvent->Set(EVENT_KEY(observerId), UINT2VAL(static_cast<SpriteObserverInfo*>(inEventData)->observerId));
+			}
 			break;
 		case pdg::eventType_SpriteLayer:
             obj1_ = v8::Local<v8::Object>::New(isolate, static_cast<SpriteLayerInfo*>(inEventData)->actingLayer->mSpriteLayerScriptObj);
-			jsEvent->Set(STR2VAL("action"),INT2VAL(static_cast<SpriteLayerInfo*>(inEventData)->action));
-			jsEvent->Set(STR2VAL("actingLayer"), obj1_);
-			jsEvent->Set(STR2VAL("millisec"),UINT2VAL(static_cast<SpriteLayerInfo*>(inEventData)->millisec));
+			jsEvent->Set(EVENT_KEY(action),INT2VAL(static_cast<SpriteLayerInfo*>(inEventData)->action));
+			jsEvent->Set(EVENT_KEY(actingLayer), obj1_);
+			jsEvent->Set(EVENT_KEY(millisec),UINT2VAL(static_cast<SpriteLayerInfo*>(inEventData)->millisec));
 			break;
 		default: {
 			std::ostringstream msg;
@@ -1171,6 +1308,7 @@ void initBindings(v8::Local<v8::Object> target) {
 	INIT_CLASS(Sprite);
 	INIT_CLASS(SpriteLayer);
 	INIT_CLASS(TileLayer);
+	INIT_CLASS(World);
 	INIT_CLASS(Image);
 	INIT_CLASS(ImageStrip);
   %#ifndef PDG_NO_GUI
@@ -1196,6 +1334,7 @@ void initBindings(v8::Local<v8::Object> target) {
     INIT_FUNCTION("srand", Srand);
     
 	INIT_FUNCTION("setSerializationDebugMode", SetSerializationDebugMode);
+	INIT_FUNCTION("getUserDataStats", GetUserDataStats);
 
     INIT_FUNCTION("registerEasingFunction", RegisterEasingFunction);
     
@@ -1220,6 +1359,11 @@ void initBindings(v8::Local<v8::Object> target) {
 %#endif
 	INIT_FUNCTION("cleanupSpriteLayer", CleanupSpriteLayer);
 	INIT_FUNCTION("createTileLayer", CreateTileLayer);
+	INIT_FUNCTION("createWorld", CreateWorld);
+	INIT_FUNCTION("getDefaultWorld", GetDefaultWorld);
+	INIT_FUNCTION("cleanupWorld", CleanupWorld);
+	INIT_FUNCTION("setWorldThreads", SetWorldThreads);
+	INIT_FUNCTION("getWorldThreads", GetWorldThreads);
 
 	// Constants
     INIT_CONSTANT("all_events", all_events);
@@ -1340,6 +1484,8 @@ void initBindings(v8::Local<v8::Object> target) {
 	INIT_CONSTANT("action_FadeInComplete", Sprite::action_FadeInComplete);
 	INIT_CONSTANT("action_FadeOutComplete", Sprite::action_FadeOutComplete);
 	INIT_CONSTANT("action_JointBreak", Sprite::action_JointBreak);
+	INIT_CONSTANT("action_EnterObserver", Sprite::action_EnterObserver);
+	INIT_CONSTANT("action_ExitObserver", Sprite::action_ExitObserver);
 	
 	INIT_CONSTANT("touch_MouseEnter", Sprite::touch_MouseEnter);
 	INIT_CONSTANT("touch_MouseLeave", Sprite::touch_MouseLeave);
@@ -1426,9 +1572,18 @@ void initBindings(v8::Local<v8::Object> target) {
 	INIT_CONSTANT("ser_HelperRefs", ser_HelperRefs);
 	INIT_CONSTANT("ser_HelperObjs", ser_HelperObjs);
 	INIT_CONSTANT("ser_InitialData", ser_InitialData);
+	INIT_CONSTANT("ser_Delta", ser_Delta);
 	INIT_CONSTANT("ser_Micro", ser_Micro);
 	INIT_CONSTANT("ser_Update", ser_Update);
 	INIT_CONSTANT("ser_Full", ser_Full);
+
+	INIT_CONSTANT("spriteState_X", spriteState_X);
+	INIT_CONSTANT("spriteState_Y", spriteState_Y);
+	INIT_CONSTANT("spriteState_VelocityX", spriteState_VelocityX);
+	INIT_CONSTANT("spriteState_VelocityY", spriteState_VelocityY);
+	INIT_CONSTANT("spriteState_Facing", spriteState_Facing);
+	INIT_CONSTANT("spriteState_Frame", spriteState_Frame);
+	INIT_CONSTANT("spriteState_Size", spriteState_Size);
 }
 
 
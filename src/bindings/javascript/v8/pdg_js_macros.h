@@ -118,5 +118,41 @@
        }                                                                      CR \
        v8::Local<v8::Object> paramName = args[n-1]->ToObject();
 
+// typed array arguments give a pointer to the first element, with the number of elements
+// in paramName##Length
+#define REQUIRE_FLOAT32_ARRAY_ARG(n, paramName)   \
+	if (!args[n-1]->IsFloat32Array()) {                                       CR \
+		THROW_TYPE_ERR("argument "#n" must be a Float32Array ("#paramName")"); CR \
+		return;                                                               CR \
+	}                                                                         CR \
+	uint32 paramName##Length = 0;                                             CR \
+	float* paramName = v8_GetFloat32ArrayData(args[n-1], paramName##Length);
+
+#define REQUIRE_UINT32_ARRAY_ARG(n, paramName)   \
+	if (!args[n-1]->IsUint32Array()) {                                        CR \
+		THROW_TYPE_ERR("argument "#n" must be a Uint32Array ("#paramName")"); CR \
+		return;                                                               CR \
+	}                                                                         CR \
+	uint32 paramName##Length = 0;                                             CR \
+	uint32* paramName = v8_GetUint32ArrayData(args[n-1], paramName##Length);
+
+// node Buffers are Uint8Arrays, so this takes either
+#define REQUIRE_UINT8_ARRAY_ARG(n, paramName)   \
+	if (!args[n-1]->IsUint8Array()) {                                         CR \
+		THROW_TYPE_ERR("argument "#n" must be a Buffer or Uint8Array ("#paramName")"); CR \
+		return;                                                               CR \
+	}                                                                         CR \
+	uint32 paramName##Length = 0;                                             CR \
+	uint8* paramName = v8_GetUint8ArrayData(args[n-1], paramName##Length);
+
+// paramName is 0 if the argument is missing, undefined or null
+#define OPTIONAL_UINT32_ARRAY_ARG(n, paramName)   \
+	if (!args[n-1]->IsUint32Array() && !args[n-1]->IsUndefined() && !args[n-1]->IsNull()) { CR \
+		THROW_TYPE_ERR("argument "#n" must be a Uint32Array ("#paramName")"); CR \
+		return;                                                               CR \
+	}                                                                         CR \
+	uint32 paramName##Length = 0;                                             CR \
+	uint32* paramName = v8_GetUint32ArrayData(args[n-1], paramName##Length);
+
 
 #endif // PDG_JS_MACROS_H_INCLUDED
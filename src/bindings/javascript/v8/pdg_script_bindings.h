@@ -66,6 +66,7 @@ void CleanupAnimatedScriptObject(SCRIPT_CLEANUP_PARAM);
 void CleanupSpriteScriptObject(SCRIPT_CLEANUP_PARAM);
 void CleanupSpriteLayerScriptObject(SCRIPT_CLEANUP_PARAM);
 void CleanupTileLayerScriptObject(SCRIPT_CLEANUP_PARAM);
+void CleanupWorldScriptObject(SCRIPT_CLEANUP_PARAM);
 void CleanupISpriteCollideHelperScriptObject(SCRIPT_CLEANUP_PARAM);
 void CleanupISpriteDrawHelperScriptObject(SCRIPT_CLEANUP_PARAM);
 void CleanupISerializableScriptObject(SCRIPT_CLEANUP_PARAM);
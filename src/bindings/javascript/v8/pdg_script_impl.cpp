@@ -119,6 +119,10 @@ namespace pdg
         v8::Local<v8::FunctionTemplate> GetBytes_Tpl =
             v8::FunctionTemplate::New(isolate, GetBytes, v8::Local<v8::Value>(), GetBytes_Sig);
         t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getBytes", v8::String::kInternalizedString), GetBytes_Tpl);
+        v8::Local<v8::Signature> ToBuffer_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> ToBuffer_Tpl =
+            v8::FunctionTemplate::New(isolate, ToBuffer, v8::Local<v8::Value>(), ToBuffer_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "toBuffer", v8::String::kInternalizedString), ToBuffer_Tpl);
         target->Set(v8::String::NewFromUtf8(isolate, "MemBlock", v8::String::kInternalizedString), t->GetFunction());
 
     }
@@ -194,6 +198,22 @@ namespace pdg
         { args.GetReturnValue().Set( resultVal ); return; };
     }
 
+    void MemBlockWrap::ToBuffer(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        MemBlockWrap* objWrapper = jswrap::ObjectWrap::Unwrap<MemBlockWrap>(args.This());
+        MemBlock* self = dynamic_cast<MemBlock*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Buffer]" " function" "()" " - " "") ); return; };
+        }
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+
+        { args.GetReturnValue().Set( v8_NewBuffer(isolate, self->ptr, self->bytes, false) ); return; };
+    }
+
     void CleanupMemBlockScriptObject(v8::Persistent<v8::Object> &obj) { }
 
     MemBlock* New_MemBlock(const v8::FunctionCallbackInfo<v8::Value>& args)
@@ -1890,6 +1910,30 @@ namespace pdg
         v8::Local<v8::FunctionTemplate> GetDataPtr_Tpl =
             v8::FunctionTemplate::New(isolate, GetDataPtr, v8::Local<v8::Value>(), GetDataPtr_Sig);
         t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getDataPtr", v8::String::kInternalizedString), GetDataPtr_Tpl);
+        v8::Local<v8::Signature> CopyDataTo_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> CopyDataTo_Tpl =
+            v8::FunctionTemplate::New(isolate, CopyDataTo, v8::Local<v8::Value>(), CopyDataTo_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "copyDataTo", v8::String::kInternalizedString), CopyDataTo_Tpl);
+        v8::Local<v8::Signature> ReleaseBuffer_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> ReleaseBuffer_Tpl =
+            v8::FunctionTemplate::New(isolate, ReleaseBuffer, v8::Local<v8::Value>(), ReleaseBuffer_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "releaseBuffer", v8::String::kInternalizedString), ReleaseBuffer_Tpl);
+        v8::Local<v8::Signature> GetCapacity_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetCapacity_Tpl =
+            v8::FunctionTemplate::New(isolate, GetCapacity, v8::Local<v8::Value>(), GetCapacity_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getCapacity", v8::String::kInternalizedString), GetCapacity_Tpl);
+        v8::Local<v8::Signature> Reserve_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> Reserve_Tpl =
+            v8::FunctionTemplate::New(isolate, Reserve, v8::Local<v8::Value>(), Reserve_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "reserve", v8::String::kInternalizedString), Reserve_Tpl);
+        v8::Local<v8::Signature> Reset_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> Reset_Tpl =
+            v8::FunctionTemplate::New(isolate, Reset, v8::Local<v8::Value>(), Reset_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "reset", v8::String::kInternalizedString), Reset_Tpl);
+        v8::Local<v8::Signature> SetStreaming_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetStreaming_Tpl =
+            v8::FunctionTemplate::New(isolate, SetStreaming, v8::Local<v8::Value>(), SetStreaming_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setStreaming", v8::String::kInternalizedString), SetStreaming_Tpl);
         target->Set(v8::String::NewFromUtf8(isolate, "Serializer", v8::String::kInternalizedString), t->GetFunction());
 
     }
@@ -2304,7 +2348,7 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "({[string Binary]|[object MemBlock]} mem)" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "({[string Binary]|[object MemBlock]|[object Buffer]} mem)" " - " "") ); return; };
         };
         if (args.Length() != 1)
             v8_ThrowArgCountException(isolate, args.Length(), 1);
@@ -2312,7 +2356,7 @@ namespace pdg
         if (!isStr && !args[0]->IsObject())
         {
             std::ostringstream excpt_;
-            excpt_ << "argument 1 (mem) must be either a binary string or an object of type MemBlock";
+            excpt_ << "argument 1 (mem) must be a binary string, a Buffer or an object of type MemBlock";
             isolate->ThrowException( v8::Exception::TypeError( v8::String::NewFromUtf8(isolate, excpt_.str().c_str())));
         }
         if (isStr)
@@ -2320,6 +2364,12 @@ namespace pdg
             size_t bytes = 0;
             uint8* ptr = (uint8*) DecodeBinary(args[0], &bytes);
             self->serialize_mem(ptr, bytes);
+            std::free(ptr);
+        }
+        else if (args[0]->IsUint8Array())
+        {
+            REQUIRE_UINT8_ARRAY_ARG(1, buffer);
+            self->serialize_mem(buffer, bufferLength);
         }
         else
         {
@@ -2388,6 +2438,126 @@ namespace pdg
         };
     }
 
+    void SerializerWrap::CopyDataTo(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SerializerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SerializerWrap>(args.This());
+        Serializer* self = dynamic_cast<Serializer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "([object Buffer] out, number offset = 0)" " - " "") ); return; };
+        };
+        if (args.Length() < 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1, true);
+        REQUIRE_UINT8_ARRAY_ARG(1, out);
+        if (args.Length() >= 2 && !args[2 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 2, "a number (""offset"")");
+        unsigned long offset = (args.Length()<2) ? 0 : args[2 -1]->Uint32Value();;
+
+        uint32 dataSize = self->getDataSize();
+        if ((offset > outLength) || (dataSize > outLength - offset))
+        {
+            std::ostringstream excpt_;
+            excpt_ << "serialized data ("<<dataSize<<" bytes) doesn't fit in the buffer ("<<outLength<<" bytes) at offset "<<offset;
+            isolate->ThrowException( v8::Exception::RangeError( v8::String::NewFromUtf8(isolate, excpt_.str().c_str())));
+            dataSize = 0;
+        }
+        else
+        {
+            std::memcpy(out + offset, self->getDataPtr(), dataSize);
+        }
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, dataSize) ); return; };
+    }
+
+    void SerializerWrap::ReleaseBuffer(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SerializerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SerializerWrap>(args.This());
+        Serializer* self = dynamic_cast<Serializer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Buffer]" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+
+        size_t dataSize = 0;
+        uint8* data = self->releaseData(dataSize);
+        { args.GetReturnValue().Set( v8_NewBuffer(isolate, data, dataSize, true) ); return; };
+    }
+
+    void SerializerWrap::GetCapacity(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SerializerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SerializerWrap>(args.This());
+        Serializer* self = dynamic_cast<Serializer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        uint32 capacity = self->getCapacity();
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, capacity) ); return; };
+    }
+
+    void SerializerWrap::Reserve(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SerializerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SerializerWrap>(args.This());
+        Serializer* self = dynamic_cast<Serializer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(number bytes)" " - " "") ); return; };
+        };
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""bytes"")");
+        unsigned long bytes = args[1 -1]->Uint32Value();
+        self->reserve(bytes);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void SerializerWrap::Reset(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SerializerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SerializerWrap>(args.This());
+        Serializer* self = dynamic_cast<Serializer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        self->reset();
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void SerializerWrap::SetStreaming(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SerializerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SerializerWrap>(args.This());
+        Serializer* self = dynamic_cast<Serializer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "Serializer" " function" "(boolean streamIt)" " - " "") ); return; };
+        };
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        if (!args[1 -1]->IsBoolean())
+            v8_ThrowArgTypeException(isolate, 1, "a boolean (""streamIt"")");
+        bool streamIt = args[1 -1]->BooleanValue();
+        self->setStreaming(streamIt);
+        { args.GetReturnValue().Set( args.This() ); return; };
+    }
+
     void SerializerWrap::Sizeof_1(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
@@ -2832,7 +3002,7 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[number uint]" " function" "({[string Binary]|[object MemBlock]} mem)" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[number uint]" " function" "({[string Binary]|[object MemBlock]|[object Buffer]} mem)" " - " "") ); return; };
         };
         if (args.Length() != 1)
             v8_ThrowArgCountException(isolate, args.Length(), 1);
@@ -2840,7 +3010,7 @@ namespace pdg
         if (!isStr && !args[0]->IsObject())
         {
             std::ostringstream excpt_;
-            excpt_ << "argument 1 (mem) must be either a binary string or an object of type MemBlock";
+            excpt_ << "argument 1 (mem) must be a binary string, a Buffer or an object of type MemBlock";
             isolate->ThrowException( v8::Exception::TypeError( v8::String::NewFromUtf8(isolate, excpt_.str().c_str())));
         }
         size_t n = 0;
@@ -2849,6 +3019,12 @@ namespace pdg
             size_t bytes = 0;
             uint8* ptr = (uint8*) DecodeBinary(args[0], &bytes);
             n = self->sizeof_mem(ptr, bytes);
+            std::free(ptr);
+        }
+        else if (args[0]->IsUint8Array())
+        {
+            REQUIRE_UINT8_ARRAY_ARG(1, buffer);
+            n = self->sizeof_mem(buffer, bufferLength);
         }
         else
         {
@@ -3698,14 +3874,14 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "({[string Binary]|[object MemBlock]} data)" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "({[string Binary]|[object MemBlock]|[object Buffer]} data)" " - " "") ); return; };
         };
         if (args.Length() != 1)
             v8_ThrowArgCountException(isolate, args.Length(), 1);
         if (!args[0]->IsString() && !args[0]->IsObject())
         {
             std::ostringstream excpt_;
-            excpt_ << "argument 1 (mem) must be either a binary string or an object of type MemBlock";
+            excpt_ << "argument 1 (mem) must be a binary string, a Buffer or an object of type MemBlock";
             isolate->ThrowException( v8::Exception::TypeError( v8::String::NewFromUtf8(isolate, excpt_.str().c_str())));
         }
         if (args[0]->IsString())
@@ -3714,10 +3890,17 @@ namespace pdg
             uint8* ptr = (uint8*) DecodeBinary(args[0], &bytes);
             self->setDataPtr(ptr, bytes);
         }
+        else if (args[0]->IsUint8Array())
+        {
+            REQUIRE_UINT8_ARRAY_ARG(1, buffer);
+            args.This()->ForceSet(v8::String::NewFromUtf8(isolate, "_data", v8::String::kInternalizedString), args[0], v8::DontEnum);
+            self->setDataPtr(buffer, bufferLength, false);
+        }
         else
         {
             REQUIRE_CPP_OBJECT_ARG(1, memBlock, MemBlock);
-            self->setDataPtr(memBlock->ptr, memBlock->bytes);
+            args.This()->ForceSet(v8::String::NewFromUtf8(isolate, "_data", v8::String::kInternalizedString), args[0], v8::DontEnum);
+            self->setDataPtr(memBlock->ptr, memBlock->bytes, false);
         }
         args.GetReturnValue().SetUndefined();
     }
@@ -8608,12 +8791,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Point]" " function" "()") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Point]" " function" "({[object Point]|[object Float32Array]} out, [number int] outIndex = 0)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
-
         pdg::Point theLocation = self->getLocation();
+        if (args.Length() >= 1)
+        {
+            if (args.Length() >= 1+1 && !args[1+1 -1]->IsNumber())
+                v8_ThrowArgTypeException(isolate, 1+1, "a number (""outIndex_"")");
+            unsigned long outIndex_ = (args.Length()<1+1) ? 0 : args[1+1 -1]->Uint32Value();;
+            if (!v8_FillJavascriptOffset(isolate, theLocation, args[1 -1], outIndex_))
+                v8_ThrowArgTypeException(isolate, 1, "an object or a Float32Array with room for the result (out)");
+            { args.GetReturnValue().Set( args[1 -1] ); return; };
+        };
         { args.GetReturnValue().Set( v8_MakeJavascriptPoint(isolate, theLocation) ); return; };
     }
 
@@ -9015,11 +9204,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Rect]" " function" "()" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Rect]" " function" "({[object Rect]|[object Float32Array]} out, [number int] outIndex = 0)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
         pdg::Rect r = self->getBoundingBox();
+        if (args.Length() >= 1)
+        {
+            if (args.Length() >= 1+1 && !args[1+1 -1]->IsNumber())
+                v8_ThrowArgTypeException(isolate, 1+1, "a number (""outIndex_"")");
+            unsigned long outIndex_ = (args.Length()<1+1) ? 0 : args[1+1 -1]->Uint32Value();;
+            if (!v8_FillJavascriptRect(isolate, r, args[1 -1], outIndex_))
+                v8_ThrowArgTypeException(isolate, 1, "an object or a Float32Array with room for the result (out)");
+            { args.GetReturnValue().Set( args[1 -1] ); return; };
+        };
         { args.GetReturnValue().Set( v8_MakeJavascriptRect(isolate, r) ); return; };
     }
 
@@ -9244,12 +9440,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Vector]" " function" "()") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Vector]" " function" "({[object Vector]|[object Float32Array]} out, [number int] outIndex = 0)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
-
         pdg::Vector theVelocity = self->getVelocity();
+        if (args.Length() >= 1)
+        {
+            if (args.Length() >= 1+1 && !args[1+1 -1]->IsNumber())
+                v8_ThrowArgTypeException(isolate, 1+1, "a number (""outIndex_"")");
+            unsigned long outIndex_ = (args.Length()<1+1) ? 0 : args[1+1 -1]->Uint32Value();;
+            if (!v8_FillJavascriptOffset(isolate, theVelocity, args[1 -1], outIndex_))
+                v8_ThrowArgTypeException(isolate, 1, "an object or a Float32Array with room for the result (out)");
+            { args.GetReturnValue().Set( args[1 -1] ); return; };
+        };
         { args.GetReturnValue().Set( v8_MakeJavascriptVector(isolate, theVelocity) ); return; };
     }
 
@@ -12948,12 +13150,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Point]" " function" "()") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Point]" " function" "({[object Point]|[object Float32Array]} out, [number int] outIndex = 0)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
-
         pdg::Point theLocation = self->getLocation();
+        if (args.Length() >= 1)
+        {
+            if (args.Length() >= 1+1 && !args[1+1 -1]->IsNumber())
+                v8_ThrowArgTypeException(isolate, 1+1, "a number (""outIndex_"")");
+            unsigned long outIndex_ = (args.Length()<1+1) ? 0 : args[1+1 -1]->Uint32Value();;
+            if (!v8_FillJavascriptOffset(isolate, theLocation, args[1 -1], outIndex_))
+                v8_ThrowArgTypeException(isolate, 1, "an object or a Float32Array with room for the result (out)");
+            { args.GetReturnValue().Set( args[1 -1] ); return; };
+        };
         { args.GetReturnValue().Set( v8_MakeJavascriptPoint(isolate, theLocation) ); return; };
     }
 
@@ -13355,11 +13563,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Rect]" " function" "()" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Rect]" " function" "({[object Rect]|[object Float32Array]} out, [number int] outIndex = 0)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
         pdg::Rect r = self->getBoundingBox();
+        if (args.Length() >= 1)
+        {
+            if (args.Length() >= 1+1 && !args[1+1 -1]->IsNumber())
+                v8_ThrowArgTypeException(isolate, 1+1, "a number (""outIndex_"")");
+            unsigned long outIndex_ = (args.Length()<1+1) ? 0 : args[1+1 -1]->Uint32Value();;
+            if (!v8_FillJavascriptRect(isolate, r, args[1 -1], outIndex_))
+                v8_ThrowArgTypeException(isolate, 1, "an object or a Float32Array with room for the result (out)");
+            { args.GetReturnValue().Set( args[1 -1] ); return; };
+        };
         { args.GetReturnValue().Set( v8_MakeJavascriptRect(isolate, r) ); return; };
     }
 
@@ -13584,12 +13799,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Vector]" " function" "()") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Vector]" " function" "({[object Vector]|[object Float32Array]} out, [number int] outIndex = 0)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
-
         pdg::Vector theVelocity = self->getVelocity();
+        if (args.Length() >= 1)
+        {
+            if (args.Length() >= 1+1 && !args[1+1 -1]->IsNumber())
+                v8_ThrowArgTypeException(isolate, 1+1, "a number (""outIndex_"")");
+            unsigned long outIndex_ = (args.Length()<1+1) ? 0 : args[1+1 -1]->Uint32Value();;
+            if (!v8_FillJavascriptOffset(isolate, theVelocity, args[1 -1], outIndex_))
+                v8_ThrowArgTypeException(isolate, 1, "an object or a Float32Array with room for the result (out)");
+            { args.GetReturnValue().Set( args[1 -1] ); return; };
+        };
         { args.GetReturnValue().Set( v8_MakeJavascriptVector(isolate, theVelocity) ); return; };
     }
 
@@ -16269,6 +16490,38 @@ namespace pdg
         v8::Local<v8::FunctionTemplate> SetSerializationFlags_Tpl =
             v8::FunctionTemplate::New(isolate, SetSerializationFlags, v8::Local<v8::Value>(), SetSerializationFlags_Sig);
         t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setSerializationFlags", v8::String::kInternalizedString), SetSerializationFlags_Tpl);
+        v8::Local<v8::Signature> TakeSnapshot_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> TakeSnapshot_Tpl =
+            v8::FunctionTemplate::New(isolate, TakeSnapshot, v8::Local<v8::Value>(), TakeSnapshot_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "takeSnapshot", v8::String::kInternalizedString), TakeSnapshot_Tpl);
+        v8::Local<v8::Signature> SetSerializationBaseline_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetSerializationBaseline_Tpl =
+            v8::FunctionTemplate::New(isolate, SetSerializationBaseline, v8::Local<v8::Value>(), SetSerializationBaseline_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setSerializationBaseline", v8::String::kInternalizedString), SetSerializationBaseline_Tpl);
+        v8::Local<v8::Signature> GetLastSnapshotId_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetLastSnapshotId_Tpl =
+            v8::FunctionTemplate::New(isolate, GetLastSnapshotId, v8::Local<v8::Value>(), GetLastSnapshotId_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getLastSnapshotId", v8::String::kInternalizedString), GetLastSnapshotId_Tpl);
+        v8::Local<v8::Signature> AddObserver_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> AddObserver_Tpl =
+            v8::FunctionTemplate::New(isolate, AddObserver, v8::Local<v8::Value>(), AddObserver_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "addObserver", v8::String::kInternalizedString), AddObserver_Tpl);
+        v8::Local<v8::Signature> RemoveObserver_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> RemoveObserver_Tpl =
+            v8::FunctionTemplate::New(isolate, RemoveObserver, v8::Local<v8::Value>(), RemoveObserver_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "removeObserver", v8::String::kInternalizedString), RemoveObserver_Tpl);
+        v8::Local<v8::Signature> SetObserverArea_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetObserverArea_Tpl =
+            v8::FunctionTemplate::New(isolate, SetObserverArea, v8::Local<v8::Value>(), SetObserverArea_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setObserverArea", v8::String::kInternalizedString), SetObserverArea_Tpl);
+        v8::Local<v8::Signature> SetObserverRadius_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetObserverRadius_Tpl =
+            v8::FunctionTemplate::New(isolate, SetObserverRadius, v8::Local<v8::Value>(), SetObserverRadius_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setObserverRadius", v8::String::kInternalizedString), SetObserverRadius_Tpl);
+        v8::Local<v8::Signature> SetSerializationObserver_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetSerializationObserver_Tpl =
+            v8::FunctionTemplate::New(isolate, SetSerializationObserver, v8::Local<v8::Value>(), SetSerializationObserver_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setSerializationObserver", v8::String::kInternalizedString), SetSerializationObserver_Tpl);
         v8::Local<v8::Signature> StartAnimations_Sig = v8::Signature::New(isolate, t);
         v8::Local<v8::FunctionTemplate> StartAnimations_Tpl =
             v8::FunctionTemplate::New(isolate, StartAnimations, v8::Local<v8::Value>(), StartAnimations_Sig);
@@ -16317,6 +16570,10 @@ namespace pdg
         v8::Local<v8::FunctionTemplate> GetZOrder_Tpl =
             v8::FunctionTemplate::New(isolate, GetZOrder, v8::Local<v8::Value>(), GetZOrder_Sig);
         t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getZOrder", v8::String::kInternalizedString), GetZOrder_Tpl);
+        v8::Local<v8::Signature> GetWorld_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetWorld_Tpl =
+            v8::FunctionTemplate::New(isolate, GetWorld, v8::Local<v8::Value>(), GetWorld_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getWorld", v8::String::kInternalizedString), GetWorld_Tpl);
         v8::Local<v8::Signature> MoveWith_Sig = v8::Signature::New(isolate, t);
         v8::Local<v8::FunctionTemplate> MoveWith_Tpl =
             v8::FunctionTemplate::New(isolate, MoveWith, v8::Local<v8::Value>(), MoveWith_Sig);
@@ -16341,6 +16598,22 @@ namespace pdg
         v8::Local<v8::FunctionTemplate> HasSprite_Tpl =
             v8::FunctionTemplate::New(isolate, HasSprite, v8::Local<v8::Value>(), HasSprite_Sig);
         t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "hasSprite", v8::String::kInternalizedString), HasSprite_Tpl);
+        v8::Local<v8::Signature> GetSpriteStates_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetSpriteStates_Tpl =
+            v8::FunctionTemplate::New(isolate, GetSpriteStates, v8::Local<v8::Value>(), GetSpriteStates_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getSpriteStates", v8::String::kInternalizedString), GetSpriteStates_Tpl);
+        v8::Local<v8::Signature> GetSpriteStatesById_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetSpriteStatesById_Tpl =
+            v8::FunctionTemplate::New(isolate, GetSpriteStatesById, v8::Local<v8::Value>(), GetSpriteStatesById_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getSpriteStatesById", v8::String::kInternalizedString), GetSpriteStatesById_Tpl);
+        v8::Local<v8::Signature> SetSpriteStates_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetSpriteStates_Tpl =
+            v8::FunctionTemplate::New(isolate, SetSpriteStates, v8::Local<v8::Value>(), SetSpriteStates_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setSpriteStates", v8::String::kInternalizedString), SetSpriteStates_Tpl);
+        v8::Local<v8::Signature> SetSpriteStatesById_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetSpriteStatesById_Tpl =
+            v8::FunctionTemplate::New(isolate, SetSpriteStatesById, v8::Local<v8::Value>(), SetSpriteStatesById_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setSpriteStatesById", v8::String::kInternalizedString), SetSpriteStatesById_Tpl);
         v8::Local<v8::Signature> AddSprite_Sig = v8::Signature::New(isolate, t);
         v8::Local<v8::FunctionTemplate> AddSprite_Tpl =
             v8::FunctionTemplate::New(isolate, AddSprite, v8::Local<v8::Value>(), AddSprite_Sig);
@@ -16369,10 +16642,22 @@ namespace pdg
         v8::Local<v8::FunctionTemplate> DisableCollisionsWithLayer_Tpl =
             v8::FunctionTemplate::New(isolate, DisableCollisionsWithLayer, v8::Local<v8::Value>(), DisableCollisionsWithLayer_Sig);
         t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "disableCollisionsWithLayer", v8::String::kInternalizedString), DisableCollisionsWithLayer_Tpl);
+        v8::Local<v8::Signature> EnableCollisionGrid_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> EnableCollisionGrid_Tpl =
+            v8::FunctionTemplate::New(isolate, EnableCollisionGrid, v8::Local<v8::Value>(), EnableCollisionGrid_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "enableCollisionGrid", v8::String::kInternalizedString), EnableCollisionGrid_Tpl);
+        v8::Local<v8::Signature> DisableCollisionGrid_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> DisableCollisionGrid_Tpl =
+            v8::FunctionTemplate::New(isolate, DisableCollisionGrid, v8::Local<v8::Value>(), DisableCollisionGrid_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "disableCollisionGrid", v8::String::kInternalizedString), DisableCollisionGrid_Tpl);
         v8::Local<v8::Signature> CreateSprite_Sig = v8::Signature::New(isolate, t);
         v8::Local<v8::FunctionTemplate> CreateSprite_Tpl =
             v8::FunctionTemplate::New(isolate, CreateSprite, v8::Local<v8::Value>(), CreateSprite_Sig);
         t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "createSprite", v8::String::kInternalizedString), CreateSprite_Tpl);
+        v8::Local<v8::Signature> CloneSprite_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> CloneSprite_Tpl =
+            v8::FunctionTemplate::New(isolate, CloneSprite, v8::Local<v8::Value>(), CloneSprite_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "cloneSprite", v8::String::kInternalizedString), CloneSprite_Tpl);
 #ifndef PDG_NO_GUI
         v8::Local<v8::Signature> GetSpritePort_Sig = v8::Signature::New(isolate, t);
         v8::Local<v8::FunctionTemplate> GetSpritePort_Tpl =
@@ -16476,6 +16761,34 @@ namespace pdg
         v8::Local<v8::FunctionTemplate> SetDamping_Tpl =
             v8::FunctionTemplate::New(isolate, SetDamping, v8::Local<v8::Value>(), SetDamping_Sig);
         t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setDamping", v8::String::kInternalizedString), SetDamping_Tpl);
+        v8::Local<v8::Signature> SetPhysicsThreads_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetPhysicsThreads_Tpl =
+            v8::FunctionTemplate::New(isolate, SetPhysicsThreads, v8::Local<v8::Value>(), SetPhysicsThreads_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setPhysicsThreads", v8::String::kInternalizedString), SetPhysicsThreads_Tpl);
+        v8::Local<v8::Signature> GetPhysicsThreads_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetPhysicsThreads_Tpl =
+            v8::FunctionTemplate::New(isolate, GetPhysicsThreads, v8::Local<v8::Value>(), GetPhysicsThreads_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getPhysicsThreads", v8::String::kInternalizedString), GetPhysicsThreads_Tpl);
+        v8::Local<v8::Signature> GetPhysicsStepTime_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetPhysicsStepTime_Tpl =
+            v8::FunctionTemplate::New(isolate, GetPhysicsStepTime, v8::Local<v8::Value>(), GetPhysicsStepTime_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getPhysicsStepTime", v8::String::kInternalizedString), GetPhysicsStepTime_Tpl);
+        v8::Local<v8::Signature> SetFixedPhysicsStep_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetFixedPhysicsStep_Tpl =
+            v8::FunctionTemplate::New(isolate, SetFixedPhysicsStep, v8::Local<v8::Value>(), SetFixedPhysicsStep_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setFixedPhysicsStep", v8::String::kInternalizedString), SetFixedPhysicsStep_Tpl);
+        v8::Local<v8::Signature> GetFixedPhysicsStep_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetFixedPhysicsStep_Tpl =
+            v8::FunctionTemplate::New(isolate, GetFixedPhysicsStep, v8::Local<v8::Value>(), GetFixedPhysicsStep_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getFixedPhysicsStep", v8::String::kInternalizedString), GetFixedPhysicsStep_Tpl);
+        v8::Local<v8::Signature> SetPhysicsInterpolation_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetPhysicsInterpolation_Tpl =
+            v8::FunctionTemplate::New(isolate, SetPhysicsInterpolation, v8::Local<v8::Value>(), SetPhysicsInterpolation_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setPhysicsInterpolation", v8::String::kInternalizedString), SetPhysicsInterpolation_Tpl);
+        v8::Local<v8::Signature> GetPhysicsAlpha_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetPhysicsAlpha_Tpl =
+            v8::FunctionTemplate::New(isolate, GetPhysicsAlpha, v8::Local<v8::Value>(), GetPhysicsAlpha_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getPhysicsAlpha", v8::String::kInternalizedString), GetPhysicsAlpha_Tpl);
         v8::Local<v8::Signature> GetSpace_Sig = v8::Signature::New(isolate, t);
         v8::Local<v8::FunctionTemplate> GetSpace_Tpl =
             v8::FunctionTemplate::New(isolate, GetSpace, v8::Local<v8::Value>(), GetSpace_Sig);
@@ -16658,12 +16971,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Point]" " function" "()") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Point]" " function" "({[object Point]|[object Float32Array]} out, [number int] outIndex = 0)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
-
         pdg::Point theLocation = self->getLocation();
+        if (args.Length() >= 1)
+        {
+            if (args.Length() >= 1+1 && !args[1+1 -1]->IsNumber())
+                v8_ThrowArgTypeException(isolate, 1+1, "a number (""outIndex_"")");
+            unsigned long outIndex_ = (args.Length()<1+1) ? 0 : args[1+1 -1]->Uint32Value();;
+            if (!v8_FillJavascriptOffset(isolate, theLocation, args[1 -1], outIndex_))
+                v8_ThrowArgTypeException(isolate, 1, "an object or a Float32Array with room for the result (out)");
+            { args.GetReturnValue().Set( args[1 -1] ); return; };
+        };
         { args.GetReturnValue().Set( v8_MakeJavascriptPoint(isolate, theLocation) ); return; };
     }
 
@@ -17065,11 +17384,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Rect]" " function" "()" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Rect]" " function" "({[object Rect]|[object Float32Array]} out, [number int] outIndex = 0)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
         pdg::Rect r = self->getBoundingBox();
+        if (args.Length() >= 1)
+        {
+            if (args.Length() >= 1+1 && !args[1+1 -1]->IsNumber())
+                v8_ThrowArgTypeException(isolate, 1+1, "a number (""outIndex_"")");
+            unsigned long outIndex_ = (args.Length()<1+1) ? 0 : args[1+1 -1]->Uint32Value();;
+            if (!v8_FillJavascriptRect(isolate, r, args[1 -1], outIndex_))
+                v8_ThrowArgTypeException(isolate, 1, "an object or a Float32Array with room for the result (out)");
+            { args.GetReturnValue().Set( args[1 -1] ); return; };
+        };
         { args.GetReturnValue().Set( v8_MakeJavascriptRect(isolate, r) ); return; };
     }
 
@@ -17294,12 +17620,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Vector]" " function" "()") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Vector]" " function" "({[object Vector]|[object Float32Array]} out, [number int] outIndex = 0)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
-
         pdg::Vector theVelocity = self->getVelocity();
+        if (args.Length() >= 1)
+        {
+            if (args.Length() >= 1+1 && !args[1+1 -1]->IsNumber())
+                v8_ThrowArgTypeException(isolate, 1+1, "a number (""outIndex_"")");
+            unsigned long outIndex_ = (args.Length()<1+1) ? 0 : args[1+1 -1]->Uint32Value();;
+            if (!v8_FillJavascriptOffset(isolate, theVelocity, args[1 -1], outIndex_))
+                v8_ThrowArgTypeException(isolate, 1, "an object or a Float32Array with room for the result (out)");
+            { args.GetReturnValue().Set( args[1 -1] ); return; };
+        };
         { args.GetReturnValue().Set( v8_MakeJavascriptVector(isolate, theVelocity) ); return; };
     }
 
@@ -18554,7 +18886,7 @@ namespace pdg
         { args.GetReturnValue().Set( args.This() ); return; };
     }
 
-    void SpriteLayerWrap::StartAnimations(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void SpriteLayerWrap::TakeSnapshot(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
@@ -18562,15 +18894,16 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "") ); return; };
         };
+
         if (args.Length() != 0)
             v8_ThrowArgCountException(isolate, args.Length(), 0);
-        self->startAnimations();
-        args.GetReturnValue().SetUndefined();
+        uint32 snapshotId = self->takeSnapshot();
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, snapshotId) ); return; };
     }
 
-    void SpriteLayerWrap::StopAnimations(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void SpriteLayerWrap::SetSerializationBaseline(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
@@ -18578,15 +18911,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object SpriteLayer]" " function" "([number uint] baselineId)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
-        self->stopAnimations();
-        args.GetReturnValue().SetUndefined();
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""baselineId"")");
+        unsigned long baselineId = args[1 -1]->Uint32Value();
+        self->setSerializationBaseline(baselineId);
+        { args.GetReturnValue().Set( args.This() ); return; };
     }
 
-    void SpriteLayerWrap::Hide(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void SpriteLayerWrap::GetLastSnapshotId(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
@@ -18594,15 +18930,16 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "") ); return; };
         };
+
         if (args.Length() != 0)
             v8_ThrowArgCountException(isolate, args.Length(), 0);
-        self->hide();
-        args.GetReturnValue().SetUndefined();
+        uint32 snapshotId = self->getLastSnapshotId();
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, snapshotId) ); return; };
     }
 
-    void SpriteLayerWrap::Show(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void SpriteLayerWrap::AddObserver(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
@@ -18610,15 +18947,16 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "") ); return; };
         };
+
         if (args.Length() != 0)
             v8_ThrowArgCountException(isolate, args.Length(), 0);
-        self->show();
-        args.GetReturnValue().SetUndefined();
+        uint32 observerId = self->addObserver();
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, observerId) ); return; };
     }
 
-    void SpriteLayerWrap::IsHidden(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void SpriteLayerWrap::RemoveObserver(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
@@ -18626,15 +18964,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "boolean" " function" "()" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "([number uint] observerId)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
-        bool hidden = self->isHidden();
-        { args.GetReturnValue().Set( v8::Boolean::New(isolate, hidden) ); return; };
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""observerId"")");
+        unsigned long observerId = args[1 -1]->Uint32Value();
+        self->removeObserver(observerId);
+        args.GetReturnValue().SetUndefined();
     }
 
-    void SpriteLayerWrap::FadeIn(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void SpriteLayerWrap::SetObserverArea(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
@@ -18642,28 +18983,21 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "([number int] msDuration, [number int] easing = linearTween)" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object SpriteLayer]" " function" "([number uint] observerId, [object Rect] area)" " - " "") ); return; };
         };
-        if (args.Length() < 1)
-            v8_ThrowArgCountException(isolate, args.Length(), 1, true);
+        if (args.Length() != 2)
+            v8_ThrowArgCountException(isolate, args.Length(), 2);
         if (!args[1 -1]->IsNumber())
-            v8_ThrowArgTypeException(isolate, 1, "a number (""msDuration"")");
-        long msDuration = args[1 -1]->Int32Value();
-        if (args.Length() >= 2 && !args[2 -1]->IsNumber())
-            v8_ThrowArgTypeException(isolate, 2, "a number (""easing"")");
-        long easing = (args.Length()<2) ? EasingFuncRef::linearTween : args[2 -1]->Int32Value();;
-        if (easing >= 0 && easing < NUM_EASING_FUNCTIONS)
-        {
-            self->fadeIn(msDuration, gEasingFunctions[easing]);
-        }
-        else
-        {
-            self->fadeIn(msDuration);
-        }
-        args.GetReturnValue().SetUndefined();
+            v8_ThrowArgTypeException(isolate, 1, "a number (""observerId"")");
+        unsigned long observerId = args[1 -1]->Uint32Value();
+        if (!v8_ValueIsRect(isolate, args[2 -1]))
+            v8_ThrowArgTypeException(isolate, 2, "Rect", *args[2 -1]);
+        pdg::Rect area = v8_ValueToRect(isolate, args[2 -1]);
+        self->setObserverArea(observerId, area);
+        { args.GetReturnValue().Set( args.This() ); return; };
     }
 
-    void SpriteLayerWrap::FadeOut(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void SpriteLayerWrap::SetObserverRadius(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
@@ -18671,28 +19005,24 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "([number int] msDuration, [number int] easing = linearTween)" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object SpriteLayer]" " function" "([number uint] observerId, [object Point] center, number radius)" " - " "") ); return; };
         };
-        if (args.Length() < 1)
-            v8_ThrowArgCountException(isolate, args.Length(), 1, true);
+        if (args.Length() != 3)
+            v8_ThrowArgCountException(isolate, args.Length(), 3);
         if (!args[1 -1]->IsNumber())
-            v8_ThrowArgTypeException(isolate, 1, "a number (""msDuration"")");
-        long msDuration = args[1 -1]->Int32Value();
-        if (args.Length() >= 2 && !args[2 -1]->IsNumber())
-            v8_ThrowArgTypeException(isolate, 2, "a number (""easing"")");
-        long easing = (args.Length()<2) ? EasingFuncRef::linearTween : args[2 -1]->Int32Value();;
-        if (easing >= 0 && easing < NUM_EASING_FUNCTIONS)
-        {
-            self->fadeOut(msDuration, gEasingFunctions[easing]);
-        }
-        else
-        {
-            self->fadeOut(msDuration);
-        }
-        args.GetReturnValue().SetUndefined();
+            v8_ThrowArgTypeException(isolate, 1, "a number (""observerId"")");
+        unsigned long observerId = args[1 -1]->Uint32Value();
+        if (!v8_ValueIsPoint(isolate, args[2 -1]))
+            v8_ThrowArgTypeException(isolate, 2, "Point", *args[2 -1]);
+        pdg::Point center = v8_ValueToPoint(isolate, args[2 -1]);
+        if (!args[3 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 3, "a number (""radius"")");
+        double radius = args[3 -1]->NumberValue();
+        self->setObserverRadius(observerId, center, radius);
+        { args.GetReturnValue().Set( args.This() ); return; };
     }
 
-    void SpriteLayerWrap::MoveBehind(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void SpriteLayerWrap::SetSerializationObserver(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
@@ -18700,12 +19030,169 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "([object SpriteLayer] layer)" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object SpriteLayer]" " function" "([number uint] observerId)" " - " "") ); return; };
         };
         if (args.Length() != 1)
             v8_ThrowArgCountException(isolate, args.Length(), 1);
-        REQUIRE_CPP_OBJECT_ARG(1, layer, SpriteLayer);
-        self->moveBehind(layer);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""observerId"")");
+        unsigned long observerId = args[1 -1]->Uint32Value();
+        self->setSerializationObserver(observerId);
+        { args.GetReturnValue().Set( args.This() ); return; };
+    }
+
+    void SpriteLayerWrap::StartAnimations(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        self->startAnimations();
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void SpriteLayerWrap::StopAnimations(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        self->stopAnimations();
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void SpriteLayerWrap::Hide(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        self->hide();
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void SpriteLayerWrap::Show(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        self->show();
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void SpriteLayerWrap::IsHidden(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "boolean" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        bool hidden = self->isHidden();
+        { args.GetReturnValue().Set( v8::Boolean::New(isolate, hidden) ); return; };
+    }
+
+    void SpriteLayerWrap::FadeIn(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "([number int] msDuration, [number int] easing = linearTween)" " - " "") ); return; };
+        };
+        if (args.Length() < 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1, true);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""msDuration"")");
+        long msDuration = args[1 -1]->Int32Value();
+        if (args.Length() >= 2 && !args[2 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 2, "a number (""easing"")");
+        long easing = (args.Length()<2) ? EasingFuncRef::linearTween : args[2 -1]->Int32Value();;
+        if (easing >= 0 && easing < NUM_EASING_FUNCTIONS)
+        {
+            self->fadeIn(msDuration, gEasingFunctions[easing]);
+        }
+        else
+        {
+            self->fadeIn(msDuration);
+        }
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void SpriteLayerWrap::FadeOut(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "([number int] msDuration, [number int] easing = linearTween)" " - " "") ); return; };
+        };
+        if (args.Length() < 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1, true);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""msDuration"")");
+        long msDuration = args[1 -1]->Int32Value();
+        if (args.Length() >= 2 && !args[2 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 2, "a number (""easing"")");
+        long easing = (args.Length()<2) ? EasingFuncRef::linearTween : args[2 -1]->Int32Value();;
+        if (easing >= 0 && easing < NUM_EASING_FUNCTIONS)
+        {
+            self->fadeOut(msDuration, gEasingFunctions[easing]);
+        }
+        else
+        {
+            self->fadeOut(msDuration);
+        }
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void SpriteLayerWrap::MoveBehind(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "([object SpriteLayer] layer)" " - " "") ); return; };
+        };
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        REQUIRE_CPP_OBJECT_ARG(1, layer, SpriteLayer);
+        self->moveBehind(layer);
         args.GetReturnValue().SetUndefined();
     }
 
@@ -18815,6 +19302,34 @@ namespace pdg
         { args.GetReturnValue().Set( v8::Integer::New(isolate, zorder) ); return; };
     }
 
+    void SpriteLayerWrap::GetWorld(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object World]" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        World* world = self->getWorld();
+        if (!world)
+        {
+            args.GetReturnValue().SetNull(); return;
+        }
+        if (world->mWorldScriptObj.IsEmpty())
+        {
+            { args.GetReturnValue().Set( WorldWrap::NewFromCpp(isolate, world) ); return; };
+        }
+        else
+        {
+            v8::Local<v8::Object> obj__ = v8::Local<v8::Object>::New(isolate, world->mWorldScriptObj );
+            { args.GetReturnValue().Set( obj__ ); return; };
+        };
+    }
+
     void SpriteLayerWrap::GetSpriteZOrder(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
@@ -18905,6 +19420,83 @@ namespace pdg
         { args.GetReturnValue().Set( v8::Boolean::New(isolate, found) ); return; };
     }
 
+    void SpriteLayerWrap::GetSpriteStates(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "([object Float32Array] outStates, [object Uint32Array] outIids)" " - " "") ); return; };
+        };
+        if (args.Length() < 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1, true);
+        REQUIRE_FLOAT32_ARRAY_ARG(1, outStates);
+        OPTIONAL_UINT32_ARRAY_ARG(2, outIids);
+        uint32 maxSprites = outStatesLength / spriteState_Size;
+        if (outIids && (outIidsLength < maxSprites)) maxSprites = outIidsLength;
+        uint32 count = self->getSpriteStates(outStates, maxSprites, outIids);
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, count) ); return; };
+    }
+
+    void SpriteLayerWrap::GetSpriteStatesById(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "([object Uint32Array] iids, [object Float32Array] outStates)" " - " "") ); return; };
+        };
+        if (args.Length() != 2)
+            v8_ThrowArgCountException(isolate, args.Length(), 2);
+        REQUIRE_UINT32_ARRAY_ARG(1, iids);
+        REQUIRE_FLOAT32_ARRAY_ARG(2, outStates);
+        uint32 numIids = iidsLength;
+        if (numIids > outStatesLength / spriteState_Size) numIids = outStatesLength / spriteState_Size;
+        uint32 count = self->getSpriteStates(iids, numIids, outStates);
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, count) ); return; };
+    }
+
+    void SpriteLayerWrap::SetSpriteStates(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "([object Float32Array] states)" " - " "") ); return; };
+        };
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        REQUIRE_FLOAT32_ARRAY_ARG(1, states);
+        uint32 count = self->setSpriteStates(states, statesLength / spriteState_Size);
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, count) ); return; };
+    }
+
+    void SpriteLayerWrap::SetSpriteStatesById(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "([object Uint32Array] iids, [object Float32Array] states)" " - " "") ); return; };
+        };
+        if (args.Length() != 2)
+            v8_ThrowArgCountException(isolate, args.Length(), 2);
+        REQUIRE_UINT32_ARRAY_ARG(1, iids);
+        REQUIRE_FLOAT32_ARRAY_ARG(2, states);
+        uint32 numIids = iidsLength;
+        if (numIids > statesLength / spriteState_Size) numIids = statesLength / spriteState_Size;
+        uint32 count = self->setSpriteStates(iids, numIids, states);
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, count) ); return; };
+    }
+
     void SpriteLayerWrap::AddSprite(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
@@ -19021,6 +19613,39 @@ namespace pdg
         args.GetReturnValue().SetUndefined();
     }
 
+    void SpriteLayerWrap::EnableCollisionGrid(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(number cellSize = 64)" " - " "use a grid to find potential sprite collisions") ); return; };
+        };
+        if (args.Length() >= 1 && !args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""cellSize"")");
+        double cellSize = (args.Length()<1) ? 64.0f : args[1 -1]->NumberValue();;
+        self->enableCollisionGrid(cellSize);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void SpriteLayerWrap::DisableCollisionGrid(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        self->disableCollisionGrid();
+        args.GetReturnValue().SetUndefined();
+    }
+
     void SpriteLayerWrap::CreateSprite(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
@@ -19046,9 +19671,7 @@ namespace pdg
         };
     }
 
-#ifdef PDG_USE_CHIPMUNK_PHYSICS
-
-    void SpriteLayerWrap::SetKeepGravityDownward(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void SpriteLayerWrap::CloneSprite(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
@@ -19056,10 +19679,38 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(boolean keepItDownward = true)" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "CR [object Sprite]" " function" "([object Sprite] originalSprite)" " - " "make a new sprite with the same frames and settings as another") ); return; };
         };
-        if (args.Length() >= 1 && !args[1 -1]->IsBoolean())
-            v8_ThrowArgTypeException(isolate, 1, "a boolean (""keepItDownward"")");
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        REQUIRE_CPP_OBJECT_ARG(1, originalSprite, Sprite);
+        Sprite* sprite = self->cloneSprite(originalSprite);
+        if (!sprite) args.GetReturnValue().SetNull();
+        if (sprite->mSpriteScriptObj.IsEmpty())
+        {
+            { args.GetReturnValue().Set( SpriteWrap::NewFromCpp(isolate, sprite) ); return; };
+        }
+        else
+        {
+            v8::Local<v8::Object> obj__ = v8::Local<v8::Object>::New(isolate, sprite->mSpriteScriptObj );
+            { args.GetReturnValue().Set( obj__ ); return; };
+        };
+    }
+
+#ifdef PDG_USE_CHIPMUNK_PHYSICS
+
+    void SpriteLayerWrap::SetKeepGravityDownward(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(boolean keepItDownward = true)" " - " "") ); return; };
+        };
+        if (args.Length() >= 1 && !args[1 -1]->IsBoolean())
+            v8_ThrowArgTypeException(isolate, 1, "a boolean (""keepItDownward"")");
         bool keepItDownward = (args.Length()<1) ? true : args[1 -1]->BooleanValue();;
         self->setKeepGravityDownward(keepItDownward);
         args.GetReturnValue().SetUndefined();
@@ -19106,6 +19757,124 @@ namespace pdg
         args.GetReturnValue().SetUndefined();
     }
 
+    void SpriteLayerWrap::SetPhysicsThreads(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(number numThreads)" " - " "applies to all layers in the world") ); return; };
+        };
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""numThreads"")");
+        unsigned long numThreads = args[1 -1]->Uint32Value();
+        self->setPhysicsThreads(numThreads);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void SpriteLayerWrap::GetPhysicsThreads(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, self->getPhysicsThreads()) ); return; };
+    }
+
+    void SpriteLayerWrap::GetPhysicsStepTime(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "how long the last physics step took, in milliseconds") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        { args.GetReturnValue().Set( v8::Number::New(isolate, self->getPhysicsStepTime()) ); return; };
+    }
+
+    void SpriteLayerWrap::SetFixedPhysicsStep(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(number stepMs, number maxStepsPerTick = 8)" " - " "0 to step once per tick, applies to all layers in the world") ); return; };
+        };
+        if (args.Length() < 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1, true);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""stepMs"")");
+        double stepMs = args[1 -1]->NumberValue();
+        if (args.Length() >= 2 && !args[2 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 2, "a number (""maxStepsPerTick"")");
+        unsigned long maxStepsPerTick = (args.Length()<2) ? 8 : args[2 -1]->Uint32Value();
+        self->setFixedPhysicsStep(stepMs, maxStepsPerTick);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void SpriteLayerWrap::GetFixedPhysicsStep(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        { args.GetReturnValue().Set( v8::Number::New(isolate, self->getFixedPhysicsStep()) ); return; };
+    }
+
+    void SpriteLayerWrap::SetPhysicsInterpolation(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(boolean interpolate = true)" " - " "") ); return; };
+        };
+        if (args.Length() >= 1 && !args[1 -1]->IsBoolean())
+            v8_ThrowArgTypeException(isolate, 1, "a boolean (""interpolate"")");
+        bool interpolate = (args.Length()<1) ? true : args[1 -1]->BooleanValue();;
+        self->setPhysicsInterpolation(interpolate);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void SpriteLayerWrap::GetPhysicsAlpha(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        SpriteLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<SpriteLayerWrap>(args.This());
+        SpriteLayer* self = dynamic_cast<SpriteLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "how far the physics is toward its next fixed step, 0 to 1") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        { args.GetReturnValue().Set( v8::Number::New(isolate, self->getPhysicsAlpha()) ); return; };
+    }
+
     void SpriteLayerWrap::SetStaticLayer(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
@@ -19394,6 +20163,94 @@ namespace pdg
         };
     }
 
+
+    void CreateWorld(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object World]" " function" "([number uint] tickIntervalMs = 10)" " - " "") ); return; };
+        };
+        if (args.Length() >= 1 && !args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""tickIntervalMs"")");
+        unsigned long tickIntervalMs = (args.Length()<1) ? WORLD_DEFAULT_TICK_INTERVAL_MS : args[1 -1]->Uint32Value();;
+        World* world = createWorld(tickIntervalMs);
+        if (!world) args.GetReturnValue().SetNull();
+        if (world->mWorldScriptObj.IsEmpty())
+        {
+            { args.GetReturnValue().Set( WorldWrap::NewFromCpp(isolate, world) ); return; };
+        }
+        else
+        {
+            v8::Local<v8::Object> obj__ = v8::Local<v8::Object>::New(isolate, world->mWorldScriptObj );
+            { args.GetReturnValue().Set( obj__ ); return; };
+        };
+    }
+
+    void GetDefaultWorld(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object World]" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        World* world = getDefaultWorld();
+        if (!world) args.GetReturnValue().SetNull();
+        if (world->mWorldScriptObj.IsEmpty())
+        {
+            { args.GetReturnValue().Set( WorldWrap::NewFromCpp(isolate, world) ); return; };
+        }
+        else
+        {
+            v8::Local<v8::Object> obj__ = v8::Local<v8::Object>::New(isolate, world->mWorldScriptObj );
+            { args.GetReturnValue().Set( obj__ ); return; };
+        };
+    }
+
+    void CleanupWorld(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "([object World] world)" " - " "also cleans up every layer in the world") ); return; };
+        };
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        REQUIRE_CPP_OBJECT_ARG(1, world, World);
+        cleanupWorld(world);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void SetWorldThreads(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "([number uint] numThreads)" " - " "threads besides the main one that tick threaded worlds, 0 for one per core") ); return; };
+        };
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""numThreads"")");
+        unsigned long numThreads = args[1 -1]->Uint32Value();
+        setWorldThreads(numThreads);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void GetWorldThreads(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[number uint]" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, getWorldThreads()) ); return; };
+    }
+
     ;
     ;
 
@@ -19685,6 +20542,38 @@ namespace pdg
         v8::Local<v8::FunctionTemplate> SetSerializationFlags_Tpl =
             v8::FunctionTemplate::New(isolate, SetSerializationFlags, v8::Local<v8::Value>(), SetSerializationFlags_Sig);
         t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setSerializationFlags", v8::String::kInternalizedString), SetSerializationFlags_Tpl);
+        v8::Local<v8::Signature> TakeSnapshot_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> TakeSnapshot_Tpl =
+            v8::FunctionTemplate::New(isolate, TakeSnapshot, v8::Local<v8::Value>(), TakeSnapshot_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "takeSnapshot", v8::String::kInternalizedString), TakeSnapshot_Tpl);
+        v8::Local<v8::Signature> SetSerializationBaseline_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetSerializationBaseline_Tpl =
+            v8::FunctionTemplate::New(isolate, SetSerializationBaseline, v8::Local<v8::Value>(), SetSerializationBaseline_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setSerializationBaseline", v8::String::kInternalizedString), SetSerializationBaseline_Tpl);
+        v8::Local<v8::Signature> GetLastSnapshotId_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetLastSnapshotId_Tpl =
+            v8::FunctionTemplate::New(isolate, GetLastSnapshotId, v8::Local<v8::Value>(), GetLastSnapshotId_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getLastSnapshotId", v8::String::kInternalizedString), GetLastSnapshotId_Tpl);
+        v8::Local<v8::Signature> AddObserver_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> AddObserver_Tpl =
+            v8::FunctionTemplate::New(isolate, AddObserver, v8::Local<v8::Value>(), AddObserver_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "addObserver", v8::String::kInternalizedString), AddObserver_Tpl);
+        v8::Local<v8::Signature> RemoveObserver_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> RemoveObserver_Tpl =
+            v8::FunctionTemplate::New(isolate, RemoveObserver, v8::Local<v8::Value>(), RemoveObserver_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "removeObserver", v8::String::kInternalizedString), RemoveObserver_Tpl);
+        v8::Local<v8::Signature> SetObserverArea_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetObserverArea_Tpl =
+            v8::FunctionTemplate::New(isolate, SetObserverArea, v8::Local<v8::Value>(), SetObserverArea_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setObserverArea", v8::String::kInternalizedString), SetObserverArea_Tpl);
+        v8::Local<v8::Signature> SetObserverRadius_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetObserverRadius_Tpl =
+            v8::FunctionTemplate::New(isolate, SetObserverRadius, v8::Local<v8::Value>(), SetObserverRadius_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setObserverRadius", v8::String::kInternalizedString), SetObserverRadius_Tpl);
+        v8::Local<v8::Signature> SetSerializationObserver_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetSerializationObserver_Tpl =
+            v8::FunctionTemplate::New(isolate, SetSerializationObserver, v8::Local<v8::Value>(), SetSerializationObserver_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setSerializationObserver", v8::String::kInternalizedString), SetSerializationObserver_Tpl);
         v8::Local<v8::Signature> StartAnimations_Sig = v8::Signature::New(isolate, t);
         v8::Local<v8::FunctionTemplate> StartAnimations_Tpl =
             v8::FunctionTemplate::New(isolate, StartAnimations, v8::Local<v8::Value>(), StartAnimations_Sig);
@@ -19733,6 +20622,10 @@ namespace pdg
         v8::Local<v8::FunctionTemplate> GetZOrder_Tpl =
             v8::FunctionTemplate::New(isolate, GetZOrder, v8::Local<v8::Value>(), GetZOrder_Sig);
         t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getZOrder", v8::String::kInternalizedString), GetZOrder_Tpl);
+        v8::Local<v8::Signature> GetWorld_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetWorld_Tpl =
+            v8::FunctionTemplate::New(isolate, GetWorld, v8::Local<v8::Value>(), GetWorld_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getWorld", v8::String::kInternalizedString), GetWorld_Tpl);
         v8::Local<v8::Signature> MoveWith_Sig = v8::Signature::New(isolate, t);
         v8::Local<v8::FunctionTemplate> MoveWith_Tpl =
             v8::FunctionTemplate::New(isolate, MoveWith, v8::Local<v8::Value>(), MoveWith_Sig);
@@ -19757,6 +20650,22 @@ namespace pdg
         v8::Local<v8::FunctionTemplate> HasSprite_Tpl =
             v8::FunctionTemplate::New(isolate, HasSprite, v8::Local<v8::Value>(), HasSprite_Sig);
         t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "hasSprite", v8::String::kInternalizedString), HasSprite_Tpl);
+        v8::Local<v8::Signature> GetSpriteStates_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetSpriteStates_Tpl =
+            v8::FunctionTemplate::New(isolate, GetSpriteStates, v8::Local<v8::Value>(), GetSpriteStates_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getSpriteStates", v8::String::kInternalizedString), GetSpriteStates_Tpl);
+        v8::Local<v8::Signature> GetSpriteStatesById_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetSpriteStatesById_Tpl =
+            v8::FunctionTemplate::New(isolate, GetSpriteStatesById, v8::Local<v8::Value>(), GetSpriteStatesById_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getSpriteStatesById", v8::String::kInternalizedString), GetSpriteStatesById_Tpl);
+        v8::Local<v8::Signature> SetSpriteStates_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetSpriteStates_Tpl =
+            v8::FunctionTemplate::New(isolate, SetSpriteStates, v8::Local<v8::Value>(), SetSpriteStates_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setSpriteStates", v8::String::kInternalizedString), SetSpriteStates_Tpl);
+        v8::Local<v8::Signature> SetSpriteStatesById_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetSpriteStatesById_Tpl =
+            v8::FunctionTemplate::New(isolate, SetSpriteStatesById, v8::Local<v8::Value>(), SetSpriteStatesById_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setSpriteStatesById", v8::String::kInternalizedString), SetSpriteStatesById_Tpl);
         v8::Local<v8::Signature> AddSprite_Sig = v8::Signature::New(isolate, t);
         v8::Local<v8::FunctionTemplate> AddSprite_Tpl =
             v8::FunctionTemplate::New(isolate, AddSprite, v8::Local<v8::Value>(), AddSprite_Sig);
@@ -19785,10 +20694,22 @@ namespace pdg
         v8::Local<v8::FunctionTemplate> DisableCollisionsWithLayer_Tpl =
             v8::FunctionTemplate::New(isolate, DisableCollisionsWithLayer, v8::Local<v8::Value>(), DisableCollisionsWithLayer_Sig);
         t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "disableCollisionsWithLayer", v8::String::kInternalizedString), DisableCollisionsWithLayer_Tpl);
+        v8::Local<v8::Signature> EnableCollisionGrid_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> EnableCollisionGrid_Tpl =
+            v8::FunctionTemplate::New(isolate, EnableCollisionGrid, v8::Local<v8::Value>(), EnableCollisionGrid_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "enableCollisionGrid", v8::String::kInternalizedString), EnableCollisionGrid_Tpl);
+        v8::Local<v8::Signature> DisableCollisionGrid_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> DisableCollisionGrid_Tpl =
+            v8::FunctionTemplate::New(isolate, DisableCollisionGrid, v8::Local<v8::Value>(), DisableCollisionGrid_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "disableCollisionGrid", v8::String::kInternalizedString), DisableCollisionGrid_Tpl);
         v8::Local<v8::Signature> CreateSprite_Sig = v8::Signature::New(isolate, t);
         v8::Local<v8::FunctionTemplate> CreateSprite_Tpl =
             v8::FunctionTemplate::New(isolate, CreateSprite, v8::Local<v8::Value>(), CreateSprite_Sig);
         t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "createSprite", v8::String::kInternalizedString), CreateSprite_Tpl);
+        v8::Local<v8::Signature> CloneSprite_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> CloneSprite_Tpl =
+            v8::FunctionTemplate::New(isolate, CloneSprite, v8::Local<v8::Value>(), CloneSprite_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "cloneSprite", v8::String::kInternalizedString), CloneSprite_Tpl);
 #ifndef PDG_NO_GUI
         v8::Local<v8::Signature> GetSpritePort_Sig = v8::Signature::New(isolate, t);
         v8::Local<v8::FunctionTemplate> GetSpritePort_Tpl =
@@ -19892,6 +20813,34 @@ namespace pdg
         v8::Local<v8::FunctionTemplate> SetDamping_Tpl =
             v8::FunctionTemplate::New(isolate, SetDamping, v8::Local<v8::Value>(), SetDamping_Sig);
         t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setDamping", v8::String::kInternalizedString), SetDamping_Tpl);
+        v8::Local<v8::Signature> SetPhysicsThreads_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetPhysicsThreads_Tpl =
+            v8::FunctionTemplate::New(isolate, SetPhysicsThreads, v8::Local<v8::Value>(), SetPhysicsThreads_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setPhysicsThreads", v8::String::kInternalizedString), SetPhysicsThreads_Tpl);
+        v8::Local<v8::Signature> GetPhysicsThreads_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetPhysicsThreads_Tpl =
+            v8::FunctionTemplate::New(isolate, GetPhysicsThreads, v8::Local<v8::Value>(), GetPhysicsThreads_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getPhysicsThreads", v8::String::kInternalizedString), GetPhysicsThreads_Tpl);
+        v8::Local<v8::Signature> GetPhysicsStepTime_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetPhysicsStepTime_Tpl =
+            v8::FunctionTemplate::New(isolate, GetPhysicsStepTime, v8::Local<v8::Value>(), GetPhysicsStepTime_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getPhysicsStepTime", v8::String::kInternalizedString), GetPhysicsStepTime_Tpl);
+        v8::Local<v8::Signature> SetFixedPhysicsStep_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetFixedPhysicsStep_Tpl =
+            v8::FunctionTemplate::New(isolate, SetFixedPhysicsStep, v8::Local<v8::Value>(), SetFixedPhysicsStep_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setFixedPhysicsStep", v8::String::kInternalizedString), SetFixedPhysicsStep_Tpl);
+        v8::Local<v8::Signature> GetFixedPhysicsStep_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetFixedPhysicsStep_Tpl =
+            v8::FunctionTemplate::New(isolate, GetFixedPhysicsStep, v8::Local<v8::Value>(), GetFixedPhysicsStep_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getFixedPhysicsStep", v8::String::kInternalizedString), GetFixedPhysicsStep_Tpl);
+        v8::Local<v8::Signature> SetPhysicsInterpolation_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetPhysicsInterpolation_Tpl =
+            v8::FunctionTemplate::New(isolate, SetPhysicsInterpolation, v8::Local<v8::Value>(), SetPhysicsInterpolation_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setPhysicsInterpolation", v8::String::kInternalizedString), SetPhysicsInterpolation_Tpl);
+        v8::Local<v8::Signature> GetPhysicsAlpha_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetPhysicsAlpha_Tpl =
+            v8::FunctionTemplate::New(isolate, GetPhysicsAlpha, v8::Local<v8::Value>(), GetPhysicsAlpha_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getPhysicsAlpha", v8::String::kInternalizedString), GetPhysicsAlpha_Tpl);
         v8::Local<v8::Signature> GetSpace_Sig = v8::Signature::New(isolate, t);
         v8::Local<v8::FunctionTemplate> GetSpace_Tpl =
             v8::FunctionTemplate::New(isolate, GetSpace, v8::Local<v8::Value>(), GetSpace_Sig);
@@ -19945,6 +20894,24 @@ namespace pdg
         v8::Local<v8::FunctionTemplate> CheckCollision_Tpl =
             v8::FunctionTemplate::New(isolate, CheckCollision, v8::Local<v8::Value>(), CheckCollision_Sig);
         t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "checkCollision", v8::String::kInternalizedString), CheckCollision_Tpl);
+ #ifdef PDG_USE_CHIPMUNK_PHYSICS
+        v8::Local<v8::Signature> EnableStaticCollisions_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> EnableStaticCollisions_Tpl =
+            v8::FunctionTemplate::New(isolate, EnableStaticCollisions, v8::Local<v8::Value>(), EnableStaticCollisions_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "enableStaticCollisions", v8::String::kInternalizedString), EnableStaticCollisions_Tpl);
+        v8::Local<v8::Signature> DisableStaticCollisions_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> DisableStaticCollisions_Tpl =
+            v8::FunctionTemplate::New(isolate, DisableStaticCollisions, v8::Local<v8::Value>(), DisableStaticCollisions_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "disableStaticCollisions", v8::String::kInternalizedString), DisableStaticCollisions_Tpl);
+        v8::Local<v8::Signature> UpdateStaticCollisions_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> UpdateStaticCollisions_Tpl =
+            v8::FunctionTemplate::New(isolate, UpdateStaticCollisions, v8::Local<v8::Value>(), UpdateStaticCollisions_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "updateStaticCollisions", v8::String::kInternalizedString), UpdateStaticCollisions_Tpl);
+        v8::Local<v8::Signature> GetStaticShapeCount_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetStaticShapeCount_Tpl =
+            v8::FunctionTemplate::New(isolate, GetStaticShapeCount, v8::Local<v8::Value>(), GetStaticShapeCount_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getStaticShapeCount", v8::String::kInternalizedString), GetStaticShapeCount_Tpl);
+ #endif
         target->Set(v8::String::NewFromUtf8(isolate, "TileLayer", v8::String::kInternalizedString), t->GetFunction());
 
     }
@@ -20108,12 +21075,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Point]" " function" "()") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Point]" " function" "({[object Point]|[object Float32Array]} out, [number int] outIndex = 0)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
-
         pdg::Point theLocation = self->getLocation();
+        if (args.Length() >= 1)
+        {
+            if (args.Length() >= 1+1 && !args[1+1 -1]->IsNumber())
+                v8_ThrowArgTypeException(isolate, 1+1, "a number (""outIndex_"")");
+            unsigned long outIndex_ = (args.Length()<1+1) ? 0 : args[1+1 -1]->Uint32Value();;
+            if (!v8_FillJavascriptOffset(isolate, theLocation, args[1 -1], outIndex_))
+                v8_ThrowArgTypeException(isolate, 1, "an object or a Float32Array with room for the result (out)");
+            { args.GetReturnValue().Set( args[1 -1] ); return; };
+        };
         { args.GetReturnValue().Set( v8_MakeJavascriptPoint(isolate, theLocation) ); return; };
     }
 
@@ -20515,11 +21488,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Rect]" " function" "()" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Rect]" " function" "({[object Rect]|[object Float32Array]} out, [number int] outIndex = 0)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
         pdg::Rect r = self->getBoundingBox();
+        if (args.Length() >= 1)
+        {
+            if (args.Length() >= 1+1 && !args[1+1 -1]->IsNumber())
+                v8_ThrowArgTypeException(isolate, 1+1, "a number (""outIndex_"")");
+            unsigned long outIndex_ = (args.Length()<1+1) ? 0 : args[1+1 -1]->Uint32Value();;
+            if (!v8_FillJavascriptRect(isolate, r, args[1 -1], outIndex_))
+                v8_ThrowArgTypeException(isolate, 1, "an object or a Float32Array with room for the result (out)");
+            { args.GetReturnValue().Set( args[1 -1] ); return; };
+        };
         { args.GetReturnValue().Set( v8_MakeJavascriptRect(isolate, r) ); return; };
     }
 
@@ -20744,12 +21724,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Vector]" " function" "()") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object Vector]" " function" "({[object Vector]|[object Float32Array]} out, [number int] outIndex = 0)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
-
         pdg::Vector theVelocity = self->getVelocity();
+        if (args.Length() >= 1)
+        {
+            if (args.Length() >= 1+1 && !args[1+1 -1]->IsNumber())
+                v8_ThrowArgTypeException(isolate, 1+1, "a number (""outIndex_"")");
+            unsigned long outIndex_ = (args.Length()<1+1) ? 0 : args[1+1 -1]->Uint32Value();;
+            if (!v8_FillJavascriptOffset(isolate, theVelocity, args[1 -1], outIndex_))
+                v8_ThrowArgTypeException(isolate, 1, "an object or a Float32Array with room for the result (out)");
+            { args.GetReturnValue().Set( args[1 -1] ); return; };
+        };
         { args.GetReturnValue().Set( v8_MakeJavascriptVector(isolate, theVelocity) ); return; };
     }
 
@@ -21909,7 +22895,7 @@ namespace pdg
         { args.GetReturnValue().Set( args.This() ); return; };
     }
 
-    void TileLayerWrap::StartAnimations(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void TileLayerWrap::TakeSnapshot(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
@@ -21917,15 +22903,16 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "") ); return; };
         };
+
         if (args.Length() != 0)
             v8_ThrowArgCountException(isolate, args.Length(), 0);
-        self->startAnimations();
-        args.GetReturnValue().SetUndefined();
+        uint32 snapshotId = self->takeSnapshot();
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, snapshotId) ); return; };
     }
 
-    void TileLayerWrap::StopAnimations(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void TileLayerWrap::SetSerializationBaseline(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
@@ -21933,15 +22920,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object SpriteLayer]" " function" "([number uint] baselineId)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
-        self->stopAnimations();
-        args.GetReturnValue().SetUndefined();
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""baselineId"")");
+        unsigned long baselineId = args[1 -1]->Uint32Value();
+        self->setSerializationBaseline(baselineId);
+        { args.GetReturnValue().Set( args.This() ); return; };
     }
 
-    void TileLayerWrap::Hide(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void TileLayerWrap::GetLastSnapshotId(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
@@ -21949,15 +22939,16 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "") ); return; };
         };
+
         if (args.Length() != 0)
             v8_ThrowArgCountException(isolate, args.Length(), 0);
-        self->hide();
-        args.GetReturnValue().SetUndefined();
+        uint32 snapshotId = self->getLastSnapshotId();
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, snapshotId) ); return; };
     }
 
-    void TileLayerWrap::Show(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void TileLayerWrap::AddObserver(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
@@ -21965,15 +22956,35 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "") ); return; };
         };
+
         if (args.Length() != 0)
             v8_ThrowArgCountException(isolate, args.Length(), 0);
-        self->show();
+        uint32 observerId = self->addObserver();
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, observerId) ); return; };
+    }
+
+    void TileLayerWrap::RemoveObserver(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "([number uint] observerId)" " - " "") ); return; };
+        };
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""observerId"")");
+        unsigned long observerId = args[1 -1]->Uint32Value();
+        self->removeObserver(observerId);
         args.GetReturnValue().SetUndefined();
     }
 
-    void TileLayerWrap::IsHidden(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void TileLayerWrap::SetObserverArea(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
@@ -21981,15 +22992,21 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "boolean" " function" "()" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object SpriteLayer]" " function" "([number uint] observerId, [object Rect] area)" " - " "") ); return; };
         };
-        if (args.Length() != 0)
-            v8_ThrowArgCountException(isolate, args.Length(), 0);
-        bool hidden = self->isHidden();
-        { args.GetReturnValue().Set( v8::Boolean::New(isolate, hidden) ); return; };
+        if (args.Length() != 2)
+            v8_ThrowArgCountException(isolate, args.Length(), 2);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""observerId"")");
+        unsigned long observerId = args[1 -1]->Uint32Value();
+        if (!v8_ValueIsRect(isolate, args[2 -1]))
+            v8_ThrowArgTypeException(isolate, 2, "Rect", *args[2 -1]);
+        pdg::Rect area = v8_ValueToRect(isolate, args[2 -1]);
+        self->setObserverArea(observerId, area);
+        { args.GetReturnValue().Set( args.This() ); return; };
     }
 
-    void TileLayerWrap::FadeIn(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void TileLayerWrap::SetObserverRadius(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
@@ -21997,13 +23014,137 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "([number int] msDuration, [number int] easing = linearTween)" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object SpriteLayer]" " function" "([number uint] observerId, [object Point] center, number radius)" " - " "") ); return; };
         };
-        if (args.Length() < 1)
-            v8_ThrowArgCountException(isolate, args.Length(), 1, true);
+        if (args.Length() != 3)
+            v8_ThrowArgCountException(isolate, args.Length(), 3);
         if (!args[1 -1]->IsNumber())
-            v8_ThrowArgTypeException(isolate, 1, "a number (""msDuration"")");
-        long msDuration = args[1 -1]->Int32Value();
+            v8_ThrowArgTypeException(isolate, 1, "a number (""observerId"")");
+        unsigned long observerId = args[1 -1]->Uint32Value();
+        if (!v8_ValueIsPoint(isolate, args[2 -1]))
+            v8_ThrowArgTypeException(isolate, 2, "Point", *args[2 -1]);
+        pdg::Point center = v8_ValueToPoint(isolate, args[2 -1]);
+        if (!args[3 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 3, "a number (""radius"")");
+        double radius = args[3 -1]->NumberValue();
+        self->setObserverRadius(observerId, center, radius);
+        { args.GetReturnValue().Set( args.This() ); return; };
+    }
+
+    void TileLayerWrap::SetSerializationObserver(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object SpriteLayer]" " function" "([number uint] observerId)" " - " "") ); return; };
+        };
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""observerId"")");
+        unsigned long observerId = args[1 -1]->Uint32Value();
+        self->setSerializationObserver(observerId);
+        { args.GetReturnValue().Set( args.This() ); return; };
+    }
+
+    void TileLayerWrap::StartAnimations(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        self->startAnimations();
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void TileLayerWrap::StopAnimations(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        self->stopAnimations();
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void TileLayerWrap::Hide(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        self->hide();
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void TileLayerWrap::Show(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        self->show();
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void TileLayerWrap::IsHidden(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "boolean" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        bool hidden = self->isHidden();
+        { args.GetReturnValue().Set( v8::Boolean::New(isolate, hidden) ); return; };
+    }
+
+    void TileLayerWrap::FadeIn(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "([number int] msDuration, [number int] easing = linearTween)" " - " "") ); return; };
+        };
+        if (args.Length() < 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1, true);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""msDuration"")");
+        long msDuration = args[1 -1]->Int32Value();
         if (args.Length() >= 2 && !args[2 -1]->IsNumber())
             v8_ThrowArgTypeException(isolate, 2, "a number (""easing"")");
         long easing = (args.Length()<2) ? EasingFuncRef::linearTween : args[2 -1]->Int32Value();;
@@ -22170,6 +23311,34 @@ namespace pdg
         { args.GetReturnValue().Set( v8::Integer::New(isolate, zorder) ); return; };
     }
 
+    void TileLayerWrap::GetWorld(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object World]" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        World* world = self->getWorld();
+        if (!world)
+        {
+            args.GetReturnValue().SetNull(); return;
+        }
+        if (world->mWorldScriptObj.IsEmpty())
+        {
+            { args.GetReturnValue().Set( WorldWrap::NewFromCpp(isolate, world) ); return; };
+        }
+        else
+        {
+            v8::Local<v8::Object> obj__ = v8::Local<v8::Object>::New(isolate, world->mWorldScriptObj );
+            { args.GetReturnValue().Set( obj__ ); return; };
+        };
+    }
+
     void TileLayerWrap::GetSpriteZOrder(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
@@ -22260,6 +23429,83 @@ namespace pdg
         { args.GetReturnValue().Set( v8::Boolean::New(isolate, found) ); return; };
     }
 
+    void TileLayerWrap::GetSpriteStates(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "([object Float32Array] outStates, [object Uint32Array] outIids)" " - " "") ); return; };
+        };
+        if (args.Length() < 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1, true);
+        REQUIRE_FLOAT32_ARRAY_ARG(1, outStates);
+        OPTIONAL_UINT32_ARRAY_ARG(2, outIids);
+        uint32 maxSprites = outStatesLength / spriteState_Size;
+        if (outIids && (outIidsLength < maxSprites)) maxSprites = outIidsLength;
+        uint32 count = self->getSpriteStates(outStates, maxSprites, outIids);
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, count) ); return; };
+    }
+
+    void TileLayerWrap::GetSpriteStatesById(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "([object Uint32Array] iids, [object Float32Array] outStates)" " - " "") ); return; };
+        };
+        if (args.Length() != 2)
+            v8_ThrowArgCountException(isolate, args.Length(), 2);
+        REQUIRE_UINT32_ARRAY_ARG(1, iids);
+        REQUIRE_FLOAT32_ARRAY_ARG(2, outStates);
+        uint32 numIids = iidsLength;
+        if (numIids > outStatesLength / spriteState_Size) numIids = outStatesLength / spriteState_Size;
+        uint32 count = self->getSpriteStates(iids, numIids, outStates);
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, count) ); return; };
+    }
+
+    void TileLayerWrap::SetSpriteStates(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "([object Float32Array] states)" " - " "") ); return; };
+        };
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        REQUIRE_FLOAT32_ARRAY_ARG(1, states);
+        uint32 count = self->setSpriteStates(states, statesLength / spriteState_Size);
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, count) ); return; };
+    }
+
+    void TileLayerWrap::SetSpriteStatesById(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "([object Uint32Array] iids, [object Float32Array] states)" " - " "") ); return; };
+        };
+        if (args.Length() != 2)
+            v8_ThrowArgCountException(isolate, args.Length(), 2);
+        REQUIRE_UINT32_ARRAY_ARG(1, iids);
+        REQUIRE_FLOAT32_ARRAY_ARG(2, states);
+        uint32 numIids = iidsLength;
+        if (numIids > statesLength / spriteState_Size) numIids = statesLength / spriteState_Size;
+        uint32 count = self->setSpriteStates(iids, numIids, states);
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, count) ); return; };
+    }
+
     void TileLayerWrap::AddSprite(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
@@ -22376,6 +23622,39 @@ namespace pdg
         args.GetReturnValue().SetUndefined();
     }
 
+    void TileLayerWrap::EnableCollisionGrid(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(number cellSize = 64)" " - " "use a grid to find potential sprite collisions") ); return; };
+        };
+        if (args.Length() >= 1 && !args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""cellSize"")");
+        double cellSize = (args.Length()<1) ? 64.0f : args[1 -1]->NumberValue();;
+        self->enableCollisionGrid(cellSize);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void TileLayerWrap::DisableCollisionGrid(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        self->disableCollisionGrid();
+        args.GetReturnValue().SetUndefined();
+    }
+
     void TileLayerWrap::CreateSprite(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
@@ -22401,6 +23680,32 @@ namespace pdg
         };
     }
 
+    void TileLayerWrap::CloneSprite(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "CR [object Sprite]" " function" "([object Sprite] originalSprite)" " - " "make a new sprite with the same frames and settings as another") ); return; };
+        };
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        REQUIRE_CPP_OBJECT_ARG(1, originalSprite, Sprite);
+        Sprite* sprite = self->cloneSprite(originalSprite);
+        if (!sprite) args.GetReturnValue().SetNull();
+        if (sprite->mSpriteScriptObj.IsEmpty())
+        {
+            { args.GetReturnValue().Set( SpriteWrap::NewFromCpp(isolate, sprite) ); return; };
+        }
+        else
+        {
+            v8::Local<v8::Object> obj__ = v8::Local<v8::Object>::New(isolate, sprite->mSpriteScriptObj );
+            { args.GetReturnValue().Set( obj__ ); return; };
+        };
+    }
+
 #ifdef PDG_USE_CHIPMUNK_PHYSICS
 
     void TileLayerWrap::SetKeepGravityDownward(const v8::FunctionCallbackInfo<v8::Value>& args)
@@ -22461,7 +23766,7 @@ namespace pdg
         args.GetReturnValue().SetUndefined();
     }
 
-    void TileLayerWrap::SetStaticLayer(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void TileLayerWrap::SetPhysicsThreads(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
@@ -22469,16 +23774,18 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(boolean isStatic = true)" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(number numThreads)" " - " "applies to all layers in the world") ); return; };
         };
-        if (args.Length() >= 1 && !args[1 -1]->IsBoolean())
-            v8_ThrowArgTypeException(isolate, 1, "a boolean (""isStatic"")");
-        bool isStatic = (args.Length()<1) ? true : args[1 -1]->BooleanValue();;
-        self->setStaticLayer(isStatic);
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""numThreads"")");
+        unsigned long numThreads = args[1 -1]->Uint32Value();
+        self->setPhysicsThreads(numThreads);
         args.GetReturnValue().SetUndefined();
     }
 
-    void TileLayerWrap::SetUseChipmunkPhysics(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void TileLayerWrap::GetPhysicsThreads(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
@@ -22486,16 +23793,14 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(boolean useIt = true)" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "") ); return; };
         };
-        if (args.Length() >= 1 && !args[1 -1]->IsBoolean())
-            v8_ThrowArgTypeException(isolate, 1, "a boolean (""useIt"")");
-        bool useIt = (args.Length()<1) ? true : args[1 -1]->BooleanValue();;
-        self->setUseChipmunkPhysics(useIt);
-        args.GetReturnValue().SetUndefined();
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, self->getPhysicsThreads()) ); return; };
     }
 
-    void TileLayerWrap::GetSpace(const v8::FunctionCallbackInfo<v8::Value>& args)
+    void TileLayerWrap::GetPhysicsStepTime(const v8::FunctionCallbackInfo<v8::Value>& args)
     {
         v8::Isolate* isolate = args.GetIsolate();
         TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
@@ -22503,14 +23808,132 @@ namespace pdg
 
         if (args.Length() == 1 && args[0]->IsNull())
         {
-            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object CpSpace]" " function" "()" " - " "") ); return; };
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "how long the last physics step took, in milliseconds") ); return; };
         };
         if (args.Length() != 0)
             v8_ThrowArgCountException(isolate, args.Length(), 0);
-        cpSpace* space = self->getSpace();
-        if (!space) args.GetReturnValue().SetNull();
-        { args.GetReturnValue().Set( cpSpaceWrap::NewFromCpp(isolate, space) ); return; };
-        ;
+        { args.GetReturnValue().Set( v8::Number::New(isolate, self->getPhysicsStepTime()) ); return; };
+    }
+
+    void TileLayerWrap::SetFixedPhysicsStep(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(number stepMs, number maxStepsPerTick = 8)" " - " "0 to step once per tick, applies to all layers in the world") ); return; };
+        };
+        if (args.Length() < 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1, true);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""stepMs"")");
+        double stepMs = args[1 -1]->NumberValue();
+        if (args.Length() >= 2 && !args[2 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 2, "a number (""maxStepsPerTick"")");
+        unsigned long maxStepsPerTick = (args.Length()<2) ? 8 : args[2 -1]->Uint32Value();
+        self->setFixedPhysicsStep(stepMs, maxStepsPerTick);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void TileLayerWrap::GetFixedPhysicsStep(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        { args.GetReturnValue().Set( v8::Number::New(isolate, self->getFixedPhysicsStep()) ); return; };
+    }
+
+    void TileLayerWrap::SetPhysicsInterpolation(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(boolean interpolate = true)" " - " "") ); return; };
+        };
+        if (args.Length() >= 1 && !args[1 -1]->IsBoolean())
+            v8_ThrowArgTypeException(isolate, 1, "a boolean (""interpolate"")");
+        bool interpolate = (args.Length()<1) ? true : args[1 -1]->BooleanValue();;
+        self->setPhysicsInterpolation(interpolate);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void TileLayerWrap::GetPhysicsAlpha(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "how far the physics is toward its next fixed step, 0 to 1") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        { args.GetReturnValue().Set( v8::Number::New(isolate, self->getPhysicsAlpha()) ); return; };
+    }
+
+    void TileLayerWrap::SetStaticLayer(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(boolean isStatic = true)" " - " "") ); return; };
+        };
+        if (args.Length() >= 1 && !args[1 -1]->IsBoolean())
+            v8_ThrowArgTypeException(isolate, 1, "a boolean (""isStatic"")");
+        bool isStatic = (args.Length()<1) ? true : args[1 -1]->BooleanValue();;
+        self->setStaticLayer(isStatic);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void TileLayerWrap::SetUseChipmunkPhysics(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(boolean useIt = true)" " - " "") ); return; };
+        };
+        if (args.Length() >= 1 && !args[1 -1]->IsBoolean())
+            v8_ThrowArgTypeException(isolate, 1, "a boolean (""useIt"")");
+        bool useIt = (args.Length()<1) ? true : args[1 -1]->BooleanValue();;
+        self->setUseChipmunkPhysics(useIt);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void TileLayerWrap::GetSpace(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object CpSpace]" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        cpSpace* space = self->getSpace();
+        if (!space) args.GetReturnValue().SetNull();
+        { args.GetReturnValue().Set( cpSpaceWrap::NewFromCpp(isolate, space) ); return; };
+        ;
     }
 #endif
 
@@ -22903,6 +24326,87 @@ namespace pdg
         { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, overlapPx) ); return; };
     }
 
+ #ifdef PDG_USE_CHIPMUNK_PHYSICS
+    void TileLayerWrap::EnableStaticCollisions(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "([number uint] alphaThreshold = 128, number tolerance = 1.0, number radius = 1.0, number friction = 1.0, number elasticity = 0.0, [number int] chunkSize = 16)" " - " "build static physics shapes from the tiles") ); return; };
+        };
+        if (args.Length() >= 1 && !args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""alphaThreshold"")");
+        unsigned long alphaThreshold = (args.Length()<1) ? 128 : args[1 -1]->Uint32Value();;
+        if (args.Length() >= 2 && !args[2 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 2, "a number (""tolerance"")");
+        double tolerance = (args.Length()<2) ? 1.0f : args[2 -1]->NumberValue();;
+        if (args.Length() >= 3 && !args[3 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 3, "a number (""radius"")");
+        double radius = (args.Length()<3) ? 1.0f : args[3 -1]->NumberValue();;
+        if (args.Length() >= 4 && !args[4 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 4, "a number (""friction"")");
+        double friction = (args.Length()<4) ? 1.0f : args[4 -1]->NumberValue();;
+        if (args.Length() >= 5 && !args[5 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 5, "a number (""elasticity"")");
+        double elasticity = (args.Length()<5) ? 0.0f : args[5 -1]->NumberValue();;
+        if (args.Length() >= 6 && !args[6 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 6, "a number (""chunkSize"")");
+        long chunkSize = (args.Length()<6) ? 16 : args[6 -1]->Int32Value();;
+        self->enableStaticCollisions(alphaThreshold, tolerance, radius, friction, elasticity, chunkSize);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void TileLayerWrap::DisableStaticCollisions(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        self->disableStaticCollisions();
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void TileLayerWrap::UpdateStaticCollisions(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "rebuild shapes for changed tiles now instead of next animation step") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        self->updateStaticCollisions();
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void TileLayerWrap::GetStaticShapeCount(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        TileLayerWrap* objWrapper = jswrap::ObjectWrap::Unwrap<TileLayerWrap>(args.This());
+        TileLayer* self = dynamic_cast<TileLayer*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "number" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, self->getStaticShapeCount()) ); return; };
+    }
+
+ #endif
     void CleanupTileLayerScriptObject(v8::Persistent<v8::Object> &obj) { }
 
     TileLayer* New_TileLayer(const v8::FunctionCallbackInfo<v8::Value>& args)
@@ -22912,6 +24416,345 @@ namespace pdg
         return 0;
     }
 
+    static bool s_World_InNewFromCpp = false;
+
+    void WorldWrap::New(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        WorldWrap* objWrapper = new WorldWrap(args);
+        objWrapper->Wrap(args.This());
+        ;
+        if (s_HaveSavedError)
+        {
+            s_HaveSavedError = false;
+            v8::Local<v8::Value> s_err_ = v8::Local<v8::Value>::New(isolate, s_SavedError);
+            isolate->ThrowException(s_err_);
+        };
+        { args.GetReturnValue().Set( args.This() ); return; };
+    }
+
+    v8::Local<v8::Object> WorldWrap::NewFromCpp(v8::Isolate* isolate, World* cppObj)
+    {
+        s_World_InNewFromCpp = true;
+        v8::EscapableHandleScope scope(isolate);
+        v8::Local<v8::FunctionTemplate> constructor = v8::Local<v8::FunctionTemplate>::New(isolate, constructorTpl_);
+        v8::Local<v8::Object> instance =
+            constructor->GetFunction()->NewInstance();
+        v8::Persistent<v8::Object> obj(isolate, instance);
+        WorldWrap* objWrapper = jswrap::ObjectWrap::Unwrap<WorldWrap>(instance);
+
+        cppObj->mWorldScriptObj.Reset(isolate, obj);
+        DEBUG_ASSERT(objWrapper->cppPtr_ == 0, "NewFromCpp() already have C++ object!");
+        if (objWrapper->cppPtr_) delete objWrapper->cppPtr_;
+        objWrapper->cppPtr_ = cppObj;
+        s_World_InNewFromCpp = false;
+        return scope.Escape(instance);
+    }
+
+    v8::Persistent<v8::FunctionTemplate> WorldWrap::constructorTpl_;
+
+    void WorldWrap::Init(v8::Isolate* isolate, v8::Local<v8::Object> target)
+    {
+
+        v8::Local<v8::FunctionTemplate> t = v8::FunctionTemplate::New(isolate, New);
+        t->InstanceTemplate()->SetInternalFieldCount(1);
+        t->SetClassName(v8::String::NewFromUtf8(isolate, "World", v8::String::kInternalizedString));
+        constructorTpl_.Reset(isolate, t);
+        v8::Local<v8::Signature> CreateSpriteLayer_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> CreateSpriteLayer_Tpl =
+            v8::FunctionTemplate::New(isolate, CreateSpriteLayer, v8::Local<v8::Value>(), CreateSpriteLayer_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "createSpriteLayer", v8::String::kInternalizedString), CreateSpriteLayer_Tpl);
+        v8::Local<v8::Signature> CreateTileLayer_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> CreateTileLayer_Tpl =
+            v8::FunctionTemplate::New(isolate, CreateTileLayer, v8::Local<v8::Value>(), CreateTileLayer_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "createTileLayer", v8::String::kInternalizedString), CreateTileLayer_Tpl);
+        v8::Local<v8::Signature> GetLayerCount_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetLayerCount_Tpl =
+            v8::FunctionTemplate::New(isolate, GetLayerCount, v8::Local<v8::Value>(), GetLayerCount_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getLayerCount", v8::String::kInternalizedString), GetLayerCount_Tpl);
+        v8::Local<v8::Signature> SetTickInterval_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetTickInterval_Tpl =
+            v8::FunctionTemplate::New(isolate, SetTickInterval, v8::Local<v8::Value>(), SetTickInterval_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setTickInterval", v8::String::kInternalizedString), SetTickInterval_Tpl);
+        v8::Local<v8::Signature> GetTickInterval_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> GetTickInterval_Tpl =
+            v8::FunctionTemplate::New(isolate, GetTickInterval, v8::Local<v8::Value>(), GetTickInterval_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "getTickInterval", v8::String::kInternalizedString), GetTickInterval_Tpl);
+        v8::Local<v8::Signature> Pause_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> Pause_Tpl =
+            v8::FunctionTemplate::New(isolate, Pause, v8::Local<v8::Value>(), Pause_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "pause", v8::String::kInternalizedString), Pause_Tpl);
+        v8::Local<v8::Signature> Unpause_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> Unpause_Tpl =
+            v8::FunctionTemplate::New(isolate, Unpause, v8::Local<v8::Value>(), Unpause_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "unpause", v8::String::kInternalizedString), Unpause_Tpl);
+        v8::Local<v8::Signature> IsPaused_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> IsPaused_Tpl =
+            v8::FunctionTemplate::New(isolate, IsPaused, v8::Local<v8::Value>(), IsPaused_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "isPaused", v8::String::kInternalizedString), IsPaused_Tpl);
+        v8::Local<v8::Signature> Step_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> Step_Tpl =
+            v8::FunctionTemplate::New(isolate, Step, v8::Local<v8::Value>(), Step_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "step", v8::String::kInternalizedString), Step_Tpl);
+        v8::Local<v8::Signature> SetThreaded_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> SetThreaded_Tpl =
+            v8::FunctionTemplate::New(isolate, SetThreaded, v8::Local<v8::Value>(), SetThreaded_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "setThreaded", v8::String::kInternalizedString), SetThreaded_Tpl);
+        v8::Local<v8::Signature> IsThreaded_Sig = v8::Signature::New(isolate, t);
+        v8::Local<v8::FunctionTemplate> IsThreaded_Tpl =
+            v8::FunctionTemplate::New(isolate, IsThreaded, v8::Local<v8::Value>(), IsThreaded_Sig);
+        t->PrototypeTemplate()->Set(v8::String::NewFromUtf8(isolate, "isThreaded", v8::String::kInternalizedString), IsThreaded_Tpl);
+        target->Set(v8::String::NewFromUtf8(isolate, "World", v8::String::kInternalizedString), t->GetFunction());
+
+    }
+
+    void WorldWrap::CreateSpriteLayer(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        WorldWrap* objWrapper = jswrap::ObjectWrap::Unwrap<WorldWrap>(args.This());
+        World* self = dynamic_cast<World*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object SpriteLayer]" " function" "([object Port] port = null)" " - " "") ); return; };
+        };
+#ifndef PDG_NO_GUI
+        Port* port = 0;
+        if (args.Length() >= 1)
+        {
+            if (!args[1 -1]->IsObject())
+            {
+                v8_ThrowArgTypeException(isolate, 1, "an object of type ""Port"" (""port"")");
+            }
+            else
+            {
+                v8::Local<v8::Object> port_ = args[1 -1]->ToObject();
+                PortWrap* port__ = jswrap::ObjectWrap::Unwrap< PortWrap>( port_);
+                port = port__->getCppObject();
+            }
+        };
+        SpriteLayer* layer = self->createSpriteLayer(port);
+#else
+        SpriteLayer* layer = self->createSpriteLayer();
+#endif
+        if (!layer) args.GetReturnValue().SetNull();
+        if (layer->mSpriteLayerScriptObj.IsEmpty())
+        {
+            { args.GetReturnValue().Set( SpriteLayerWrap::NewFromCpp(isolate, layer) ); return; };
+        }
+        else
+        {
+            v8::Local<v8::Object> obj__ = v8::Local<v8::Object>::New(isolate, layer->mSpriteLayerScriptObj );
+            { args.GetReturnValue().Set( obj__ ); return; };
+        };
+    }
+
+    void WorldWrap::CreateTileLayer(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        WorldWrap* objWrapper = jswrap::ObjectWrap::Unwrap<WorldWrap>(args.This());
+        World* self = dynamic_cast<World*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[object TileLayer]" " function" "([object Port] port = null)" " - " "") ); return; };
+        };
+#ifndef PDG_NO_GUI
+        Port* port = 0;
+        if (args.Length() >= 1)
+        {
+            if (!args[1 -1]->IsObject())
+            {
+                v8_ThrowArgTypeException(isolate, 1, "an object of type ""Port"" (""port"")");
+            }
+            else
+            {
+                v8::Local<v8::Object> port_ = args[1 -1]->ToObject();
+                PortWrap* port__ = jswrap::ObjectWrap::Unwrap< PortWrap>( port_);
+                port = port__->getCppObject();
+            }
+        };
+        TileLayer* layer = self->createTileLayer(port);
+#else
+        TileLayer* layer = self->createTileLayer();
+#endif
+        if (!layer) args.GetReturnValue().SetNull();
+        if (layer->mTileLayerScriptObj.IsEmpty())
+        {
+            { args.GetReturnValue().Set( TileLayerWrap::NewFromCpp(isolate, layer) ); return; };
+        }
+        else
+        {
+            v8::Local<v8::Object> obj__ = v8::Local<v8::Object>::New(isolate, layer->mTileLayerScriptObj );
+            { args.GetReturnValue().Set( obj__ ); return; };
+        };
+    }
+
+    void WorldWrap::GetLayerCount(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        WorldWrap* objWrapper = jswrap::ObjectWrap::Unwrap<WorldWrap>(args.This());
+        World* self = dynamic_cast<World*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[number uint]" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, self->getLayerCount()) ); return; };
+    }
+
+    void WorldWrap::SetTickInterval(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        WorldWrap* objWrapper = jswrap::ObjectWrap::Unwrap<WorldWrap>(args.This());
+        World* self = dynamic_cast<World*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "([number uint] msInterval)" " - " "") ); return; };
+        };
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""msInterval"")");
+        unsigned long msInterval = args[1 -1]->Uint32Value();
+        self->setTickInterval(msInterval);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void WorldWrap::GetTickInterval(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        WorldWrap* objWrapper = jswrap::ObjectWrap::Unwrap<WorldWrap>(args.This());
+        World* self = dynamic_cast<World*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "[number uint]" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        { args.GetReturnValue().Set( v8::Integer::NewFromUnsigned(isolate, self->getTickInterval()) ); return; };
+    }
+
+    void WorldWrap::Pause(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        WorldWrap* objWrapper = jswrap::ObjectWrap::Unwrap<WorldWrap>(args.This());
+        World* self = dynamic_cast<World*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "stop animating the world until unpause() is called") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        self->pause();
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void WorldWrap::Unpause(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        WorldWrap* objWrapper = jswrap::ObjectWrap::Unwrap<WorldWrap>(args.This());
+        World* self = dynamic_cast<World*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        self->unpause();
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void WorldWrap::IsPaused(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        WorldWrap* objWrapper = jswrap::ObjectWrap::Unwrap<WorldWrap>(args.This());
+        World* self = dynamic_cast<World*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "boolean" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        bool paused = self->isPaused();
+        { args.GetReturnValue().Set( v8::Boolean::New(isolate, paused) ); return; };
+    }
+
+    void WorldWrap::Step(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        WorldWrap* objWrapper = jswrap::ObjectWrap::Unwrap<WorldWrap>(args.This());
+        World* self = dynamic_cast<World*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "([number uint] msElapsed)" " - " "animate the world by msElapsed right now") ); return; };
+        };
+        if (args.Length() != 1)
+            v8_ThrowArgCountException(isolate, args.Length(), 1);
+        if (!args[1 -1]->IsNumber())
+            v8_ThrowArgTypeException(isolate, 1, "a number (""msElapsed"")");
+        unsigned long msElapsed = args[1 -1]->Uint32Value();
+        self->step(msElapsed);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void WorldWrap::SetThreaded(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        WorldWrap* objWrapper = jswrap::ObjectWrap::Unwrap<WorldWrap>(args.This());
+        World* self = dynamic_cast<World*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "undefined" " function" "(boolean threaded = true)" " - " "tick on the world threads, only C++ animation and collision helpers can be used") ); return; };
+        };
+        if (args.Length() >= 1 && !args[1 -1]->IsBoolean())
+            v8_ThrowArgTypeException(isolate, 1, "a boolean (""threaded"")");
+        bool threaded = (args.Length()<1) ? true : args[1 -1]->BooleanValue();;
+        self->setThreaded(threaded);
+        args.GetReturnValue().SetUndefined();
+    }
+
+    void WorldWrap::IsThreaded(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        WorldWrap* objWrapper = jswrap::ObjectWrap::Unwrap<WorldWrap>(args.This());
+        World* self = dynamic_cast<World*>(objWrapper->cppPtr_);
+
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "boolean" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        bool threaded = self->isThreaded();
+        { args.GetReturnValue().Set( v8::Boolean::New(isolate, threaded) ); return; };
+    }
+
+    void CleanupWorldScriptObject(v8::Persistent<v8::Object> &obj) { }
+
+    World* New_World(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        if (s_World_InNewFromCpp) return 0;
+        v8::Isolate* isolate = args.GetIsolate();
+        s_HaveSavedError = true;
+        {
+            std::ostringstream excpt_;
+            excpt_ << "World cannot be created directly, use pdg.createWorld()";
+            v8::Isolate* isolate = v8::Isolate::GetCurrent();
+            s_SavedError.Reset(isolate, v8::Exception::Error( v8::String::NewFromUtf8(isolate, excpt_.str().c_str())));
+        };
+        return 0;
+    }
+
     ScriptSerializable::ScriptSerializable()
     {
     }
@@ -22987,6 +24830,26 @@ namespace pdg
         ISerializer::s_DebugMode = debugMode;
         args.GetReturnValue().SetUndefined();
     }
+    void GetUserDataStats(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        v8::Isolate* isolate = args.GetIsolate();
+        if (args.Length() == 1 && args[0]->IsNull())
+        {
+            { args.GetReturnValue().Set( v8::String::NewFromUtf8(isolate, "object" " function" "()" " - " "") ); return; };
+        };
+        if (args.Length() != 0)
+            v8_ThrowArgCountException(isolate, args.Length(), 0);
+        MemStats stats;
+        uint32 pooledInUse;
+        UserData::getAllocationStats(stats, &pooledInUse);
+        v8::Local<v8::Object> jsStats = v8_ObjectCreateEmpty(isolate, 0);
+        jsStats->Set(v8::String::NewFromUtf8(isolate, "objectsAllocated", v8::String::kInternalizedString), v8::Integer::NewFromUnsigned(isolate, stats.cxxObjsAllocated));
+        jsStats->Set(v8::String::NewFromUtf8(isolate, "objectsFreed", v8::String::kInternalizedString), v8::Integer::NewFromUnsigned(isolate, stats.cxxObjsFreed));
+        jsStats->Set(v8::String::NewFromUtf8(isolate, "blocksAllocated", v8::String::kInternalizedString), v8::Integer::NewFromUnsigned(isolate, stats.blocksAllocated));
+        jsStats->Set(v8::String::NewFromUtf8(isolate, "blocksFreed", v8::String::kInternalizedString), v8::Integer::NewFromUnsigned(isolate, stats.blocksFreed));
+        jsStats->Set(v8::String::NewFromUtf8(isolate, "pooledInUse", v8::String::kInternalizedString), v8::Integer::NewFromUnsigned(isolate, pooledInUse));
+        { args.GetReturnValue().Set( jsStats ); return; };
+    }
 
     bool Initializer::allowHorizontalOrientation() throw() { return true; }
     bool Initializer::allowVerticalOrientation() throw() { return true; }
@@ -84,6 +84,7 @@ namespace pdg
             static void GetDataSize (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void GetByte (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void GetBytes (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void ToBuffer (const v8::FunctionCallbackInfo<v8::Value>& args);
     };
 
     ConfigManager* New_ConfigManager(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -454,6 +455,12 @@ namespace pdg
             static void Sizeof_ref (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void GetDataSize (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void GetDataPtr (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void CopyDataTo (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void ReleaseBuffer (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetCapacity (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void Reserve (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void Reset (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetStreaming (const v8::FunctionCallbackInfo<v8::Value>& args);
     };
 
     Deserializer* New_Deserializer(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -1665,6 +1672,14 @@ namespace pdg
             static void Deserialize (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void GetMyClassTag (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void SetSerializationFlags (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void TakeSnapshot (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetSerializationBaseline (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetLastSnapshotId (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void AddObserver (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void RemoveObserver (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetObserverArea (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetObserverRadius (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetSerializationObserver (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void StartAnimations (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void StopAnimations (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void Hide (const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -1677,12 +1692,17 @@ namespace pdg
             static void MoveToFront (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void MoveToBack (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void GetZOrder (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetWorld (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void MoveWith (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void FindSprite (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void GetNthSprite (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void GetSpriteZOrder (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void IsSpriteBehind (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void HasSprite (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetSpriteStates (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetSpriteStatesById (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetSpriteStates (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetSpriteStatesById (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void AddSprite (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void RemoveSprite (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void RemoveAllSprites (const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -1690,7 +1710,10 @@ namespace pdg
             static void DisableCollisions (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void EnableCollisionsWithLayer (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void DisableCollisionsWithLayer (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void EnableCollisionGrid (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void DisableCollisionGrid (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void CreateSprite (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void CloneSprite (const v8::FunctionCallbackInfo<v8::Value>& args);
 #ifndef PDG_NO_GUI
             static void GetSpritePort (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void SetSpritePort (const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -1719,6 +1742,13 @@ namespace pdg
             static void SetGravity (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void SetKeepGravityDownward (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void SetDamping (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetPhysicsThreads (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetPhysicsThreads (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetPhysicsStepTime (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetFixedPhysicsStep (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetFixedPhysicsStep (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetPhysicsInterpolation (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetPhysicsAlpha (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void GetSpace (const v8::FunctionCallbackInfo<v8::Value>& args);
 #endif
 #ifdef PDG_SCML_SUPPORT
@@ -1828,6 +1858,14 @@ namespace pdg
             static void Deserialize (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void GetMyClassTag (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void SetSerializationFlags (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void TakeSnapshot (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetSerializationBaseline (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetLastSnapshotId (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void AddObserver (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void RemoveObserver (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetObserverArea (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetObserverRadius (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetSerializationObserver (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void StartAnimations (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void StopAnimations (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void Hide (const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -1840,12 +1878,17 @@ namespace pdg
             static void MoveToFront (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void MoveToBack (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void GetZOrder (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetWorld (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void MoveWith (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void FindSprite (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void GetNthSprite (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void GetSpriteZOrder (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void IsSpriteBehind (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void HasSprite (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetSpriteStates (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetSpriteStatesById (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetSpriteStates (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetSpriteStatesById (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void AddSprite (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void RemoveSprite (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void RemoveAllSprites (const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -1853,7 +1896,10 @@ namespace pdg
             static void DisableCollisions (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void EnableCollisionsWithLayer (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void DisableCollisionsWithLayer (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void EnableCollisionGrid (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void DisableCollisionGrid (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void CreateSprite (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void CloneSprite (const v8::FunctionCallbackInfo<v8::Value>& args);
 #ifndef PDG_NO_GUI
             static void GetSpritePort (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void SetSpritePort (const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -1882,6 +1928,13 @@ namespace pdg
             static void SetGravity (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void SetKeepGravityDownward (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void SetDamping (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetPhysicsThreads (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetPhysicsThreads (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetPhysicsStepTime (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetFixedPhysicsStep (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetFixedPhysicsStep (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetPhysicsInterpolation (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetPhysicsAlpha (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void GetSpace (const v8::FunctionCallbackInfo<v8::Value>& args);
 #endif
             static void GetWorldSize (const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -1896,6 +1949,56 @@ namespace pdg
             static void GetTileTypeAndFacingAt (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void SetTileTypeAt (const v8::FunctionCallbackInfo<v8::Value>& args);
             static void CheckCollision (const v8::FunctionCallbackInfo<v8::Value>& args);
+#ifdef PDG_USE_CHIPMUNK_PHYSICS
+            static void EnableStaticCollisions (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void DisableStaticCollisions (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void UpdateStaticCollisions (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetStaticShapeCount (const v8::FunctionCallbackInfo<v8::Value>& args);
+#endif
+    };
+
+    World* New_World(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+    class WorldWrap : public jswrap::ObjectWrap
+    {
+        public:
+            static void Init(v8::Isolate* isolate, v8::Local<v8::Object> target);
+            static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+        protected:
+            static v8::Persistent<v8::FunctionTemplate> constructorTpl_;
+        public:
+            World* getCppObject()
+            {
+                return cppPtr_;
+            }
+        protected:
+            World* cppPtr_;
+
+            WorldWrap(const v8::FunctionCallbackInfo<v8::Value>& args)
+            {
+                cppPtr_ = 0;
+            }
+
+            ~WorldWrap()
+            {
+                cppPtr_ = 0;
+            }
+
+        public:
+            static v8::Local<v8::Object> NewFromCpp(v8::Isolate* isolate, World* cppObj);
+            WorldWrap(World* obj) : cppPtr_(obj) {}
+
+            static void CreateSpriteLayer (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void CreateTileLayer (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetLayerCount (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetTickInterval (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void GetTickInterval (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void Pause (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void Unpause (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void IsPaused (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void Step (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void SetThreaded (const v8::FunctionCallbackInfo<v8::Value>& args);
+            static void IsThreaded (const v8::FunctionCallbackInfo<v8::Value>& args);
     };
 
     extern void GetConfigManager(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -1903,6 +2006,7 @@ namespace pdg
     extern void GetEventManager(const v8::FunctionCallbackInfo<v8::Value>& args);
     extern void GetResourceManager(const v8::FunctionCallbackInfo<v8::Value>& args);
     extern void SetSerializationDebugMode(const v8::FunctionCallbackInfo<v8::Value>& args);
+    extern void GetUserDataStats(const v8::FunctionCallbackInfo<v8::Value>& args);
     extern void RegisterSerializableClass(const v8::FunctionCallbackInfo<v8::Value>& args);
     extern void RegisterSerializableObject(const v8::FunctionCallbackInfo<v8::Value>& args);
     extern void GetGraphicsManager(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -1915,6 +2019,11 @@ namespace pdg
 #endif
     extern void CleanupSpriteLayer(const v8::FunctionCallbackInfo<v8::Value>& args);
     extern void CreateTileLayer(const v8::FunctionCallbackInfo<v8::Value>& args);
+    extern void CreateWorld(const v8::FunctionCallbackInfo<v8::Value>& args);
+    extern void GetDefaultWorld(const v8::FunctionCallbackInfo<v8::Value>& args);
+    extern void CleanupWorld(const v8::FunctionCallbackInfo<v8::Value>& args);
+    extern void SetWorldThreads(const v8::FunctionCallbackInfo<v8::Value>& args);
+    extern void GetWorldThreads(const v8::FunctionCallbackInfo<v8::Value>& args);
     extern void Rand(const v8::FunctionCallbackInfo<v8::Value>& args);
     extern void GameCriticalRandom(const v8::FunctionCallbackInfo<v8::Value>& args);
     extern void Srand(const v8::FunctionCallbackInfo<v8::Value>& args);
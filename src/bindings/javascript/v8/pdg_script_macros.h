@@ -116,6 +116,13 @@
 #define VAL2FUNC(val)		v8::Local<v8::Function>::Cast(val)
 #define VAL2OBJ(val)		val->ToObject()
 
+// node Buffers, either holding a copy of the data or taking over memory from std::malloc() as is
+#define BUFFER2VAL(p, n)			v8_NewBuffer(isolate, p, n, false)
+#define OWNED_BUFFER2VAL(p, n)		v8_NewBuffer(isolate, p, n, true)
+
+// keep val alive for as long as obj is, without it showing up as one of obj's properties
+#define HIDDEN_REF_SAVE(obj, sym, val)	obj->ForceSet(SYMBOL(sym), val, v8::DontEnum)
+
 #define TIME_T_TO_VALUE(time)	v8_TimeToValue(time)
 
 // conversion between PDG coordinate types and Javascript Value type
@@ -158,6 +165,7 @@
 #define VALUE_IS_FUNCTION(val)  val->IsFunction()
  
 #define VALUE_IS_OBJECT(val)	val->IsObject()
+#define VALUE_IS_BUFFER(val)	val->IsUint8Array()
 
 #define VALUE_IS_OBJECT_OF_CLASS(val, klass)	\
 	((!val->IsObject()) ? false : 													CR \
@@ -862,6 +870,21 @@ klass* New_##klass(SCRIPT_ARGS) {						   CR \
 #define RETURN_QUAD(what)	   RETURN( QUAD2VAL( what ) )
 #define RETURN_COLOR(what)	   RETURN( COLOR2VAL( what ) )
 
+// for getters that take an optional out argument: if argument n is given, fill it in and return it
+// instead of making a new object. It can be an object or a Float32Array, and argument n+1 is
+// where to start in the Float32Array
+#define RETURN_FILLED_ARG(fillFunc, what, n)   \
+	if (ARGC >= n) {                                                				CR \
+		OPTIONAL_UINT32_ARG(n+1, outIndex_, 0);                     				CR \
+		if (!fillFunc(isolate, what, ARGV[n-1], outIndex_))         				CR \
+			v8_ThrowArgTypeException(isolate, n, "an object or a Float32Array with room for the result (out)"); CR \
+		RETURN( ARGV[n-1] );                                        				CR \
+	}
+
+#define RETURN_POINT_INTO(what, n)    RETURN_FILLED_ARG(v8_FillJavascriptOffset, what, n) RETURN_POINT(what)
+#define RETURN_VECTOR_INTO(what, n)   RETURN_FILLED_ARG(v8_FillJavascriptOffset, what, n) RETURN_VECTOR(what)
+#define RETURN_RECT_INTO(what, n)     RETURN_FILLED_ARG(v8_FillJavascriptRect, what, n) RETURN_RECT(what)
+
 #define RETURN_CPP_OBJECT(what, klass)   \
 	if (!what) RETURN_NULL;												CR \
     if (what->m##klass##ScriptObj.IsEmpty()) {                          CR \
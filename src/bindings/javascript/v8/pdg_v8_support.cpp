@@ -33,6 +33,8 @@
 #include "pdg_script_macros.h"
 #include "memblock.h"
 
+#include "node_buffer.h"
+
 #include <cstdlib>
 #include <iostream>
 #include <sstream>
@@ -79,6 +81,25 @@ v8::Persistent<v8::Object> gNetServerPrototype;
 v8::Persistent<v8::Object> gNetClientPrototype;
 v8::Persistent<v8::Object> gNetConnectionPrototype;
 
+// Constructors for the pure javascript classes above. Each is made from a template that already
+// has all the class's fields, and has the class's prototype as its prototype property, so the
+// objects we make with it all share one hidden class with the fields stored in the object.
+// Making a plain object and then changing its prototype would put it in dictionary mode instead
+v8::Persistent<v8::Function> gOffsetConstructor;
+v8::Persistent<v8::Function> gPointConstructor;
+v8::Persistent<v8::Function> gVectorConstructor;
+v8::Persistent<v8::Function> gRectConstructor;
+v8::Persistent<v8::Function> gRotatedRectConstructor;
+v8::Persistent<v8::Function> gQuadConstructor;
+v8::Persistent<v8::Function> gColorConstructor;
+
+static const char* const sOffsetFields[] = { "x", "y", 0 };
+static const char* const sRectFields[] = { "left", "top", "right", "bottom", 0 };
+static const char* const sRotatedRectFields[] = { "left", "top", "right", "bottom", "radians", 0 };
+static const char* const sRotatedRectObjectFields[] = { "centeroffset", 0 };
+static const char* const sQuadObjectFields[] = { "points", 0 };
+static const char* const sColorFields[] = { "red", "green", "blue", "alpha", 0 };
+
 const char* v8_GetFunctionName(v8::Local<v8::Function> func) {
     if (func->IsNull()) return "NULL";
     static std::string result_;
@@ -134,46 +155,62 @@ void v8_ThrowArgTypeException(v8::Isolate* isolate, int argn, const char* mustBe
 }
 
 // these let us set a prototype that will be used when an object of a particulr JavaScript class is created
-void v8_SetOffsetPrototype(v8::Local<v8::Object> obj) {
+static void SetClassPrototype(v8::Persistent<v8::Object>& protoRef, v8::Persistent<v8::Function>& ctorRef,
+			v8::Local<v8::Object> proto, const char* const numberFields[], const char* const objectFields[] = 0) {
     v8::Isolate* isolate = v8::Isolate::GetCurrent();
-	gOffsetPrototype.Reset(isolate, obj);
+	protoRef.Reset(isolate, proto);
+	v8::Local<v8::FunctionTemplate> t = v8::FunctionTemplate::New(isolate);
+	v8::Local<v8::ObjectTemplate> inst = t->InstanceTemplate();
+	for (int i = 0; numberFields && numberFields[i]; i++) {
+		inst->Set(_V8_STR(numberFields[i]), NUM2VAL(0));
+	}
+	for (int i = 0; objectFields && objectFields[i]; i++) {
+		inst->Set(_V8_STR(objectFields[i]), v8::Null(isolate));
+	}
+	v8::Local<v8::Function> ctor = t->GetFunction();
+	ctor->Set(_V8_STR("prototype"), proto);
+	ctorRef.Reset(isolate, ctor);
+}
+
+// a new object of one of the classes above, or a plain object if script setup hasn't told us about the class
+static inline v8::Local<v8::Object> NewClassObject(v8::Isolate* isolate, v8::Persistent<v8::Function>& ctorRef) {
+	if (ctorRef.IsEmpty()) {
+		return v8::Object::New(isolate);
+	}
+	return v8::Local<v8::Function>::New(isolate, ctorRef)->NewInstance();
+}
+
+void v8_SetOffsetPrototype(v8::Local<v8::Object> obj) {
+	SetClassPrototype(gOffsetPrototype, gOffsetConstructor, obj, sOffsetFields);
 }
 
 void v8_SetPointPrototype(v8::Local<v8::Object> obj) {
-    v8::Isolate* isolate = v8::Isolate::GetCurrent();
-	gPointPrototype.Reset(isolate, obj);
+	SetClassPrototype(gPointPrototype, gPointConstructor, obj, sOffsetFields);
 }
 
 void v8_SetVectorPrototype(v8::Local<v8::Object> obj) {
-    v8::Isolate* isolate = v8::Isolate::GetCurrent();
-	gVectorPrototype.Reset(isolate, obj);
+	SetClassPrototype(gVectorPrototype, gVectorConstructor, obj, sOffsetFields);
 }
 
 void v8_SetRectPrototype(v8::Local<v8::Object> obj) {
-    v8::Isolate* isolate = v8::Isolate::GetCurrent();
-	gRectPrototype.Reset(isolate, obj);
+	SetClassPrototype(gRectPrototype, gRectConstructor, obj, sRectFields);
 }
 
 void v8_SetRotatedRectPrototype(v8::Local<v8::Object> obj) {
-    v8::Isolate* isolate = v8::Isolate::GetCurrent();
-	gRotatedRectPrototype.Reset(isolate, obj);
+	SetClassPrototype(gRotatedRectPrototype, gRotatedRectConstructor, obj, sRotatedRectFields, sRotatedRectObjectFields);
 }
 
 void v8_SetQuadPrototype(v8::Local<v8::Object> obj) {
-    v8::Isolate* isolate = v8::Isolate::GetCurrent();
-	gQuadPrototype.Reset(isolate, obj);
+	SetClassPrototype(gQuadPrototype, gQuadConstructor, obj, 0, sQuadObjectFields);
 }
 
 void v8_SetColorPrototype(v8::Local<v8::Object> obj) {
-    v8::Isolate* isolate = v8::Isolate::GetCurrent();
-	gColorPrototype.Reset(isolate, obj);
+	SetClassPrototype(gColorPrototype, gColorConstructor, obj, sColorFields);
 }
 
 v8::Local<v8::Object> v8_MakeJavascriptOffset(v8::Isolate* isolate, pdg::Offset& o) {
     v8::EscapableHandleScope scope(isolate);
-  	v8::Local<v8::Object> obj = v8::Object::New(isolate);
-    v8::Local<v8::Object> proto = v8::Local<v8::Object>::New(isolate, gOffsetPrototype);
-    if (!gOffsetPrototype.IsEmpty()) obj->SetPrototype(proto);
+  	v8::Local<v8::Object> obj = NewClassObject(isolate, gOffsetConstructor);
 	obj->Set(X_Symbol,NUM2VAL(o.x));
 	obj->Set(Y_Symbol,NUM2VAL(o.y));
   	return scope.Escape(obj);
@@ -181,9 +218,7 @@ v8::Local<v8::Object> v8_MakeJavascriptOffset(v8::Isolate* isolate, pdg::Offset&
 
 v8::Local<v8::Object> v8_MakeJavascriptPoint(v8::Isolate* isolate, pdg::Point& p) {
     v8::EscapableHandleScope scope(isolate);
-  	v8::Local<v8::Object> obj = v8::Object::New(isolate);
-    v8::Local<v8::Object> proto = v8::Local<v8::Object>::New(isolate, gPointPrototype);
-  	if (!gPointPrototype.IsEmpty()) obj->SetPrototype(proto);
+  	v8::Local<v8::Object> obj = NewClassObject(isolate, gPointConstructor);
 	obj->Set(X_Symbol,NUM2VAL(p.x));
 	obj->Set(Y_Symbol,NUM2VAL(p.y));
   	return scope.Escape(obj);
@@ -191,9 +226,7 @@ v8::Local<v8::Object> v8_MakeJavascriptPoint(v8::Isolate* isolate, pdg::Point& p
 
 v8::Local<v8::Object> v8_MakeJavascriptVector(v8::Isolate* isolate, pdg::Vector& v) {
     v8::EscapableHandleScope scope(isolate);
-  	v8::Local<v8::Object> obj = v8::Object::New(isolate);
-    v8::Local<v8::Object> proto = v8::Local<v8::Object>::New(isolate, gVectorPrototype);
-  	if (!gVectorPrototype.IsEmpty()) obj->SetPrototype(proto);
+  	v8::Local<v8::Object> obj = NewClassObject(isolate, gVectorConstructor);
 	obj->Set(X_Symbol,NUM2VAL(v.x));
 	obj->Set(Y_Symbol,NUM2VAL(v.y));
   	return scope.Escape(obj);
@@ -201,9 +234,7 @@ v8::Local<v8::Object> v8_MakeJavascriptVector(v8::Isolate* isolate, pdg::Vector&
 
 v8::Local<v8::Object> v8_MakeJavascriptRect(v8::Isolate* isolate, pdg::Rect& r) {
     v8::EscapableHandleScope scope(isolate);
-  	v8::Local<v8::Object> obj = v8::Object::New(isolate);
-    v8::Local<v8::Object> proto = v8::Local<v8::Object>::New(isolate, gRectPrototype);
-  	if (!gRectPrototype.IsEmpty()) obj->SetPrototype(proto);
+  	v8::Local<v8::Object> obj = NewClassObject(isolate, gRectConstructor);
 	obj->Set(Left_Symbol,NUM2VAL(r.left));
 	obj->Set(Top_Symbol,NUM2VAL(r.top));
 	obj->Set(Right_Symbol,NUM2VAL(r.right));
@@ -213,9 +244,7 @@ v8::Local<v8::Object> v8_MakeJavascriptRect(v8::Isolate* isolate, pdg::Rect& r)
 
 v8::Local<v8::Object> v8_MakeJavascriptRect(v8::Isolate* isolate, pdg::RotatedRect& r) {
     v8::EscapableHandleScope scope(isolate);
-  	v8::Local<v8::Object> obj = v8::Object::New(isolate);
-    v8::Local<v8::Object> proto = v8::Local<v8::Object>::New(isolate, gRotatedRectPrototype);
-  	if (!gRotatedRectPrototype.IsEmpty()) obj->SetPrototype(proto);
+  	v8::Local<v8::Object> obj = NewClassObject(isolate, gRotatedRectConstructor);
 	obj->Set(Left_Symbol,NUM2VAL(r.left));
 	obj->Set(Top_Symbol,NUM2VAL(r.top));
 	obj->Set(Right_Symbol,NUM2VAL(r.right));
@@ -229,9 +258,7 @@ v8::Local<v8::Object> v8_MakeJavascriptRect(v8::Isolate* isolate, pdg::RotatedRe
 v8::Local<v8::Object> v8_MakeJavascriptQuad(v8::Isolate* isolate, pdg::Quad& q) {
     v8::EscapableHandleScope scope(isolate);
   	v8::Local<v8::Array> arr = v8::Array::New(isolate);
-  	v8::Local<v8::Object> obj = v8::Object::New(isolate);
-    v8::Local<v8::Object> proto = v8::Local<v8::Object>::New(isolate, gQuadPrototype);
-  	if (!gQuadPrototype.IsEmpty()) obj->SetPrototype(proto);
+  	v8::Local<v8::Object> obj = NewClassObject(isolate, gQuadConstructor);
   	for (int i = 0; i<4; i++) {
 		v8::Local<v8::Object> q_p_ = v8_MakeJavascriptPoint(isolate, q.points[i]);
 		arr->Set(v8::Integer::New(isolate, i), q_p_);
@@ -242,9 +269,7 @@ v8::Local<v8::Object> v8_MakeJavascriptQuad(v8::Isolate* isolate, pdg::Quad& q)
 
 v8::Local<v8::Object> v8_MakeJavascriptColor(v8::Isolate* isolate, pdg::Color& c) {
     v8::EscapableHandleScope scope(isolate);
-  	v8::Local<v8::Object> obj = v8::Object::New(isolate);
-    v8::Local<v8::Object> proto = v8::Local<v8::Object>::New(isolate, gColorPrototype);
-  	if (!gColorPrototype.IsEmpty()) obj->SetPrototype(proto);
+  	v8::Local<v8::Object> obj = NewClassObject(isolate, gColorConstructor);
 	obj->Set(Red_Symbol,NUM2VAL(c.red));
 	obj->Set(Green_Symbol,NUM2VAL(c.green));
 	obj->Set(Blue_Symbol,NUM2VAL(c.blue));
@@ -252,6 +277,114 @@ v8::Local<v8::Object> v8_MakeJavascriptColor(v8::Isolate* isolate, pdg::Color& c
   	return scope.Escape(obj);
 }
 
+static void* GetTypedArrayData(v8::Local<v8::TypedArray> arr) {
+	return static_cast<char*>(arr->Buffer()->GetContents().Data()) + arr->ByteOffset();
+}
+
+float* v8_GetFloat32ArrayData(v8::Local<v8::Value> val, uint32& outLength) {
+	if (!val->IsFloat32Array()) {
+		outLength = 0;
+		return 0;
+	}
+	v8::Local<v8::Float32Array> arr = v8::Local<v8::Float32Array>::Cast(val);
+	outLength = (uint32)arr->Length();
+	return static_cast<float*>(GetTypedArrayData(arr));
+}
+
+uint32* v8_GetUint32ArrayData(v8::Local<v8::Value> val, uint32& outLength) {
+	if (!val->IsUint32Array()) {
+		outLength = 0;
+		return 0;
+	}
+	v8::Local<v8::Uint32Array> arr = v8::Local<v8::Uint32Array>::Cast(val);
+	outLength = (uint32)arr->Length();
+	return static_cast<uint32*>(GetTypedArrayData(arr));
+}
+
+uint8* v8_GetUint8ArrayData(v8::Local<v8::Value> val, uint32& outLength) {
+	if (!val->IsUint8Array()) {
+		outLength = 0;
+		return 0;
+	}
+	v8::Local<v8::Uint8Array> arr = v8::Local<v8::Uint8Array>::Cast(val);
+	outLength = (uint32)arr->Length();
+	return static_cast<uint8*>(GetTypedArrayData(arr));
+}
+
+static void FreeBufferData(char* data, void* hint) {
+	std::free(data);
+}
+
+v8::Local<v8::Object> v8_NewBuffer(v8::Isolate* isolate, void* data, size_t len, bool takeOwnership) {
+	v8::EscapableHandleScope scope(isolate);
+	v8::MaybeLocal<v8::Object> maybeBuf;
+	if (!data || (len == 0)) {
+		if (takeOwnership) {
+			std::free(data);
+		}
+		maybeBuf = node::Buffer::New(isolate, 0);
+	} else if (takeOwnership) {
+		maybeBuf = node::Buffer::New(isolate, static_cast<char*>(data), len, FreeBufferData, 0);
+	} else {
+		maybeBuf = node::Buffer::Copy(isolate, static_cast<const char*>(data), len);
+	}
+	v8::Local<v8::Object> buf;
+	if (!maybeBuf.ToLocal(&buf)) {
+		return buf;
+	}
+	return scope.Escape(buf);
+}
+
+// where to put count floats in a Float32Array starting at element index, or 0 if it isn't one or is too short
+static float* GetFloat32ArrayData(v8::Local<v8::Value> out, uint32 index, uint32 count) {
+	uint32 length;
+	float* data = v8_GetFloat32ArrayData(out, length);
+	if (!data || (index > length) || (count > length - index)) {
+		return 0;
+	}
+	return data + index;
+}
+
+bool v8_FillJavascriptOffset(v8::Isolate* isolate, pdg::Offset& o, v8::Local<v8::Value> out, uint32 index) {
+	if (out->IsFloat32Array()) {
+		float* data = GetFloat32ArrayData(out, index, 2);
+		if (!data) {
+			return false;
+		}
+		data[0] = o.x;
+		data[1] = o.y;
+		return true;
+	} else if (!out->IsObject() || out->IsArrayBufferView()) {
+		return false;
+	}
+	v8::Local<v8::Object> obj = out->ToObject();
+	obj->Set(X_Symbol,NUM2VAL(o.x));
+	obj->Set(Y_Symbol,NUM2VAL(o.y));
+	return true;
+}
+
+bool v8_FillJavascriptRect(v8::Isolate* isolate, pdg::Rect& r, v8::Local<v8::Value> out, uint32 index) {
+	if (out->IsFloat32Array()) {
+		float* data = GetFloat32ArrayData(out, index, 4);
+		if (!data) {
+			return false;
+		}
+		data[0] = r.left;
+		data[1] = r.top;
+		data[2] = r.right;
+		data[3] = r.bottom;
+		return true;
+	} else if (!out->IsObject() || out->IsArrayBufferView()) {
+		return false;
+	}
+	v8::Local<v8::Object> obj = out->ToObject();
+	obj->Set(Left_Symbol,NUM2VAL(r.left));
+	obj->Set(Top_Symbol,NUM2VAL(r.top));
+	obj->Set(Right_Symbol,NUM2VAL(r.right));
+	obj->Set(Bottom_Symbol,NUM2VAL(r.bottom));
+	return true;
+}
+
 v8::Local<v8::Value> MakeCppOffset(v8::Isolate* isolate, v8::Local<v8::Value> val, pdg::Offset& o, bool canFail) {
     v8::EscapableHandleScope scope(isolate);
 	if (val->IsArray()) {
@@ -71,6 +71,23 @@ v8::Local<v8::Object> v8_MakeJavascriptRect(v8::Isolate* isolate, pdg::RotatedRe
 v8::Local<v8::Object> v8_MakeJavascriptQuad(v8::Isolate* isolate, pdg::Quad& q);
 v8::Local<v8::Object> v8_MakeJavascriptColor(v8::Isolate* isolate, pdg::Color& c);
 
+// these fill in an object the caller already has instead of making a new one. Any object gets
+// the same fields the v8_MakeJavascript version would give it, and a Float32Array gets the
+// values in the same order starting at element index. They return false if out is neither,
+// or if the array doesn't have room
+bool v8_FillJavascriptOffset(v8::Isolate* isolate, pdg::Offset& o, v8::Local<v8::Value> out, uint32 index = 0);
+bool v8_FillJavascriptRect(v8::Isolate* isolate, pdg::Rect& r, v8::Local<v8::Value> out, uint32 index = 0);
+
+// the elements of a Float32Array, Uint32Array or Uint8Array (which includes node Buffers), with
+// the number of them in outLength. If val isn't that kind of array these return 0 with a length of 0
+float* v8_GetFloat32ArrayData(v8::Local<v8::Value> val, uint32& outLength);
+uint32* v8_GetUint32ArrayData(v8::Local<v8::Value> val, uint32& outLength);
+uint8* v8_GetUint8ArrayData(v8::Local<v8::Value> val, uint32& outLength);
+
+// make a node Buffer from len bytes of data. With takeOwnership the data, which must have come
+// from std::malloc(), is used in place and freed when the Buffer is collected, otherwise it's copied
+v8::Local<v8::Object> v8_NewBuffer(v8::Isolate* isolate, void* data, size_t len, bool takeOwnership);
+
 Offset  	v8_ValueToOffset(v8::Isolate* isolate, v8::Local<v8::Value> val);
 Point  		v8_ValueToPoint(v8::Isolate* isolate, v8::Local<v8::Value> val);
 Vector  	v8_ValueToVector(v8::Isolate* isolate, v8::Local<v8::Value> val);
@@ -66,8 +66,6 @@
 
 // Fine Tuning:
 //#define PDG_BASE_COORD_TYPE float  			// what the base type for coordinate elements is
-//#define MAX_FRAMES_PER_SPRITE 256				// individual animation frames (images)
-//#define MAX_BREAKABLE_JOINTS_PER_SPRITE 16	// max joints that can have a breakingForce set
 //#define PDG_NO_SERIALIZER_SANITY_CHECKS		// look for out of sync serialization
 //#define SPRITE_IGNORE_ANIMATION_TIMER_DRIFT	// use fixed time step rather than actual elapsed time
 //#define MAX_CACHED_STRING_TEXTURES 250		// largest number of strings that can be onscreen at once
@@ -135,6 +133,7 @@
 #include "pdg/sys/sprite.h"
 #include "pdg/sys/spritelayer.h"
 #include "pdg/sys/tilelayer.h"
+#include "pdg/sys/world.h"
 
 #ifndef PDG_NO_APP_FRAMEWORK
   // Application Framework
@@ -0,0 +1,83 @@
+// -----------------------------------------------
+// atomic.h
+//
+// Atomic counter operations for values shared between threads,
+// such as reference counts and stats
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+
+
+#ifndef PDG_ATOMIC_H_INCLUDED
+#define PDG_ATOMIC_H_INCLUDED
+
+#include "pdg_project.h"
+
+#include "pdg/sys/platform.h"
+#include "pdg/sys/mutex.h"
+
+// ==========================================================================================
+// PDG_ATOMIC_INC/DEC/ADD change a 32 bit integer in place and return the new value.
+// PDG_ATOMIC_CAS_PTR only stores the new pointer if the old one is still there, and
+// returns true if it did. All are full barriers. If the compiler doesn't give us atomics
+// then PDG_HAS_ATOMICS isn't defined, and these fall back to plain operations that
+// aren't thread safe.
+// ==========================================================================================
+#if defined( PDG_NO_THREAD_SAFETY )
+	#define PDG_HAS_ATOMICS 1
+	#define PDG_ATOMIC_INC(p)			(++(*(p)))
+	#define PDG_ATOMIC_DEC(p)			(--(*(p)))
+	#define PDG_ATOMIC_ADD(p, v)		((*(p)) += (v))
+	#define PDG_ATOMIC_CAS_PTR(p, o, n)	((*(p) == (o)) ? ((*(p) = (n)), true) : false)
+#elif defined( COMPILER_GCC ) && ( defined( __clang__ ) || (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 1) )
+	#define PDG_HAS_ATOMICS 1
+	#define PDG_ATOMIC_INC(p)			__sync_add_and_fetch((p), 1)
+	#define PDG_ATOMIC_DEC(p)			__sync_sub_and_fetch((p), 1)
+	#define PDG_ATOMIC_ADD(p, v)		__sync_add_and_fetch((p), (v))
+	#define PDG_ATOMIC_CAS_PTR(p, o, n)	__sync_bool_compare_and_swap((p), (o), (n))
+#elif defined( PLATFORM_WIN32 )
+	#define PDG_HAS_ATOMICS 1
+	#define PDG_ATOMIC_INC(p)			WinAPI::InterlockedIncrement((volatile LONG*)(p))
+	#define PDG_ATOMIC_DEC(p)			WinAPI::InterlockedDecrement((volatile LONG*)(p))
+	#define PDG_ATOMIC_ADD(p, v)		(WinAPI::InterlockedExchangeAdd((volatile LONG*)(p), (LONG)(v)) + (LONG)(v))
+	#define PDG_ATOMIC_CAS_PTR(p, o, n)	(WinAPI::InterlockedCompareExchangePointer((volatile PVOID*)(p), (PVOID)(n), (PVOID)(o)) == (PVOID)(o))
+#else
+	#define PDG_ATOMIC_INC(p)			(++(*(p)))
+	#define PDG_ATOMIC_DEC(p)			(--(*(p)))
+	#define PDG_ATOMIC_ADD(p, v)		((*(p)) += (v))
+	#define PDG_ATOMIC_CAS_PTR(p, o, n)	((*(p) == (o)) ? ((*(p) = (n)), true) : false)
+#endif
+
+// ==========================================================================================
+// PDG_THREAD_LOCAL gives each thread its own copy of a static POD variable. It isn't
+// defined if the compiler can't do that
+// ==========================================================================================
+#if defined( PDG_NO_THREAD_SAFETY )
+	#define PDG_THREAD_LOCAL
+#elif defined( COMPILER_GCC )
+	#define PDG_THREAD_LOCAL			__thread
+#elif defined( COMPILER_MSVC )
+	#define PDG_THREAD_LOCAL			__declspec(thread)
+#endif
+
+#endif // PDG_ATOMIC_H_INCLUDED
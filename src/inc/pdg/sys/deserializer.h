@@ -44,6 +44,8 @@
 
 namespace pdg {
 	
+	class ObjectRegistry;
+
 	//! A class to serialize data into memory
 	//! \ingroup Serialization
 	class Deserializer : public IDeserializer {
@@ -170,8 +172,21 @@ namespace pdg {
 		// data methods
 		// --------------------------------------------
 		
-		void setDataPtr(void* ptr, uint32 ptrSize);
+		//! Start reading a new stream
+		/*! By default the Deserializer takes ownership of ptr, which must have been allocated
+		    with std::malloc(), and frees it when given new data or deleted. Pass false for
+		    takeOwnership to read from memory that belongs to someone else, which must then
+		    stay valid until the Deserializer is done with it
+		 */
+		void setDataPtr(void* ptr, uint32 ptrSize, bool takeOwnership = true);
 		
+		//! Register an object for deserialize_ref() from this stream only
+		/*! Works like IDeserializer::registerObject(), but the registration goes away with the
+		    Deserializer, so per connection objects don't pile up in the global registry.
+		    Objects registered here are checked before the global ones
+		 */
+		void registerStreamObject(void* obj, uint32 uniqueId);
+
 		// --------------------------------------------
 		// constructors
 		// --------------------------------------------
@@ -195,11 +210,13 @@ namespace pdg {
 		uint8* mDataEnd;
 		uint8* p;   // current position in pointer
 		uint32 mDataSize;
+		bool   mOwnsData;
 		uint8  mLastBoolByte;
 		int mBoolBitOffset;
 		bool mUsingTags;
 		
 		std::vector<ISerializable*> mDeserializedInstances;
+		ObjectRegistry* mStreamObjects;
 	};
 	
 } // end namespace pdg
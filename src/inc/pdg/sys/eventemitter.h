@@ -35,8 +35,9 @@
 
 #include "pdg/msvcfix.h"  // fix non-standard MSVC
 
-#include <map>
-#include <list>
+#include "pdg/sys/global_types.h"
+
+#include <vector>
 
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 #include "pdg_script_bindings.h"
@@ -91,7 +92,7 @@ public:
 
 // lifecycle
     //! constructor for new event emitter
-    EventEmitter() : mHandlers(), mHandlerRemoved(false) {
+    EventEmitter() : mHandlers(), mHandledTypes(0), mEmitDepth(0), mHandlerRemoved(false) {
     	#ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
     		INIT_SCRIPT_OBJECT(mEventEmitterScriptObj);
     	#endif
@@ -116,23 +117,52 @@ protected:
 
 	virtual void cleanupRemovedHandlers();
 
+	// quick conservative check, false means there is definitely no handler (or block) for the type
+	bool hasHandlersFor(long inEventType) const {
+		return (mHandledTypes & (typeBit(inEventType) | typeBit(all_events))) != 0;
+	}
+
 	struct EventHandlerInfo {
 		IEventHandler*  handler;
 		bool			removed;
 		EventHandlerInfo(IEventHandler *inHandler) : handler(inHandler), removed(false) {}
 		EventHandlerInfo() : handler(), removed(false) {}
 	};
-	typedef std::list<EventHandlerInfo> HandlerListT;
+	typedef std::vector<EventHandlerInfo> HandlerListT;
 	struct EventHandlingInfo {
+		long			eventType;
 		HandlerListT    handlerList;
 		bool            blocked;
 		bool			handlerRemoved;
-		EventHandlingInfo(HandlerListT lst) : handlerList(lst), blocked(false), handlerRemoved(false) {}
-		EventHandlingInfo() : handlerList(), blocked(false), handlerRemoved(false) {}
+		EventHandlingInfo(long inType) : eventType(inType), handlerList(), blocked(false), handlerRemoved(false) {}
+	};
+	// most emitters only ever have handlers for a few event types, so this is just
+	// searched in order rather than being a map
+	typedef std::vector<EventHandlingInfo> HandlerTableT;
+
+	// one bit per event type in mHandledTypes, with all the higher numbered types sharing the last bit
+	static uint32 typeBit(long inEventType) {
+		return ((inEventType >= 0) && (inEventType < 31)) ? (1U << inEventType) : (1U << 31);
+	}
+	int  findHandlingInfo(long inEventType) const;  // index in mHandlers, or -1 if not there
+	int  addHandlingInfo(long inEventType);         // index of new or existing entry
+	bool dispatchToHandlers(int infoIndex, EventEmitter* emitter, long inEventType, void* inEventData);
+
+	// counts an emitEvent() in mEmitDepth for as long as it runs, and takes it back out however
+	// emitEvent() is left, even if a handler throws, so removed handlers still get cleaned up
+	class EmitDepthGuard {
+	public:
+		EmitDepthGuard(EventEmitter* emitter) : mEmitter(emitter) { mEmitter->mEmitDepth++; }
+		~EmitDepthGuard() {
+			mEmitter->mEmitDepth--;
+			mEmitter->cleanupRemovedHandlers();
+		}
+		EventEmitter* mEmitter;
 	};
-	typedef std::map<long, EventHandlingInfo> HandlerMapT;
 
-    HandlerMapT     mHandlers;
+    HandlerTableT   mHandlers;
+    uint32          mHandledTypes;    // which types have an entry in mHandlers, see typeBit()
+    int             mEmitDepth;       // removed handlers are only cleaned up once this is back to 0
 	bool			mHandlerRemoved;
 /// @endcond
 };
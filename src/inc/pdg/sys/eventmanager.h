@@ -42,8 +42,7 @@
 // define PDG_NO_EVENT_QUEUE in your build environment if you don't
 // need multithreaded safe event queues
 #ifndef PDG_NO_EVENT_QUEUE
-#include <queue>
-#include "pdg/sys/mutex.h"
+#include "pdg/sys/eventqueue.h"
 #endif // PDG_NO_EVENT_QUEUE
 
 //! \defgroup Managers
@@ -93,12 +92,21 @@ public:
 	virtual bool postEventToEmitter(long inEventType, void* inEventData, EventEmitter* toEmitter);
 
 #ifndef PDG_NO_EVENT_QUEUE
-    //! mutexed for posting events between threads, makes copy of the data
+    //! lock-free, for posting events between threads, takes ownership of the data
     void enqueueEvent(long inEventType, UserData* inEventData, EventEmitter* inEmitter);
     
-	//! mutexed for posting events between threads, must call std::free() on the data
+	//! main thread only, takes the oldest queued event, must call release() on the data
     //! returns false when there are no more events in the queue
     bool getQueuedEvent(long& outEventType, UserData*& outEventData, EventEmitter*& outEmitter);
+
+	//! main thread only, takes every event currently queued in a single pass and
+	//! appends them to outEvents in the order they were posted. Must call release()
+	//! on the data of each one. Returns the number of events added
+	int getQueuedEvents(EventQueueEntryListT& outEvents);
+
+	//! main thread only, posts everything in the queue to its emitter and releases the
+	//! data, including any events queued by the handlers. Returns the number posted
+	int dispatchQueuedEvents();
   #endif // PDG_NO_EVENT_QUEUE
 
 // lifecycle
@@ -113,18 +121,8 @@ protected:
     EventManager() {};
 
   #ifndef PDG_NO_EVENT_QUEUE
-	struct EventQueueEntry {
-		long			eventType;
-		UserData*   	userData;
-		EventEmitter*	emitter;
-		EventQueueEntry(long inEventType, UserData* inUserData, EventEmitter* inEmitter) 
-			: eventType(inEventType), userData(inUserData), emitter(inEmitter) {}
-		EventQueueEntry() : eventType(0), userData(0), emitter(0) {}
-	};
-	typedef std::queue<EventQueueEntry> EventQueueT;
-
-    EventQueueT     mEventQueue;
-    Mutex           mEventQueueMutex;
+    EventQueue				mEventQueue;
+    EventQueueEntryListT	mDispatchBatch;
   #endif // PDG_NO_EVENT_QUEUE
 /// @endcond
 };
@@ -0,0 +1,268 @@
+// -----------------------------------------------
+// eventqueue.h
+//
+// Bounded lock-free multi-producer, single-consumer queue
+// used by the EventManager to pass events between threads
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+
+
+#ifndef PDG_EVENTQUEUE_H_INCLUDED
+#define PDG_EVENTQUEUE_H_INCLUDED
+
+#include "pdg_project.h"
+
+#include "pdg/sys/platform.h"
+#include "pdg/sys/global_types.h"
+#include "pdg/sys/mutex.h"
+
+#include <vector>
+
+// number of events the lock-free ring can hold, must be a power of 2
+// anything posted while the ring is full goes to a mutexed overflow list instead
+#ifndef EVENT_QUEUE_DEFAULT_CAPACITY
+#define EVENT_QUEUE_DEFAULT_CAPACITY	4096
+#endif
+
+// ==========================================================================================
+// Atomic operations used by the queue. If the compiler doesn't give us any we fall back
+// to always using the mutexed overflow list, which is no worse than the old std::queue
+// ==========================================================================================
+#if defined( PDG_NO_THREAD_SAFETY )
+	#define PDG_EVENT_QUEUE_ATOMICS 1
+	#define EVENT_QUEUE_LOAD(p)			(*(p))
+	#define EVENT_QUEUE_STORE(p, v)		(*(p) = (v))
+	#define EVENT_QUEUE_CAS(p, o, n)	((*(p) == (o)) ? ((*(p) = (n)), true) : false)
+	#define EVENT_QUEUE_YIELD()
+#elif defined( COMPILER_GCC ) && ( defined( __clang__ ) || (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7) )
+	#include <sched.h>
+	#define PDG_EVENT_QUEUE_ATOMICS 1
+	#define EVENT_QUEUE_LOAD(p)			__atomic_load_n((p), __ATOMIC_ACQUIRE)
+	#define EVENT_QUEUE_STORE(p, v)		__atomic_store_n((p), (v), __ATOMIC_RELEASE)
+	#define EVENT_QUEUE_CAS(p, o, n)	__sync_bool_compare_and_swap((p), (o), (n))
+	#define EVENT_QUEUE_YIELD()			sched_yield()
+#elif defined( PLATFORM_WIN32 )
+	// volatile reads and writes have acquire and release semantics with MSVC
+	#define PDG_EVENT_QUEUE_ATOMICS 1
+	#define EVENT_QUEUE_LOAD(p)			(*(p))
+	#define EVENT_QUEUE_STORE(p, v)		(*(p) = (v))
+	#define EVENT_QUEUE_CAS(p, o, n)	(WinAPI::InterlockedCompareExchange((volatile LONG*)(p), (LONG)(n), (LONG)(o)) == (LONG)(o))
+	#define EVENT_QUEUE_YIELD()			WinAPI::Sleep(0)
+#else
+	#define EVENT_QUEUE_LOAD(p)			(*(p))
+	#define EVENT_QUEUE_STORE(p, v)		(*(p) = (v))
+#endif
+
+namespace pdg {
+
+class UserData;
+class EventEmitter;
+
+struct EventQueueEntry {
+	long			eventType;
+	UserData*   	userData;
+	EventEmitter*	emitter;
+	EventQueueEntry(long inEventType, UserData* inUserData, EventEmitter* inEmitter)
+		: eventType(inEventType), userData(inUserData), emitter(inEmitter) {}
+	EventQueueEntry() : eventType(0), userData(0), emitter(0) {}
+};
+
+typedef std::vector<EventQueueEntry> EventQueueEntryListT;
+
+// -----------------------------------------------------------------------------------
+// Event Queue
+// Any number of threads can push() at once without taking a lock. Only one thread
+// (the main thread) may take events out, either all at once with drain() or one at
+// a time with pop(). Events from any single thread always come out in the order that
+// thread pushed them.
+// The ring is bounded; when it fills up events go to an overflow list under a mutex
+// until the consumer catches up, so a push never fails and never blocks waiting for
+// the consumer, which matters because the main thread posts to the queue too
+// -----------------------------------------------------------------------------------
+
+class EventQueue {
+public:
+	EventQueue(uint32 capacity = EVENT_QUEUE_DEFAULT_CAPACITY);
+	~EventQueue() { delete [] mSlots; }
+
+	//! add an event, safe to call from any thread
+	void	push(const EventQueueEntry& entry);
+
+	//! move everything currently in the queue onto the end of outEntries in a single pass
+	//! returns the number of entries added. Consumer thread only
+	int		drain(EventQueueEntryListT& outEntries);
+
+	//! take the oldest event from the queue, returns false if the queue is empty.
+	//! Consumer thread only
+	bool	pop(EventQueueEntry& outEntry);
+
+	uint32	getCapacity() const { return mMask + 1; }
+
+/// @cond INTERNAL
+private:
+	struct Slot {
+		volatile uint32		sequence;
+		EventQueueEntry		entry;
+	};
+
+	void	drainQueue(EventQueueEntryListT& outEntries);
+
+	// not copyable
+	EventQueue(const EventQueue&);
+	EventQueue& operator=(const EventQueue&);
+
+	Slot*					mSlots;
+	uint32					mMask;
+	// keep the producer and consumer positions on separate cache lines
+	char					mPad0[64];
+	volatile uint32			mEnqueuePos;
+	char					mPad1[64];
+	uint32					mDequeuePos;
+	volatile uint32			mOverflowed;
+	Mutex					mOverflowMutex;
+	EventQueueEntryListT	mOverflow;
+	EventQueueEntryListT	mOverflowDrain;
+	EventQueueEntryListT	mPopped;
+	size_t					mPoppedIndex;
+/// @endcond
+};
+
+inline
+EventQueue::EventQueue(uint32 capacity)
+ :	mSlots(0),
+	mMask(0),
+	mEnqueuePos(0),
+	mDequeuePos(0),
+	mOverflowed(0),
+	mPoppedIndex(0)
+{
+	uint32 size = 2;
+	while (size < capacity) {
+		size <<= 1;
+	}
+	mSlots = new Slot[size];
+	mMask = size - 1;
+	for (uint32 i = 0; i < size; i++) {
+		mSlots[i].sequence = i;
+	}
+}
+
+inline void
+EventQueue::push(const EventQueueEntry& entry) {
+  #ifdef PDG_EVENT_QUEUE_ATOMICS
+	// once anything has gone into the overflow list everything else has to follow it
+	// there until the consumer empties it, otherwise events could get out of order
+	if (EVENT_QUEUE_LOAD(&mOverflowed) == 0) {
+		uint32 pos = EVENT_QUEUE_LOAD(&mEnqueuePos);
+		for (;;) {
+			Slot& slot = mSlots[pos & mMask];
+			int32 diff = (int32)(EVENT_QUEUE_LOAD(&slot.sequence) - pos);
+			if (diff == 0) {
+				// slot is free, try to claim it
+				if (EVENT_QUEUE_CAS(&mEnqueuePos, pos, pos + 1)) {
+					slot.entry = entry;
+					EVENT_QUEUE_STORE(&slot.sequence, pos + 1);
+					return;
+				}
+			} else if (diff < 0) {
+				// the consumer hasn't gotten to this slot yet, the ring is full
+				break;
+			}
+			// someone else got there first
+			pos = EVENT_QUEUE_LOAD(&mEnqueuePos);
+		}
+	}
+  #endif // PDG_EVENT_QUEUE_ATOMICS
+	AutoMutex lock(&mOverflowMutex);
+	EVENT_QUEUE_STORE(&mOverflowed, 1);
+	mOverflow.push_back(entry);
+}
+
+inline int
+EventQueue::drain(EventQueueEntryListT& outEntries) {
+	size_t startCount = outEntries.size();
+	// anything left over from pop() is older than what is still in the queue
+	if (mPoppedIndex < mPopped.size()) {
+		outEntries.insert(outEntries.end(), mPopped.begin() + mPoppedIndex, mPopped.end());
+	}
+	mPopped.clear();
+	mPoppedIndex = 0;
+	drainQueue(outEntries);
+	return (int)(outEntries.size() - startCount);
+}
+
+inline void
+EventQueue::drainQueue(EventQueueEntryListT& outEntries) {
+  #ifdef PDG_EVENT_QUEUE_ATOMICS
+	// the end position has to be read while holding the overflow lock, so that everything a
+	// thread put in the ring before it started using the overflow list is taken this pass
+	uint32 endPos;
+	if (EVENT_QUEUE_LOAD(&mOverflowed) != 0) {
+		AutoMutex lock(&mOverflowMutex);
+		endPos = EVENT_QUEUE_LOAD(&mEnqueuePos);
+		mOverflowDrain.swap(mOverflow);
+		EVENT_QUEUE_STORE(&mOverflowed, 0);
+	} else {
+		endPos = EVENT_QUEUE_LOAD(&mEnqueuePos);
+	}
+	while (mDequeuePos != endPos) {
+		Slot& slot = mSlots[mDequeuePos & mMask];
+		// the slot may have been claimed by a producer that hasn't finished writing it yet
+		while ((int32)(EVENT_QUEUE_LOAD(&slot.sequence) - (mDequeuePos + 1)) < 0) {
+			EVENT_QUEUE_YIELD();
+		}
+		outEntries.push_back(slot.entry);
+		EVENT_QUEUE_STORE(&slot.sequence, mDequeuePos + mMask + 1);
+		mDequeuePos++;
+	}
+  #else
+	{
+		AutoMutex lock(&mOverflowMutex);
+		mOverflowDrain.swap(mOverflow);
+		EVENT_QUEUE_STORE(&mOverflowed, 0);
+	}
+  #endif // PDG_EVENT_QUEUE_ATOMICS
+	if (!mOverflowDrain.empty()) {
+		outEntries.insert(outEntries.end(), mOverflowDrain.begin(), mOverflowDrain.end());
+		mOverflowDrain.clear();
+	}
+}
+
+inline bool
+EventQueue::pop(EventQueueEntry& outEntry) {
+	if (mPoppedIndex >= mPopped.size()) {
+		mPopped.clear();
+		mPoppedIndex = 0;
+		drainQueue(mPopped);
+		if (mPopped.empty()) {
+			return false;
+		}
+	}
+	outEntry = mPopped[mPoppedIndex++];
+	return true;
+}
+
+} // end namespace pdg
+
+#endif // PDG_EVENTQUEUE_H_INCLUDED
@@ -404,6 +404,17 @@ struct SpriteJointBreakInfo PDG_SUBCLASS_OF( SpriteAnimateInfo ) {
 PDG_CLASS_TYPEDEF(SpriteJointBreakInfo)
 #endif
 
+//! Event Data for eventType_SpriteAnimate with the Sprite::action_EnterObserver and
+//! Sprite::action_ExitObserver actions.
+//! \ingroup Events
+//! \ingroup Sprites
+struct SpriteObserverInfo PDG_SUBCLASS_OF( SpriteAnimateInfo ) {
+	PDG_INHERITED_FIELDS_FROM(SpriteAnimateInfo)
+	//! the observer the sprite entered or left the area of, from SpriteLayer::addObserver()
+	uint32		observerId;
+};
+PDG_CLASS_TYPEDEF(SpriteObserverInfo)
+
 //! Event Data for eventType_SpriteLayer.
 //! \ingroup Events
 //! \ingroup Animation
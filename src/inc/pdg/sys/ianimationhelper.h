@@ -35,6 +35,7 @@
 
 #include "pdg/sys/global_types.h"
 #include "pdg/sys/serializable.h"
+#include "pdg/sys/ideserializer.h"
 
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 #include "pdg_script_bindings.h"
@@ -99,6 +100,7 @@ public:
 	}
 
     virtual ~IAnimationHelper() {
+				pdg::IDeserializer::unregisterObject(this);  // in case it was registered for serialize_ref()
 				#ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 					CleanupIAnimationHelperScriptObject(mIAnimationHelperScriptObj);
 				#endif
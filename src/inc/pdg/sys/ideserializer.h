@@ -257,12 +257,20 @@ namespace pdg {
 		
 		//! Register object that is not serializable for use with |de|serialize_ref()
 		/*! \param uniqueId a 32 bit value that uniquely identifies this object
-		   Calling this twice with the same uniqueId will replace the old value.
+		   Calling this twice with the same uniqueId will replace the old value, and
+		   registering an object that already has an id moves it to the new id.
 		   These values are then sent instead of the object data or pointer. On
 		   deserialization, the object registered to that id on the receiver is used.
 		 */
 		static void registerObject(void* obj, uint32 uniqueId);
 
+		//! Remove an object registered with registerObject()
+		/*! Call this before the object is destroyed, so a later object that happens to get
+		    the same address isn't sent using the old object's id. Images, Sprites, SpriteLayers
+		    and sprite helpers do this themselves when they are destroyed
+		 */
+		static void unregisterObject(const void* obj);
+
 	protected:
 		virtual char* statusDump(int hiliteBytes = 0) = 0;
 		virtual void* deserialize_ptr() MAY_THROW( (out_of_data, bad_tag, sync_error, unknown_object) ) = 0;
@@ -40,6 +40,7 @@
 #include "pdg/sys/refcounted.h"
 #include "pdg/sys/color.h"
 #include "pdg/sys/serializable.h"
+#include "pdg/sys/ideserializer.h"
 
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 #include "pdg_script_bindings.h"
@@ -239,6 +240,7 @@ Image::Image()
 inline  
 Image::~Image() {
 //                DEBUG_ONLY( OS::_DOUT("dt Image %p", this); )
+	IDeserializer::unregisterObject(this);  // in case it was registered for serialize_ref()
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 	CleanupImageScriptObject(mImageScriptObj);
 #endif
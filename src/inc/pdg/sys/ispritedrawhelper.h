@@ -35,6 +35,7 @@
 
 #include "pdg/sys/global_types.h"
 #include "pdg/sys/coordinates.h"
+#include "pdg/sys/ideserializer.h"
 
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 #include "pdg_script_bindings.h"
@@ -102,6 +103,7 @@ public:
 	}
 
     virtual ~ISpriteDrawHelper() {
+				pdg::IDeserializer::unregisterObject(this);  // in case it was registered for serialize_ref()
 				#ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 					CleanupISpriteDrawHelperScriptObject(mISpriteDrawHelperScriptObj);
 				#endif
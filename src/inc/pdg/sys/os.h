@@ -150,6 +150,12 @@ public:
 	
 	// Get a millisecond time stamp
     static ms_time  getMilliseconds();
+
+	// Get a time stamp in milliseconds with sub-millisecond precision, for timing short operations
+    static double   getPreciseMilliseconds();
+
+	// Get the number of processor cores currently available to this process, always at least 1
+    static uint32   getProcessorCount();
 	
 	// Get the position of the mouse. 
 	// On a multi-touch interface, mouseNumber specifies which pointer/finger, in order they started touching
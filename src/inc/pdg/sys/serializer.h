@@ -40,6 +40,8 @@
 #endif
 
 namespace pdg {
+
+	class ObjectRegistry;
 	
 	// ==============================================
 	// Serializer class
@@ -201,6 +203,47 @@ namespace pdg {
 		uint8* getDataPtr() { return mDataPtr; }
 		size_t getDataSize() { return (mDataPtr) ? p - mDataPtr : 0; }
 		
+		//! How many bytes the serializer can hold before it has to grow its buffer
+		size_t getCapacity() const { return mAllocatedSize; }
+
+		//! Make sure at least this many bytes in total can be written without growing the buffer
+		/*! Useful when you know roughly how big a stream will be, such as a layer update that
+		    is sent every tick, so that the buffer is allocated once up front
+		 */
+		void   reserve(size_t bytes);
+
+		//! Discard everything written so far and start a new stream, keeping the buffer
+		/*! This lets one Serializer be reused for a stream that is rebuilt over and over
+		    (ie: once per tick) without reallocating. Object references from the previous
+		    stream are forgotten. The new stream uses tags if the previous one did, call
+		    setSendTags() after reset() to change that
+		 */
+		void   reset();
+
+		//! Hand the serialized data over to the caller and start a new stream
+		/*! Returns the buffer holding everything written so far, with its size in outSize, without
+		    copying it. The caller owns the buffer and must release it with std::free(). Afterwards the
+		    Serializer is empty, as if reset() had been called, and allocates a new buffer when it
+		    is next written to. Returns 0 if nothing has been written
+		 */
+		uint8* releaseData(size_t& outSize);
+
+		//! Choose how serialize_obj() writes the length of an object's data
+		/*! When streaming (the default), the object is written in a single pass and its length is filled
+		    in afterwards. When not streaming, getSerializedSize() is called on the object first to get
+		    the length, which means every object is effectively walked twice. The resulting stream
+		    is the same either way, provided the object's getSerializedSize() is accurate
+		 */
+		Serializer& setStreaming(bool streamIt) { mStreaming = streamIt; return *this; }
+		bool   isStreaming() const { return mStreaming; }
+
+		//! Register an object for serialize_ref() in this stream only
+		/*! Works like IDeserializer::registerObject(), but the registration goes away with the
+		    Serializer, so per connection objects don't pile up in the global registry.
+		    Objects registered here are checked before the global ones, and are kept across reset()
+		 */
+		void   registerStreamObject(void* obj, uint32 uniqueId);
+
 		// --------------------------------------------
 		// constructors
 		// --------------------------------------------
@@ -219,10 +262,14 @@ namespace pdg {
 		virtual int bytesFromMark();
 		virtual void serialize_ptr(const void* ptr);
 		virtual uint32 sizeof_ptr(const void* ptr) const;
+		uint32 findObjectId(const void* ptr) const;
 
 		// Make sure there is space to write 
 		virtual void  ensureSpace(size_t bytes);
 		
+		// grow the buffer so it can hold at least this many bytes in total
+		void  growTo(size_t bytes);
+
 		uint8* mDataPtr;
 		uint8* mDataEnd;
 		uint8* p;   // current position in pointer
@@ -239,6 +286,9 @@ namespace pdg {
 		int mBoolBitOffset;
 		mutable int mBoolSizeCount;
 		bool mUsingTags;
+		bool mStreamStarted;
+		bool mStreaming;
+		ObjectRegistry* mStreamObjects;
 	};
 
 		
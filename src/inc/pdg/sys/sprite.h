@@ -52,6 +52,7 @@
 
 #include <cmath>  // for sin() and cos()
 #include <limits> // for infinity()
+#include <vector>
 
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 #include "pdg_script_bindings.h"
@@ -67,12 +68,11 @@
 #include "SCML_pdg.h"
 #endif
 
-#define MAX_FRAMES_PER_SPRITE 256
-#define MAX_BREAKABLE_JOINTS_PER_SPRITE 16
-
 namespace pdg {
 
 class ImageImpl;  // internal implementation class
+class CollisionGrid;  // internal implementation class
+class SpriteIndex;  // internal implementation class
 
 // -----------------------------------------------------------------------------------
 // Sprite
@@ -86,6 +86,9 @@ class Sprite : public EventEmitter, public Animated {
     friend class SpriteLayer;
     friend class TileLayer;
     friend class SpriteManager;
+    friend class CollisionGrid;
+    friend class SpriteIndex;
+    friend class World;
 public:
 
 	SERIALIZABLE_TAG( CLASSTAG_SPRITE );
@@ -124,6 +127,8 @@ public:
 		action_FadeInComplete = 11,
 		action_FadeOutComplete = 12,
         action_JointBreak = 13,     // only available with chipmunk physics
+		action_EnterObserver = 14,	// has come into an observer's area, see SpriteLayer::addObserver()
+		action_ExitObserver = 15,	// has left an observer's area
 
 		// touch types for SpritTouchInfo
 		touch_MouseEnter = 20, /** NOT IMPLEMENTED **/
@@ -275,7 +280,7 @@ public:
     
     SpriteLayer* getLayer() { return mLayer; }
 
-	long spriteId;
+	long spriteId;	// if you change this after adding the sprite to a layer, call layer->updateSpriteIndex()
 	
 	bool wantsMouseOver;
 	bool wantsClicks;
@@ -394,9 +399,6 @@ protected:
     cpSpace*        getSpace();
     
     // override these to set values in chipmunk
-	virtual void	locationChanged(const Offset& delta);
-	virtual void	sizeChanged(float deltaW, float deltaH);
-	virtual void	rotationChanged(float deltaRadians);
 	virtual void	centerChanged(const Offset& delta);
     
     // hide these since they don't do what is expected
@@ -412,14 +414,22 @@ protected:
     void			initCpBody();
     void			freeCpBody();
 
-    cpConstraint*   mBreakableJoints[MAX_BREAKABLE_JOINTS_PER_SPRITE];
-    int             mNumBreakableJoints;
+    std::vector<cpConstraint*> mBreakableJoints;
     long            mCollideGroup;
     bool            mStatic;
+    // where the body was before the last fixed physics step, for interpolation
+    cpVect          mPrevPhysicsPos;
+    float           mPrevPhysicsAngle;
+    uint32          mPrevPhysicsStamp;  // matches World::mPhysicsStamp when valid
   #endif
 
     virtual ~Sprite();
 
+	// overridden to track changes for delta serialization, and to set values in chipmunk
+	virtual void	locationChanged(const Offset& delta);
+	virtual void	sizeChanged(float deltaW, float deltaH);
+	virtual void	rotationChanged(float deltaRadians);
+
 	// checks to see if the movingSprite collides with any features of the spriteLayer.  
 	//	Determines the number of pixels that overlap based on the specified alphaThreshold
 	//AB 10/2/10 - currently only returns 0 or 1
@@ -434,6 +444,10 @@ protected:
 	bool collidesWith(Sprite* sprite);
 	
 	bool collidesWith(const Point& p);
+
+	// narrow phase check against another sprite, imparting the collision impulse and
+	// notifying the layer if they do collide
+	void collideWithSprite(Sprite* otherSprite, float elapsedSecs, bool sendImmediately = false);
 	
 	void recalcOnscreenAndInBounds();
     
@@ -458,8 +472,22 @@ protected:
     } FrameInfoT;
 
 
+	// frame table, sized to the actual number of frames and shared copy-on-write
+	// between sprites that are cloned from one another
+	struct FrameTableT {
+		int32 refCount;		// only changed with PDG_ATOMIC_INC/DEC, sprites in other worlds may share it
+		std::vector<FrameInfoT> frames;
+		FrameTableT() : refCount(1) {}
+		~FrameTableT();
+	};
+
+	void			setFrameTable(FrameTableT* table);
+	void			makeFramesWritable();	// call before changing anything in mFrames
+	void			copyFrom(const Sprite* original);
+
 	// animation data
-	FrameInfoT		mFrames[MAX_FRAMES_PER_SPRITE];
+	FrameTableT*	mFrameTable;
+	FrameInfoT*		mFrames;	// the frames in mFrameTable, or 0 if there are none
 	float			mFps;
 	float			mCurrFramePrecise;
 	int				mCurrFrame;
@@ -506,6 +534,49 @@ protected:
 	bool mOnscreen;
 	bool mInBounds;
 	bool mCompletelyInBounds;
+
+	// conservative axis aligned bounds that enclose anything collidesWith() could check,
+	// regardless of rotation or collision type
+	Rect getCollisionBounds();
+
+	// keep the layer's CollisionGrid current, called whenever our collision bounds might change
+	void	gridBoundsChanged();
+
+	// broad phase data, maintained by the layer's CollisionGrid
+	Rect	mGridBounds;
+	int		mGridCellLeft;
+	int		mGridCellTop;
+	int		mGridCellRight;
+	int		mGridCellBottom;
+	uint32	mGridQueryStamp;
+	bool	mGridOversized;
+	bool	mInGrid;
+
+	// lookup data, maintained by the layer's SpriteIndex
+	uint32	mIndexedIid;
+	long	mIndexedId;
+	bool	mIndexed;
+	// position in the layer's z-order, only valid while the layer's z-order cache is
+	int		mZIndex;
+
+	// delta serialization, see SpriteLayer::takeSnapshot()
+	enum {
+		dirty_Location =	1 << 0,
+		dirty_Facing =		1 << 1,
+		dirty_Frame =		1 << 2,
+		dirty_Size =		1 << 3,
+		dirty_Created =		1 << 4,	// new to the client, the delta also has what's needed to create it
+		dirty_All = dirty_Location | dirty_Facing | dirty_Frame | dirty_Size | dirty_Created,
+		num_DirtyFields = 5
+	};
+	void	commitChanges(uint32 snapshotId);	// stamp the fields changed since the last snapshot
+	uint32	getDeltaFields(uint32 baselineId) const;	// fields changed after the baseline snapshot
+	uint32	getDeltaSize(ISerializer* serializer, uint32 fields) const;
+	void	serializeDelta(ISerializer* serializer, uint32 fields) const;
+	// reads the fields, and applies them to sprite unless it is 0
+	static void	deserializeDelta(IDeserializer* deserializer, uint32 fields, Sprite* sprite);
+	uint32	mFieldChangedAt[num_DirtyFields];	// snapshot id each field last changed in
+	uint8	mDirtyFields;	// fields changed since the last snapshot
 	
 	uint32 iid;
 
@@ -51,6 +51,14 @@
 #endif
 
 #include <vector>
+#include <deque>
+#include <list>
+
+// versions of the SpriteLayer stream, Sprites need these too since they are read as part of it
+#define PDG_SPRITE_LAYER_STREAM_V_1		0
+#define PDG_SPRITE_LAYER_STREAM_V_2		1	// frame counts and frame numbers are variable length uints
+// add new versions here
+#define PDG_SPRITE_LAYER_STREAM_VERSION	PDG_SPRITE_LAYER_STREAM_V_2
 
 namespace pdg {
 
@@ -60,7 +68,10 @@ class Port;
 class Sprite;
 class SpriteLayer;
 class SpriteManager;
+class World;
 class TimerManager;
+class CollisionGrid;
+class SpriteIndex;
 
 /// @cond INTERNAL
 struct LinkedLayerInfo {
@@ -87,11 +98,23 @@ enum {
 	ser_SCMLData =		1 << 12, // send the SCML data
 	ser_HelperObjs = 	1 << 13, // send the helper objects (which must be serializable)
 	ser_InitialData =   1 << 14, // send whatever is needed to initialize everything
+	ser_Delta =			1 << 15, // only what changed since the baseline snapshot, see SpriteLayer::takeSnapshot()
 	ser_Micro =	ser_Positions | ser_ZOrder,
 	ser_Update = ser_Micro | ser_Sizes | ser_Animations | ser_Motion | ser_Forces | ser_Physics,
 	ser_Full = ser_Update | ser_ImageRefs | ser_SCMLRefs | ser_HelperRefs | ser_InitialData
 };
 
+// layout of each sprite's state for SpriteLayer::getSpriteStates() and setSpriteStates()
+enum {
+	spriteState_X,			// location
+	spriteState_Y,
+	spriteState_VelocityX,	// per second
+	spriteState_VelocityY,
+	spriteState_Facing,		// rotation in radians
+	spriteState_Frame,
+	spriteState_Size		// number of floats for each sprite
+};
+
 // -----------------------------------------------------------------------------------
 // Sprite Layer
 // Used to create and track collections of sprites
@@ -100,12 +123,41 @@ enum {
 class SpriteLayer : public EventEmitter, public Animated, public Serializable<SpriteLayer> {
 friend class Sprite;
 friend class SpriteManager;
+friend class World;
 public:
     
 	SERIALIZABLE_TAG( CLASSTAG_SPRITE_LAYER )
 	SERIALIZABLE_METHODS()
 	void setSerializationFlags(uint32 flags);
 
+	// delta serialization (ser_Delta) for network state sync
+	// the sender calls takeSnapshot() once per network tick, then for each client calls
+	// setSerializationBaseline() with the last snapshot id that client acknowledged before
+	// serializing. Only sprite fields that changed after the baseline are written, along with
+	// the sprites removed since then. The receiver gets the id to acknowledge from
+	// getLastSnapshotId(). Sprites the client might not have yet (all of them when there is
+	// no baseline) are sent as create records, and the receiver makes bare sprites with the
+	// sender's ids for the app to give frames to. If a delta names a sprite the receiver
+	// doesn't have and can't create, getLastSnapshotId() goes back to 0 so the sender
+	// resends everything. Deltas don't change z-order
+	uint32 takeSnapshot();	// returns the new snapshot id, never 0
+	void setSerializationBaseline(uint32 baselineId);
+	uint32 getLastSnapshotId() const;	// the newest snapshot applied by deserialize()
+
+	// interest management for ser_Delta streams
+	// an observer is the part of the layer one client can see, usually its viewport. Each
+	// takeSnapshot() finds the sprites in every observer's area using the collision grid
+	// (enabled by addObserver() if need be) and sends Sprite::action_EnterObserver and
+	// action_ExitObserver events as sprites come and go, so the server can tell the client
+	// to create or destroy them. After setSerializationObserver() a delta only covers that
+	// observer's sprites: every field of the ones that entered after the baseline, changed
+	// fields of the rest, and removals for the ones that left
+	uint32 addObserver();	// returns the observer id, never 0. Sees nothing until given an area
+	void removeObserver(uint32 observerId);
+	void setObserverArea(uint32 observerId, const Rect& area);
+	void setObserverRadius(uint32 observerId, const Point& center, float radius);
+	void setSerializationObserver(uint32 observerId);	// 0 to serialize every sprite
+
 	enum {
 		addSprites = true,		// add sprites for all entities when initializing from SCML
 		dontAddSprites = false,	// don't add sprites when initializing from SCML, just load entity definitions
@@ -148,13 +200,16 @@ public:
 	virtual void	fadeIn(ms_delta msDuration, EasingFunc easing = linearTween);  // fadeInComplete notification when done
 	virtual void	fadeOut(ms_delta msDuration, EasingFunc easing = linearTween);  // fadeOutComplete notification when done
 	
-	// arrange layers
+	// arrange layers, only within the layer's own world
 	virtual void	moveBehind(SpriteLayer* layer);
 	virtual void	moveInFrontOf(SpriteLayer* layer);
 	void 			moveToFront();
 	void 			moveToBack();
 	int				getZOrder();
 
+	// the world this layer is animated and drawn as part of
+	World*			getWorld() { return mWorld; }
+
 	// link layers so they move, rotate and zoom together
 	// rotation is always at 1:1 ratio, but movement and zoom ratios can be optionally specified
 	virtual	void	moveWith(SpriteLayer* layer, float moveRatio = 1.0f, float zoomRatio = 1.0f);
@@ -195,6 +250,19 @@ public:
 	virtual void	addSpriteInFrontOf(Sprite* newSprite, Sprite* targetSprite);
 	virtual void	removeSprite(Sprite* oldSprite); // will delete if no longer referenced
 	virtual void	removeAllSprites(); // completely empty out the layer
+	void			updateSpriteIndex(Sprite* sprite); // call if you change the spriteId of a sprite that is already in the layer
+
+	// read or write the state of many sprites in one call, for code that touches every sprite
+	// each tick. Each sprite's state is spriteState_Size floats, laid out as the spriteState_
+	// enum says. Without ids the sprites are gone through in z-order, furthest back first, and
+	// getSpriteStates() can also give back the internal id (iid) of each one. Those are unique,
+	// unlike spriteId, so pass them back in to do just those sprites, in that order. The state
+	// of an iid not in the layer reads as all NaN. A NaN given to setSpriteStates() leaves that
+	// field of the sprite as it was. All of them return the number of sprites read or written
+	uint32			getSpriteStates(float* outStates, uint32 maxSprites, uint32* outIids = 0);
+	uint32			getSpriteStates(const uint32* iids, uint32 numIids, float* outStates);
+	uint32			setSpriteStates(const float* states, uint32 numSprites);
+	uint32			setSpriteStates(const uint32* iids, uint32 numIids, const float* states);
 
 	// turn on or off collisions of objects within this layer
     // individual sprites in the layer still won't collide if their collisions are turned off
@@ -206,6 +274,13 @@ public:
     virtual void    enableCollisionsWithLayer(SpriteLayer* otherLayer);
     virtual void    disableCollisionsWithLayer(SpriteLayer* otherLayer);
 
+	// use a uniform grid to find potential collisions instead of checking every pair of sprites
+	// this is much faster for layers with many sprites, as long as most of them are smaller
+	// than the cell size. Has no effect on layers that use Chipmunk physics
+	virtual void	enableCollisionGrid(float cellSize = 64.0f);
+	virtual void	disableCollisionGrid();
+	bool			hasCollisionGrid() const { return (mCollisionGrid != 0); }
+
 	// create sprites in the layer
 	virtual Sprite* createSprite();
 	virtual Sprite* cloneSprite(const Sprite* originalSprite);
@@ -254,12 +329,37 @@ public:
     cpSpace*    getSpace();
 
     // continual force
-    void        setGravity(float gravity, bool keepItDownward = true); // applies to all layers, pulls everything downward
+    void        setGravity(float gravity, bool keepItDownward = true); // applies to all layers in the world, pulls everything downward
     void        setKeepGravityDownward(bool keepItDownward = true);
 
     // continual damping effect of movement. Identical to calling
     // setMoveFriction() and setSpinFriction() on every sprite in every layer
-    void        setDamping(float damping); // applies to all layers
+    void        setDamping(float damping); // applies to all layers in the world
+
+    // number of threads the Chipmunk solver uses to step the space, applies to all layers in the world.
+    // The default of 1 steps on the main thread, Chipmunk currently won't use more than 2.
+    // Only worth doing for spaces with lots of contacts and joints
+    void        setPhysicsThreads(uint32 numThreads);
+    uint32      getPhysicsThreads();
+
+    // how many milliseconds stepping the physics took on the last animation tick
+    float       getPhysicsStepTime();
+
+    // step the physics in fixed amounts of stepMs instead of by however long each tick took,
+    // which makes the simulation repeatable and collisions less jittery. Time left over from
+    // one tick is carried over to the next, but no more than maxStepsPerTick steps are done
+    // in one tick, so a slow simulation can't fall further and further behind. Passing a
+    // stepMs of 0 goes back to stepping once per tick. Applies to all layers in the world
+    void        setFixedPhysicsStep(float stepMs, uint32 maxStepsPerTick = 8);
+    float       getFixedPhysicsStep();
+
+    // with a fixed physics step, show sprites part way between their positions at the start
+    // and end of the last step, based on getPhysicsAlpha(). This trails the simulation by
+    // up to one step, but keeps motion smooth when the step and animation rates differ
+    void        setPhysicsInterpolation(bool interpolate = true);
+
+    // how far the physics is toward its next fixed step, from 0 to 1
+    float       getPhysicsAlpha();
   #endif
 
 #ifndef PDG_INTERNAL_LIB
@@ -288,6 +388,13 @@ protected:
 
 	virtual void animateLayer(ms_delta msElapsed);
 
+	// called by our world before we stop using its physics space, either because we're being
+	// taken out of the world or because the world is going away and will free the space
+	virtual void leavingWorldSpace();
+
+	// events posted while our world is ticking on a world thread are held for the main thread
+	virtual bool postEvent(long inEventType, void* inEventData, EventEmitter* fromEmitter = 0); // returns true if event handled
+
     // do collision between layers
 	virtual void    collide(ms_delta msElapsed, SpriteLayer* withLayer, bool deferEvents = false);
 
@@ -340,12 +447,23 @@ protected:
   	std::list<SCML::Data*>	mSCMLData;
   #endif
 
+	World* mWorld;
 	SpriteLayer* mNextLayer;
 	SpriteLayer* mPrevLayer;
 	Sprite* mFirstSprite;
 	Sprite* mLastSprite;
 
     std::vector<SpriteLayer*> mCollideLayers;
+
+	CollisionGrid* mCollisionGrid;
+
+	// lookup of sprites by iid and spriteId
+	SpriteIndex* mSpriteIndex;
+	// sprites by z-order, rebuilt when needed after the order changes
+	void updateZOrder();
+	void invalidateZOrder() { mZOrderValid = false; }
+	std::vector<Sprite*> mZOrder;
+	bool mZOrderValid;
     
     std::vector<LinkedLayerInfo> mLinkedLayers;
 	SpriteLayer* mControlledBy;
@@ -356,6 +474,44 @@ protected:
 	float mFacingSin;
 	
 	uint32 mSerFlags;
+	uint8 mSerStreamVers;	// version of the stream being deserialized
+
+	// delta serialization
+	struct RemovedSpriteT {
+		uint32 iid;
+		uint32 snapshotId;
+	};
+	uint32 getDeltaBaseline() const;	// mSerBaseline, or 0 if we can't make a delta against it
+	uint32 mSnapshotId;
+	uint32 mSerBaseline;
+	uint32 mLastSnapshotId;
+	std::deque<RemovedSpriteT> mRemovedSprites;
+
+	// interest management
+	struct ObservedSpriteT {
+		uint32 iid;
+		uint32 enteredAt;	// snapshot id
+		Sprite* sprite;		// retained while it's in an observer's visible list
+		bool operator<(const ObservedSpriteT& other) const { return iid < other.iid; }
+	};
+	struct ObserverT {
+		uint32 id;
+		bool hasArea;
+		Rect area;
+		Point center;
+		float radius;	// 0 if the area is just the rectangle
+		std::vector<ObservedSpriteT> visible;	// sorted by iid
+		std::deque<RemovedSpriteT> left;	// left the area or were removed from the layer
+		~ObserverT();	// releases the visible sprites
+	};
+	ObserverT* findObserver(uint32 observerId) const;
+	static bool isObserving(const ObserverT* observer, uint32 iid);
+	void updateObservers();
+	void notifyObserverAction(int action, Sprite* actingSprite, uint32 observerId);
+	std::vector<ObserverT*> mObservers;
+	std::vector<ObservedSpriteT> mObserverScratch;
+	uint32 mNextObserverId;
+	uint32 mSerObserver;
 	
 	uint32 iid;
 
@@ -85,7 +85,21 @@ public:
 	// checks to see if the movingSprite collides with any features of the spriteLayer.  
 	//	Determines the number of pixels that overlap based on the specified alphaThreshold
 	virtual uint32    checkCollision(Sprite *movingSprite, uint8 alphaThreshold = 128, bool shortCircuit = true, float *outCollisionMag = 0) const;
-	
+
+  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+	// generate static Chipmunk segment shapes (collision type CP_COLLIDE_TYPE_WALL) from the outline of the
+	// map's tiles, so physics sprites collide with the terrain through the space instead of checkCollision().
+	// The map is traced a chunk of chunkSize x chunkSize tiles at a time, and only chunks with changed tiles
+	// are traced again. Tolerance is how far in pixels the simplified outline may stray from the tile edges.
+	// Needs setUseChipmunkPhysics(), and retainAlpha() on the tile set image if the tiles have transparency
+	void	enableStaticCollisions(uint8 alphaThreshold = 128, float tolerance = 1.0f, float radius = 1.0f,
+								   float friction = 1.0f, float elasticity = 0.0f, int chunkSize = 16);
+	void	disableStaticCollisions();
+	// rebuild the shapes for any changed chunks now rather than at the start of the next animation step
+	void	updateStaticCollisions();
+	uint32	getStaticShapeCount() const;
+  #endif // PDG_USE_CHIPMUNK_PHYSICS
+
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 	SCRIPT_OBJECT_REF mTileLayerScriptObj;
 #endif
@@ -127,7 +141,35 @@ protected:
 	float	mTileWorldRatioY;
 	float	mPixelWorldRatioX;
 	float	mPixelWorldRatioY;
-	
+
+  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+	struct StaticChunk {
+		std::vector<cpShape*> shapes;
+		bool	dirty;
+	};
+	struct StaticSampleContext;
+	static cpFloat staticCollisionSample(cpVect point, void* data);
+	void	resetStaticChunks();
+	void	markStaticTilesDirty(long x, long y);
+	void	markAllStaticTilesDirty();
+	void	buildStaticChunk(int chunkX, int chunkY);
+	void	freeStaticShapes(StaticChunk& chunk);
+	virtual void leavingWorldSpace();
+
+	std::vector<StaticChunk> mStaticChunks;
+	cpSpace* mStaticSpace;			// the space our shapes were added to
+	int		mStaticChunkSize;
+	int		mStaticChunksX;
+	int		mStaticChunksY;
+	bool	mStaticCollisions;
+	bool	mStaticDirty;
+	uint8	mStaticAlphaThreshold;
+	float	mStaticTolerance;
+	float	mStaticRadius;
+	float	mStaticFriction;
+	float	mStaticElasticity;
+  #endif // PDG_USE_CHIPMUNK_PHYSICS
+
 	// DEBUG STUFF
 public:
 	float rec_PixelXOffset;
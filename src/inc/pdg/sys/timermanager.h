@@ -42,6 +42,8 @@
 
 #include <exception>
 #include <cstdio>
+#include <map>
+#include <vector>
 
 #ifdef LEAK_AND_EXCEPTION_CHECKS
 #include "..\LeakCheck\LeakCheck.h"
@@ -128,7 +130,7 @@ protected:
 
 	//! create a new timer manager that posts timer events to a particular event manager
     TimerManager()	// call TimerManger::getSingletonInstance instead
-     : timers(0), firing(), nextid(0), next(0), 
+     : firing(), firingTimer(0), checkPass(0),
        allTimersPaused(false) { firing.id = 0; }
 
     struct Timer {
@@ -138,8 +140,9 @@ protected:
         UserData* userData; // any data the user may have associated with this timer
         bool oneshot;   // true if this should be deleted after firing
         bool paused;    // true if this timer is paused
-        Timer* next;    // next Timer in the list
-        Timer* prev;    // prev Timer in the list
+        bool parked;    // true if this timer is waiting in the parked list
+        int heapIndex;  // where this timer is in the heap, or -1 if it isn't in the heap
+        uint32 pass;    // the checkTimers() pass this timer last fired or was started in
         Timer();
         ~Timer();
         void freeUserData();
@@ -147,10 +150,22 @@ protected:
 
 	Timer* findTimer(long id);
 
-	Timer* timers;              // doubly linked list of timers
+	// the heap of scheduled timers, used to find the next timer to fire
+	void schedule(Timer* t);    // add to or reposition in the heap, unless paused, firing or parked
+	void unschedule(Timer* t);  // take out of the heap and parked list
+	void unparkTimers();
+	void heapSiftUp(int i);
+	void heapSiftDown(int i);
+	void heapSet(int i, Timer* t) { heap[i] = t; t->heapIndex = i; }
+
+	typedef std::map<long, Timer*> TimerMapT;
+
+	TimerMapT timers;           // all the timers, by id
+	std::vector<Timer*> heap;   // binary min-heap of timers that aren't paused, soonest first
+	std::vector<Timer*> parked; // timers that are due, but already fired in this checkTimers() pass
     Timer firing;    // a copy of the timer currently being fired
-    long    nextid;     // id of the next timer to fire, only valid when firing.id != 0
-    Timer*  next;       // this will be the next timer to fire, only valid when firing.id != 0
+    Timer* firingTimer; // the repeating timer being fired, it stays out of the heap till it is done
+    uint32 checkPass;   // incremented for each checkTimers() call
     bool deleted;     // did we cancel the timer that is firing from within its handler?
     ms_delta addDelay;  // addition delay added to timer that is firing from within its handler
     ms_time  delayUntil; // new time when current timer is supposed to fire
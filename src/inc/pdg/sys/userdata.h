@@ -35,6 +35,19 @@
 
 #include "pdg_project.h"
 
+#include "pdg/sys/memstats.h"
+
+// largest data block makeUserDataViaPooledCopy() will take from the pool rather than the heap
+// big enough for any of the event info structs that are regularly queued
+#ifndef USERDATA_POOL_BLOCK_SIZE
+#define USERDATA_POOL_BLOCK_SIZE	128
+#endif
+
+// how many pooled blocks to allocate at once when the pool runs dry
+#ifndef USERDATA_POOL_CHUNK_BLOCKS
+#define USERDATA_POOL_CHUNK_BLOCKS	64
+#endif
+
 namespace pdg {
 
 class RefCountedObj;
@@ -56,13 +69,20 @@ class UserData {
 public:
 	template <class T> T* getData() { return static_cast<T*>(data); }
 	void* getData() { return data;}
-	void release() { delete this; }
+	void release();
 
 	// makes a malloc'd copy of the data block, with an optional custom function to free or
 	// release data or objects pointed to within that data. The custom free function must *NOT*
 	// free the master pointer, however, that is taken care of automatically
 	static UserData* makeUserDataViaCopy(void* ptr, long dataSize, UserFreeFuncT freeFunc = 0);
 
+	// same as makeUserDataViaCopy, but the UserData and the copy share a block recycled from a
+	// fixed size free list, so once the pool has grown to its working size there are no
+	// heap allocations at all. Use this for things that are created and freed at a high
+	// rate, like queued events. Blocks larger than USERDATA_POOL_BLOCK_SIZE fall back to
+	// makeUserDataViaCopy. Safe to call from any thread
+	static UserData* makeUserDataViaPooledCopy(void* ptr, long dataSize, UserFreeFuncT freeFunc = 0);
+
 	// stores the pointer, and calls a custom function to free it
 	// for example, this could be used for a pointer to an object Foo, and the custom free
 	// function would typecast the pointer back to a Foo* then delete it.
@@ -80,12 +100,20 @@ public:
 	// no other modes are allowed
 	static UserData* makeUserDataFromPointer(void* ptr, FreeDataT freeHow = data_Free);
 
+	// heap allocation counters for UserData. cxxObjs are UserData objects, blocks are data blocks
+	// UserData allocated or freed, plus chunks added to the pool used by makeUserDataViaPooledCopy().
+	// When nothing is being created or destroyed but the pooled ones the counts stop changing.
+	// outPooledInUse gets the number of pooled blocks that haven't been released yet
+	static void getAllocationStats(MemStats& outStats, uint32* outPooledInUse = 0);
+
 protected:
-	UserData();
+	UserData(bool inPooled = false);
 	~UserData();
 	FreeDataT		freeHow;
 	UserFreeFuncT	freeFunc;
 	void*			data;
+	bool			pooled;
+	bool			ownsCopy;	// data is the block makeUserDataViaCopy() allocated
 };
 
 
@@ -0,0 +1,207 @@
+// -----------------------------------------------
+// world.h
+//
+// independent simulations, each with its own layers,
+// physics space and animation tick
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+
+
+#ifndef PDG_WORLD_H_INCLUDED
+#define PDG_WORLD_H_INCLUDED
+
+#include "pdg_project.h"
+
+#include "pdg/sys/global_types.h"
+#include "pdg/sys/eventqueue.h"
+
+#ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
+#include "pdg_script_bindings.h"
+#endif
+
+#ifdef PDG_USE_CHIPMUNK_PHYSICS
+#include "chipmunk/chipmunk_private.h"
+#endif
+
+// how often a world animates its layers unless told otherwise
+#define WORLD_DEFAULT_TICK_INTERVAL_MS 10  // 100 fps for sprite animation
+
+// most fixed physics steps a world will do in one tick
+#define WORLD_DEFAULT_MAX_PHYSICS_STEPS 8
+
+namespace pdg {
+
+#ifndef PDG_NO_GUI
+class Port;
+#endif
+class SpriteLayer;
+class TileLayer;
+class SpriteManager;
+class EventEmitter;
+
+// -----------------------------------------------------------------------------------
+// World
+// A self contained simulation: a list of layers, the physics space their sprites
+// live in, and the timer that animates them. Layers and sprites in one world never
+// interact with those in another, and each world can run at its own tick rate or be
+// paused or stepped by hand without affecting the others. A world with no layers,
+// or that is paused, has no timer running, so idle worlds cost nothing.
+// The timer is a single repeating timer in the global TimerManager, and its ticks
+// are delivered by the global EventManager, rather than a timer wheel of its own.
+// Threaded worlds tick on a shared pool of native threads, in parallel with each
+// other, and their events are handed back to the main thread afterwards.
+// Layers made with createSpriteLayer() and createTileLayer() go in the default world
+// -----------------------------------------------------------------------------------
+
+class World {
+friend class SpriteManager;
+friend class SpriteLayer;
+friend class Sprite;
+public:
+
+  #ifndef PDG_NO_GUI
+	SpriteLayer*	createSpriteLayer(Port* port = 0);
+	TileLayer*		createTileLayer(Port* port = 0);
+  #else
+	SpriteLayer*	createSpriteLayer();
+	TileLayer*		createTileLayer();
+  #endif
+	uint32			getLayerCount();
+
+	// how often the world's timer animates its layers
+	void			setTickInterval(ms_delta msInterval);
+	ms_delta		getTickInterval() { return mTickIntervalMs; }
+
+	// stop or restart the world's timer. Animation picks up where it left off, the
+	// time spent paused isn't simulated
+	void			pause();
+	void			unpause();
+	bool			isPaused() { return mPaused; }
+
+	// animate everything in the world by msElapsed right now, exactly as the timer does
+	// each tick. Use with pause() to drive a world from your own loop
+	void			step(ms_delta msElapsed);
+
+	// tick this world on one of the world threads instead of the main thread. All the
+	// threaded worlds that are due are ticked at once, in parallel, right after the
+	// main loop checks its timers, and the main thread waits for them before going on,
+	// so nothing else ever runs at the same time as a world tick.
+	// Events posted during a threaded tick are held and delivered on the main thread,
+	// in the order they were posted, once all the worlds have finished. Since a handler
+	// sees the event after the tick, an unhandled joint break disconnects the joint then,
+	// and the handled result of any event is ignored by the tick that posted it.
+	// Animation and collision helpers run in the tick itself, so a threaded world must
+	// only use ones implemented in C++, never ones implemented in script.
+	// step() always ticks on the calling thread, whether the world is threaded or not
+	void			setThreaded(bool threaded = true);
+	bool			isThreaded() { return mThreaded; }
+
+  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+	cpSpace*		getSpace() { return mSpace; }
+
+	// these are described with their counterparts in SpriteLayer
+	void			setPhysicsThreads(uint32 numThreads);
+	uint32			getPhysicsThreads();
+	float			getPhysicsStepTime() { return mPhysicsStepMs; }
+	void			setFixedPhysicsStep(float stepMs, uint32 maxStepsPerTick = WORLD_DEFAULT_MAX_PHYSICS_STEPS);
+	float			getFixedPhysicsStep() { return mFixedPhysicsStepMs; }
+	void			setPhysicsInterpolation(bool interpolate = true) { mInterpolatePhysics = interpolate; }
+	float			getPhysicsAlpha() { return mPhysicsAlpha; }
+  #endif
+
+  #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
+	SCRIPT_OBJECT_REF mWorldScriptObj;
+  #endif
+
+/// @cond C++
+	World(ms_delta tickIntervalMs = WORLD_DEFAULT_TICK_INTERVAL_MS);
+	~World();
+/// @endcond
+
+#ifndef PDG_INTERNAL_LIB
+protected:
+#endif
+/// @cond INTERNAL
+	void	addLayer(SpriteLayer* layer);
+	void	removeLayer(SpriteLayer* layer);
+	void	updateTimer();  // start or stop our timer to match whether we have anything to animate
+	void	tick(ms_delta elapsedMs, ms_delta actualElapsedMs, ms_time millisec);
+
+	// threaded ticks
+	void	tickWhenDue(ms_delta elapsedMs, ms_delta actualElapsedMs, ms_time millisec);
+	void	runDueTick();  // called on a world thread
+	bool	deferEvent(EventEmitter* emitter, long inEventType, void* inEventData);
+	static void	discardEventsForLayer(EventQueueEntryListT& events, SpriteLayer* layer);
+
+	SpriteLayer*	mFirstLayer;
+	SpriteLayer*	mLastLayer;
+	long			mTimerId;
+	ms_delta		mTickIntervalMs;
+	bool			mPaused;
+	bool			mTimerRunning;
+
+	bool			mThreaded;
+	bool			mTickDue;        // the timer fired, waiting for SpriteManager::runThreadedWorlds()
+	bool			mDeferEvents;    // set while ticking on a world thread
+	ms_delta		mDueElapsedMs;
+	ms_delta		mDueActualElapsedMs;
+	ms_time			mDueMillisec;
+	EventQueueEntryListT mDeferredEvents;  // posted during the last threaded tick, not yet delivered
+
+  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+	void	stepPhysics(ms_delta elapsedMs, ms_delta actualElapsedMs);
+	static void	SavePhysicsStateFunc(cpBody* body, void* data);
+
+	cpSpace* mSpace;        // a cpHastySpace where available, so the solver can be given more threads
+	float mPhysicsStepMs;   // how long stepping mSpace took on the last tick
+
+	// fixed step mode, used when mFixedPhysicsStepMs > 0
+	float mFixedPhysicsStepMs;
+	uint32 mMaxPhysicsStepsPerTick;
+	double mPhysicsAccumulatorMs;   // simulation time not yet stepped
+	float mPhysicsAlpha;            // fraction of a fixed step in the accumulator
+	bool mInterpolatePhysics;
+	uint32 mPhysicsStamp;           // changes each time body positions are saved for interpolation
+  #endif
+/// @endcond
+};
+
+// create a new, empty world. It starts ticking once layers are added to it
+World* createWorld(ms_delta tickIntervalMs = WORLD_DEFAULT_TICK_INTERVAL_MS);
+
+// the world that createSpriteLayer() and createTileLayer() put layers in
+World* getDefaultWorld();
+
+// delete a world along with every layer in it. The default world can't be deleted
+void cleanupWorld(World* world);
+
+// how many native threads, besides the main thread, tick the threaded worlds.
+// 0 (the default) uses one per processor core, less one for the main thread.
+// getWorldThreads() tells how many that actually is
+void setWorldThreads(uint32 numThreads);
+uint32 getWorldThreads();
+
+} // end namespace pdg
+
+#endif // PDG_WORLD_H_INCLUDED
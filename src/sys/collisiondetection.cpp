@@ -29,7 +29,9 @@
 #include "pdg_project.h"
 
 #include "collisiondetection.h"
+#include "image-impl.h"
 
+#include <cmath>
 #include <vector>
 
 #ifdef DEBUG_PIXEL_COLLISIONS
@@ -44,6 +46,121 @@ namespace parthenon {
 
 namespace pdg {
 
+static inline int countBits(uint64 v) {
+  #ifdef COMPILER_GCC
+	return __builtin_popcountll(v);
+  #else
+	v = v - ((v >> 1) & 0x5555555555555555ULL);
+	v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+	v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (int)((v * 0x0101010101010101ULL) >> 56);
+  #endif
+}
+
+static inline int lowestBit(uint64 v) {
+  #ifdef COMPILER_GCC
+	return __builtin_ctzll(v);
+  #else
+	int n = 0;
+	while ((v & 1) == 0) {
+		v >>= 1;
+		n++;
+	}
+	return n;
+  #endif
+}
+
+// the part of detectPixelCollision() that handles unscaled images that are aligned with one
+// another, comparing 64 pixels at a time. Arguments are as calculated by detectPixelCollision(),
+// and the pixels sampled are the same as the per-pixel loop there, except that when an offset
+// is within float rounding error of a whole pixel every column is treated the same way
+static bool detectAlignedMaskCollision(const AlphaMask* maskA, const AlphaMask* maskB, 
+										const Image* imageA, const Image* imageB, 
+										const Rect& r, const Rect& B, const Point& rTopLeftInA,
+										float imgA_width, float imgA_height, 
+										const Rect &imageBoundsA, const Rect &imageBoundsB, uint8 alphaThreshold,
+										uint32 *outOverlapCount, float *outThresholdExcess) {
+	bool collided = false;
+	// number of columns the per-pixel loop would visit
+	int numCols = (r.right > 0) ? (int)std::ceil(r.right) : 0;
+	// first and last+1 columns that fall within A
+	float qx = rTopLeftInA.x;
+	int colA0 = (int)std::ceil(-qx);
+	if (colA0 < 0) colA0 = 0;
+	while ((colA0 > 0) && ((float)(colA0 - 1) + qx >= 0)) colA0--;
+	while ((colA0 < numCols) && !((float)colA0 + qx >= 0)) colA0++;
+	int colA1 = (int)std::ceil(imgA_width - qx);
+	if (colA1 > numCols) colA1 = numCols;
+	if (colA1 < colA0) colA1 = colA0;
+	while ((colA1 > colA0) && !((float)(colA1 - 1) + qx < imgA_width)) colA1--;
+	while ((colA1 < numCols) && ((float)colA1 + qx < imgA_width)) colA1++;
+	if (colA1 <= colA0) {
+		return false;
+	}
+	// first column that falls on or right of B's left edge. The column before it might still
+	// land on pixel 0, because converting the coordinate to an integer truncates toward zero
+	float bx = imageBoundsB.left - B.left;
+	int colB0 = (int)std::ceil(-bx);
+	while (((float)(colB0 - 1) + bx >= 0)) colB0--;
+	while (!((float)colB0 + bx >= 0)) colB0++;
+	int edgeCol = colB0 - 1;
+	bool hasEdgeCol = ((float)edgeCol + bx > -1.0f) && (edgeCol >= colA0) && (edgeCol < colA1);
+	int startCol = (colA0 > colB0) ? colA0 : colB0;
+	int n = colA1 - startCol;
+	int32 firstA = (int32)((float)startCol + qx + imageBoundsA.left);
+	int32 firstB = (int32)((float)startCol + bx);
+
+	for (int y = 0; y < r.bottom; y++) {
+		float fy = y;
+		float a_y = fy + rTopLeftInA.y;
+		if ((a_y < 0) || (a_y >= imgA_height)) continue;
+		int32 ay = a_y + imageBoundsA.top;
+		long ly = (fy - B.top) + imageBoundsB.top;
+		if ((ly < 0) || (ly >= maskB->height)) continue;
+		if (hasEdgeCol) {
+			int32 ax = (float)edgeCol + qx + imageBoundsA.left;
+			if (maskA->isSet(ax, ay) && maskB->isSet(0, ly)) {
+				collided = true;
+				if (!outThresholdExcess && !outOverlapCount) {
+					return true;
+				}
+				if (outOverlapCount) {
+					*outOverlapCount += 1;
+				}
+				if (outThresholdExcess) {
+					uint8 a_a = imageA->getAlphaValue(ax, ay);
+					uint8 b_a = imageB->getAlphaValue(0, ly);
+					*outThresholdExcess += (float)((a_a - alphaThreshold) + (b_a - alphaThreshold))/510.0f;
+				}
+			}
+		}
+		for (int i = 0; i < n; i += 64) {
+			uint64 overlap = maskA->getBits(firstA + i, ay) & maskB->getBits(firstB + i, ly);
+			if (n - i < 64) {
+				overlap &= ((uint64)1 << (n - i)) - 1;
+			}
+			if (overlap == 0) continue;
+			collided = true;
+			if (!outThresholdExcess && !outOverlapCount) {
+				return true;
+			}
+			if (outOverlapCount) {
+				*outOverlapCount += countBits(overlap);
+			}
+			if (outThresholdExcess) {
+				while (overlap) {
+					int bit = lowestBit(overlap);
+					uint8 a_a = imageA->getAlphaValue(firstA + i + bit, ay);
+					uint8 b_a = imageB->getAlphaValue(firstB + i + bit, ly);
+					*outThresholdExcess += (float)((a_a - alphaThreshold) + (b_a - alphaThreshold))/510.0f;
+					overlap &= overlap - 1;
+				}
+			}
+		}
+	}
+	return collided;
+}
+
 bool CollisionDetection::detectRadiusCollision(const Point &locA, float radiusA, const Point &locB, float radiusB) {
 	// don't need to compare actual distance, just compare squared distance
 	float distanceSquared = (locA.x-locB.x)*(locA.x-locB.x) + (locA.y-locB.y)*(locA.y-locB.y);
@@ -212,7 +329,35 @@ bool CollisionDetection::detectPixelCollision(const RotatedRect &rectA, const Ro
 		
 		float imgA_width = imageBoundsA.width()/imgA_h_ratio;
 		float imgA_height = imageBoundsA.height()/imgA_v_ratio;
-		
+
+		// use the packed alpha masks when we can, rather than a virtual getAlphaValue() call
+		// for every pixel. If there is no image data to build them from we fall back to
+		// getAlphaValue(), which will complain about it in debug builds
+		const AlphaMask* maskA = 0;
+		const AlphaMask* maskB = 0;
+	  #ifndef DEBUG_PIXEL_COLLISIONS
+		const ImageImpl* implA = dynamic_cast<const ImageImpl*>(imageA);
+		const ImageImpl* implB = dynamic_cast<const ImageImpl*>(imageB);
+		if (implA && (implB || !imageB)) {
+			maskA = implA->getAlphaMask(alphaThreshold);
+			maskB = (implB) ? implB->getAlphaMask(alphaThreshold) : 0;
+			if (!maskA || (imageB && !maskB)) {
+				maskA = 0;
+				maskB = 0;
+			}
+		}
+		// rotating the quads back leaves some float error in the slope even when the sprites
+		// weren't rotated relative to one another, so treat a tiny slope as aligned
+		if ( maskA && maskB && (std::fabs(mR) < 0.00001f)
+		  && ((facingB == TileLayer::facing_North) || (facingB == TileLayer::facing_Ignore))
+		  && (imgA_h_ratio == 1.0f) && (imgA_v_ratio == 1.0f) && (imgB_h_ratio == 1.0f) && (imgB_v_ratio == 1.0f) ) {
+			// both images are unscaled and line up with each other, so we can compare whole rows
+			return detectAlignedMaskCollision(maskA, maskB, imageA, imageB, r, B, quadR_prime.points[lftTop],
+										imgA_width, imgA_height, imageBoundsA, imageBoundsB, alphaThreshold,
+										outOverlapCount, outThresholdExcess);
+		}
+	  #endif // ! DEBUG_PIXEL_COLLISIONS
+
 		for (int y = 0; y < r.bottom; y++) {
 			float fy = y;
 			float b_x = -B.left;
@@ -239,7 +384,12 @@ bool CollisionDetection::detectPixelCollision(const RotatedRect &rectA, const Ro
 	//				Color bp = imageB->getPixel(lx, ly);
 	//				uint8 b_a = bp.alpha * 255;
 	//#else
-					b_a = imageB->getAlphaValue(lx, ly);
+					if (maskB) {
+						// only need the real alpha value when totalling how far over the threshold we are
+						b_a = maskB->isSet(lx, ly) ? ((outThresholdExcess) ? imageB->getAlphaValue(lx, ly) : 255) : 0;
+					} else {
+						b_a = imageB->getAlphaValue(lx, ly);
+					}
 				}
 //#endif
 				b_x += 1.0f;
@@ -261,7 +411,14 @@ bool CollisionDetection::detectPixelCollision(const RotatedRect &rectA, const Ro
 //						Color ap = imageA->getPixel(a_x * imgA_h_ratio + imageBoundsA.left, a_y * imgA_v_ratio + imageBoundsA.top);
 //						uint8 a_a = ap.alpha * 255;
 //#else
-						uint8 a_a = imageA->getAlphaValue(a_x * imgA_h_ratio + imageBoundsA.left, a_y * imgA_v_ratio + imageBoundsA.top);
+						int32 ax = a_x * imgA_h_ratio + imageBoundsA.left;
+						int32 ay = a_y * imgA_v_ratio + imageBoundsA.top;
+						uint8 a_a;
+						if (maskA) {
+							a_a = maskA->isSet(ax, ay) ? ((outThresholdExcess) ? imageA->getAlphaValue(ax, ay) : 255) : 0;
+						} else {
+							a_a = imageA->getAlphaValue(ax, ay);
+						}
 //#endif
 						if (a_a > alphaThreshold) {
 							collided = true;
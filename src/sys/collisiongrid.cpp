@@ -0,0 +1,241 @@
+// -----------------------------------------------
+// collisiongrid.cpp
+//
+// Uniform grid broad phase for sprite collisions
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+
+
+#include "pdg_project.h"
+
+#include "pdg/sys/global_types.h"
+#include "pdg/sys/sprite.h"
+
+#include "collisiongrid.h"
+
+#include <cmath>
+
+namespace pdg {
+
+CollisionGrid::CollisionGrid(float cellSize)
+ :	mCellSize(cellSize),
+	mBuckets(COLLISION_GRID_NUM_BUCKETS),
+	mQueryStamp(0)
+{
+	if (mCellSize <= 0.0f) {
+		mCellSize = COLLISION_GRID_DEFAULT_CELL_SIZE;
+	}
+}
+
+CollisionGrid::~CollisionGrid() {
+	clear();
+}
+
+bool
+CollisionGrid::boundsOverlap(const Rect& a, const Rect& b) {
+	// unlike Rect::overlaps(), touching edges and zero sized bounds (ie: a sprite
+	// with a collision radius but no image) are treated as overlapping
+	return (a.left <= b.right) && (b.left <= a.right) && (a.top <= b.bottom) && (b.top <= a.bottom);
+}
+
+void
+CollisionGrid::calcCells(const Rect& bounds, int& outLeft, int& outTop, int& outRight, int& outBottom) const {
+	outLeft = (int)std::floor(bounds.left / mCellSize);
+	outTop = (int)std::floor(bounds.top / mCellSize);
+	outRight = (int)std::floor(bounds.right / mCellSize);
+	outBottom = (int)std::floor(bounds.bottom / mCellSize);
+}
+
+CollisionGrid::BucketT&
+CollisionGrid::bucketFor(int cellX, int cellY) {
+	// same spatial hash Chipmunk uses for cpSpaceHash
+	uint32 h = ((uint32)cellX * 1640531513UL) ^ ((uint32)cellY * 2654435789UL);
+	return mBuckets[h % COLLISION_GRID_NUM_BUCKETS];
+}
+
+void
+CollisionGrid::removeFromBucket(BucketT& bucket, Sprite* sprite) {
+	for (size_t i = 0; i < bucket.size(); i++) {
+		if (bucket[i] == sprite) {
+			bucket[i] = bucket.back();
+			bucket.pop_back();
+			return;
+		}
+	}
+}
+
+void
+CollisionGrid::addToCells(Sprite* sprite) {
+	Rect& b = sprite->mGridBounds;
+	float cellsWide = std::floor(b.right / mCellSize) - std::floor(b.left / mCellSize) + 1.0f;
+	float cellsHigh = std::floor(b.bottom / mCellSize) - std::floor(b.top / mCellSize) + 1.0f;
+	if (!(cellsWide * cellsHigh <= COLLISION_GRID_MAX_CELLS_PER_SPRITE)) {
+		// too big (or NaN) to be worth hashing into cells
+		sprite->mGridOversized = true;
+		mOversized.push_back(sprite);
+		return;
+	}
+	sprite->mGridOversized = false;
+	calcCells(b, sprite->mGridCellLeft, sprite->mGridCellTop, sprite->mGridCellRight, sprite->mGridCellBottom);
+	for (int y = sprite->mGridCellTop; y <= sprite->mGridCellBottom; y++) {
+		for (int x = sprite->mGridCellLeft; x <= sprite->mGridCellRight; x++) {
+			BucketT& bucket = bucketFor(x, y);
+			// cells that hash to the same bucket would otherwise add the sprite twice
+			if (bucket.empty() || bucket.back() != sprite) {
+				bucket.push_back(sprite);
+			}
+		}
+	}
+}
+
+void
+CollisionGrid::removeFromCells(Sprite* sprite) {
+	if (sprite->mGridOversized) {
+		removeFromBucket(mOversized, sprite);
+		return;
+	}
+	for (int y = sprite->mGridCellTop; y <= sprite->mGridCellBottom; y++) {
+		for (int x = sprite->mGridCellLeft; x <= sprite->mGridCellRight; x++) {
+			removeFromBucket(bucketFor(x, y), sprite);
+		}
+	}
+}
+
+void
+CollisionGrid::insert(Sprite* sprite) {
+	if (!sprite || sprite->mInGrid) return;
+	sprite->mGridBounds = sprite->getCollisionBounds();
+	sprite->mGridQueryStamp = 0;
+	sprite->mInGrid = true;
+	addToCells(sprite);
+}
+
+void
+CollisionGrid::remove(Sprite* sprite) {
+	if (!sprite || !sprite->mInGrid) return;
+	removeFromCells(sprite);
+	sprite->mInGrid = false;
+}
+
+void
+CollisionGrid::update(Sprite* sprite) {
+	if (!sprite || !sprite->mInGrid) return;
+	Rect newBounds = sprite->getCollisionBounds();
+	if (!sprite->mGridOversized) {
+		int l, t, r, b;
+		calcCells(newBounds, l, t, r, b);
+		if ( (l == sprite->mGridCellLeft) && (t == sprite->mGridCellTop) &&
+			 (r == sprite->mGridCellRight) && (b == sprite->mGridCellBottom) ) {
+			// still covers the same cells, which is by far the most common case
+			sprite->mGridBounds = newBounds;
+			return;
+		}
+	}
+	removeFromCells(sprite);
+	sprite->mGridBounds = newBounds;
+	addToCells(sprite);
+}
+
+void
+CollisionGrid::clear() {
+	for (size_t i = 0; i < mBuckets.size(); i++) {
+		BucketT& bucket = mBuckets[i];
+		for (size_t j = 0; j < bucket.size(); j++) {
+			bucket[j]->mInGrid = false;
+		}
+		bucket.clear();
+	}
+	for (size_t i = 0; i < mOversized.size(); i++) {
+		mOversized[i]->mInGrid = false;
+	}
+	mOversized.clear();
+	mResults.clear();
+}
+
+const std::vector<Sprite*>&
+CollisionGrid::query(const Rect& bounds, Sprite* exclude) {
+	mResults.clear();
+	mQueryStamp++;
+	if (mQueryStamp == 0) {
+		// wrapped around, so old stamps could match again
+		for (size_t i = 0; i < mBuckets.size(); i++) {
+			for (size_t j = 0; j < mBuckets[i].size(); j++) {
+				mBuckets[i][j]->mGridQueryStamp = 0;
+			}
+		}
+		for (size_t i = 0; i < mOversized.size(); i++) {
+			mOversized[i]->mGridQueryStamp = 0;
+		}
+		mQueryStamp = 1;
+	}
+	if (exclude) {
+		exclude->mGridQueryStamp = mQueryStamp;
+	}
+	for (size_t i = 0; i < mOversized.size(); i++) {
+		Sprite* sprite = mOversized[i];
+		if (sprite->mGridQueryStamp != mQueryStamp) {
+			sprite->mGridQueryStamp = mQueryStamp;
+			if (boundsOverlap(bounds, sprite->mGridBounds)) {
+				mResults.push_back(sprite);
+			}
+		}
+	}
+	float cellsWide = std::floor(bounds.right / mCellSize) - std::floor(bounds.left / mCellSize) + 1.0f;
+	float cellsHigh = std::floor(bounds.bottom / mCellSize) - std::floor(bounds.top / mCellSize) + 1.0f;
+	if (!(cellsWide * cellsHigh <= COLLISION_GRID_NUM_BUCKETS)) {
+		// the query covers more cells than we have buckets, so just check every bucket
+		for (size_t i = 0; i < mBuckets.size(); i++) {
+			BucketT& bucket = mBuckets[i];
+			for (size_t j = 0; j < bucket.size(); j++) {
+				Sprite* sprite = bucket[j];
+				if (sprite->mGridQueryStamp != mQueryStamp) {
+					sprite->mGridQueryStamp = mQueryStamp;
+					if (boundsOverlap(bounds, sprite->mGridBounds)) {
+						mResults.push_back(sprite);
+					}
+				}
+			}
+		}
+		return mResults;
+	}
+	int left, top, right, bottom;
+	calcCells(bounds, left, top, right, bottom);
+	for (int y = top; y <= bottom; y++) {
+		for (int x = left; x <= right; x++) {
+			BucketT& bucket = bucketFor(x, y);
+			for (size_t j = 0; j < bucket.size(); j++) {
+				Sprite* sprite = bucket[j];
+				if (sprite->mGridQueryStamp != mQueryStamp) {
+					sprite->mGridQueryStamp = mQueryStamp;
+					if (boundsOverlap(bounds, sprite->mGridBounds)) {
+						mResults.push_back(sprite);
+					}
+				}
+			}
+		}
+	}
+	return mResults;
+}
+
+} // end namespace pdg
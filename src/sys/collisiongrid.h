@@ -0,0 +1,101 @@
+// -----------------------------------------------
+// collisiongrid.h
+//
+// Uniform grid broad phase for sprite collisions
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+
+
+#ifndef PDG_COLLISIONGRID_H_INCLUDED
+#define PDG_COLLISIONGRID_H_INCLUDED
+
+#include "pdg_project.h"
+
+#include "pdg/sys/global_types.h"
+#include "pdg/sys/coordinates.h"
+
+#include <vector>
+
+// default size of a grid cell, in layer coordinates
+#define COLLISION_GRID_DEFAULT_CELL_SIZE	64.0f
+
+// number of hash buckets the grid cells are spread across
+#define COLLISION_GRID_NUM_BUCKETS			4093
+
+// sprites whose bounds cover more cells than this are kept in a separate
+// list that is checked by every query, rather than being put in every cell
+#define COLLISION_GRID_MAX_CELLS_PER_SPRITE	64
+
+namespace pdg {
+
+class Sprite;
+
+// -----------------------------------------------------------------------------------
+// Collision Grid
+// Used by SpriteLayer as an optional broad phase for collisions that are not handled
+// by Chipmunk. Sprites are hashed into the fixed size cells their collision bounds
+// cover, so only sprites that share a cell and whose bounds overlap are ever passed
+// on to Sprite::collidesWith()
+// -----------------------------------------------------------------------------------
+
+class CollisionGrid {
+public:
+	CollisionGrid(float cellSize = COLLISION_GRID_DEFAULT_CELL_SIZE);
+	~CollisionGrid();
+
+	float	getCellSize() const { return mCellSize; }
+
+	void	insert(Sprite* sprite);
+	void	remove(Sprite* sprite);
+	// recalculate the sprite's bounds, and move it to new cells if needed
+	void	update(Sprite* sprite);
+	void	clear();
+
+	// find all the sprites whose bounds overlap the given bounds, other than the excluded one
+	// the result is only valid until the next query or change to the grid
+	const std::vector<Sprite*>& query(const Rect& bounds, Sprite* exclude = 0);
+
+	static bool boundsOverlap(const Rect& a, const Rect& b);
+
+/// @cond INTERNAL
+private:
+	typedef std::vector<Sprite*> BucketT;
+
+	void	calcCells(const Rect& bounds, int& outLeft, int& outTop, int& outRight, int& outBottom) const;
+	void	addToCells(Sprite* sprite);
+	void	removeFromCells(Sprite* sprite);
+	BucketT& bucketFor(int cellX, int cellY);
+	static void removeFromBucket(BucketT& bucket, Sprite* sprite);
+
+	float	mCellSize;
+	std::vector<BucketT> mBuckets;
+	BucketT mOversized;
+	BucketT mResults;
+	uint32	mQueryStamp;
+/// @endcond
+};
+
+} // end namespace pdg
+
+#endif // PDG_COLLISIONGRID_H_INCLUDED
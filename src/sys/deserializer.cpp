@@ -53,8 +53,9 @@ int IDeserializer::s_TraceDepth = 0;
 typedef std::map<uint32, IDeserializer::CreateSerializableFunc> SerializableRegistryT;
 SerializableRegistryT gSerializableRegistry;
 
-// maps object unique ids to the object pointers
-ObjectRegistryT gObjectRegistry;
+// maps object unique ids to the object pointers and back
+ObjectRegistry gObjectRegistry;
+Mutex gObjectRegistryMutex;
 
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
   typedef std::map< uint32, SAVED_FUNCTION > ScriptRegistryT;
@@ -409,17 +410,35 @@ void* Deserializer::deserialize_ptr() {
         STREAM_SAFETY_CHECK(tag_pointerRef == tag, "OUT OF SYNC: expected Pointer Ref", bad_tag, DESERIALIZE_OUT);
     }
 	uint32 uniqueObjectId = deserialize_uint();
-    void* ptr = gObjectRegistry[uniqueObjectId];
+    void* ptr = 0;
+    bool found = (mStreamObjects && mStreamObjects->findObject(uniqueObjectId, ptr));
+    if (!found) {
+        AutoMutex mutex(&gObjectRegistryMutex);
+        found = gObjectRegistry.findObject(uniqueObjectId, ptr);
+    }
+    STREAM_SAFETY_CHECK(found, "Unregistered Object Id!!", unknown_object, DESERIALIZE_OUT);
 	DESERIALIZE_OUT;
 	return ptr;
 }
 
-void Deserializer::setDataPtr(void* ptr, uint32 ptrSize) {
+void Deserializer::registerStreamObject(void* obj, uint32 uniqueId) {
+	if (!mStreamObjects) {
+		mStreamObjects = new ObjectRegistry();
+	}
+	mStreamObjects->add(obj, uniqueId);
+}
+
+void Deserializer::setDataPtr(void* ptr, uint32 ptrSize, bool takeOwnership) {
+	if (mDataPtr && mOwnsData && (mDataPtr != ptr)) {
+		std::free(mDataPtr);
+	}
+	mOwnsData = takeOwnership;
 	mDataPtr = (uint8*)ptr; 
 	mDataSize = ptrSize;
 	mDataEnd = (uint8*)ptr + ptrSize; 
 //	DEBUG_PRINT("Deserializer Initialized with Ptr [%p] size [%ld] bytes", mDataPtr, mDataEnd - mDataPtr);
 	p = (uint8*)ptr;
+	mUsingTags = false;
 	uint32 tag = deserialize_3u();
 	if (tag_pdgTaggedStream == tag) {
 	    mUsingTags = true;
@@ -433,9 +452,11 @@ Deserializer::Deserializer()
 	mDataEnd(0),
 	p(0),
 	mDataSize(0),
+	mOwnsData(false),
 	mLastBoolByte(0),
 	mBoolBitOffset(0),
-	mDeserializedInstances()
+	mDeserializedInstances(),
+	mStreamObjects(0)
 {
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 	INIT_SCRIPT_OBJECT(mDeserializerScriptObj);
@@ -447,10 +468,12 @@ Deserializer::Deserializer(void* ptr, uint32 ptrSize)
 	mDataEnd(0),
 	p(0),
 	mDataSize(0),
+	mOwnsData(false),
 	mLastBoolByte(0),
 	mBoolBitOffset(0),
 	mUsingTags(false),
-	mDeserializedInstances()
+	mDeserializedInstances(),
+	mStreamObjects(0)
 {
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 	INIT_SCRIPT_OBJECT(mDeserializerScriptObj);
@@ -459,10 +482,12 @@ Deserializer::Deserializer(void* ptr, uint32 ptrSize)
 }
 
 Deserializer::~Deserializer() {
-	if (mDataPtr) {
+	if (mDataPtr && mOwnsData) {
 		std::free(mDataPtr);
 		mDataPtr = 0;
 	}
+	delete mStreamObjects;
+	mStreamObjects = 0;
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 	CleanupDeserializerScriptObject(mDeserializerScriptObj);
 #endif
@@ -483,7 +508,142 @@ char* Deserializer::statusDump(int hiliteBytes) {
 
 void
 IDeserializer::registerObject(void* obj, uint32 uniqueId) {
-	gObjectRegistry[uniqueId] = obj;
+	AutoMutex mutex(&gObjectRegistryMutex);
+	gObjectRegistry.add(obj, uniqueId);
+}
+
+// called from the destructors of the objects that are usually registered, so keep the
+// common case of an empty registry from taking the lock
+void
+IDeserializer::unregisterObject(const void* obj) {
+	if (gObjectRegistry.size() == 0) return;
+	AutoMutex mutex(&gObjectRegistryMutex);
+	gObjectRegistry.remove(obj);
+}
+
+// --------------------------------------------
+// object registry
+// --------------------------------------------
+
+#define OBJECT_REGISTRY_INITIAL_BUCKETS 64
+
+ObjectRegistry::ObjectRegistry()
+ :	mById(OBJECT_REGISTRY_INITIAL_BUCKETS),
+	mByObj(OBJECT_REGISTRY_INITIAL_BUCKETS),
+	mMask(OBJECT_REGISTRY_INITIAL_BUCKETS - 1),
+	mCount(0)
+{
+}
+
+uint32
+ObjectRegistry::hashId(uint32 uniqueId) {
+	uniqueId ^= uniqueId >> 16;
+	uniqueId *= 0x45d9f3b;
+	uniqueId ^= uniqueId >> 16;
+	return uniqueId;
+}
+
+uint32
+ObjectRegistry::hashObj(const void* obj) {
+	// low bits of a pointer are always zero because of alignment
+	size_t bits = (size_t)obj >> 3;
+	return hashId((uint32)bits ^ (uint32)((bits >> 16) >> 16));
+}
+
+void
+ObjectRegistry::grow() {
+	uint32 numBuckets = (mMask + 1) * 2;
+	std::vector<BucketT> byId(numBuckets);
+	std::vector<BucketT> byObj(numBuckets);
+	mMask = numBuckets - 1;
+	for (size_t i = 0; i < mById.size(); i++) {
+		BucketT& bucket = mById[i];
+		for (size_t j = 0; j < bucket.size(); j++) {
+			byId[hashId(bucket[j].id) & mMask].push_back(bucket[j]);
+			byObj[hashObj(bucket[j].obj) & mMask].push_back(bucket[j]);
+		}
+	}
+	mById.swap(byId);
+	mByObj.swap(byObj);
+}
+
+void
+ObjectRegistry::add(void* obj, uint32 uniqueId) {
+	removeId(uniqueId);
+	if (!obj) return;
+	remove(obj);
+	if (mCount > mMask) {
+		grow();
+	}
+	EntryT entry;
+	entry.id = uniqueId;
+	entry.obj = obj;
+	mById[hashId(uniqueId) & mMask].push_back(entry);
+	mByObj[hashObj(obj) & mMask].push_back(entry);
+	mCount++;
+}
+
+void
+ObjectRegistry::remove(const void* obj) {
+	BucketT& bucket = mByObj[hashObj(obj) & mMask];
+	for (size_t i = 0; i < bucket.size(); i++) {
+		if (bucket[i].obj == obj) {
+			uint32 uniqueId = bucket[i].id;
+			bucket[i] = bucket.back();
+			bucket.pop_back();
+			BucketT& idBucket = mById[hashId(uniqueId) & mMask];
+			for (size_t j = 0; j < idBucket.size(); j++) {
+				if (idBucket[j].id == uniqueId) {
+					idBucket[j] = idBucket.back();
+					idBucket.pop_back();
+					break;
+				}
+			}
+			mCount--;
+			return;
+		}
+	}
+}
+
+void
+ObjectRegistry::removeId(uint32 uniqueId) {
+	void* obj;
+	if (findObject(uniqueId, obj)) {
+		remove(obj);
+	}
+}
+
+void
+ObjectRegistry::clear() {
+	for (size_t i = 0; i < mById.size(); i++) {
+		mById[i].clear();
+		mByObj[i].clear();
+	}
+	mCount = 0;
+}
+
+bool
+ObjectRegistry::findId(const void* obj, uint32& outUniqueId) const {
+	const BucketT& bucket = mByObj[hashObj(obj) & mMask];
+	for (size_t i = 0; i < bucket.size(); i++) {
+		if (bucket[i].obj == obj) {
+			outUniqueId = bucket[i].id;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool
+ObjectRegistry::findObject(uint32 uniqueId, void*& outObj) const {
+	const BucketT& bucket = mById[hashId(uniqueId) & mMask];
+	for (size_t i = 0; i < bucket.size(); i++) {
+		if (bucket[i].id == uniqueId) {
+			outObj = bucket[i].obj;
+			return true;
+		}
+	}
+	return false;
 }
 
 void
@@ -62,6 +62,33 @@ EventEmitter::~EventEmitter() {
 	clear();
 }
 
+// PROTECTED: find the entry for an event type
+int
+EventEmitter::findHandlingInfo(long inEventType) const {
+	if ((mHandledTypes & typeBit(inEventType)) == 0) {
+		return -1;
+	}
+	for (size_t i = 0; i < mHandlers.size(); i++) {
+		if (mHandlers[i].eventType == inEventType) {
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+// PROTECTED: find the entry for an event type, adding one if needed
+// entries are only ever added at the end, so indexes stay valid while emitting
+int
+EventEmitter::addHandlingInfo(long inEventType) {
+	int idx = findHandlingInfo(inEventType);
+	if (idx < 0) {
+		mHandlers.push_back(EventHandlingInfo(inEventType));
+		mHandledTypes |= typeBit(inEventType);
+		idx = (int)mHandlers.size() - 1;
+	}
+	return idx;
+}
+
 // EventManger methods
 void 
 EventEmitter::addHandler(IEventHandler *inHandler, long inType) {
@@ -72,30 +99,19 @@ EventEmitter::addHandler(IEventHandler *inHandler, long inType) {
         			inType, getEventName(inType)); )
         return;
     }
-    // see if this type is already registered
-    HandlerMapT::iterator it = mHandlers.find(inType);
-    if (it == mHandlers.end()) {
-        // new type
-        HandlerListT list;
-        list.push_back(inHandler);
-        mHandlers.insert( HandlerMapT::value_type(inType, EventHandlingInfo(list)) );
-    } else {
-        DEBUG_ONLY(
-			HandlerListT& list = (*it).second.handlerList;
-			HandlerListT::iterator listIt = list.begin();
-            while (listIt != list.end()) {
-            	IEventHandler* handler = (*listIt).handler;
-                if (handler == inHandler) {
-                    OS::_DOUT("addHandler: handler %p is already registered for event type %d [%s]",
-                    		inHandler, inType, getEventName(inType));
-                }
-                DEBUG_ASSERT(handler != inHandler, "EventEmitter::addHandler Added same handler twice for same event type");
-                ++listIt;
+    int idx = addHandlingInfo(inType);
+    HandlerListT& list = mHandlers[idx].handlerList;
+    DEBUG_ONLY(
+        for (size_t i = 0; i < list.size(); i++) {
+            IEventHandler* handler = list[i].handler;
+            if (handler == inHandler) {
+                OS::_DOUT("addHandler: handler %p is already registered for event type %d [%s]",
+                		inHandler, inType, getEventName(inType));
             }
-        )
-        // established type, so add it to the list
-        (*it).second.handlerList.push_back(inHandler);
-    }
+            DEBUG_ASSERT(handler != inHandler, "EventEmitter::addHandler Added same handler twice for same event type");
+        }
+    )
+    list.push_back(inHandler);
     EVENT_DEBUG_ONLY( OS::_DOUT("Done registering handler %p for event type %d [%s]", inHandler, 
     		inType, getEventName(inType)); )
     inHandler->addRef();
@@ -116,26 +132,25 @@ EventEmitter::removeHandler(IEventHandler *inHandler, long inType) {
         return;
     }
     // see if this type is already registered
-    HandlerMapT::iterator it = mHandlers.find(inType);
-    if (it == mHandlers.end()) {
+    int idx = findHandlingInfo(inType);
+    if (idx < 0) {
         DEBUG_ONLY( OS::_DOUT("EventEmitter::removeHandler could not find inType [%d] [%s] in mHandlers", 
         	inType, getEventName(inType)); )
     } else {
         // found the type, remove the handler from the list
-        HandlerListT& list = (*it).second.handlerList;
-        HandlerListT::iterator listIt = list.begin();
-        while (listIt != list.end()) {
-            IEventHandler* handler = (*listIt).handler;
+        EventHandlingInfo& info = mHandlers[idx];
+        HandlerListT& list = info.handlerList;
+        for (size_t i = 0; i < list.size(); i++) {
+            IEventHandler* handler = list[i].handler;
             if (handler == inHandler) {
-                (*listIt).removed = true;            // mark it removed
-				(*it).second.handlerRemoved = true;  // mark the map for this type as having a dead handler
+                list[i].removed = true;              // mark it removed
+				info.handlerRemoved = true;          // mark the entry for this type as having a dead handler
 				mHandlerRemoved = true;              // mark that we need to cleanup removed handlers
 				handler->release();				     // we add ref'd when we put it in, release it now -- must do immediately in case this removeHandler is called from a destructor
-				(*listIt).handler = 0;				 // don't reuse it now that we have released it
+				list[i].handler = 0;				 // don't reuse it now that we have released it
 				EVENT_DEBUG_ONLY(OS::_DOUT("EventEmitter::removeHandler: marked as removed handler [%p]", handler);)
 				break;
             }
-            ++listIt;
         }
     }
 }
@@ -149,108 +164,119 @@ EventEmitter::postEvent(long inEventType, void* inEventData, EventEmitter* fromE
 	}
 	bool wasHandled = emitEvent(fromEmitter, inEventType, inEventData);
 	if (!wasHandled) {
-        EVENT_DEBUG_ONLY( OS::_DOUT("EventEmitter::postEvent event [%d][%s] unhandled, passing to EventManager", 
-        					inEventType,  getEventName(inEventType)); )
-		wasHandled = EventManager::getSingletonInstance()->postEvent(inEventType, inEventData, fromEmitter);
+		EventManager* eventMgr = EventManager::getSingletonInstance();
+		// don't bother going through the EventManager if it can't possibly handle it
+		if (eventMgr->hasHandlersFor(inEventType)) {
+	        EVENT_DEBUG_ONLY( OS::_DOUT("EventEmitter::postEvent event [%d][%s] unhandled, passing to EventManager", 
+	        					inEventType,  getEventName(inEventType)); )
+			wasHandled = eventMgr->postEvent(inEventType, inEventData, fromEmitter);
+		}
 	}
 	return wasHandled;
 }
 
+// PROTECTED: call the handlers in one entry, newest first, until one of them handles the event
+// handlers can add and remove handlers, or even clear this emitter, while we are going through
+// them, so everything is looked up by index each time around
+bool
+EventEmitter::dispatchToHandlers(int infoIndex, EventEmitter* emitter, long inEventType, void* inEventData) {
+	size_t i = mHandlers[infoIndex].handlerList.size();
+	while (i > 0) {
+		i--;
+		if (((size_t)infoIndex >= mHandlers.size()) || (i >= mHandlers[infoIndex].handlerList.size())) {
+			break;  // a handler cleared the emitter
+		}
+		const EventHandlerInfo& info = mHandlers[infoIndex].handlerList[i];
+		if (info.handler && !info.removed) {
+			IEventHandler* handler = info.handler;
+            EVENT_DEBUG_ONLY( OS::_DOUT("EventEmitter::emitEvent: trying handler [%p] [%s]", 
+            	handler, typeid_name(handler)); )
+			if (handler->handleEvent(emitter, inEventType, inEventData)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
 bool 
 EventEmitter::emitEvent(EventEmitter* emitter, long inEventType, void* inEventData) {
     if (inEventType == all_events) {
         DEBUG_ONLY( OS::_DOUT("EventEmitter::emitEvent ignoring attempt to post illegal event of type all_events"); )
         return false;
     }
-    if (mHandlers.size() == 0) {
-        EVENT_DEBUG_ONLY( OS::_DOUT("EventEmitter::emitEvent but no handlers at all have been registered"); )
+    if (!hasHandlersFor(inEventType)) {
+        EVENT_DEBUG_ONLY( OS::_DOUT("EventEmitter::emitEvent but no handlers have been registered for the type"); )
         return false;
     }
     EVENT_DEBUG_ONLY(OS::_DOUT("EventEmitter::emitEvent: posting event type [%d][%s] with data [%p]", inEventType, 
                                 getEventName(inEventType), inEventData);)
     bool wasHandled = false;
+    EmitDepthGuard depthGuard(this);
     // --- typed handlers ---
-    HandlerMapT::iterator it = mHandlers.find(inEventType);
-    if (it != mHandlers.end()) {
+    int idx = findHandlingInfo(inEventType);
+    if (idx >= 0) {
         // found a list of handlers for this type
-        if ((*it).second.blocked) {
+        if (mHandlers[idx].blocked) {
             DEBUG_ONLY( OS::_DOUT("EventEmitter::emitEvent got blocked event type [%d][%s] data [%p], IGNORING",
                         inEventType, getEventName(inEventType), inEventData); )
             return false; // go no further with this event
-        } else {
-            HandlerListT& list = (*it).second.handlerList;
-            if (list.size() > 0) {
-                HandlerListT::reverse_iterator listIt = list.rbegin();
-                while (listIt != list.rend() && !wasHandled) {
-                    IEventHandler* handler = (*listIt).handler;
-					bool removed = (*listIt).removed;
-					listIt++;
-					if (handler && !removed) {
-                        EVENT_DEBUG_ONLY( OS::_DOUT("EventEmitter::emitEvent: trying typed handler [%p] [%s]", 
-                        	handler, typeid_name(handler)); )
-				        wasHandled = handler->handleEvent(emitter, inEventType, inEventData);
-					}
-                }
-            }
         }
+        wasHandled = dispatchToHandlers(idx, emitter, inEventType, inEventData);
     }
     // --- untyped handlers ---
     EVENT_DEBUG_ONLY(OS::_DOUT("EventEmitter::emitEvent: all typed handlers tried: %s", wasHandled ? "handled" : "not handled");)
     if (!wasHandled) {
         // no need to check for blocked events here, blocked events always have a handler entry
-        // in the type map, even if there are no handlers assigned to that type, so they
+        // in the table, even if there are no handlers assigned to that type, so they
         // will always be dealt with in the typed handlers section
         EVENT_DEBUG_ONLY(OS::_DOUT("EventEmitter::emitEvent: event still not handled, trying untyped handlers");)
-        it = mHandlers.find(all_events);
-        if (it != mHandlers.end()) {
+        idx = findHandlingInfo(all_events);
+        if (idx >= 0) {
             // we have a list of handlers interested in all events
-            HandlerListT& list = (*it).second.handlerList;
-            if (list.size() > 0) {
-                HandlerListT::reverse_iterator listIt = list.rbegin();
-                while (listIt != list.rend() && !wasHandled) {
-                    IEventHandler* handler = (*listIt).handler;
-					bool removed = (*listIt).removed;
-					++listIt;
-					if (handler && !removed) {
-                        EVENT_DEBUG_ONLY(OS::_DOUT("EventEmitter::emitEvent: trying untyped handler [%p]", handler);)
-				        wasHandled = handler->handleEvent(emitter, inEventType, inEventData);
-					}
-                }
-            }
+            wasHandled = dispatchToHandlers(idx, emitter, inEventType, inEventData);
         }
     	EVENT_DEBUG_ONLY(OS::_DOUT("EventEmitter::emitEvent: all untyped handlers tried: %s", wasHandled ? "handled" : "not handled");)
     }
-	cleanupRemovedHandlers();
 	return wasHandled;
 }    
     
+// removed handlers are only marked as removed while events are being emitted, this
+// actually takes them out once it is safe to do so
 void 
 EventEmitter::cleanupRemovedHandlers() {
-	if (mHandlerRemoved) {
+	if (mHandlerRemoved && (mEmitDepth == 0)) {
 		EVENT_DEBUG_ONLY(OS::_DOUT("EventEmitter::cleanupRemovedHandlers: some handlers where removed, doing cleanup");)
-		HandlerMapT::iterator it = mHandlers.begin();
-		while (it != mHandlers.end()) {
-			if ((*it).second.handlerRemoved) {
-				HandlerListT& list = (*it).second.handlerList;
-				HandlerListT::iterator listIt = list.begin();
-				while (listIt != list.end()) {
-					HandlerListT::iterator oldListIt = listIt;
-					++listIt;
-					if ((*oldListIt).removed) {
-						DEBUG_ONLY( 
-						    IEventHandler* handler = (*oldListIt).handler;
-							DEBUG_ASSERT( handler == 0, "handler in list should have been set to 0 by removeHandler()" );
-						)
+		mHandledTypes = 0;
+		size_t n = 0;
+		for (size_t i = 0; i < mHandlers.size(); i++) {
+			EventHandlingInfo& info = mHandlers[i];
+			if (info.handlerRemoved) {
+				HandlerListT& list = info.handlerList;
+				size_t keep = 0;
+				for (size_t j = 0; j < list.size(); j++) {
+					if (list[j].removed) {
+						DEBUG_ASSERT( list[j].handler == 0, "handler in list should have been set to 0 by removeHandler()" );
 						EVENT_DEBUG_ONLY(
 							OS::_DOUT("EventEmitter::cleanupRemovedHandlers: cleanup removed handler");
 						)
-						list.erase(oldListIt);
+					} else {
+						list[keep++] = list[j];
 					}
 				}
-				(*it).second.handlerRemoved = false;
+				list.resize(keep);
+				info.handlerRemoved = false;
+			}
+			// drop types that have nothing left in them, so they go back to the fast path
+			if (!info.handlerList.empty() || info.blocked) {
+				if (n != i) {
+					mHandlers[n] = mHandlers[i];
+				}
+				mHandledTypes |= typeBit(mHandlers[n].eventType);
+				n++;
 			}
-			it++;
 		}
+		mHandlers.resize(n, EventHandlingInfo(all_events));
 		mHandlerRemoved = false;
 	}
 }
@@ -258,21 +284,17 @@ EventEmitter::cleanupRemovedHandlers() {
 void 
 EventEmitter::clear(bool doRelease) {
     if (doRelease) {
-		HandlerMapT::iterator it = mHandlers.begin();
-		while (it != mHandlers.end()) {
+		for (size_t i = 0; i < mHandlers.size(); i++) {
 			// iterate through entire list releasing references to handlers
-			HandlerListT& list = (*it).second.handlerList;
-			HandlerListT::iterator listIt = list.begin();
-			while (listIt != list.end()) {
-				IEventHandler* handler = (*listIt).handler;
+			HandlerListT& list = mHandlers[i].handlerList;
+			for (size_t j = 0; j < list.size(); j++) {
+				IEventHandler* handler = list[j].handler;
 				if (handler) {
 					handler->release();				     // we add ref'd when we put it in, release it now -- must do immediately in case this removeHandler is called from a destructor
-					(*listIt).handler = 0;				 // don't reuse it now that we have released it
+					list[j].handler = 0;				 // don't reuse it now that we have released it
 					EVENT_DEBUG_ONLY(OS::_DOUT("EventEmitter::clear: removed handler [%p]", handler);)
 				}
-				++listIt;
 			}
-			++it;
 		}
     } else {
     	DEBUG_ONLY( if (mHandlers.size() != 0) 
@@ -280,6 +302,8 @@ EventEmitter::clear(bool doRelease) {
 	}
     // now free all the list data
     mHandlers.clear();
+    mHandledTypes = 0;
+    mHandlerRemoved = false;
 }
 
 void 
@@ -294,17 +318,9 @@ EventEmitter::blockEvent(long inEventType) {
     // temporarily ignore all events of a particular type
     DEBUG_ONLY( OS::_DOUT("EventEmitter::blockEvent for event type [%d][%s]", inEventType, 
                             getEventName(inEventType)); )
-    HandlerMapT::iterator it = mHandlers.find(inEventType);
-    if (it != mHandlers.end()) {
-        // found a list of handlers for this type
-        EventHandlingInfo& info = (*it).second;
-        info.blocked = true;
-    } else {
-        // no list of handlers found, create a new one and tag it as blocked
-        EventHandlingInfo newInfo;
-        newInfo.blocked = true;
-        mHandlers.insert( HandlerMapT::value_type(inEventType, newInfo) );
-    }
+    // if there is no list of handlers for this type, this creates a new one to tag as blocked
+    int idx = addHandlingInfo(inEventType);
+    mHandlers[idx].blocked = true;
 }
 
 void 
@@ -320,11 +336,10 @@ EventEmitter::unblockEvent(long inEventType) {
     DEBUG_ONLY( OS::_DOUT("EventEmitter::unblockEvent for event type [%d][%s]", inEventType, 
                             getEventName(inEventType)); )
     
-    HandlerMapT::iterator it = mHandlers.find(inEventType);
-    if (it != mHandlers.end()) {
+    int idx = findHandlingInfo(inEventType);
+    if (idx >= 0) {
         // found a list of handlers for this type
-        EventHandlingInfo& info = (*it).second;
-        info.blocked = false;
+        mHandlers[idx].blocked = false;
     } else {
         DEBUG_ONLY( OS::_DOUT("WARNING: unblockEvent for event type [%d][%s] with no handlers",
                     inEventType, getEventName(inEventType)); )
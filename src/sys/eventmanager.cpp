@@ -159,16 +159,14 @@ void
 EventManager::clear(bool doRelease) {
     EventEmitter::clear(doRelease);
 #ifndef PDG_NO_EVENT_QUEUE
-    AutoMutex mutex(&mEventQueueMutex);
-    DEBUG_ONLY( if (mEventQueue.size() != 0) OS::_DOUT("WARNING: unhandled events in queue when EventMgr::clear() called"); )
-    while (mEventQueue.size() > 0) {
-        EventQueueEntry& evt = mEventQueue.front();
+    EventQueueEntryListT events;
+    mEventQueue.drain(events);
+    DEBUG_ONLY( if (events.size() != 0) OS::_DOUT("WARNING: unhandled events in queue when EventMgr::clear() called"); )
+    for (size_t i = 0; i < events.size(); i++) {
         // release the user data if there was any
-        if (evt.userData) {
-        	evt.userData->release();
-        	evt.userData = 0;
+        if (events[i].userData) {
+        	events[i].userData->release();
         }
-        mEventQueue.pop();
     }
 #endif
 }
@@ -188,28 +186,68 @@ EventManager::unblockEvent(long inEventType) {
 #ifndef PDG_NO_EVENT_QUEUE
 void 
 EventManager::enqueueEvent(long inEventType, UserData* inEventData, EventEmitter* inEmitter) {
- // mutexed for posting events between threads
-    AutoMutex mutex(&mEventQueueMutex);
+ // lock-free unless the queue has overflowed, safe to call from any thread
     DEBUG_ASSERT(inEventData != 0, "bad event data ptr");
-    EventQueueEntry entry(inEventType, inEventData, inEmitter);
-    mEventQueue.push(entry);
+    mEventQueue.push(EventQueueEntry(inEventType, inEventData, inEmitter));
 }
 
 bool 
 EventManager::getQueuedEvent(long& outEventType, UserData*& outEventData, EventEmitter*& outEmitter) {
- // mutexed for posting events between threads
-    AutoMutex mutex(&mEventQueueMutex);
-    if (mEventQueue.size() == 0) {
+    EventQueueEntry evt;
+    if (!mEventQueue.pop(evt)) {
         return false;
     } else {
-        EventQueueEntry& evt = mEventQueue.front();
         outEventType = evt.eventType;
         outEventData = evt.userData;
         outEmitter = evt.emitter;
-        mEventQueue.pop();
         return true;
     }
 }
+
+int
+EventManager::getQueuedEvents(EventQueueEntryListT& outEvents) {
+    return mEventQueue.drain(outEvents);
+}
+
+// releases the events left in a batch if a handler throws part way through it, and
+// hands the batch list back to the EventManager for reuse
+class DispatchBatchCleanup {
+public:
+    DispatchBatchCleanup(EventQueueEntryListT& batch, EventQueueEntryListT& reuseList)
+        : mBatch(batch), mReuseList(reuseList), next(0) {}
+    ~DispatchBatchCleanup() {
+        for (size_t i = next; i < mBatch.size(); i++) {
+            mBatch[i].userData->release();
+        }
+        mBatch.clear();
+        mBatch.swap(mReuseList);
+    }
+    EventQueueEntryListT& mBatch;
+    EventQueueEntryListT& mReuseList;
+    size_t next;	// first event in the batch that hasn't been released yet
+};
+
+int
+EventManager::dispatchQueuedEvents() {
+    // borrow the member batch list so we don't reallocate every time, but stay safe
+    // if a handler dispatches queued events itself
+    EventQueueEntryListT batch;
+    batch.swap(mDispatchBatch);
+    DispatchBatchCleanup cleanup(batch, mDispatchBatch);
+    int eventCount = 0;
+    while (mEventQueue.drain(batch) > 0) {
+        for (size_t i = 0; i < batch.size(); i++) {
+            EventQueueEntry& evt = batch[i];
+            postEventToEmitter(evt.eventType, evt.userData->getData(), evt.emitter);
+            evt.userData->release();
+            cleanup.next = i + 1;
+        }
+        eventCount += (int)batch.size();
+        batch.clear();
+        cleanup.next = 0;
+    }
+    return eventCount;
+}
 #endif // PDG_NO_EVENT_QUEUE
 
 EventManager* EventManager::createSingletonInstance() {
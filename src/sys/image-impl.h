@@ -36,6 +36,9 @@
 #include "pdg/sys/image.h"
 #include "pdg/sys/imagestrip.h"
 #include "pdg/sys/color.h"
+#include "pdg/sys/mutex.h"
+
+#include <vector>
 
 #ifdef PDG_NO_GUI
   // not really using GL textures, just need to keep track 
@@ -46,6 +49,26 @@
 
 namespace pdg {
 
+	class ImageImpl;
+
+	// packed 1 bit per pixel copy of an image's alpha channel, with a bit set for each pixel
+	// whose alpha value is above the threshold. Built on demand for per-pixel collisions
+	class AlphaMask {
+	public:
+		AlphaMask(const ImageImpl* image, uint8 inThreshold);
+
+		// same results as (image->getAlphaValue(x, y) > threshold)
+		bool	isSet(int32 x, int32 y) const;
+		// 64 pixels of row y starting at x, with pixel x in the lowest bit. x must be >= 0
+		uint64	getBits(int32 x, int32 y) const;
+
+		uint8	threshold;
+		int32	width;
+		int32	height;
+		int32	wordsPerRow;
+		std::vector<uint64> bits;
+	};
+
 	class ImageImpl : public ImageStrip {  // all images implement ImageStrip, the distinction is for the caller only
 	public:
 
@@ -97,6 +120,12 @@ namespace pdg {
 		virtual void	initFromData(char* imageData, long imageDataLen, const char* filename);
     	virtual void    initEmpty(long width, long height, uint8 inBitsPerPixel = 32);
 
+		// get a mask of the pixels with alpha above the threshold, building it if needed
+		// returns 0 if the image has no data to build it from
+		const AlphaMask* getAlphaMask(uint8 threshold) const;
+		// call after changing the image data directly, so the masks get rebuilt
+		void	invalidateAlphaMasks();
+
 		ImageImpl();
 		virtual ~ImageImpl();
 
@@ -114,9 +143,38 @@ namespace pdg {
 		Rect    mSectionRect;	// only valid when (mFrameNum < 0 && !mIsQuadSection)
 		Quad	mSectionQuad;	// only valid when (mFrameNum < 0 && mIsQuadSection)
 
+		mutable std::vector<AlphaMask*> mAlphaMasks;  // one per alpha threshold used
+		mutable Mutex mAlphaMaskMutex;  // worlds on other threads may build masks at the same time
+
 	};
 
 
+inline bool
+AlphaMask::isSet(int32 x, int32 y) const {
+	if ( (x < 0) || (x >= width) || (y < 0) || (y >= height) ) {
+		return false; // there is no image outside the image
+	}
+	return (bits[y * wordsPerRow + (x >> 6)] >> (x & 63)) & 1;
+}
+
+inline uint64
+AlphaMask::getBits(int32 x, int32 y) const {
+	if ( (y < 0) || (y >= height) ) {
+		return 0;
+	}
+	int32 word = x >> 6;
+	if (word >= wordsPerRow) {
+		return 0;
+	}
+	const uint64* row = &bits[y * wordsPerRow];
+	int shift = x & 63;
+	uint64 result = row[word] >> shift;
+	if (shift && (word + 1 < wordsPerRow)) {
+		result |= row[word + 1] << (64 - shift);
+	}
+	return result;
+}
+
 inline Image*  
 ImageImpl::createImageFromFrame(int frame) {
 	return getFrame(frame);
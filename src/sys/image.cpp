@@ -180,6 +180,7 @@ ImageImpl::setTransparentColor(Color rgb) {
 		}
 		src += pitch;
 	}
+	invalidateAlphaMasks();
 }
 
 void
@@ -211,6 +212,61 @@ uint8 ImageImpl::getAlphaValue(int32 x, int32 y) const {
 	uint8* src = (uint8*)data + rowOffset + colOffset;
 	return src[3];
 }
+
+AlphaMask::AlphaMask(const ImageImpl* image, uint8 inThreshold)
+ :	threshold(inThreshold),
+	width(image->width),
+	height(image->height),
+	wordsPerRow((image->width + 63) / 64),
+	bits(wordsPerRow * height, 0)
+{
+	// same rules as getAlphaValue(), images without an alpha channel are all one opacity
+	if ((image->bpp >> 3) != 4) {
+		if (image->getOpacity() > threshold) {
+			for (int32 y = 0; y < height; y++) {
+				for (int32 x = 0; x < width; x++) {
+					bits[y * wordsPerRow + (x >> 6)] |= (uint64)1 << (x & 63);
+				}
+			}
+		}
+		return;
+	}
+	for (int32 y = 0; y < height; y++) {
+		const uint8* src = (const uint8*)image->data + y * image->pitch;
+		uint64* row = &bits[y * wordsPerRow];
+		for (int32 x = 0; x < width; x++) {
+			if (src[3] > threshold) {
+				row[x >> 6] |= (uint64)1 << (x & 63);
+			}
+			src += 4;
+		}
+	}
+}
+
+const AlphaMask*
+ImageImpl::getAlphaMask(uint8 threshold) const {
+	AutoMutex mutex(&mAlphaMaskMutex);
+	for (size_t i = 0; i < mAlphaMasks.size(); i++) {
+		if (mAlphaMasks[i]->threshold == threshold) {
+			return mAlphaMasks[i];
+		}
+	}
+	if (data == 0) {
+		return 0; // nothing to build it from, caller will have to use getAlphaValue()
+	}
+	AlphaMask* mask = new AlphaMask(this, threshold);
+	mAlphaMasks.push_back(mask);
+	return mask;
+}
+
+void
+ImageImpl::invalidateAlphaMasks() {
+	AutoMutex mutex(&mAlphaMaskMutex);
+	for (size_t i = 0; i < mAlphaMasks.size(); i++) {
+		delete mAlphaMasks[i];
+	}
+	mAlphaMasks.clear();
+}
 	
 Color ImageImpl::getPixel(int32 x, int32 y) const {
 	DEBUG_ONLY(
@@ -237,6 +293,7 @@ ImageImpl::initFromData(char* imageData, long imageDataLen, const char* filename
 	std::strncpy(mFilename, filename, 255);
   #endif
 	// pass this on to our platform code
+	invalidateAlphaMasks();
 	platform_initImageData((unsigned char*)imageData, imageDataLen, (unsigned char**)&data, &width, 
 			&height, &mBufferWidth, &mBufferHeight, &pitch, &mTextureFormat);
 	if (mTextureFormat == GL_RGBA) {
@@ -260,6 +317,7 @@ ImageImpl::initFromData(char* imageData, long imageDataLen, const char* filename
 	
 void
 ImageImpl::initEmpty(long w, long h, uint8 inBitsPerPixel) {
+	invalidateAlphaMasks();
     // set the output params
     width = w;
     height = h;
@@ -290,6 +348,7 @@ ImageImpl::ImageImpl()
 
 
 ImageImpl::~ImageImpl() {
+	invalidateAlphaMasks();
 	if (!data) {
 		std::free(data);
 		data = 0;
@@ -49,6 +49,13 @@
 	#define OP_API_NETWORK_SOCKETS
 #endif
 
+// on Linux the worker thread waits on an edge triggered epoll set instead of calling select(), so
+// it isn't limited to FD_SETSIZE sockets and a wakeup costs the same however many are open.
+// Define PDG_NET_NO_EPOLL in your build environment to use select() there as well
+#if defined( PLATFORM_LINUX ) && defined( OP_API_NETWORK_SOCKETS ) && !defined( PDG_NET_NO_EPOLL )
+	#define PDG_NET_USE_EPOLL
+#endif
+
 // define the following in your build environment, or uncomment it here to get
 // debug output for the network layer
 //#define PDG_DEBUG_NETWORKING
@@ -88,7 +95,7 @@ static void     ListenerCallback(PEndpointRef inEndpoint, void* inContext,
 
 
 NetEndpoint::NetEndpoint(OpenPlayNetworkManager* mgr, PEndpointRef ref, void* userContext, uint8 connectFlags) 
- : mNetMgr(mgr), mEndpoint(ref), mMaxIncomingPacketSize(DEFAULT_MAX_INCOMING_PACKET_SIZE),
+ : mNetMgr(mgr), mEndpoint(ref), mMaxIncomingPacketSize(DEFAULT_MAX_INCOMING_PACKET_SIZE), mOutgoingOffset(0),
    mInProgressPacket(0), mOffsetInHeader(0), mListener(true), mConnectFlags(connectFlags), 
    mLastError(0), mReceivePending(false) {
     initialize(userContext);
@@ -107,7 +114,7 @@ NetEndpoint::NetEndpoint(OpenPlayNetworkManager* mgr, PEndpointRef ref, void* us
 }
 
 NetEndpoint::NetEndpoint(OpenPlayNetworkManager* mgr, void* userContext, uint8 connectFlags) 
- : mNetMgr(mgr), mEndpoint(0), mMaxIncomingPacketSize(DEFAULT_MAX_INCOMING_PACKET_SIZE),
+ : mNetMgr(mgr), mEndpoint(0), mMaxIncomingPacketSize(DEFAULT_MAX_INCOMING_PACKET_SIZE), mOutgoingOffset(0),
    mInProgressPacket(0), mOffsetInHeader(0), mListener(false), mConnectFlags(connectFlags),
    mLastError(0), mReceivePending(false) {
    initialize(userContext);
@@ -137,6 +144,12 @@ NetEndpoint::~NetEndpoint() {
         netDataP->endpointRefs.erase(EndpointRefMap::key_type(mEndpoint));
         netDataP->endpointIds.erase(EndpointIdMap::key_type(mId));
     }
+    // anything still waiting to go is never going to be sent
+    AutoMutex mutex(&mOutgoingQueueMutex);
+    while (!mOutgoingPackets.empty()) {
+        releasePacket(mOutgoingPackets.front());
+        mOutgoingPackets.pop_front();
+    }
 }
 
 void
@@ -318,73 +331,56 @@ NetEndpoint::sendPacket(NetPacket* inPacket) {
     if (inPacket->packetLen < sizeof(NetPacket) ) {
         NET_DEBUG_ONLY( OS::_DOUT("Endpoint SendPacket failed, size not set, size = %d", inPacket->packetLen); )
     }
+    // hold the queue for the whole send, so nothing can get in between the waiting packets and this one
+    AutoMutex mutex(&mOutgoingQueueMutex);
     // always try to send any waiting packets
-    sendWaitingPackets();
+    sendQueuedPackets();
     // if, after trying to send waiting packets, there are still some in the queue, then queue
     // the packet to be sent
-    if (waitingToSend()) {
+    if (!mOutgoingPackets.empty()) {
         ASYNC_DEBUG_OUT("Packets already waiting, queuing outgoing packet", DEBUG_TRIVIA | DEBUG_PACKETS);
         NetPacket* p = clonePacket(inPacket);  // packet will be freed by caller, so we must make a copy
-        AutoMutex mutex(&mOutgoingQueueMutex);
-        mOutgoingPackets.push(p);        
-    } else {
-        long packetLen = inPacket->packetLen;
-        long sentBytes;
-        if ((mConnectFlags & NetworkManager::flag_NoFraming) == 0) {
-            // using packet framing
-            byteSwapOutgoingPacket(inPacket);   // swap to network byte order
-            mLastError = kNMProtocolErr; // in case next call fails
-            sentBytes = ProtocolSend(mEndpoint, (void*)inPacket, packetLen, 0);
-          #ifdef PDG_NET_DEBUG_PACKET_DUMP
-            if (sentBytes > 0) {
-                char buf[4096];
-                OS::binaryDump(buf, 4096, (const char*)inPacket, sentBytes);
-                NET_DEBUG_ONLY( OS::_DOUT("Sent on connection [%ld]:\n%s", mId, buf); )
-            }
-          #endif
-            byteSwapIncomingPacket(inPacket);   // restore the data now that it's been sent
-        } else {
-            // no packet framing, just send the data
-            void* ptr = (void*)((char*)inPacket+PDG_PACKET_DATA_OFFSET);
-            sentBytes = ProtocolSend(mEndpoint, ptr, packetLen, 0);
-          #ifdef PDG_NET_DEBUG_PACKET_DUMP
-            if (sentBytes > 0) {
-                char buf[4096];
-                OS::binaryDump(buf, 4096, (const char*)ptr, sentBytes);
-                NET_DEBUG_ONLY( OS::_DOUT("Sent on connection [%ld]:\n%s", mId, buf); )
-            }
-          #endif
-            if (sentBytes != kNMFlowErr) {
-                // we don't want to change the packet length if we are about to 
-                // push the packet onto the queue for later transmission
-                inPacket->packetLen -= PDG_PACKET_DATA_OFFSET;
-            }
+        if (p) {
+            mOutgoingPackets.push_back(p);
         }
-        mLastError = 0;
-        if (sentBytes < 0) {
-            // an error was returned, no bytes sent
-            NMErr err = sentBytes;
-            if (err == kNMFlowErr) {
-                ASYNC_DEBUG_OUT("Flow error, queuing outgoing packet ", DEBUG_TRIVIA | DEBUG_PACKETS);
-                NetPacket *p = clonePacket(inPacket);  // packet will be freed by caller, so we must make a copy
-                AutoMutex mutex(&mOutgoingQueueMutex);
-                mOutgoingPackets.push(p);
-            } else {
-                mLastError = err;
-                DEBUG_ONLY( OS::_DOUT("Endpoint SendPacket Failed! Error %d", err); )
-            }
-        } else if (sentBytes != (long)inPacket->packetLen) {
-            // wrong number of bytes sent
-            DEBUG_ONLY( OS::_DOUT("Endpoint SendPacket failed to send entire contents, "
-                                  "size = %d, sent = %d", inPacket->packetLen, sentBytes); )
-        } else {
-            // packet was sent normally
-            if (mNetMgr) {
-                mNetMgr->getNetData().packetStats.recordPacketSent(inPacket);   // globally for all endpoints
-            }
-            mPacketStats.recordPacketSent(inPacket);   // locally for this endpoint
-            NET_DEBUG_ONLY( OS::_DOUT("Sent Packet to OpenPlay endpoint [%p] connection [%d]", mEndpoint, mId); )
+        return;
+    }
+    uint32 wireSize = getWireSize(inPacket);
+    long sentBytes;
+    if ((mConnectFlags & NetworkManager::flag_NoFraming) == 0) {
+        // using packet framing
+        byteSwapOutgoingPacket(inPacket);   // swap to network byte order
+        mLastError = kNMProtocolErr; // in case next call fails
+        sentBytes = ProtocolSend(mEndpoint, (void*)inPacket, wireSize, 0);
+        byteSwapIncomingPacket(inPacket);   // restore the data now that it's been sent
+    } else {
+        // no packet framing, just send the data
+        sentBytes = ProtocolSend(mEndpoint, (char*)inPacket + PDG_PACKET_DATA_OFFSET, wireSize, 0);
+    }
+  #ifdef PDG_NET_DEBUG_PACKET_DUMP
+    if (sentBytes > 0) {
+        char buf[4096];
+        OS::binaryDump(buf, 4096, (const char*)inPacket + (inPacket->packetLen - wireSize), sentBytes);
+        NET_DEBUG_ONLY( OS::_DOUT("Sent on connection [%ld]:\n%s", mId, buf); )
+    }
+  #endif
+    mLastError = 0;
+    if (sentBytes < 0) {
+        // an error was returned, no bytes sent
+        mLastError = sentBytes;
+        DEBUG_ONLY( OS::_DOUT("Endpoint SendPacket Failed! Error %d", mLastError); )
+    } else if (sentBytes < (long)wireSize) {
+        // the socket only took part of it, so queue the rest to go when we get a flow clear
+        ASYNC_DEBUG_OUT("Flow blocked, queuing rest of outgoing packet", DEBUG_TRIVIA | DEBUG_PACKETS);
+        NetPacket* p = clonePacket(inPacket);  // packet will be freed by caller, so we must make a copy
+        if (p) {
+            mOutgoingPackets.push_back(p);
+            mOutgoingOffset = sentBytes;
         }
+    } else {
+        // packet was sent normally
+        packetSent(inPacket);
+        NET_DEBUG_ONLY( OS::_DOUT("Sent Packet to OpenPlay endpoint [%p] connection [%d]", mEndpoint, mId); )
     }
 }
 
@@ -398,66 +394,91 @@ NetEndpoint::waitingToSend() {
 void
 NetEndpoint::sendWaitingPackets() {
     AutoMutex mutex(&mOutgoingQueueMutex);
+    sendQueuedPackets();
+}
+
+// hands as many of the waiting packets as it can to the socket in each send, rather than
+// making a call for every packet, and stops when the socket won't take any more
+void
+NetEndpoint::sendQueuedPackets() {
+    bool framing = ((mConnectFlags & NetworkManager::flag_NoFraming) == 0);
     while (!mOutgoingPackets.empty()) {
-        NetPacket* p = mOutgoingPackets.front();
-        long packetLen = p->packetLen;
-        long sentBytes;
-        if ((mConnectFlags & NetworkManager::flag_NoFraming) == 0) {
-            // using packet framing
-            byteSwapOutgoingPacket(p);   // swap to network byte order
-            mLastError = kNMProtocolErr; // in case send fails
-            sentBytes = ProtocolSend(mEndpoint, (void*)p, packetLen, 0);
-          #ifdef PDG_NET_DEBUG_PACKET_DUMP
-            if (sentBytes > 0) {
-                char buf[4096];
-                OS::binaryDump(buf, 4096, (const char*)p, sentBytes);
-                NET_DEBUG_ONLY( OS::_DOUT("Sent on connection [%ld]:\n%s", mId, buf); )
+        NMSendBuffer buffers[MAX_PACKETS_PER_SEND];
+        uint32 count = 0;
+        long batchBytes = 0;
+        uint32 offset = mOutgoingOffset;
+        std::deque<NetPacket*>::iterator it = mOutgoingPackets.begin();
+        while ((it != mOutgoingPackets.end()) && (count < MAX_PACKETS_PER_SEND)) {
+            NetPacket* p = *it++;
+            uint32 wireSize = getWireSize(p);
+            buffers[count].data = (char*)p + (p->packetLen - wireSize) + offset;
+            buffers[count].size = wireSize - offset;
+            batchBytes += buffers[count].size;
+            if (framing) {
+                byteSwapOutgoingPacket(p);   // swap to network byte order
             }
-          #endif
-            byteSwapIncomingPacket(p);   // restore the data now that it's been sent
-        } else {
-            // no packet framing, just send the data
-            void* ptr = (void*)((char*)p+PDG_PACKET_DATA_OFFSET);
-            sentBytes = ProtocolSend(mEndpoint, ptr, packetLen, 0);
-          #ifdef PDG_NET_DEBUG_PACKET_DUMP
-            if (sentBytes > 0) {
-                char buf[4096];
-                OS::binaryDump(buf, 4096, (const char*)ptr, sentBytes);
-                NET_DEBUG_ONLY( OS::_DOUT("Sent on connection [%ld]:\n%s", mId, buf); )
+            offset = 0;
+            ++count;
+        }
+        mLastError = kNMProtocolErr; // in case send fails
+        long sentBytes = ProtocolSendv(mEndpoint, buffers, count, 0);
+        if (framing) {
+            // restore the packets now they've been sent
+            it = mOutgoingPackets.begin();
+            for (uint32 i = 0; i < count; i++) {
+                byteSwapIncomingPacket(*it++);
             }
-          #endif
-            p->packetLen -= PDG_PACKET_DATA_OFFSET;
         }
         mLastError = 0;
         if (sentBytes < 0) {
-            NMErr err = sentBytes;
-            if (err == kNMFlowErr) {
-                ASYNC_DEBUG_OUT("Flow error, leaving packet in queue", DEBUG_TRIVIA | DEBUG_PACKETS);
-                return;  // don't try to send any more
-            } else {
-                mLastError = err;
-                DEBUG_ONLY( OS::_DOUT("Endpoint SendWaitingPackets Failed! Error %d", err); )
-                return; // don't try to send any more
-            }
-        } else if (sentBytes != (long)p->packetLen) {
-            // wrong number of bytes sent
-            TODO("Need to handle partial send");
-            DEBUG_ONLY( OS::_DOUT("Endpoint SendWaitingPacket failed to send entire contents, "
-                                   "size = %d, sent = %d", p->packetLen, sentBytes); )
+            mLastError = sentBytes;
+            DEBUG_ONLY( OS::_DOUT("Endpoint SendWaitingPackets Failed! Error %d", mLastError); )
             return; // don't try to send any more
-        } else {
-            // packet was sent normally
-            mOutgoingPackets.pop();
-            if (mNetMgr) {
-                mNetMgr->getNetData().packetStats.recordPacketSent(p);   // globally for all endpoints
-            }
-            mPacketStats.recordPacketSent(p);   // locally for this endpoint
+        }
+      #ifdef PDG_NET_DEBUG_PACKET_DUMP
+        if (sentBytes > 0) {
+            char buf[4096];
+            OS::binaryDump(buf, 4096, (const char*)buffers[0].data, (sentBytes < (long)buffers[0].size) ? sentBytes : buffers[0].size);
+            NET_DEBUG_ONLY( OS::_DOUT("Sent on connection [%ld]:\n%s", mId, buf); )
+        }
+      #endif
+        // drop the packets that went out completely, and remember how far we got into the next one
+        long remaining = sentBytes;
+        for (uint32 i = 0; (i < count) && (remaining >= (long)buffers[i].size); i++) {
+            remaining -= buffers[i].size;
+            NetPacket* p = mOutgoingPackets.front();
+            mOutgoingPackets.pop_front();
+            mOutgoingOffset = 0;
+            packetSent(p);
             NET_DEBUG_ONLY( OS::_DOUT("Sent Waiting Packet to OpenPlay endpoint [%p] connection [%d]", mEndpoint, mId); )
             releasePacket(p);
         }
+        mOutgoingOffset += remaining;
+        if (sentBytes < batchBytes) {
+            ASYNC_DEBUG_OUT("Flow blocked, leaving packets in queue", DEBUG_TRIVIA | DEBUG_PACKETS);
+            return;  // don't try to send any more
+        }
+    }
+}
+
+// how many bytes of the packet go over the wire. Without framing that's just the data
+uint32
+NetEndpoint::getWireSize(NetPacket* inPacket) {
+    if ((mConnectFlags & NetworkManager::flag_NoFraming) == 0) {
+        return inPacket->packetLen;
+    } else {
+        return inPacket->packetLen - PDG_PACKET_DATA_OFFSET;
     }
 }
 
+void
+NetEndpoint::packetSent(NetPacket* inPacket) {
+    if (mNetMgr) {
+        mNetMgr->getNetData().packetStats.recordPacketSent(inPacket);   // globally for all endpoints
+    }
+    mPacketStats.recordPacketSent(inPacket);   // locally for this endpoint
+}
+
 void
 NetEndpoint::setMaxIncomingSize(uint32 inMaxLen) {
     mMaxIncomingPacketSize = inMaxLen;
@@ -1194,8 +1215,32 @@ void ListenerCallback(PEndpointRef inEndpoint, void* inContext, NMCallbackCode i
    }   
 }
 
-void 
+// send the same data on every established connection. The packet is built once and handed to each
+// endpoint in turn, only endpoints that are backed up keep a copy of it in their queue
+void
 OpenPlayNetworkManager::broadcastData(void* inEventData, long dataLen) {
+    AutoMutex mutex(&(mNetData.dataMutex));     // endpoints map could be changed by worker thread
+    EndpointIdMap& endpointIds = mNetData.endpointIds;
+    NetEndpoint* packetOwner = 0;
+    NetPacket* packet = 0;
+    for (EndpointIdMap::iterator it = endpointIds.begin(); it != endpointIds.end(); ++it) {
+        NetEndpoint* ep = (*it).second;
+        if (!ep || !ep->getOpenPlayEndpoint()) {
+            continue;   // still connecting
+        }
+        if (!packet) {
+            packet = ep->createPacket(dataLen + sizeof(NetPacket));
+            if (!packet) {
+                return;
+            }
+            std::memcpy((char*)packet + PDG_PACKET_DATA_OFFSET, inEventData, dataLen);
+            packetOwner = ep;
+        }
+        ep->sendPacket(packet);
+    }
+    if (packet) {
+        packetOwner->releasePacket(packet);
+    }
 }
 
 bool 
@@ -1360,6 +1405,7 @@ OpenPlayNetworkManager::isWaitingForNetwork() {
 #else
 	#include <sys/types.h>
 	#include <sys/socket.h>
+	#include <sys/uio.h>
 	#include <netinet/in.h>
 	#include <netinet/tcp.h>
 	#include <arpa/inet.h>
@@ -1562,6 +1608,11 @@ NMErr		NMSend				(	NMEndpointRef 		inEndpoint,
 								uint32			inSize,
 								NMFlags 			inFlags);
 
+NMErr		NMSendv				(	NMEndpointRef 		inEndpoint, 
+								const NMSendBuffer *	inBuffers, 
+								uint32			inCount,
+								NMFlags 			inFlags);
+
 NMErr		NMReceive			(	NMEndpointRef		inEndpoint,
 								void *				ioData, 
 								uint32 *			ioSize,
@@ -1920,6 +1971,37 @@ int32 ProtocolSend(
 	return result; // is < 0 incase of error...
 }
 
+//----------------------------------------------------------------------------------------
+// ProtocolSendv
+//----------------------------------------------------------------------------------------
+/**
+	Send several pieces of data via an endpoint's reliable(stream) connection, in order, as if they
+	were one block passed to ProtocolSend(), but with a single call to the socket.
+	@brief Send several pieces of data via an endpoint's reliable(stream) connection.
+	@param endpoint The endpoint to send the data to.
+	@param inBuffers The pieces of data to be sent.
+	@param inCount Number of entries in \e inBuffers.
+	@param inFlags Flags.
+	@return If positive, the total number of bytes actually sent.\n If negative, an error code.\n
+	If the number of bytes sent is less than the total requested, the endpoint will receive a \ref kNMFlowClear message once
+	more data can be sent.
+	\n\n\n\n
+*/
+int32 ProtocolSendv(
+	PEndpointRef endpoint, 
+	const NMSendBuffer *inBuffers, 
+	uint32 inCount, 
+	NMFlags inFlags)
+{
+	int32 result= kNMNoError;
+	if (valid_endpoint(endpoint)) { // don't assert if invalid endpoint, just return an error
+		result= NMSendv(endpoint->module, inBuffers, inCount, inFlags);
+	} else {
+		result= kNMParameterErr;
+	}
+	return result; // is < 0 incase of error...
+}
+
 //----------------------------------------------------------------------------------------
 // ProtocolReceive
 //----------------------------------------------------------------------------------------
@@ -2197,6 +2279,10 @@ static Endpoint *create_endpoint_for_accept(
 #include <sys/time.h>
 #include <pthread.h>
 #endif
+#ifdef PDG_NET_USE_EPOLL
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
 
 #define kDefaultNetSprocketMode false
 
@@ -2261,13 +2347,20 @@ pdg::Mutex endpointWaitingListLock;
 
 #define MARK_ENDPOINT_AS_VALID(e, t) ((e)->valid_endpoints |= (1<<(t)))
 
+//the worker only walks the endpoint list looking for endpoints that need to die when one has been marked
+#ifdef PDG_NET_USE_EPOLL
+	#define MARK_ENDPOINT_TO_DIE(e) ((e)->needToDie = true, endpointsNeedToDie = true)
+#else
+	#define MARK_ENDPOINT_TO_DIE(e) ((e)->needToDie = true)
+#endif
+
 #define MACHINE_TICKS_PER_SECOND  1000L
 
 
 //	------------------------------	Private Functions
 static bool 	internally_handle_read_data(NMEndpointRef endpoint, int16 type);
 bool processEndpoints(bool block);
-void processEndPointSocket(NMEndpointPriv *theEndPoint, long socketType, fd_set *input_set, fd_set *output_set, fd_set *exc_set);
+bool processEndPointSocket(NMEndpointPriv *theEndPoint, long socketType, bool hasException, bool hasInput, bool canOutput);
 void receive_udp_port(NMEndpointRef endpoint);
 static bool internally_handled_datagram(NMEndpointRef endpoint);
 static long socketReadResult(NMEndpointRef endpoint,int socketType);
@@ -2275,6 +2368,12 @@ void SetNonBlockingMode(int fd);
 int createWakeSocket(void);
 void disposeWakeSocket(void);
 void sendWakeMessage(void);
+static void _flow_blocked(NMEndpointRef endpoint, int index);
+#ifdef PDG_NET_USE_EPOLL
+	static void _watch_endpoint_sockets(NMEndpointRef endpoint);
+	static void _unwatch_endpoint_sockets(NMEndpointRef endpoint);
+	static void _rearm_endpoint_socket(NMEndpointRef endpoint, int index);
+#endif
 void createWorkerThread(void);
 void killWorkerThread(void);
 #ifdef OP_API_NETWORK_WINSOCK
@@ -2337,6 +2436,22 @@ const char *kConfigCustomData = "enumData";
 static int wakeSocket;
 static int wakeHostSocket;
 
+#ifdef PDG_NET_USE_EPOLL
+	static int epollFd = -1;
+	static int wakeEventFd = -1;	//written to by sendWakeMessage() to break out of epoll_wait()
+	static volatile bool endpointsNeedToDie = false;
+
+	//the events from the last epoll_wait() that the worker hasn't handled yet. NMClose() blanks out
+	//the ones for the endpoint it closes, so the rest can still be handled after the list changes.
+	//each event carries the endpoint with the socket type in the low bit, or 0 for the wake eventfd
+	#define MAX_EPOLL_EVENTS 256
+	#define EPOLL_EVENT_ENDPOINT(ev) ((NMEndpointRef)(uintptr_t)((ev).data.u64 & ~(uint64)1))
+	#define EPOLL_EVENT_SOCKET(ev) ((long)((ev).data.u64 & 1))
+	static struct epoll_event pendingEvents[MAX_EPOLL_EVENTS];
+	static int pendingEventCount = 0;
+	static int nextPendingEvent = 0;
+#endif
+
 //for notifier locks
 //static long notifierLockCount = 0;
 
@@ -2849,6 +2964,12 @@ _create_endpoint(
 	endpointListState++;
 	UNLOCK_ENDPOINT_LIST();
 	UNLOCK_ENDPOINT_WAITING_LIST();
+
+#ifdef PDG_NET_USE_EPOLL
+	//a joiner's sockets are watched once NMAcceptConnection() has made them
+	if (create_sockets)
+		_watch_endpoint_sockets(new_endpoint);
+#endif
 	return(kNMNoError);
 }
 
@@ -2935,6 +3056,108 @@ static NMErr _send_data(	NMEndpointRef 		Endpoint,
 } /* _send_data */
 
 
+/* 
+ * Static Function: _send_data_vector
+ *--------------------------------------------------------------------
+ * Parameters:
+ *  [IN] Endpoint = 
+ *  [IN] socket_index = 
+ *  [IN] Buffers = 
+ *  [IN] Count = 
+ *
+ * Returns:
+ *   The total number of bytes sent, or an error code.
+ *
+ * Description:
+ *   Sends the buffers one after another with a single writev(), so a backlog of packets
+ *   costs one system call instead of one each. Stream sockets only.
+ *
+ *--------------------------------------------------------------------
+ */
+
+static NMErr _send_data_vector(	NMEndpointRef 		Endpoint, 
+								int					socket_index,
+								const NMSendBuffer *	Buffers, 
+								unsigned long 		Count)
+{
+	unsigned long total_bytes_sent = 0;
+
+	DEBUG_ENTRY_EXIT("_send_data_vector");
+
+	if (Endpoint->sockets[socket_index] == INVALID_SOCKET)
+		return(kNMParameterErr);
+
+#ifdef OP_API_NETWORK_SOCKETS
+	struct iovec iov[MAX_PACKETS_PER_SEND];
+	unsigned long index = 0;
+
+	while (index < Count)
+	{
+		unsigned long iov_count = 0;
+		unsigned long bytes_to_send = 0;
+		long result;
+
+		while ((index < Count) && (iov_count < MAX_PACKETS_PER_SEND))
+		{
+			iov[iov_count].iov_base = Buffers[index].data;
+			iov[iov_count].iov_len = Buffers[index].size;
+			bytes_to_send += Buffers[index].size;
+			++iov_count;
+			++index;
+		}
+		result = writev(Endpoint->sockets[socket_index], iov, iov_count);
+		if (result == -1)
+		{
+#ifdef HACKY_EAGAIN
+			if ( errno == EAGAIN )
+			{
+				result = 0;
+			}
+			else
+			{
+				DEBUG_NETWORK_API("writev",result);
+				return(kNMInternalErr);
+			}
+#else
+			DEBUG_NETWORK_API("writev",result);
+			return(kNMInternalErr);
+#endif // HACKY_EAGAIN
+		}
+		total_bytes_sent += result;
+
+		//the socket is full, the caller will get a flow clear when there's room for the rest
+		if ((unsigned long)result != bytes_to_send)
+			break;
+	}
+#elif defined(OP_API_NETWORK_WINSOCK)
+	for (unsigned long index = 0; index < Count; ++index)
+	{
+		NMErr result = _send_data(Endpoint, socket_index, Buffers[index].data, Buffers[index].size, 0);
+		if (result < 0)
+			return(result);
+		total_bytes_sent += result;
+		if ((unsigned long)result != Buffers[index].size)
+			break;
+	}
+#endif
+
+	return(total_bytes_sent);
+
+} /* _send_data_vector */
+
+
+//the socket couldn't take everything we gave it, so have the worker tell us when it can
+static void _flow_blocked(NMEndpointRef endpoint, int index)
+{
+	endpoint->flowBlocked[index] = true;
+#ifdef PDG_NET_USE_EPOLL
+	//the socket may have drained before flowBlocked was set, and the worker would have
+	//passed over that edge, so have epoll look at it again
+	_rearm_endpoint_socket(endpoint, index);
+#endif
+}
+
+
 /* 
  * Static Function: _receive_data
  *--------------------------------------------------------------------
@@ -2974,7 +3197,7 @@ static NMErr _receive_data(NMEndpointRef inEndpoint, int which_socket,
 
 	if (result == 0)
 	{
-		inEndpoint->needToDie = true;
+		MARK_ENDPOINT_TO_DIE(inEndpoint);
 		return kNMNoDataErr;
 	}
 	
@@ -3057,6 +3280,10 @@ bool	handled_internally = false;
 			
 			receive_udp_port(endpoint);
 			handled_internally = true;
+#ifdef PDG_NET_USE_EPOLL
+			//edge triggered, so have epoll report the socket again if there's more behind the port
+			_rearm_endpoint_socket(endpoint, _stream_socket);
+#endif
 
 		}
 	}
@@ -3064,6 +3291,11 @@ bool	handled_internally = false;
 	{
 		
 		handled_internally= internally_handled_datagram(endpoint);
+#ifdef PDG_NET_USE_EPOLL
+		//edge triggered, so have epoll report the socket again if there's another request waiting
+		if (handled_internally)
+			_rearm_endpoint_socket(endpoint, _datagram_socket);
+#endif
 	}
 
 	return handled_internally;
@@ -3322,6 +3554,15 @@ NMErr NMClose(NMEndpointRef Endpoint, bool Orderly)
 	linger_option.l_onoff = 1;
 	linger_option.l_linger = 0;
 
+#ifdef PDG_NET_USE_EPOLL
+	//the worker might be holding events for this endpoint, so get the list from it before we go
+	LOCK_ENDPOINT_WAITING_LIST();
+	sendWakeMessage();
+	LOCK_ENDPOINT_LIST();
+	UNLOCK_ENDPOINT_WAITING_LIST();
+	_unwatch_endpoint_sockets(Endpoint);
+#endif
+
 	DEBUG_PRINT("Searching for theEndpoint in NMClose");
 
 	//search for this endpoint on the list, and if its there, remove it
@@ -3349,6 +3590,9 @@ NMErr NMClose(NMEndpointRef Endpoint, bool Orderly)
 		if (found)
 			endpointListState++;
 	}
+#ifdef PDG_NET_USE_EPOLL
+	UNLOCK_ENDPOINT_LIST();
+#endif
 
     	DEBUG_PRINT("Done searching for theEndpoint in NMClose");
 
@@ -3491,6 +3735,10 @@ NMAcceptConnection(
 			// passive and active send the datagram port.
 				_send_datagram_socket(new_endpoint);
 			}
+
+#ifdef PDG_NET_USE_EPOLL
+			_watch_endpoint_sockets(new_endpoint);
+#endif
 		}
 
 		// and the async calls...
@@ -3650,7 +3898,7 @@ NMErr NMSend(NMEndpointRef Endpoint, void *Data, unsigned long Size, NMFlags Fla
 {
 	DEBUG_ENTRY_EXIT("NMSend");
 
-	unsigned long result;
+	long result;
 
 	if (!Endpoint || !Data)
 		return(kNMParameterErr);
@@ -3660,15 +3908,58 @@ NMErr NMSend(NMEndpointRef Endpoint, void *Data, unsigned long Size, NMFlags Fla
 
 	result = _send_data(Endpoint, _stream_socket, Data, Size, Flags);
 
-	//if its a positive return value (not an error) and not the same as they requested,
-	//we're flow blocked - start looking for a flow clear
-	if ((result != Size) && (result > 0))
-		Endpoint->flowBlocked[_stream_socket] = true; //let em know when they can go again
+	//if its not an error and not the same as they requested (the socket may not have
+	//taken any of it), we're flow blocked - start looking for a flow clear
+	if ((result >= 0) && ((unsigned long)result != Size))
+		_flow_blocked(Endpoint, _stream_socket); //let em know when they can go again
 
 	return(result);
 } /* NMSend */
 
 
+/* 
+ * Function: NMSendv
+ *--------------------------------------------------------------------
+ * Parameters:
+ *  [IN] Endpoint = 
+ *  [IN] Buffers = 
+ *  [IN] Count = 
+ *  [IN] Flags = 
+ *
+ * Returns:
+ *   See _send_data_vector(). 
+ *
+ * Description:
+ *   Function to send several pieces of a stream at once.
+ *
+ *--------------------------------------------------------------------
+ */
+
+NMErr NMSendv(NMEndpointRef Endpoint, const NMSendBuffer *Buffers, uint32 Count, NMFlags Flags)
+{
+	DEBUG_ENTRY_EXIT("NMSendv");
+
+	long result;
+	unsigned long size = 0;
+
+	if (!Endpoint || !Buffers)
+		return(kNMParameterErr);
+
+	if (Endpoint->cookie != kModuleID)
+		return(kNMInternalErr);
+
+	for (uint32 index = 0; index < Count; ++index)
+		size += Buffers[index].size;
+
+	result = _send_data_vector(Endpoint, _stream_socket, Buffers, Count);
+
+	if ((result >= 0) && ((unsigned long)result != size))
+		_flow_blocked(Endpoint, _stream_socket); //let em know when they can go again
+
+	return(result);
+} /* NMSendv */
+
+
 /* 
  * Function: NMReceive
  *--------------------------------------------------------------------
@@ -3821,6 +4112,45 @@ NMErr NMDeleteConfig(NMConfigRef inConfig)
 
 
 
+#ifdef PDG_NET_USE_EPOLL
+
+//with epoll, the "wake socket" is an eventfd in the worker's epoll set
+int createWakeSocket(void)
+{
+	struct epoll_event event;
+
+	epollFd = epoll_create(MAX_EPOLL_EVENTS);
+	if (epollFd == -1)	return false;
+	wakeEventFd = eventfd(0, 0);
+	if (wakeEventFd == -1)	return false;
+	SetNonBlockingMode(wakeEventFd);
+
+	event.events = EPOLLIN;
+	event.data.u64 = 0;
+	if (epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeEventFd, &event) == -1)	return false;
+	return true;
+}
+
+void disposeWakeSocket(void)
+{
+	if (wakeEventFd != -1)
+		close(wakeEventFd);
+	if (epollFd != -1)
+		close(epollFd);
+	wakeEventFd = -1;
+	epollFd = -1;
+}
+
+//bumps our eventfd to break out of an epoll_wait() call
+void sendWakeMessage(void)
+{
+	uint64 value = 1;
+	if (wakeEventFd != -1)
+		write(wakeEventFd, &value, sizeof(value));
+}
+
+#else
+
 int createWakeSocket(void)
 {
 	struct sockaddr Server_Address;
@@ -3876,6 +4206,7 @@ void sendWakeMessage(void)
 	//DEBUG_PRINT("sendWakeMessage result: %d",result);
 }
 
+#endif // PDG_NET_USE_EPOLL
 
 void SetNonBlockingMode(int fd)
 {
@@ -3903,6 +4234,178 @@ void SetNonBlockingMode(int fd)
 }
 
 
+#ifdef PDG_NET_USE_EPOLL
+
+//connected sockets are edge triggered, so whatever is waiting on them has to be dealt with each time
+//they come up. A listener's stream socket stays level triggered, since each connect request only
+//accepts one connection and any others have to come up again
+static uint32 _epoll_events_for_socket(NMEndpointRef endpoint, int index)
+{
+	uint32 events = EPOLLIN | EPOLLOUT | EPOLLPRI;
+	if ((index != _stream_socket) || (endpoint->listener == false))
+		events |= EPOLLET;
+	return events;
+}
+
+//start watching an endpoint's sockets with the worker's epoll set
+static void _watch_endpoint_sockets(NMEndpointRef endpoint)
+{
+	struct epoll_event event;
+	int index;
+
+	for (index = 0; index < NUMBER_OF_SOCKETS; ++index)
+	{
+		if (endpoint->sockets[index] != INVALID_SOCKET)
+		{
+			SetNonBlockingMode(endpoint->sockets[index]);
+			event.events = _epoll_events_for_socket(endpoint, index);
+			event.data.u64 = (uint64)(uintptr_t)endpoint | index;
+			if (epoll_ctl(epollFd, EPOLL_CTL_ADD, endpoint->sockets[index], &event) == -1)
+				DEBUG_PRINT("error: epoll_ctl() failed to add fd %d: err %d",endpoint->sockets[index],op_errno);
+		}
+	}
+}
+
+//stop watching an endpoint's sockets, and forget any events for it the worker hasn't got to yet.
+//call with the endpoint list locked
+static void _unwatch_endpoint_sockets(NMEndpointRef endpoint)
+{
+	struct epoll_event event;
+	int index;
+
+	for (index = 0; index < NUMBER_OF_SOCKETS; ++index)
+	{
+		if (endpoint->sockets[index] != INVALID_SOCKET)
+			epoll_ctl(epollFd, EPOLL_CTL_DEL, endpoint->sockets[index], &event);
+	}
+	for (index = nextPendingEvent; index < pendingEventCount; ++index)
+	{
+		if ((pendingEvents[index].data.u64 != 0) && (EPOLL_EVENT_ENDPOINT(pendingEvents[index]) == endpoint))
+			pendingEvents[index].events = 0;
+	}
+}
+
+//have epoll look at a socket again, so it gets reported if it's ready now even though nothing new
+//has happened to it. Used when the worker might have passed over an edge we still need
+static void _rearm_endpoint_socket(NMEndpointRef endpoint, int index)
+{
+	struct epoll_event event;
+
+	if ((epollFd == -1) || (endpoint->sockets[index] == INVALID_SOCKET))
+		return;
+	event.events = _epoll_events_for_socket(endpoint, index);
+	event.data.u64 = (uint64)(uintptr_t)endpoint | index;
+	epoll_ctl(epollFd, EPOLL_CTL_MOD, endpoint->sockets[index], &event);
+}
+
+//process any events that have happened with the endpoints
+bool processEndpoints(bool block)
+{
+	NMEndpointPriv *theEndPoint;
+	bool gotEvent = false;
+	uint32 listStartState;
+
+	//anyone changing the list gets on the waiting list and wakes us, so let them go first
+	LOCK_ENDPOINT_WAITING_LIST();
+	LOCK_ENDPOINT_LIST();
+	UNLOCK_ENDPOINT_WAITING_LIST();
+
+	//start any endpoints that need to die dying
+	if (endpointsNeedToDie)
+	{
+		endpointsNeedToDie = false;
+		listStartState = endpointListState;
+		for (theEndPoint = endpointList; theEndPoint != NULL; theEndPoint = theEndPoint->next)
+		{
+			if ((theEndPoint->needToDie == true) && (theEndPoint->dying == false))
+			{
+				theEndPoint->dying = true;
+
+				//only inform them of its demise if its been fully formed
+				if (theEndPoint->alive == true)
+				{
+					UNLOCK_ENDPOINT_LIST(); //they'll probably kill the endpoint (and thus modify the list) as a result
+					theEndPoint->callback(theEndPoint,theEndPoint->user_context,kNMEndpointDied,0,NULL);
+					LOCK_ENDPOINT_LIST();
+				}
+			}
+
+			//if the list has changed, we need to abort and do the rest next time
+			if (listStartState != endpointListState)
+			{
+				endpointsNeedToDie = true;
+				UNLOCK_ENDPOINT_LIST();
+				return true;
+			}
+		}
+	}
+
+	//wait for more events once we've handled the last lot. With the eventfd to wake us we'd never
+	//need a timeout, but we keep the one the select() version has so nothing can get stuck for long
+	if (nextPendingEvent >= pendingEventCount)
+	{
+		int timeoutMs = 0;
+		int numEvents;
+
+		if (block && !endpointsNeedToDie)
+		{
+			#if (DEBUG)
+				timeoutMs = 10000;
+			#else
+				timeoutMs = 1000;
+			#endif
+		}
+		numEvents = epoll_wait(epollFd, pendingEvents, MAX_EPOLL_EVENTS, timeoutMs);
+		pendingEventCount = (numEvents > 0) ? numEvents : 0;
+		nextPendingEvent = 0;
+
+		//dont spin if we have no epoll set to wait on
+		if ((numEvents == -1) && (op_errno != EINTR) && block)
+			usleep(10000); //sleep for 10 millisecs
+	}
+
+	while (nextPendingEvent < pendingEventCount)
+	{
+		struct epoll_event *event = &pendingEvents[nextPendingEvent];
+
+		gotEvent = true;
+		if (event->data.u64 == 0)
+		{
+			uint64 value;
+			read(wakeEventFd, &value, sizeof(value));
+		}
+		else if (event->events != 0)
+		{
+			//these mirror what select() would have said about the socket
+			uint32 events = event->events;
+			long socketType = EPOLL_EVENT_SOCKET(*event);
+			theEndPoint = EPOLL_EVENT_ENDPOINT(*event);
+			listStartState = endpointListState;
+
+			//cant do nothing if they've called ProtocolEnterNotifier, so leave the rest for next time
+			if (!processEndPointSocket(theEndPoint, socketType, (events & EPOLLPRI) != 0,
+					(events & (EPOLLIN | EPOLLERR | EPOLLHUP)) != 0,
+					((events & (EPOLLOUT | EPOLLERR)) != 0) && theEndPoint->flowBlocked[socketType]))
+			{
+				UNLOCK_ENDPOINT_LIST();
+				usleep(1000); //sleep for 1 millisec
+				return true;
+			}
+
+			//if the list changed, processEndPointSocket() may have stopped part way. If the endpoint
+			//wasn't closed, have epoll report the socket again so the rest of the edge isn't lost
+			if ((listStartState != endpointListState) && (event->events != 0))
+				_rearm_endpoint_socket(theEndPoint, socketType);
+		}
+		++nextPendingEvent;
+	}
+
+	UNLOCK_ENDPOINT_LIST();
+	return gotEvent;
+}
+
+#else
+
 //process any events that have happened with the endpoints
 bool processEndpoints(bool block)
 {
@@ -3964,7 +4467,10 @@ bool processEndpoints(bool block)
 	
 	//if we have a wake endpoint, add it
 	if (wakeHostSocket)
+	{
 		FD_SET(wakeHostSocket,&input_set);
+		nfds = wakeHostSocket + 1;
+	}
 	
 	//add all endpoints to our lists to check
 	theEndPoint = endpointList;
@@ -4039,7 +4545,11 @@ bool processEndpoints(bool block)
 		{
 			//this endpoint has a datagram socket
 			if (theEndPoint->connectionMode & (1 << _datagram_socket))
-				processEndPointSocket(theEndPoint,_datagram_socket,&input_set,&output_set,&exc_set);			
+			{
+				int theSocket = theEndPoint->sockets[_datagram_socket];
+				processEndPointSocket(theEndPoint,_datagram_socket,FD_ISSET(theSocket,&exc_set),
+						FD_ISSET(theSocket,&input_set),FD_ISSET(theSocket,&output_set));
+			}
 
 			//abort if the list has been changed since theEndPoint may no longer exist for all we know...
 			if (endpointListState != listStartState)
@@ -4049,7 +4559,11 @@ bool processEndpoints(bool block)
 				
 			//if it has a stream socket
 			if (theEndPoint->connectionMode & (1 << _stream_socket))
-				processEndPointSocket(theEndPoint,_stream_socket,&input_set,&output_set,&exc_set);
+			{
+				int theSocket = theEndPoint->sockets[_stream_socket];
+				processEndPointSocket(theEndPoint,_stream_socket,FD_ISSET(theSocket,&exc_set),
+						FD_ISSET(theSocket,&input_set),FD_ISSET(theSocket,&output_set));
+			}
 			
 			//abort if the list has been changed since theEndPoint may no longer exist for all we know...
 			if (endpointListState != listStartState)
@@ -4069,14 +4583,17 @@ bool processEndpoints(bool block)
 	return gotEvent;
 }
 
+#endif // PDG_NET_USE_EPOLL
+
 //this function is always called with access to a locked endpoint-list, remember. And it should always return a locked list.
-void processEndPointSocket(NMEndpointPriv *theEndPoint, long socketType, fd_set *input_set, fd_set *output_set, fd_set *exc_set)
+//returns false if it couldn't do anything because the notifier was held
+bool processEndPointSocket(NMEndpointPriv *theEndPoint, long socketType, bool hasException, bool hasInput, bool canOutput)
 {
 	//cant do nothing if they've called ProtocolEnterNotifier
 	if (TRY_ENTER_NOTIFIER() == false)
-		return;
+		return false;
 
-	if (FD_ISSET(theEndPoint->sockets[socketType],exc_set)) // There was an Error?
+	if (hasException) // There was an Error?
 	{
 		uint32 listStartState = endpointListState;
 		//if we're already dying, theres nothing to be done...
@@ -4088,7 +4605,7 @@ void processEndPointSocket(NMEndpointPriv *theEndPoint, long socketType, fd_set
 				//todo: is there something that would end up here that's not fatal?
 			
 				//tell the player the endpoint died and make sure we don't do anything else with it
-				theEndPoint->needToDie = true;
+				MARK_ENDPOINT_TO_DIE(theEndPoint);
 				theEndPoint->dying = true;
 				UNLOCK_ENDPOINT_LIST();
 				theEndPoint->callback(theEndPoint,theEndPoint->user_context,kNMEndpointDied,0,NULL);
@@ -4097,20 +4614,20 @@ void processEndPointSocket(NMEndpointPriv *theEndPoint, long socketType, fd_set
 				//if an endpoint was added or removed, we can't go on (it might have been us)
 				if (listStartState != endpointListState){
 					LEAVE_NOTIFIER();
-					return;
+					return true;
 				}
 			}
 			else//if the endpoint is just being created, set it up to return an error.
 			{
 				theEndPoint->opening_error = kNMOpenFailedErr;
-				theEndPoint->needToDie = true;
+				MARK_ENDPOINT_TO_DIE(theEndPoint);
 				LEAVE_NOTIFIER();
-				return;
+				return true;
 			}
 		}
 	}
 
-	if ((FD_ISSET(theEndPoint->sockets[socketType],input_set))) // Data has arrived
+	if (hasInput) // Data has arrived
 	{
 		uint32 listStartState = endpointListState;
 			
@@ -4134,7 +4651,7 @@ void processEndPointSocket(NMEndpointPriv *theEndPoint, long socketType, fd_set
 					//if an endpoint was added or removed, we can't go on (it might have been us)
 					if (listStartState != endpointListState){
 						LEAVE_NOTIFIER();
-						return;
+						return true;
 					}
 				}
 			}
@@ -4155,7 +4672,7 @@ void processEndPointSocket(NMEndpointPriv *theEndPoint, long socketType, fd_set
 						if (theEndPoint->dying == false) //if we havn't delivered the news, do it
 						{
 							//tell the player the endpoint died and make sure we don't do anything else with it
-							theEndPoint->needToDie = true;
+							MARK_ENDPOINT_TO_DIE(theEndPoint);
 							theEndPoint->dying = true;
 							UNLOCK_ENDPOINT_LIST();
 							DEBUG_PRINT("sending kNMEndpointDied for ep 0x%x",theEndPoint);
@@ -4163,7 +4680,7 @@ void processEndPointSocket(NMEndpointPriv *theEndPoint, long socketType, fd_set
 							LOCK_ENDPOINT_LIST();
 							
 							LEAVE_NOTIFIER();
-							return;
+							return true;
 						}					
 					}
 					
@@ -4192,7 +4709,7 @@ void processEndPointSocket(NMEndpointPriv *theEndPoint, long socketType, fd_set
 						//if an endpoint was added or removed, we can't go on (it might have been us)
 						if (listStartState != endpointListState){
 							LEAVE_NOTIFIER();
-							return;
+							return true;
 						}
 					}
 				}
@@ -4204,16 +4721,16 @@ void processEndPointSocket(NMEndpointPriv *theEndPoint, long socketType, fd_set
 					if (socketReadResult(theEndPoint,_stream_socket) <= 0)
 					{
 						theEndPoint->opening_error = kNMAcceptFailedErr;
-						theEndPoint->needToDie = true;
+						MARK_ENDPOINT_TO_DIE(theEndPoint);
 						LEAVE_NOTIFIER();
-						return;
+						return true;
 					}
 				}
 			}
 		}
 	}
 	
-	if (FD_ISSET(theEndPoint->sockets[socketType],output_set)) // Socket is ready to write
+	if (canOutput) // Socket is ready to write
 	{
 		uint32 listStartState = endpointListState;
 	
@@ -4310,12 +4827,12 @@ void processEndPointSocket(NMEndpointPriv *theEndPoint, long socketType, fd_set
 			//if an endpoint was added or removed, we can't go on (it might have been us)
 			if (listStartState != endpointListState){
 				LEAVE_NOTIFIER();
-				return;
+				return true;
 			}
 		}
 	}
 	LEAVE_NOTIFIER();
-	return;
+	return true;
 }
 
 
@@ -4329,6 +4846,9 @@ void createWorkerThread(void)
 		
 	DEBUG_PRINT("creating network worker-thread...");	
 
+	if (!createWakeSocket())
+		DEBUG_PRINT("error: unable to create the wake socket: err %d",op_errno);
+
 	#ifdef OP_API_NETWORK_SOCKETS
 		long pThreadResult = pthread_create(&worker_thread,NULL,worker_thread_func,NULL);
 		op_assert(pThreadResult == 0);
@@ -4373,6 +4893,7 @@ void killWorkerThread(void)
 	{
 		usleep(10000); //sleep for 10 millisecs
 	}
+	disposeWakeSocket();
 	DEBUG_PRINT("...worker thread terminated.");			
 }
 
@@ -4421,7 +4942,7 @@ receive_udp_port(NMEndpointRef endpoint)
 	if (socketReadResult(endpoint,_stream_socket) <= 0)
 	{
 		endpoint->opening_error = kNMAcceptFailedErr;
-		endpoint->needToDie = true;
+		MARK_ENDPOINT_TO_DIE(endpoint);
 		return;
 	}
 	// Read the port...
@@ -4458,7 +4979,7 @@ receive_udp_port(NMEndpointRef endpoint)
 	{
 		DEBUG_PRINT("error receiving udp port");	
 		endpoint->opening_error = kNMAcceptFailedErr;
-		endpoint->needToDie = true;
+		MARK_ENDPOINT_TO_DIE(endpoint);
 	}
 }
 
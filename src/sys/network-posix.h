@@ -54,7 +54,7 @@
 #include "pdg/sys/mutex.h"
 
 #include <map>
-#include <queue>
+#include <deque>
 #include <string>
 
 
@@ -112,6 +112,12 @@ typedef enum {
 	kOpenActive	= 0x01 /* open it active (dial for a connection, etc.) */
 } NMOpenFlags;
 
+// one piece of the data passed to ProtocolSendv()
+struct NMSendBuffer {
+    void*   data;
+    uint32  size;
+};
+
 extern "C" {
 typedef void (*PEndpointCallbackFunction)(PEndpointRef inEndpoint, void *inContext,NMCallbackCode inCode, NMErr inError, void *inCookie);
 
@@ -125,6 +131,7 @@ NMErr ProtocolOpenEndpoint(PConfigRef inConfig, PEndpointCallbackFunction inCall
 NMErr ProtocolCloseEndpoint(PEndpointRef endpoint, bool inOrderly);
 NMErr ProtocolSetEndpointContext(PEndpointRef endpoint, void *newContext);
 int32 ProtocolSend(PEndpointRef endpoint, void *inData, uint32 inSize, NMFlags inFlags);
+int32 ProtocolSendv(PEndpointRef endpoint, const NMSendBuffer *inBuffers, uint32 inCount, NMFlags inFlags);
 NMErr ProtocolReceive(PEndpointRef endpoint, void *outData, uint32 *ioSize, NMFlags *outFlags);
 NMErr ProtocolAcceptConnection(PEndpointRef endpoint, void *inCookie, PEndpointCallbackFunction inNewCallback, void *inNewContext);
 NMErr ProtocolGetEndpointIdentifier(PEndpointRef endpoint, char *identifier_string, int16 max_length);
@@ -144,6 +151,7 @@ struct NetPacket {
 #define PDG_PACKET_DATA_OFFSET  sizeof(NetPacket)
 #define NUMBER_ALL_PACKETS
 #define DEFAULT_MAX_INCOMING_PACKET_SIZE 1024
+#define MAX_PACKETS_PER_SEND    64  // most queued packets handed to one ProtocolSendv() call
 
 
 // =======================================================================================================
@@ -247,12 +255,16 @@ protected:
     void            initialize(void* userContext);
     void            byteSwapIncomingPacket(NetPacket *ioPacket);
     void            byteSwapOutgoingPacket(NetPacket *ioPacket);
+    uint32          getWireSize(NetPacket* inPacket);
+    void            sendQueuedPackets();  // call with mOutgoingQueueMutex held
+    void            packetSent(NetPacket* inPacket);
 
     OpenPlayNetworkManager* mNetMgr; 
     char                mName[PDG_MAX_NET_CONNECTION_NAME_LEN];   
 	PEndpointRef        mEndpoint;
     uint32              mMaxIncomingPacketSize;
-	std::queue<NetPacket*> mOutgoingPackets;
+	std::deque<NetPacket*> mOutgoingPackets;
+    uint32              mOutgoingOffset;    // how much of the packet at the front of mOutgoingPackets has been sent
     NetPacket*          mInProgressPacket;
     uint32              mBytesRemainingForPacket;
     uint32              mOffsetInPacket;
@@ -62,6 +62,7 @@
 #include "pdg-main.h"
 #include "pdg-lib.h"
 #include "internals.h"
+#include "spritemanager.h"
 
 #include <iostream>
 #include <cstring>
@@ -509,6 +510,11 @@ void main_run() {
 
 	TimerManager::instance().checkTimers();
 
+	// any threaded worlds whose timers just fired tick now, all at once
+	if (SpriteManager::hasInstance()) {
+		SpriteManager::instance().runThreadedWorlds();
+	}
+
 	RUN_LOOP_DEBUG_ONLY(OS::_DOUT("%12u -    Timer check/fire complete", OS::getMilliseconds()); )
 
   #ifndef PDG_NO_SLEEP
@@ -538,18 +544,7 @@ void main_run() {
   #ifndef PDG_NO_EVENT_QUEUE
 	// check of the event queue in case someone put an event in the queue while the
 	// main thread was sleeping
-	long eventType;
-	UserData* eventData;
-	EventEmitter* eventEmitter;
-	int eventCount = 0;
-	while (EventManager::instance().getQueuedEvent(eventType, eventData, eventEmitter)) {
-		EventManager::instance().postEventToEmitter(
-			eventType, eventData->getData(), eventEmitter);
-		eventData->release();
-		eventData = 0;
-		eventEmitter = 0;
-		eventCount++;
-	}
+	RUN_LOOP_DEBUG_ONLY( int eventCount = ) EventManager::instance().dispatchQueuedEvents();
 	RUN_LOOP_DEBUG_ONLY(OS::_DOUT("%12u -    Dequeued %d event(s) queued during sleep", OS::getMilliseconds(), eventCount); )
   #endif // NO_EVENT_QUEUE
 
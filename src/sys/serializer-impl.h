@@ -31,7 +31,10 @@
 
 #include "pdg_project.h"
 
+#include "pdg/sys/mutex.h"
+
 #include <map>
+#include <vector>
 #include <cstdio>
 
 #ifndef PDG_NO_SERIALIZER_SANITY_CHECKS
@@ -55,9 +58,47 @@ namespace pdg {
 	};
 	
 
-    // maps object unique ids to the object pointers
-    typedef std::map<uint32, void*> ObjectRegistryT;
-    extern ObjectRegistryT gObjectRegistry;
+    // -----------------------------------------------------------------------------------
+    // Object Registry
+    // Maps the unique ids given to IDeserializer::registerObject() to object pointers and
+    // back again, so serialize_ref() and deserialize_ref() are both a hash lookup. Each
+    // object has one id and each id one object; registering either again replaces the
+    // old pairing
+    // -----------------------------------------------------------------------------------
+    class ObjectRegistry {
+    public:
+        ObjectRegistry();
+
+        void    add(void* obj, uint32 uniqueId);
+        void    remove(const void* obj);
+        void    removeId(uint32 uniqueId);
+        void    clear();
+
+        bool    findId(const void* obj, uint32& outUniqueId) const;
+        bool    findObject(uint32 uniqueId, void*& outObj) const;
+        uint32  size() const { return mCount; }
+
+    private:
+        struct EntryT {
+            uint32  id;
+            void*   obj;
+        };
+        typedef std::vector<EntryT> BucketT;
+
+        static uint32 hashId(uint32 uniqueId);
+        static uint32 hashObj(const void* obj);
+        void    grow();
+
+        std::vector<BucketT> mById;
+        std::vector<BucketT> mByObj;
+        uint32  mMask;
+        uint32  mCount;
+    };
+
+    // objects registered with IDeserializer::registerObject(), hold gObjectRegistryMutex
+    // while using it since objects can be registered and destroyed on any thread
+    extern ObjectRegistry gObjectRegistry;
+    extern Mutex gObjectRegistryMutex;
 
 
 #ifdef PDG_DESERIALIZER_NO_THROW
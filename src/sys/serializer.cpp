@@ -212,10 +212,52 @@ Serializer::serialize_obj(const ISerializable* obj) {
     if (mUsingTags) {
     	serialize_2(mSerializedInstances.size());
     }
-	uint32 objLen = obj->getSerializedSize(this);
-	serialize_uint(objLen);
+	if (!mStreaming) {
+		uint32 objLen = obj->getSerializedSize(this);
+		serialize_uint(objLen);
+		SERIALIZED("obj ", 0);   // stop here so we can see the object being serialized
+		obj->serialize(this);
+		mSerializeObjDepth--;
+		return;
+	}
+	// leave room for a 1 byte length, which is enough for most objects, and fill it
+	// in once the object has been written rather than asking the object for its size first
+	ensureSpace(1);
+	size_t lenPos = p - mDataPtr;
+	*p++ = 0;
 	SERIALIZED("obj ", 0);   // stop here so we can see the object being serialized
 	obj->serialize(this);
+	size_t objLen = (p - mDataPtr) - lenPos - 1;
+	uint32 lenOfLen = sizeof_uint((uint32)objLen);
+	if (lenOfLen > 1) {
+		// the length didn't fit in one byte, so slide the object's data over to make room
+		size_t extra = lenOfLen - 1;
+		ensureSpace(extra);
+		uint8* objData = mDataPtr + lenPos + 1;
+		std::memmove(objData + extra, objData, objLen);
+		p += extra;
+		if (mLastBoolPtr >= objData) {
+			mLastBoolPtr += extra;
+		}
+		if (mMark >= objData) {
+			mMark += extra;
+		}
+	}
+	// same encoding serialize_uint() uses
+	uint8* lenPtr = mDataPtr + lenPos;
+	if (lenOfLen == 1) {
+		lenPtr[0] = objLen;
+	} else if (lenOfLen == 3) {
+		lenPtr[0] = tag_longLen;
+		lenPtr[1] = (objLen >> 8) & 0xff;
+		lenPtr[2] = objLen & 0xff;
+	} else {
+		lenPtr[0] = tag_veryLongLen;
+		lenPtr[1] = (objLen >> 24) & 0xff;
+		lenPtr[2] = (objLen >> 16) & 0xff;
+		lenPtr[3] = (objLen >> 8) & 0xff;
+		lenPtr[4] = objLen & 0xff;
+	}
 	mSerializeObjDepth--;
 }
 
@@ -291,17 +333,9 @@ Serializer::serialize_quad(const Quad& q) {
 
 void   
 Serializer::serialize_ptr(const void* ptr) {
+    // look it up first so an unknown object throws before anything is written
+    uint32 uniqueId = findObjectId(ptr);
 	SERIALIZE_START;
-    uint32 uniqueId = 0;
-    for(ObjectRegistryT::iterator i = gObjectRegistry.begin(); i != gObjectRegistry.end(); i++) {
-        if (i->second == ptr) {
-            uniqueId = i->first;
-            break;
-        }
-    }
-    if (!uniqueId) {
-        throw unknown_object("");
-    }
     if (mUsingTags) {
     	serialize_3u(tag_pointerRef);
     }
@@ -455,19 +489,36 @@ Serializer::sizeof_obj(const ISerializable* obj) {
 }
 
 
-//! How many bytes are used to serialize a particular Object Reference value
-uint32 
-Serializer::sizeof_ptr(const void* ptr) const {
+// look up the id an object was registered with, stream registrations first
+uint32
+Serializer::findObjectId(const void* ptr) const {
     uint32 uniqueId = 0;
-    for(ObjectRegistryT::iterator i = gObjectRegistry.begin(); i != gObjectRegistry.end(); i++) {
-        if (i->second == ptr) {
-            uniqueId = i->first;
-            break;
-        }
+    if (mStreamObjects && mStreamObjects->findId(ptr, uniqueId)) {
+        return uniqueId;
     }
-    if (!uniqueId) {
+    bool found;
+    {
+        AutoMutex mutex(&gObjectRegistryMutex);
+        found = gObjectRegistry.findId(ptr, uniqueId);
+    }
+    if (!found) {
         throw unknown_object("");
     }
+    return uniqueId;
+}
+
+void
+Serializer::registerStreamObject(void* obj, uint32 uniqueId) {
+	if (!mStreamObjects) {
+		mStreamObjects = new ObjectRegistry();
+	}
+	mStreamObjects->add(obj, uniqueId);
+}
+
+//! How many bytes are used to serialize a particular Object Reference value
+uint32 
+Serializer::sizeof_ptr(const void* ptr) const {
+    uint32 uniqueId = findObjectId(ptr);
     uint32 result = 0;
     if (mUsingTags) {
     	result += 3;
@@ -478,23 +529,74 @@ Serializer::sizeof_ptr(const void* ptr) const {
 
 
 void  Serializer::ensureSpace(size_t bytes) {
-	size_t currSize = getDataSize();
-	size_t blocksNeeded = ((currSize + bytes) / mBlockSize) + 1;
-	size_t blocksAllocated = mAllocatedSize / mBlockSize;
-	if (blocksNeeded > blocksAllocated) {
-	    bool firstAlloc = (mAllocatedSize == 0);
-		mAllocatedSize = blocksNeeded * mBlockSize;
-		size_t offset = p - mDataPtr;
-		mDataPtr = (uint8*)std::realloc(mDataPtr, mAllocatedSize);
-		p = mDataPtr + offset;
-		mDataEnd = mDataPtr + mAllocatedSize;
-        // clear the new buffer for easier debugging
-        memset(p, 0, mDataEnd - p);
-		if (firstAlloc && mSendTags) {  // checks what we gave in setSendTags()
-            mUsingTags = true;  // prevents changes via setSendTags() during life of stream
-            serialize_3u(tag_pdgTaggedStream);  // save a tag that shows we are using tags
+	if (!mStreamStarted) {
+		mStreamStarted = true;
+		mUsingTags = mSendTags;  // checks what we gave in setSendTags(), prevents changes during life of stream
+		if (mUsingTags) {
+			serialize_3u(tag_pdgTaggedStream);  // save a tag that shows we are using tags
 		}
 	}
+	if ((size_t)(mDataEnd - p) < bytes) {
+		growTo(getDataSize() + bytes);
+	}
+}
+
+void  Serializer::growTo(size_t bytes) {
+	if (bytes <= mAllocatedSize) return;
+	// double the size each time so that building a large stream a few bytes at
+	// a time is linear overall, we don't clear the new space since every byte
+	// we hand out gets written
+	size_t newSize = (mAllocatedSize) ? mAllocatedSize : mBlockSize;
+	while (newSize < bytes) {
+		newSize *= 2;
+	}
+	uint8* oldPtr = mDataPtr;
+	size_t offset = p - mDataPtr;
+	mDataPtr = (uint8*)std::realloc(mDataPtr, newSize);
+	mAllocatedSize = newSize;
+	p = mDataPtr + offset;
+	mDataEnd = mDataPtr + mAllocatedSize;
+	// these point into the buffer, so they have to move with it
+	if (mLastBoolPtr) {
+		mLastBoolPtr = mDataPtr + (mLastBoolPtr - oldPtr);
+	}
+	if (mMark) {
+		mMark = mDataPtr + (mMark - oldPtr);
+	}
+}
+
+void  Serializer::reserve(size_t bytes) {
+	growTo(bytes);
+}
+
+void  Serializer::reset() {
+	p = mDataPtr;
+	mSerializedInstances.clear();
+	mSerializedSizeInstances.clear();
+	mSerializeObjDepth = 0;
+	mMark = 0;
+	mLastBoolPtr = 0;
+	mBoolBitOffset = 0;
+	mBoolSizeCount = 0;
+	if (mStreamStarted) {
+		// objects like SpriteLayer turn tags off partway through a stream, the next
+		// stream should come out the same way as this one did
+		mSendTags = mUsingTags;
+	}
+	mUsingTags = false;
+	mStreamStarted = false;
+}
+
+uint8* Serializer::releaseData(size_t& outSize) {
+	outSize = getDataSize();
+	uint8* data = (outSize > 0) ? mDataPtr : 0;
+	if (data) {
+		mDataPtr = 0;
+		mDataEnd = 0;
+		mAllocatedSize = 0;
+	}
+	reset();
+	return data;
 }
 
 // --------------------------------------------
@@ -513,7 +615,11 @@ Serializer::Serializer()
 	mMark(0),
 	mLastBoolPtr(0),
 	mBoolBitOffset(0),
-	mBoolSizeCount(0)
+	mBoolSizeCount(0),
+	mUsingTags(false),
+	mStreamStarted(false),
+	mStreaming(true),
+	mStreamObjects(0)
 {
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 	INIT_SCRIPT_OBJECT(mSerializerScriptObj);
@@ -525,6 +631,8 @@ Serializer::~Serializer() {
 		std::free(mDataPtr);
 		mDataPtr = 0;
 	}
+	delete mStreamObjects;
+	mStreamObjects = 0;
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 	CleanupSerializerScriptObject(mSerializerScriptObj);
 #endif
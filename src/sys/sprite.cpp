@@ -32,12 +32,14 @@
 
 #include "pdg/sys/sprite.h"
 #include "pdg/sys/spritelayer.h"
+#include "pdg/sys/world.h"
 #include "pdg/sys/os.h"
 #include "pdg/sys/events.h"
 #include "pdg/sys/image.h"
 #include "pdg/sys/imagestrip.h"
 #include "pdg/sys/iserializer.h"
 #include "pdg/sys/ideserializer.h"
+#include "pdg/sys/atomic.h"
 
 #include "image-impl.h"
 
@@ -50,6 +52,7 @@
 #endif
 
 #include "collisiondetection.h"
+#include "collisiongrid.h"
 #include "spritemanager.h"
 
 #include <cmath>
@@ -111,6 +114,7 @@ enum {
 	var_Opacity
 };
 
+// sprites can be created by worlds ticking on other threads, so this is only changed atomically
 static uint32 sUniqueSpriteId = 1;
 
 #ifdef PDG_USE_CHIPMUNK_PHYSICS
@@ -254,7 +258,8 @@ uint32 Sprite::getSerializedSize(ISerializer* serializer) const {
 		SIZE_FLOAT_LIST_END(totalSize);
 		if (serFlags & ser_Animations) {
 			if (serFlags & ser_InitialData) {
-				totalSize += 5;
+				totalSize += 4; // mFps
+				totalSize += serializer->sizeof_uint(mNumFrames);
 				for (int i = 0; i < mNumFrames; i++) {
 					if (serFlags & ser_ImageRefs) {
 						// not sure yet how to handle images -- filename?
@@ -268,7 +273,10 @@ uint32 Sprite::getSerializedSize(ISerializer* serializer) const {
 					totalSize += 4; // mFrames[i].centerOffsetX, mFrames[i].centerOffsetY);
 				}
 			}
-			totalSize += 4; // 1 byte each for mCurrFrame, mFirstFrame, mLastFrame, mFadeCompleteAction
+			totalSize += serializer->sizeof_uint(mCurrFrame);
+			totalSize += serializer->sizeof_uint(mFirstFrame);
+			totalSize += serializer->sizeof_uint(mLastFrame);
+			totalSize += 1; // mFadeCompleteAction
 			size_t numAnims = mAnimations.size();
 			totalSize += serializer->sizeof_uint((uint32)numAnims);
 			for (uint32 i = 0; i < numAnims; i++) {
@@ -311,8 +319,8 @@ uint32 Sprite::getSerializedSize(ISerializer* serializer) const {
           #ifndef PDG_USE_CHIPMUNK_PHYSICS
           	totalSize += serializer->sizeof_uint(0);
           #else
-          	totalSize += serializer->sizeof_uint(mNumBreakableJoints);
-			for (int i = 0; i < mNumBreakableJoints; i++) {
+          	totalSize += serializer->sizeof_uint((uint32)mBreakableJoints.size());
+			for (size_t i = 0; i < mBreakableJoints.size(); i++) {
 				cpConstraint* constraint = mBreakableJoints[i];
 				uint8 jti = getJointTypeId(constraint);
 				cpBody* b = cpConstraintGetBodyB(constraint);
@@ -462,7 +470,7 @@ void Sprite::serialize(ISerializer* serializer) const {
 		if (serFlags & ser_Animations) {
 			if (serFlags & ser_InitialData) {
 				serializer->serialize_f(mFps);
-				serializer->serialize_1u(mNumFrames);
+				serializer->serialize_uint(mNumFrames);
 				for (int i = 0; i < mNumFrames; i++) {
 					if (serFlags & ser_ImageRefs) {
 						// not sure yet how to handle images -- filename?
@@ -480,9 +488,9 @@ void Sprite::serialize(ISerializer* serializer) const {
 					serializer->serialize_2(mFrames[i].centerOffsetY);
 				}
 			}
-			serializer->serialize_1u(mCurrFrame);
-			serializer->serialize_1u(mFirstFrame);
-			serializer->serialize_1u(mLastFrame);
+			serializer->serialize_uint(mCurrFrame);
+			serializer->serialize_uint(mFirstFrame);
+			serializer->serialize_uint(mLastFrame);
 			serializer->serialize_1(mFadeCompleteAction);
 			// serializer->serialize_uint(mDelayMs);  don't actually send this, it is only used for building series of animations
 			uint32 numAnims = (uint32)mAnimations.size();
@@ -556,8 +564,8 @@ void Sprite::serialize(ISerializer* serializer) const {
           #ifndef PDG_USE_CHIPMUNK_PHYSICS
           	serializer->serialize_uint(0);    // serialize a value indicating no breakable joints
           #else
-          	serializer->serialize_uint(mNumBreakableJoints);
-			for (int i = 0; i < mNumBreakableJoints; i++) {
+          	serializer->serialize_uint((uint32)mBreakableJoints.size());
+			for (size_t i = 0; i < mBreakableJoints.size(); i++) {
 				cpConstraint* constraint = mBreakableJoints[i];
 				uint8 jti = getJointTypeId(constraint);
 				cpBody* b = cpConstraintGetBodyB(constraint);
@@ -675,6 +683,8 @@ void Sprite::serialize(ISerializer* serializer) const {
 
 void Sprite::deserialize(IDeserializer* deserializer) {
 	uint32 serFlags = (mLayer) ? mLayer->mSerFlags : (uint32)ser_Full;
+	// frame numbers were single bytes in older streams
+	bool uintFrames = (!mLayer || (mLayer->mSerStreamVers >= PDG_SPRITE_LAYER_STREAM_V_2));
 	if ( (serFlags == ser_Micro) || (serFlags == ser_Positions) ) {
 
 		// special case, smallest possible update
@@ -717,6 +727,9 @@ void Sprite::deserialize(IDeserializer* deserializer) {
 			iid = deserializer->deserialize_uint();
 			spriteId = deserializer->deserialize_uint();
 			mMouseDetectMode = (int)deserializer->deserialize_uint();
+			if (mLayer) {
+				mLayer->updateSpriteIndex(this);  // so the layer can find us by our new ids
+			}
 		}
 		if (serFlags & (ser_InitialData | ser_Animations) ) {
 			uint8 opacity = deserializer->deserialize_1u();
@@ -753,7 +766,24 @@ void Sprite::deserialize(IDeserializer* deserializer) {
 		if (serFlags & ser_Animations) {
 			if (serFlags & ser_InitialData) {
 				mFps = deserializer->deserialize_f();
-				mNumFrames = deserializer->deserialize_1u();
+				int numFrames = uintFrames ? (int)deserializer->deserialize_uint() : deserializer->deserialize_1u();
+				makeFramesWritable();
+				if (numFrames < mNumFrames) {
+					for (int i = numFrames; i < mNumFrames; i++) {
+						if (mFrames[i].image) mFrames[i].image->release();
+						if (mFrames[i].collisionMask) mFrames[i].collisionMask->release();
+					}
+					mFrameTable->frames.resize(numFrames);
+				} else if (numFrames > mNumFrames) {
+					FrameInfoT newFrame;
+					newFrame.image = 0;
+					newFrame.collisionMask = 0;
+					newFrame.imageFrameNum = 0;
+					newFrame.centerOffsetX = 0;
+					newFrame.centerOffsetY = 0;
+					mFrameTable->frames.resize(numFrames, newFrame);
+				}
+				setFrameTable(mFrameTable);
 				for (int i = 0; i < mNumFrames; i++) {
 					if (serFlags & ser_ImageRefs) {
 						// not sure yet how to handle images -- filename?
@@ -771,10 +801,10 @@ void Sprite::deserialize(IDeserializer* deserializer) {
 					mFrames[i].centerOffsetY = deserializer->deserialize_2();
 				}
 			}
-			mCurrFrame = deserializer->deserialize_1u();
+			mCurrFrame = uintFrames ? (int)deserializer->deserialize_uint() : deserializer->deserialize_1u();
 			mCurrFramePrecise = mCurrFrame;
-			mFirstFrame = deserializer->deserialize_1u();
-			mLastFrame = deserializer->deserialize_1u();
+			mFirstFrame = uintFrames ? (int)deserializer->deserialize_uint() : deserializer->deserialize_1u();
+			mLastFrame = uintFrames ? (int)deserializer->deserialize_uint() : deserializer->deserialize_1u();
 			mFadeCompleteAction = deserializer->deserialize_1();
 			mDelayMs = 0;  // never gets sent, but this is correct value for it.			
 			uint32 numAnims = deserializer->deserialize_uint();
@@ -865,7 +895,7 @@ void Sprite::deserialize(IDeserializer* deserializer) {
               #ifdef PDG_USE_CHIPMUNK_PHYSICS
 				// get all the info about the existing constraint
 				cpConstraint* constraint = 0;
-				if (i < mNumBreakableJoints) {
+				if (i < (int)mBreakableJoints.size()) {
 					uint8 curr_jti = 0;
 					uint32 curr_siid = 0;
 					constraint = mBreakableJoints[i];
@@ -1049,16 +1079,16 @@ void Sprite::deserialize(IDeserializer* deserializer) {
               #endif  // PDG_USE_CHIPMUNK_PHYSICS
 			}
           #ifdef PDG_USE_CHIPMUNK_PHYSICS
-			for (int i = numJoints; i < mNumBreakableJoints; i++) {
+			while ((int)mBreakableJoints.size() > numJoints) {
 				// these are extra, remove them
-				cpConstraint* constraint = mBreakableJoints[i];
-				removeJoint(constraint);
+				removeJoint(mBreakableJoints.back());
 			}
-         	mNumBreakableJoints = numJoints; 
           #endif
 		}
 
 	}
+	// location, frame or collision radius may all have just changed
+	gridBoundsChanged();
 }
 
 void Sprite::setUserData(UserData* inUserData) {
@@ -1077,13 +1107,10 @@ void Sprite::freeUserData() {
 // sets current frame of Sprite to a given frame number
 Sprite&    Sprite::setFrame(int frame) {
 	mSpriteAnimatingBackwardsNow = false;
-	DEBUG_ASSERT(frame >= 0 && frame < MAX_FRAMES_PER_SPRITE, "invalid frame number passed to sprite setFrame");
+	DEBUG_ASSERT(frame >= 0, "invalid frame number passed to sprite setFrame");
 	if (frame < 0) {
 		frame = 0;
 	}
-	if (frame >= MAX_FRAMES_PER_SPRITE) {
-		frame = MAX_FRAMES_PER_SPRITE - 1;
-	}
 	if ((frame == start_FromLastFrame) || (frame >= mNumFrames)) {
 		mCurrFrame = mNumFrames - 1;
 		if (mBidirectionalAnim) {
@@ -1095,6 +1122,8 @@ Sprite&    Sprite::setFrame(int frame) {
 		mCurrFrame = frame;
 	}
 	mCurrFramePrecise = mCurrFrame;
+	mDirtyFields |= dirty_Frame;
+	gridBoundsChanged();
 	return *this;
 }
 
@@ -1143,6 +1172,8 @@ void	Sprite::startFrameAnimation(float fps, int startingFrame, int numFrames, in
 		mSpriteAnimatingBackwardsNow = false;
 	}
 	mCurrFramePrecise = mCurrFrame;
+	mDirtyFields |= dirty_Frame;
+	gridBoundsChanged();
 }
 
 
@@ -1153,6 +1184,93 @@ void	Sprite::stopFrameAnimation() {
 	mSpriteAnimating = false;
 }
 
+Sprite::FrameTableT::~FrameTableT() {
+	for (size_t i = 0; i < frames.size(); i++) {
+		if (frames[i].image) frames[i].image->release();
+		if (frames[i].collisionMask) frames[i].collisionMask->release();
+	}
+}
+
+// PROTECTED: start using the given frame table, sharing it with any other sprites that use it
+// also resyncs mFrames and mNumFrames if the table is the one we already have
+void	Sprite::setFrameTable(FrameTableT* table) {
+	if (table != mFrameTable) {
+		if (table) {
+			PDG_ATOMIC_INC(&table->refCount);
+		}
+		if (mFrameTable && (PDG_ATOMIC_DEC(&mFrameTable->refCount) == 0)) {
+			delete mFrameTable;
+		}
+		mFrameTable = table;
+	}
+	if (mFrameTable && !mFrameTable->frames.empty()) {
+		mFrames = &mFrameTable->frames[0];
+		mNumFrames = (int)mFrameTable->frames.size();
+	} else {
+		mFrames = 0;
+		mNumFrames = 0;
+	}
+	gridBoundsChanged();
+}
+
+// PROTECTED: make sure we have a frame table of our own that can be changed
+// without affecting any sprites we were cloned from or that were cloned from us
+void	Sprite::makeFramesWritable() {
+	if (!mFrameTable) {
+		mFrameTable = new FrameTableT;
+	} else if (mFrameTable->refCount > 1) {
+		FrameTableT* table = new FrameTableT;
+		table->frames = mFrameTable->frames;
+		for (size_t i = 0; i < table->frames.size(); i++) {
+			if (table->frames[i].image) table->frames[i].image->addRef();
+			if (table->frames[i].collisionMask) table->frames[i].collisionMask->addRef();
+		}
+		if (PDG_ATOMIC_DEC(&mFrameTable->refCount) == 0) {
+			delete mFrameTable;  // everyone else let go of it while we were copying
+		}
+		mFrameTable = table;
+	}
+	setFrameTable(mFrameTable);
+}
+
+// PROTECTED: copy the state of another sprite that doesn't depend on which layer we are in
+// used by SpriteLayer::cloneSprite(), the frames are shared until one of the sprites changes them
+void	Sprite::copyFrom(const Sprite* original) {
+	setFrameTable(original->mFrameTable);
+	mFps = original->mFps;
+	mCurrFramePrecise = original->mCurrFramePrecise;
+	mCurrFrame = original->mCurrFrame;
+	mFirstFrame = original->mFirstFrame;
+	mLastFrame = original->mLastFrame;
+	mLoopAnim = original->mLoopAnim;
+	mBackToFrontAnim = original->mBackToFrontAnim;
+	mBidirectionalAnim = original->mBidirectionalAnim;
+	mSpriteAnimating = original->mSpriteAnimating;
+	mSpriteAnimatingBackwardsNow = original->mSpriteAnimatingBackwardsNow;
+	mLocation = original->mLocation;
+	mWidth = original->mWidth;
+	mHeight = original->mHeight;
+	mFacing = original->mFacing;
+	mCenterOffset = original->mCenterOffset;
+	mDeltaXPerMs = original->mDeltaXPerMs;
+	mDeltaYPerMs = original->mDeltaYPerMs;
+	mDeltaWidthPerMs = original->mDeltaWidthPerMs;
+	mDeltaHeightPerMs = original->mDeltaHeightPerMs;
+	mDeltaFacingPerMs = original->mDeltaFacingPerMs;
+	mMass = original->mMass;
+	mMoveFriction = original->mMoveFriction;
+	mSpinFriction = original->mSpinFriction;
+	mSizeFriction = original->mSizeFriction;
+	mCollisionRadius = original->mCollisionRadius;
+	mElasticity = original->mElasticity;
+	mMouseDetectMode = original->mMouseDetectMode;
+	mOpacity = original->mOpacity;
+	wantsAnimLoop = original->wantsAnimLoop;
+	wantsAnimEnd = original->wantsAnimEnd;
+	wantsOffscreen = original->wantsOffscreen;
+	wantsWallCollide = original->wantsWallCollide;
+}
+
 // adds an image that is used for one or more frames
 // since an image itself can have multiple frames, all frames of the image are added
 // to the Sprite, unless startingFrame and/or numFrames is passed in.
@@ -1162,21 +1280,23 @@ void	Sprite::addFramesImage(Image* image, int startingFrame, int numFrames) {
 	if (startingFrame == start_FromFirstFrame) {
 		startingFrame = 0;
 	}
+	makeFramesWritable();
 	do {
-		if (mNumFrames >= MAX_FRAMES_PER_SPRITE) break;  // stop if we run out of space
 		ImageImpl* img = dynamic_cast<ImageImpl*>(image);
 		numFrames--; // goes negative and loop continues if numFrames was all_frames (0)
-		mFrames[mNumFrames].image = img;
+		FrameInfoT frame;
+		frame.image = img;
 		img->addRef();
-		mFrames[mNumFrames].collisionMask = 0;
-		mFrames[mNumFrames].imageFrameNum = startingFrame;
-		mFrames[mNumFrames].centerOffsetX = 0;
-		mFrames[mNumFrames].centerOffsetY = 0;
-		mFrames[mNumFrames].center = Rect( (img->frames) ? img->frameWidth : img->width, img->height).centerPoint();
-		mNumFrames++;
+		frame.collisionMask = 0;
+		frame.imageFrameNum = startingFrame;
+		frame.centerOffsetX = 0;
+		frame.centerOffsetY = 0;
+		frame.center = Rect( (img->frames) ? img->frameWidth : img->width, img->height).centerPoint();
+		mFrameTable->frames.push_back(frame);
 		startingFrame++;
 		if (startingFrame >= img->frames) break; // stop if we run out of frames in the image
 	} while (numFrames != 0);
+	setFrameTable(mFrameTable);
 }
 
 
@@ -1242,6 +1362,7 @@ void	Sprite::changeFramesImage(Image* oldImage, Image* newImage) {
 	ImageImpl* img = dynamic_cast<ImageImpl*>(newImage);
 	for (int i = 0; i< mNumFrames; i++) {
 		if (mFrames[i].image == oldImage) {
+			makeFramesWritable();
 			mFrames[i].image = img;
 			oldImage->release();
 			newImage->addRef();
@@ -1251,16 +1372,46 @@ void	Sprite::changeFramesImage(Image* oldImage, Image* newImage) {
 
 RotatedRect
 Sprite::getFrameRotatedBounds(int frameNum) {
-	if ( (frameNum <= 0) || (frameNum > mNumFrames) ) {
+	if ( (frameNum < 0) || (frameNum >= mNumFrames) ) {
 		frameNum = mCurrFrame;
 	}
-    Rect r = mFrames[frameNum].image->getImageBounds();
+	Rect r;
+	Offset coff;
+	if ((frameNum >= 0) && (frameNum < mNumFrames) && mFrames[frameNum].image) {
+		r = mFrames[frameNum].image->getImageBounds();
+		coff = Offset(mFrames[frameNum].centerOffsetX, mFrames[frameNum].centerOffsetY);
+	}
     r.center(mLocation);
-    Offset coff(mFrames[frameNum].centerOffsetX, mFrames[frameNum].centerOffsetY);
     RotatedRect rr(r, mFacing, coff);
     return rr;
 }
 
+// PROTECTED: bounds used by the layer's collision grid. The frame bounds may be rotated
+// around an offset center point, so use the furthest any corner could possibly be from
+// the sprite's location rather than calculating the exact rotated rect
+Rect
+Sprite::getCollisionBounds() {
+	float extent = mCollisionRadius;
+	if (mNumFrames > 0) {
+		int frameNum = mCurrFrame;
+		if ( (frameNum < 0) || (frameNum >= mNumFrames) ) {
+			frameNum = 0;
+		}
+		if (mFrames[frameNum].image) {
+			Rect r = mFrames[frameNum].image->getImageBounds();
+			float cx = std::fabs((float)mFrames[frameNum].centerOffsetX);
+			float cy = std::fabs((float)mFrames[frameNum].centerOffsetY);
+			float hw = r.width()/2.0f + cx;
+			float hh = r.height()/2.0f + cy;
+			float cornerDist = std::sqrt(hw*hw + hh*hh) + std::sqrt(cx*cx + cy*cy);
+			if (cornerDist > extent) {
+				extent = cornerDist;
+			}
+		}
+	}
+	return Rect(mLocation.x - extent, mLocation.y - extent, mLocation.x + extent, mLocation.y + extent);
+}
+
 
 // set offset of centerpoint of sprite (rotation and location are all relative to centerpoint)
 // this can be set for the whole sprite, if image, or for an individual frame or group of
@@ -1273,6 +1424,7 @@ void	Sprite::offsetFrameCenters(int offsetX, int offsetY, Image* image, int star
 	if (numFrames >= 0) {
 		if (image == 0) {
 			for (int i = startingFrame; i< mNumFrames; i++) {
+				makeFramesWritable();
 				mFrames[i].centerOffsetX = offsetX;
 				mFrames[i].centerOffsetY = offsetY;
 				numFrames--;
@@ -1290,6 +1442,7 @@ void	Sprite::offsetFrameCenters(int offsetX, int offsetY, Image* image, int star
 						}
 					}
 					if (found) {
+						makeFramesWritable();
 						mFrames[i].centerOffsetX = offsetX;
 						mFrames[i].centerOffsetY = offsetY;
 						numFrames--;
@@ -1301,6 +1454,7 @@ void	Sprite::offsetFrameCenters(int offsetX, int offsetY, Image* image, int star
 			}
 		}
 	}
+	gridBoundsChanged();
 }
 
 
@@ -1490,6 +1644,7 @@ Sprite&	Sprite::disableCollisions() {
 
 Sprite&	Sprite::setCollisionRadius(float pixelRadius) {
 	mCollisionRadius = pixelRadius;
+	gridBoundsChanged();
 	if (mCollisionRadius > 0.0f) {
         if (mDoCollisions < collide_CollisionRadius) {
             // if our collision type was alpha collisions, we still want to use
@@ -1531,6 +1686,7 @@ void	Sprite::useCollisionMask(Image* frameImage, Image* maskImage) {
 	ImageImpl* img = dynamic_cast<ImageImpl*>(maskImage);
 	for (int i = 0; i< mNumFrames; i++) {
 		if (mFrames[i].image == frameImage) {
+			makeFramesWritable();
 			Image* oldMask = mFrames[i].collisionMask;
 			if (oldMask) {
 				oldMask->release();
@@ -1614,6 +1770,9 @@ bool Sprite::collidesWith(Sprite* sprite) {
         RotatedRect rectA = getFrameRotatedBounds(mCurrFrame);
 		// argument sprite bounding rect
         RotatedRect rectB = sprite->getFrameRotatedBounds(sprite->mCurrFrame);
+		if ((mNumFrames == 0) || (sprite->mNumFrames == 0)) {
+			return false;  // no images to check against
+		}
 		
 		ImageImpl* imageA = mFrames[mCurrFrame].collisionMask;
 		if (imageA == 0) {
@@ -1663,6 +1822,9 @@ bool Sprite::collidesWith(const Point& p) {
 		RotatedRect rectB;
 		rectB.setSize(1);
 		rectB.moveTo(p);
+		if (mNumFrames == 0) {
+			return false;  // no image to check against
+		}
 		
 		ImageImpl* imageA = mFrames[mCurrFrame].collisionMask;
 		if (imageA == 0) {
@@ -1678,6 +1840,26 @@ bool Sprite::collidesWith(const Point& p) {
 	return false;
 }
 
+void Sprite::collideWithSprite(Sprite* otherSprite, float elapsedSecs, bool sendImmediately) {
+	if (!otherSprite->mDoCollisions || !collidesWith(otherSprite)) return;
+	Vector normal;
+	Vector impulse;
+	float kineticEnergy;
+	impartCollisionImpulse(otherSprite, normal, impulse, kineticEnergy);
+	float force = impulse.vectorLength() / elapsedSecs;
+	mLayer->notifyCollisionAction(Sprite::action_CollideSprite, this, normal, impulse, force, kineticEnergy, 
+							  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+								0,  // need to pass in something for cpArbiter param
+							  #endif
+								otherSprite, sendImmediately);
+}
+
+void Sprite::gridBoundsChanged() {
+	if (mInGrid) {
+		mLayer->mCollisionGrid->update(this);
+	}
+}
+
 	
 void Sprite::impartCollisionImpulse(Sprite* sprite, Vector& outNormal, Vector& outImpulse, float& outKineticEnergy) {
 
@@ -1816,9 +1998,25 @@ Sprite::doAnimate(ms_delta msElapsed, bool layerDoCollisions) {
     if (USE_CHIPMUNK && !cpBodyIsSleeping(mBody)) {
         cpVect v = cpBodyGetPosition(mBody);
         cpFloat angle = cpBodyGetAngle(mBody);
-        mLocation.x = v.x - mCenterOffset.x;
-        mLocation.y = v.y - mCenterOffset.y;
-        mFacing = angle;
+        World* world = mLayer->mWorld;
+        if (world && world->mInterpolatePhysics && (mPrevPhysicsStamp == world->mPhysicsStamp)) {
+            // fixed step physics is partway to its next step, so show the sprite
+            // that far between where the last step started and ended
+            v = cpvlerp(mPrevPhysicsPos, v, world->mPhysicsAlpha);
+            angle = mPrevPhysicsAngle + (angle - mPrevPhysicsAngle) * world->mPhysicsAlpha;
+        }
+        Point physicsLoc(v.x - mCenterOffset.x, v.y - mCenterOffset.y);
+        // set directly, so the change hooks don't push the values back into chipmunk
+        if (physicsLoc != mLocation) {
+            mLocation = physicsLoc;
+            mDirtyFields |= dirty_Location;
+            gridBoundsChanged();
+        }
+        float facing = angle;
+        if (mFacing != facing) {
+            mFacing = facing;
+            mDirtyFields |= dirty_Facing;
+        }
     }
     Point saveLoc = mLocation;
     Offset saveOffset = mCenterOffset;
@@ -1830,6 +2028,7 @@ Sprite::doAnimate(ms_delta msElapsed, bool layerDoCollisions) {
 
 	// select the appropriate frame of the animation
 	float elapsed = (float)msElapsed / 1000.0;
+	int saveFrame = mCurrFrame;
 
 
   #ifdef PDG_USE_CHIPMUNK_PHYSICS
@@ -1913,14 +2112,18 @@ Sprite::doAnimate(ms_delta msElapsed, bool layerDoCollisions) {
 			mCurrFrame = mLastFrame;
 			mCurrFramePrecise = mLastFrame;
 		}
-		DEBUG_ASSERT((mCurrFrame >= 0) && (mCurrFrame < MAX_FRAMES_PER_SPRITE), "invalid frame number in Sprite::animate()");
+		DEBUG_ASSERT((mCurrFrame >= 0) && ((mCurrFrame < mNumFrames) || (mNumFrames == 0)), "invalid frame number in Sprite::animate()");
+		if (mCurrFrame >= mNumFrames) {
+			mCurrFrame = mNumFrames - 1;
+			mCurrFramePrecise = mLastFrame;
+		}
 		if (mCurrFrame < 0) {
 			mCurrFrame = 0;
 			mCurrFramePrecise = mFirstFrame;
 		}
-		if (mCurrFrame >= MAX_FRAMES_PER_SPRITE) {
-			mCurrFrame = MAX_FRAMES_PER_SPRITE - 1;
-			mCurrFramePrecise = mLastFrame;
+		if (mCurrFrame != saveFrame) {
+			mDirtyFields |= dirty_Frame;
+			gridBoundsChanged();
 		}
 	}
 
@@ -1929,34 +2132,41 @@ Sprite::doAnimate(ms_delta msElapsed, bool layerDoCollisions) {
   		SPRITEANIMATE_DEBUG_ONLY( OS::_DOUT("Sprite [%p] checking collisions", this); )
 		
 		addRef(); // make sure this won't be deleted by being removed from the layer while we are working with it
-		Sprite* otherSprite = mLayer->mFirstSprite;
-		while (otherSprite) {
-			Sprite* nextOther = otherSprite->mNextSprite;
-			if (otherSprite != this && otherSprite->mDoCollisions && otherSprite) {
-				if (collidesWith(otherSprite)) {
-                    Vector normal;
-                    Vector impulse;
-                    float kineticEnergy;
-                    impartCollisionImpulse(otherSprite, normal, impulse, kineticEnergy);
-                    float force = impulse.vectorLength() / elapsed;
-					mLayer->notifyCollisionAction(Sprite::action_CollideSprite, this, normal, impulse, force, kineticEnergy, 
-                            #ifdef PDG_USE_CHIPMUNK_PHYSICS
-                                0,  // need to pass in something for cpArbiter param
-                            #endif
-								otherSprite);
+		SpriteLayer* layer = mLayer;
+		if (layer->mCollisionGrid) {
+			// broad phase: only check the sprites whose bounds overlap ours. The handlers can remove
+			// sprites or query the grid again, so work from our own retained copy of the results
+			std::vector<Sprite*> candidates(layer->mCollisionGrid->query(mGridBounds, this));
+			for (size_t i = 0; i < candidates.size(); i++) {
+				candidates[i]->addRef();
+			}
+			for (size_t i = 0; (i < candidates.size()) && (mLayer == layer); i++) {
+				if (candidates[i]->mLayer == layer) {
+					collideWithSprite(candidates[i], elapsed);
 				}
 			}
-			otherSprite = nextOther;
+			for (size_t i = 0; i < candidates.size(); i++) {
+				candidates[i]->release();
+			}
+		} else {
+			Sprite* otherSprite = layer->mFirstSprite;
+			while (otherSprite && (mLayer == layer)) {
+				Sprite* nextOther = otherSprite->mNextSprite;
+				if (otherSprite != this) {
+					collideWithSprite(otherSprite, elapsed);
+				}
+				otherSprite = nextOther;
+			}
 		}
-		if (refs == 1) dead = true;
+		if ((refs == 1) || (mLayer != layer)) dead = true;  // released or removed from the layer by a handler
 		release();
 		if (dead) return;
 	}
   #ifdef PDG_USE_CHIPMUNK_PHYSICS
-    if (mNumBreakableJoints > 0) {
+    if (!mBreakableJoints.empty()) {
   		SPRITEANIMATE_DEBUG_ONLY( OS::_DOUT("Sprite [%p] checking joints", this); )
         addRef();
-        for (int i = 0; i < mNumBreakableJoints; i++) {
+        for (size_t i = 0; i < mBreakableJoints.size(); i++) {
             cpFloat impulse = cpConstraintGetImpulse(mBreakableJoints[i]);
             cpFloat force = impulse/elapsed;
             cpFloat maxForce = cpConstraintGetMaxForce(mBreakableJoints[i]);
@@ -2044,6 +2254,11 @@ Sprite::postEvent(long inEventType, void* inEventData, EventEmitter* fromEmitter
 	if (fromEmitter == 0) {
 		fromEmitter = this;
 	}
+	if (mLayer && mLayer->mWorld && mLayer->mWorld->mDeferEvents) {
+		// our world is ticking on a world thread, so this gets posted again from
+		// the main thread, where the handlers can run, once the tick is done
+		return mLayer->mWorld->deferEvent(this, inEventType, inEventData);
+	}
 	bool wasHandled = emitEvent(fromEmitter, inEventType, inEventData);
 	cleanupRemovedHandlers();
 	// special case for collision events because we want to give both objects in the
@@ -2105,10 +2320,13 @@ Sprite::postEvent(long inEventType, void* inEventData, EventEmitter* fromEmitter
 
     void	
     Sprite::locationChanged(const Offset& delta) {
+        mDirtyFields |= dirty_Location;
+        gridBoundsChanged();
         if (USE_CHIPMUNK && !mAnimating) {
             // only do when not changed by animate() call because we
             // don't want to recalc this multiple times if center changes too
             cpBodySetPosition(mBody, cpv(mLocation.x + mCenterOffset.x, mLocation.y + mCenterOffset.y));
+            mPrevPhysicsStamp = 0;  // moved by hand, so don't interpolate from the old location
             if (mStatic) {
                 cpSpaceReindexStatic(getSpace());
             } else {
@@ -2119,6 +2337,8 @@ Sprite::postEvent(long inEventType, void* inEventData, EventEmitter* fromEmitter
 
     void	
     Sprite::sizeChanged(float deltaW, float deltaH) {
+        mDirtyFields |= dirty_Size;
+        gridBoundsChanged();
         if (USE_CHIPMUNK && !mAnimating && !mStatic) {
             cpFloat moment = cpMomentForBox(mMass, mWidth, mHeight);
             if (moment > 0) {
@@ -2129,6 +2349,7 @@ Sprite::postEvent(long inEventType, void* inEventData, EventEmitter* fromEmitter
 
     void	
     Sprite::rotationChanged(float deltaRadians) {
+        mDirtyFields |= dirty_Facing;
     	if (!USE_CHIPMUNK) return;
         // do this anytime we change rotation
         cpBodySetAngle(mBody, mFacing);
@@ -2245,26 +2466,20 @@ Sprite::postEvent(long inEventType, void* inEventData, EventEmitter* fromEmitter
     Sprite::makeJointBreakable(cpConstraint* joint, float breakingForce, Sound* breakSound) {
     	if (!USE_CHIPMUNK) return;
         DEBUG_ASSERT(breakingForce > 0, "Breaking Force must be > 0");
-        DEBUG_ASSERT(mNumBreakableJoints < MAX_BREAKABLE_JOINTS_PER_SPRITE, "Too many breakable joints!!");
-        if ((breakingForce > 0) && (mNumBreakableJoints < MAX_BREAKABLE_JOINTS_PER_SPRITE)) {
+        if (breakingForce > 0) {
             cpConstraintSetMaxForce(joint, breakingForce / BREAK_COEFFICIENT);
-            mBreakableJoints[mNumBreakableJoints] = joint;
-            mNumBreakableJoints++;
+            mBreakableJoints.push_back(joint);
         }
     }
 
     void
     Sprite::makeJointUnbreakable(cpConstraint* joint) {
     	if (!USE_CHIPMUNK) return;
-        bool found = false;
-        for (int i = 0; i < mNumBreakableJoints; i++) {
-            // remove from the breakable joints array
+        for (size_t i = 0; i < mBreakableJoints.size(); i++) {
+            // remove from the breakable joints list
             if (mBreakableJoints[i] == joint) {
-                found = true;
-                mNumBreakableJoints--;
-            }
-            if (found && (i < mNumBreakableJoints-1) ) {
-                mBreakableJoints[i] = mBreakableJoints[i+1];
+                mBreakableJoints.erase(mBreakableJoints.begin() + i);
+                break;
             }
         }
     }
@@ -2434,7 +2649,7 @@ Sprite::postEvent(long inEventType, void* inEventData, EventEmitter* fromEmitter
     Sprite::disconnect(Sprite* otherSprite) {
     	if (!USE_CHIPMUNK) return;
         if (!otherSprite) {
-            mNumBreakableJoints = 0; // this saves us having to do a lot of manipulation of the mBreakableJoints array
+            mBreakableJoints.clear(); // this saves us having to do a lot of manipulation of the mBreakableJoints list
         }
         cpBodyEachConstraint(mBody, RemoveConstraint, otherSprite);
     }
@@ -2488,9 +2703,153 @@ Sprite::postEvent(long inEventType, void* inEventData, EventEmitter* fromEmitter
 		mBody = 0;
     }
 
+#else
+
+void
+Sprite::locationChanged(const Offset& delta) {
+	mDirtyFields |= dirty_Location;
+	gridBoundsChanged();
+}
+
+void
+Sprite::sizeChanged(float deltaW, float deltaH) {
+	mDirtyFields |= dirty_Size;
+	gridBoundsChanged();
+}
+
+void
+Sprite::rotationChanged(float deltaRadians) {
+	mDirtyFields |= dirty_Facing;
+}
 
 #endif // PDG_USE_CHIPMUNK_PHYSICS
 
+// -----------------------------------------------------------------------------------
+// delta serialization
+// each field remembers the snapshot it last changed in, so a delta against any
+// baseline snapshot is just the fields stamped with a newer id
+// -----------------------------------------------------------------------------------
+
+void
+Sprite::commitChanges(uint32 snapshotId) {
+	if (mDirtyFields == 0) return;
+	for (int i = 0; i < num_DirtyFields; i++) {
+		if (mDirtyFields & (1 << i)) {
+			mFieldChangedAt[i] = snapshotId;
+		}
+	}
+	mDirtyFields = 0;
+}
+
+uint32
+Sprite::getDeltaFields(uint32 baselineId) const {
+	if (baselineId == 0) {
+		return dirty_All;
+	}
+	uint32 fields = 0;
+	for (int i = 0; i < num_DirtyFields; i++) {
+		// wraparound safe version of mFieldChangedAt[i] > baselineId
+		if ((int32)(mFieldChangedAt[i] - baselineId) > 0) {
+			fields |= (1 << i);
+		}
+	}
+	return fields;
+}
+
+uint32
+Sprite::getDeltaSize(ISerializer* serializer, uint32 fields) const {
+	uint32 totalSize = 0;
+	if (fields & dirty_Created) {
+		totalSize += serializer->sizeof_uint((uint32)spriteId);
+	}
+	if (fields & dirty_Location) {
+		totalSize += 4; // 2x 2 byte shorts, same as ser_Micro
+	}
+	if (fields & dirty_Facing) {
+		totalSize += 4;
+	}
+	if (fields & dirty_Frame) {
+		totalSize += serializer->sizeof_uint(mCurrFrame);
+	}
+	if (fields & dirty_Size) {
+		totalSize += 8;
+	}
+	return totalSize;
+}
+
+void
+Sprite::serializeDelta(ISerializer* serializer, uint32 fields) const {
+	if (fields & dirty_Created) {
+		serializer->serialize_uint((uint32)spriteId);
+	}
+	if (fields & dirty_Location) {
+		int16 x = (mLocation.x < MIN_INT16) ? MIN_INT16 : ((mLocation.x > MAX_INT16) ? MAX_INT16 : (int16)mLocation.x);
+		int16 y = (mLocation.y < MIN_INT16) ? MIN_INT16 : ((mLocation.y > MAX_INT16) ? MAX_INT16 : (int16)mLocation.y);
+		serializer->serialize_2(x);
+		serializer->serialize_2(y);
+	}
+	if (fields & dirty_Facing) {
+		serializer->serialize_f(mFacing);
+	}
+	if (fields & dirty_Frame) {
+		serializer->serialize_uint(mCurrFrame);
+	}
+	if (fields & dirty_Size) {
+		serializer->serialize_f(mWidth);
+		serializer->serialize_f(mHeight);
+	}
+}
+
+// static, sprite is 0 if the fields should be read and ignored
+// everything is applied through the setters so physics, the collision grid and the
+// change hooks all see it the same as a local change
+void
+Sprite::deserializeDelta(IDeserializer* deserializer, uint32 fields, Sprite* sprite) {
+	if (fields & dirty_Created) {
+		long id = (long)deserializer->deserialize_uint();
+		if (sprite && (sprite->spriteId != id)) {
+			sprite->spriteId = id;
+			if (sprite->mLayer) {
+				sprite->mLayer->updateSpriteIndex(sprite);
+			}
+		}
+	}
+	if (fields & dirty_Location) {
+		float x = deserializer->deserialize_2();
+		float y = deserializer->deserialize_2();
+		if (sprite) {
+			sprite->setLocation(Point(x, y));
+		}
+	}
+	if (fields & dirty_Facing) {
+		float facing = deserializer->deserialize_f();
+		if (sprite) {
+			sprite->setRotation(facing);
+		}
+	}
+	if (fields & dirty_Frame) {
+		int frame = (int)deserializer->deserialize_uint();
+		if (sprite) {
+			if (frame < sprite->mNumFrames) {
+				sprite->setFrame(frame);
+			} else {
+				// a sprite we just created won't have its frames yet, so keep the number
+				// for when it does rather than letting setFrame() clamp it
+				sprite->mCurrFrame = frame;
+				sprite->mCurrFramePrecise = frame;
+				sprite->mDirtyFields |= dirty_Frame;
+			}
+		}
+	}
+	if (fields & dirty_Size) {
+		float w = deserializer->deserialize_f();
+		float h = deserializer->deserialize_f();
+		if (sprite) {
+			sprite->setSize(w, h);
+		}
+	}
+}
+
 void
 Sprite::recalcOnscreenAndInBounds() {
 	RotatedRect srb = getRotatedBounds();
@@ -2523,6 +2882,8 @@ Sprite::Sprite() :
 	wantsWallCollide(false),
     userData(0),	
     mNumFrames(0), 
+	mFrameTable(0),
+	mFrames(0),
 	mFps(1.0),
 	mCurrFramePrecise(0),
 	mCurrFrame(0),
@@ -2556,8 +2917,23 @@ Sprite::Sprite() :
   	mOnscreen(true),
   	mInBounds(true),
   	mCompletelyInBounds(true),
-	iid(sUniqueSpriteId++)
+	mGridCellLeft(0),
+	mGridCellTop(0),
+	mGridCellRight(-1),
+	mGridCellBottom(-1),
+	mGridQueryStamp(0),
+	mGridOversized(false),
+	mInGrid(false),
+	mIndexedIid(0),
+	mIndexedId(0),
+	mIndexed(false),
+	mZIndex(0),
+	mDirtyFields(dirty_All),
+	iid(PDG_ATOMIC_INC(&sUniqueSpriteId) - 1)
 {
+	for (int i = 0; i < num_DirtyFields; i++) {
+		mFieldChangedAt[i] = 0;
+	}
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 	INIT_SCRIPT_OBJECT(mSpriteScriptObj);
 #endif
@@ -2567,8 +2943,8 @@ Sprite::Sprite() :
     mHeight = 1;    // make sure we've got some height and width
     mWidth = 1;
     mCollideShape = 0; // only create this when we set collisions
-    mNumBreakableJoints = 0;
     mStatic = false;
+    mPrevPhysicsStamp = 0;
 #endif
 //	mBounds = Rect(20, 20);
 //	DEBUG_PRINT("Constructed Sprite [%p]", this);
@@ -2582,6 +2958,7 @@ Sprite::Sprite() :
 //
 Sprite::~Sprite() {
     //                DEBUG_ONLY( OS::_DOUT("dt Sprite %p", this) = 0; )
+	IDeserializer::unregisterObject(this);  // in case it was registered for serialize_ref()
   #ifndef PDG_NO_GUI
 	if (mDrawHelper && mDrawHelper->ownedBySprite()) {
 		delete mDrawHelper;
@@ -2608,6 +2985,7 @@ Sprite::~Sprite() {
 		mEntity = 0;
 	}
   #endif
+	setFrameTable(0);
   #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 	CleanupSpriteScriptObject(mSpriteScriptObj);
   #endif
@@ -0,0 +1,161 @@
+// -----------------------------------------------
+// spriteindex.cpp
+//
+// Hash indexes for finding the sprites in a layer by id
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+
+
+#include "pdg_project.h"
+
+#include "pdg/sys/global_types.h"
+#include "pdg/sys/sprite.h"
+
+#include "spriteindex.h"
+
+namespace pdg {
+
+SpriteIndex::SpriteIndex()
+ :	mByIid(SPRITE_INDEX_INITIAL_BUCKETS),
+	mById(SPRITE_INDEX_INITIAL_BUCKETS),
+	mMask(SPRITE_INDEX_INITIAL_BUCKETS - 1),
+	mCount(0)
+{
+}
+
+uint32
+SpriteIndex::hashKey(uint32 key) {
+	// iids are handed out sequentially, so mix the bits up before masking
+	key ^= key >> 16;
+	key *= 0x45d9f3b;
+	key ^= key >> 16;
+	return key;
+}
+
+void
+SpriteIndex::removeFromBucket(BucketT& bucket, Sprite* sprite) {
+	for (size_t i = 0; i < bucket.size(); i++) {
+		if (bucket[i] == sprite) {
+			bucket[i] = bucket.back();
+			bucket.pop_back();
+			return;
+		}
+	}
+}
+
+void
+SpriteIndex::grow() {
+	uint32 numBuckets = (mMask + 1) * 2;
+	std::vector<BucketT> byIid(numBuckets);
+	std::vector<BucketT> byId(numBuckets);
+	mMask = numBuckets - 1;
+	for (size_t i = 0; i < mByIid.size(); i++) {
+		BucketT& bucket = mByIid[i];
+		for (size_t j = 0; j < bucket.size(); j++) {
+			Sprite* sprite = bucket[j];
+			byIid[hashKey(sprite->mIndexedIid) & mMask].push_back(sprite);
+			if (sprite->mIndexedId != 0) {
+				byId[hashKey((uint32)sprite->mIndexedId) & mMask].push_back(sprite);
+			}
+		}
+	}
+	mByIid.swap(byIid);
+	mById.swap(byId);
+}
+
+void
+SpriteIndex::insert(Sprite* sprite) {
+	if (!sprite || sprite->mIndexed) return;
+	if (mCount > mMask) {
+		grow();
+	}
+	sprite->mIndexed = true;
+	sprite->mIndexedIid = sprite->iid;
+	sprite->mIndexedId = sprite->spriteId;
+	mByIid[hashKey(sprite->mIndexedIid) & mMask].push_back(sprite);
+	if (sprite->mIndexedId != 0) {
+		mById[hashKey((uint32)sprite->mIndexedId) & mMask].push_back(sprite);
+	}
+	mCount++;
+}
+
+void
+SpriteIndex::remove(Sprite* sprite) {
+	if (!sprite || !sprite->mIndexed) return;
+	removeFromBucket(mByIid[hashKey(sprite->mIndexedIid) & mMask], sprite);
+	if (sprite->mIndexedId != 0) {
+		removeFromBucket(mById[hashKey((uint32)sprite->mIndexedId) & mMask], sprite);
+	}
+	sprite->mIndexed = false;
+	mCount--;
+}
+
+void
+SpriteIndex::update(Sprite* sprite) {
+	if (!sprite || !sprite->mIndexed) return;
+	if (sprite->mIndexedIid != sprite->iid) {
+		removeFromBucket(mByIid[hashKey(sprite->mIndexedIid) & mMask], sprite);
+		sprite->mIndexedIid = sprite->iid;
+		mByIid[hashKey(sprite->mIndexedIid) & mMask].push_back(sprite);
+	}
+	if (sprite->mIndexedId != sprite->spriteId) {
+		if (sprite->mIndexedId != 0) {
+			removeFromBucket(mById[hashKey((uint32)sprite->mIndexedId) & mMask], sprite);
+		}
+		sprite->mIndexedId = sprite->spriteId;
+		if (sprite->mIndexedId != 0) {
+			mById[hashKey((uint32)sprite->mIndexedId) & mMask].push_back(sprite);
+		}
+	}
+}
+
+Sprite*
+SpriteIndex::findByInternalId(uint32 iid) const {
+	const BucketT& bucket = mByIid[hashKey(iid) & mMask];
+	for (size_t i = 0; i < bucket.size(); i++) {
+		if (bucket[i]->mIndexedIid == iid) {
+			return bucket[i];
+		}
+	}
+	return 0;
+}
+
+Sprite*
+SpriteIndex::findById(long id, int& outMatches) const {
+	outMatches = 0;
+	if (id == 0) return 0;
+	Sprite* found = 0;
+	const BucketT& bucket = mById[hashKey((uint32)id) & mMask];
+	for (size_t i = 0; i < bucket.size(); i++) {
+		if (bucket[i]->mIndexedId == id) {
+			if (!found) {
+				found = bucket[i];
+			}
+			outMatches++;
+		}
+	}
+	return found;
+}
+
+} // end namespace pdg
@@ -0,0 +1,84 @@
+// -----------------------------------------------
+// spriteindex.h
+//
+// Hash indexes for finding the sprites in a layer by id
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+
+#ifndef PDG_SPRITEINDEX_H_INCLUDED
+#define PDG_SPRITEINDEX_H_INCLUDED
+
+#include "pdg_project.h"
+
+#include "pdg/sys/global_types.h"
+
+#include <vector>
+
+// number of hash buckets an index starts with, must be a power of 2
+// the number of buckets doubles whenever there are more sprites than buckets
+#define SPRITE_INDEX_INITIAL_BUCKETS	64
+
+namespace pdg {
+
+class Sprite;
+
+// -----------------------------------------------------------------------------------
+// Sprite Index
+// Used by SpriteLayer to find sprites by iid and spriteId without walking the whole
+// layer. Each sprite remembers the keys it was filed under, so the index can still
+// remove it after its ids have been changed, and update() refiles it under the new ones.
+// spriteId 0 is never indexed, since that is what every sprite starts out with
+// -----------------------------------------------------------------------------------
+
+class SpriteIndex {
+public:
+	SpriteIndex();
+
+	void	insert(Sprite* sprite);
+	void	remove(Sprite* sprite);
+	// refile the sprite if its iid or spriteId have changed since it was indexed
+	void	update(Sprite* sprite);
+
+	Sprite*	findByInternalId(uint32 iid) const;
+	// spriteIds don't have to be unique, outMatches is set to the number of sprites using the id
+	Sprite*	findById(long id, int& outMatches) const;
+
+/// @cond INTERNAL
+private:
+	typedef std::vector<Sprite*> BucketT;
+
+	static uint32 hashKey(uint32 key);
+	static void removeFromBucket(BucketT& bucket, Sprite* sprite);
+	void	grow();
+
+	std::vector<BucketT> mByIid;
+	std::vector<BucketT> mById;
+	uint32	mMask;
+	uint32	mCount;
+/// @endcond
+};
+
+} // end namespace pdg
+
+#endif // PDG_SPRITEINDEX_H_INCLUDED
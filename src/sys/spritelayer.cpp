@@ -34,10 +34,14 @@
 #include "pdg/sys/os.h"
 #include "pdg/sys/sprite.h"
 #include "pdg/sys/spritelayer.h"
+#include "pdg/sys/world.h"
 #include "pdg/sys/iserializer.h"
 #include "pdg/sys/ideserializer.h"
+#include "pdg/sys/atomic.h"
 
 #include "spritemanager.h"
+#include "collisiongrid.h"
+#include "spriteindex.h"
 #include "internals.h"
 
 #ifdef PDG_SCML_SUPPORT
@@ -46,6 +50,7 @@
 
 #include <algorithm>
 #include <fstream>
+#include <limits>
 
 // define the following in your build environment, or uncomment it here to get
 // debug output for the core events and timers
@@ -87,9 +92,12 @@
 #endif
 
 #define PDG_SPRITE_LAYER_MAGIC_NUMBER   0x31008971
-#define PDG_SPRITE_LAYER_STREAM_V_1		0
-// add new versions here
-#define PDG_SPRITE_LAYER_STREAM_VERSION	PDG_SPRITE_LAYER_STREAM_V_1
+
+// how many snapshots back we keep removed sprites for, a client whose baseline is
+// older than this gets everything resent
+#ifndef PDG_SPRITE_LAYER_DELTA_HISTORY
+#define PDG_SPRITE_LAYER_DELTA_HISTORY	256
+#endif
 
 #ifndef PDG_UNSAFE_SERIALIZATION
 #define PDG_TAG_SERIALIZED_DATA
@@ -138,8 +146,187 @@ void SpriteLayer::setSerializationFlags(uint32 flags) {
 	mSerFlags = flags;
 }
 
+uint32 SpriteLayer::takeSnapshot() {
+	mSnapshotId++;
+	if (mSnapshotId == 0) {
+		mSnapshotId = 1;  // 0 always means no baseline
+	}
+	Sprite* sprite = mFirstSprite;
+	while (sprite) {
+		sprite->commitChanges(mSnapshotId);
+		sprite = sprite->mNextSprite;
+	}
+	while (!mRemovedSprites.empty() &&
+		   (int32)(mSnapshotId - mRemovedSprites.front().snapshotId) >= PDG_SPRITE_LAYER_DELTA_HISTORY) {
+		mRemovedSprites.pop_front();
+	}
+	if (!mObservers.empty()) {
+		updateObservers();
+	}
+	return mSnapshotId;
+}
+
+void SpriteLayer::setSerializationBaseline(uint32 baselineId) {
+	mSerBaseline = baselineId;
+}
+
+uint32 SpriteLayer::getLastSnapshotId() const {
+	return mLastSnapshotId;
+}
+
+// PROTECTED
+uint32 SpriteLayer::getDeltaBaseline() const {
+	int32 age = (int32)(mSnapshotId - mSerBaseline);
+	if ((mSerBaseline == 0) || (age < 0) || (age >= PDG_SPRITE_LAYER_DELTA_HISTORY)) {
+		// never had one, from the future, or too old to know what was removed since
+		return 0;
+	}
+	return mSerBaseline;
+}
+
+uint32 SpriteLayer::addObserver() {
+	if (!mCollisionGrid) {
+		enableCollisionGrid();
+	}
+	ObserverT* observer = new ObserverT();
+	observer->id = mNextObserverId++;
+	if (mNextObserverId == 0) {
+		mNextObserverId = 1;
+	}
+	observer->hasArea = false;
+	observer->radius = 0.0f;
+	mObservers.push_back(observer);
+	return observer->id;
+}
+
+void SpriteLayer::removeObserver(uint32 observerId) {
+	for (size_t i = 0; i < mObservers.size(); i++) {
+		if (mObservers[i]->id == observerId) {
+			delete mObservers[i];
+			mObservers.erase(mObservers.begin() + i);
+			break;
+		}
+	}
+	if (mSerObserver == observerId) {
+		mSerObserver = 0;
+	}
+}
+
+void SpriteLayer::setObserverArea(uint32 observerId, const Rect& area) {
+	ObserverT* observer = findObserver(observerId);
+	if (!observer) return;
+	observer->hasArea = true;
+	observer->area = area;
+	observer->radius = 0.0f;
+}
+
+void SpriteLayer::setObserverRadius(uint32 observerId, const Point& center, float radius) {
+	ObserverT* observer = findObserver(observerId);
+	if (!observer) return;
+	observer->hasArea = (radius > 0.0f);
+	observer->area = Rect(center.x - radius, center.y - radius, center.x + radius, center.y + radius);
+	observer->center = center;
+	observer->radius = radius;
+}
+
+void SpriteLayer::setSerializationObserver(uint32 observerId) {
+	mSerObserver = observerId;
+}
+
+// PROTECTED
+SpriteLayer::ObserverT* SpriteLayer::findObserver(uint32 observerId) const {
+	for (size_t i = 0; i < mObservers.size(); i++) {
+		if (mObservers[i]->id == observerId) {
+			return mObservers[i];
+		}
+	}
+	return 0;
+}
+
+SpriteLayer::ObserverT::~ObserverT() {
+	for (size_t i = 0; i < visible.size(); i++) {
+		visible[i].sprite->release();
+	}
+}
+
+// PROTECTED
+bool SpriteLayer::isObserving(const ObserverT* observer, uint32 iid) {
+	ObservedSpriteT key;
+	key.iid = iid;
+	return std::binary_search(observer->visible.begin(), observer->visible.end(), key);
+}
+
+// PROTECTED: called from takeSnapshot() once the grid is up to date
+void SpriteLayer::updateObservers() {
+	for (size_t i = 0; i < mObservers.size(); i++) {
+		ObserverT* observer = mObservers[i];
+		mObserverScratch.clear();
+		if (observer->hasArea) {
+			const std::vector<Sprite*>& found = mCollisionGrid->query(observer->area);
+			float r2 = observer->radius * observer->radius;
+			for (size_t j = 0; j < found.size(); j++) {
+				Sprite* sprite = found[j];
+				if (observer->radius > 0.0f) {
+					// distance from the center to the nearest point of the sprite's bounds
+					const Rect& b = sprite->mGridBounds;
+					float nx = std::max(b.left, std::min(observer->center.x, b.right));
+					float ny = std::max(b.top, std::min(observer->center.y, b.bottom));
+					float dx = observer->center.x - nx;
+					float dy = observer->center.y - ny;
+					if ((dx * dx + dy * dy) > r2) continue;
+				}
+				ObservedSpriteT seen;
+				seen.iid = sprite->iid;
+				seen.enteredAt = mSnapshotId;
+				seen.sprite = sprite;
+				sprite->addRef();
+				mObserverScratch.push_back(seen);
+			}
+			std::sort(mObserverScratch.begin(), mObserverScratch.end());
+		}
+		// both lists are sorted by iid, so one pass finds what came and went
+		std::vector<ObservedSpriteT>& old = observer->visible;
+		size_t j = 0;
+		for (size_t k = 0; k < mObserverScratch.size(); k++) {
+			ObservedSpriteT& seen = mObserverScratch[k];
+			while ((j < old.size()) && (old[j].iid < seen.iid)) {
+				RemovedSpriteT gone;
+				gone.iid = old[j].iid;
+				gone.snapshotId = mSnapshotId;
+				observer->left.push_back(gone);
+				notifyObserverAction(Sprite::action_ExitObserver, old[j].sprite, observer->id);
+				j++;
+			}
+			if ((j < old.size()) && (old[j].iid == seen.iid)) {
+				seen.enteredAt = old[j].enteredAt;
+				j++;
+			} else {
+				notifyObserverAction(Sprite::action_EnterObserver, seen.sprite, observer->id);
+			}
+		}
+		while (j < old.size()) {
+			RemovedSpriteT gone;
+			gone.iid = old[j].iid;
+			gone.snapshotId = mSnapshotId;
+			observer->left.push_back(gone);
+			notifyObserverAction(Sprite::action_ExitObserver, old[j].sprite, observer->id);
+			j++;
+		}
+		old.swap(mObserverScratch);
+		// the scratch list has the old visible list now, let go of those sprites
+		for (size_t k = 0; k < mObserverScratch.size(); k++) {
+			mObserverScratch[k].sprite->release();
+		}
+		mObserverScratch.clear();
+		while (!observer->left.empty() &&
+			   (int32)(mSnapshotId - observer->left.front().snapshotId) >= PDG_SPRITE_LAYER_DELTA_HISTORY) {
+			observer->left.pop_front();
+		}
+	}
+}
+
 uint32 SpriteLayer::getSerializedSize(ISerializer* serializer) const {
-	if ( (mSerFlags == ser_Micro) || (mSerFlags == ser_Positions) ) {
+	if ( (mSerFlags == ser_Micro) || (mSerFlags == ser_Positions) || (mSerFlags & ser_Delta) ) {
         serializer->setSendTags(false);  // we don't want to send any unnecessary data
     }
 	uint32 totalSize = 0;
@@ -147,7 +334,48 @@ uint32 SpriteLayer::getSerializedSize(ISerializer* serializer) const {
 	uint32 count = 0;
 	totalSize += 1;  // size of PDG_SPRITE_LAYER_STREAM_VERSION
 	totalSize += serializer->sizeof_uint(mSerFlags); // size of serializable flags
-	if ( (mSerFlags == ser_Micro) || (mSerFlags == ser_Positions) ) {
+	if (mSerFlags & ser_Delta) {
+		// only the fields that changed since the baseline, other flags are ignored
+		uint32 baseline = getDeltaBaseline();
+		const ObserverT* observer = findObserver(mSerObserver);
+		totalSize += serializer->sizeof_uint(mSnapshotId);
+		totalSize += serializer->sizeof_uint(baseline);
+		const std::deque<RemovedSpriteT>& removed = (observer) ? observer->left : mRemovedSprites;
+		for (std::deque<RemovedSpriteT>::const_iterator it = removed.begin(); it != removed.end(); it++) {
+			if (((int32)(it->snapshotId - baseline) > 0) && (!observer || !isObserving(observer, it->iid))) {
+				count++;
+				totalSize += serializer->sizeof_uint(it->iid);
+			}
+		}
+		totalSize += serializer->sizeof_uint(count);
+		count = 0;
+		if (observer) {
+			for (size_t i = 0; i < observer->visible.size(); i++) {
+				const ObservedSpriteT& seen = observer->visible[i];
+				// the client might not have the sprite yet, so it gets everything until it acks the snapshot it entered in
+				uint32 fields = ((int32)(seen.enteredAt - baseline) > 0) ? (uint32)Sprite::dirty_All : seen.sprite->getDeltaFields(baseline);
+				if (fields) {
+					count++;
+					totalSize += serializer->sizeof_uint(seen.iid);
+					totalSize += 1; // fields
+					totalSize += seen.sprite->getDeltaSize(serializer, fields);
+				}
+			}
+		} else {
+			sprite = mFirstSprite;
+			while (sprite) {
+				uint32 fields = sprite->getDeltaFields(baseline);
+				if (fields) {
+					count++;
+					totalSize += serializer->sizeof_uint(sprite->iid);
+					totalSize += 1; // fields
+					totalSize += sprite->getDeltaSize(serializer, fields);
+				}
+				sprite = sprite->mNextSprite;
+			}
+		}
+		totalSize += serializer->sizeof_uint(count);
+	} else if ( (mSerFlags == ser_Micro) || (mSerFlags == ser_Positions) ) {
 		// special case, smallest possible update, basically just the sprites
 		sprite = mFirstSprite;
 		while (sprite) {
@@ -237,7 +465,7 @@ uint32 SpriteLayer::getSerializedSize(ISerializer* serializer) const {
 
 
 void SpriteLayer::serialize(ISerializer* serializer) const {
-	if ( (mSerFlags == ser_Micro) || (mSerFlags == ser_Positions) ) {
+	if ( (mSerFlags == ser_Micro) || (mSerFlags == ser_Positions) || (mSerFlags & ser_Delta) ) {
         serializer->setSendTags(false);  // we don't want to send any unnecessary data
     }
 	Sprite* sprite = 0;
@@ -245,7 +473,69 @@ void SpriteLayer::serialize(ISerializer* serializer) const {
 	serializer->serialize_1u(PDG_SPRITE_LAYER_STREAM_VERSION);
 	serializer->serialize_uint(mSerFlags);
 	SERIALIZATION_DEBUG_ONLY( DEBUG_PRINT("SpriteLayer [%p] vers [%d] flags [%p]", this, PDG_SPRITE_LAYER_STREAM_VERSION, mSerFlags); )
-	if ( (mSerFlags == ser_Micro) || (mSerFlags == ser_Positions) ) {
+	if (mSerFlags & ser_Delta) {
+		uint32 baseline = getDeltaBaseline();
+		SERIALIZATION_DEBUG_ONLY( DEBUG_PRINT("SpriteLayer [%p] writing Delta update %d from %d", this, mSnapshotId, baseline); )
+		serializer->serialize_uint(mSnapshotId);
+		serializer->serialize_uint(baseline);
+		// sprites removed since the baseline, or that left the observer's area and haven't come back
+		const ObserverT* observer = findObserver(mSerObserver);
+		const std::deque<RemovedSpriteT>& removed = (observer) ? observer->left : mRemovedSprites;
+		for (std::deque<RemovedSpriteT>::const_iterator it = removed.begin(); it != removed.end(); it++) {
+			if (((int32)(it->snapshotId - baseline) > 0) && (!observer || !isObserving(observer, it->iid))) {
+				count++;
+			}
+		}
+		serializer->serialize_uint(count);
+		SERIALIZATION_DEBUG_ONLY( DEBUG_PRINT("  removed count: %d", count); )
+		for (std::deque<RemovedSpriteT>::const_iterator it = removed.begin(); it != removed.end(); it++) {
+			if (((int32)(it->snapshotId - baseline) > 0) && (!observer || !isObserving(observer, it->iid))) {
+				serializer->serialize_uint(it->iid);
+			}
+		}
+		// sprites with fields that changed since the baseline
+		count = 0;
+		if (observer) {
+			SERIALIZATION_DEBUG_ONLY( DEBUG_PRINT("  for observer %d", observer->id); )
+			for (size_t i = 0; i < observer->visible.size(); i++) {
+				const ObservedSpriteT& seen = observer->visible[i];
+				if (((int32)(seen.enteredAt - baseline) > 0) || seen.sprite->getDeltaFields(baseline)) {
+					count++;
+				}
+			}
+			serializer->serialize_uint(count);
+			SERIALIZATION_DEBUG_ONLY( DEBUG_PRINT("  changed count: %d", count); )
+			for (size_t i = 0; i < observer->visible.size(); i++) {
+				const ObservedSpriteT& seen = observer->visible[i];
+				uint32 fields = ((int32)(seen.enteredAt - baseline) > 0) ? (uint32)Sprite::dirty_All : seen.sprite->getDeltaFields(baseline);
+				if (fields) {
+					serializer->serialize_uint(seen.iid);
+					serializer->serialize_1u(fields);
+					seen.sprite->serializeDelta(serializer, fields);
+				}
+			}
+		} else {
+			sprite = mFirstSprite;
+			while (sprite) {
+				if (sprite->getDeltaFields(baseline)) {
+					count++;
+				}
+				sprite = sprite->mNextSprite;
+			}
+			serializer->serialize_uint(count);
+			SERIALIZATION_DEBUG_ONLY( DEBUG_PRINT("  changed count: %d", count); )
+			sprite = mFirstSprite;
+			while (sprite) {
+				uint32 fields = sprite->getDeltaFields(baseline);
+				if (fields) {
+					serializer->serialize_uint(sprite->iid);
+					serializer->serialize_1u(fields);
+					sprite->serializeDelta(serializer, fields);
+				}
+				sprite = sprite->mNextSprite;
+			}
+		}
+	} else if ( (mSerFlags == ser_Micro) || (mSerFlags == ser_Positions) ) {
 		SERIALIZATION_DEBUG_ONLY( DEBUG_PRINT("SpriteLayer [%p] writing Micro update", this); )
 		// special case, smallest possible update, basically just the sprites
 		// get and write the count
@@ -369,10 +659,55 @@ void SpriteLayer::deserialize(IDeserializer* deserializer) {
 	uint32 serFlags = deserializer->deserialize_uint();
 	uint32 oldSerFlags = mSerFlags;
 	mSerFlags = serFlags;
+	mSerStreamVers = streamVers;
 	SERIALIZATION_DEBUG_ONLY( DEBUG_PRINT("SpriteLayer [%p] reading vers [%d] flags [%p]", this, streamVers, serFlags); )
 	Sprite* sprite = 0;
 	uint32 count = 0;
-	if ( (mSerFlags == ser_Micro) || (mSerFlags == ser_Positions) ) {
+	if (mSerFlags & ser_Delta) {
+		uint32 snapshotId = deserializer->deserialize_uint();
+		SERIALIZATION_DEBUG_ONLY( uint32 baseline = ) deserializer->deserialize_uint();
+		// deltas can arrive out of order over an unreliable transport, anything older than
+		// what we already have is read and thrown away
+		bool apply = (mLastSnapshotId == 0) || ((int32)(snapshotId - mLastSnapshotId) > 0);
+		SERIALIZATION_DEBUG_ONLY( DEBUG_PRINT("SpriteLayer [%p] reading Delta update %d from %d%s", this, snapshotId, baseline, apply ? "" : " (stale)"); )
+		count = deserializer->deserialize_uint();
+		while (count) {
+			uint32 siid = deserializer->deserialize_uint();
+			if (apply) {
+				sprite = findSpriteByInternalId(siid);
+				if (sprite) {
+					removeSprite(sprite);
+				}
+			}
+			count--;
+		}
+		count = deserializer->deserialize_uint();
+		bool missingSprites = false;
+		while (count) {
+			uint32 siid = deserializer->deserialize_uint();
+			uint32 fields = deserializer->deserialize_1u();
+			sprite = (apply) ? findSpriteByInternalId(siid) : 0;
+			if (apply && !sprite) {
+				if (fields & Sprite::dirty_Created) {
+					// a create record, make a bare sprite with the sender's ids for the app to fill in
+					SERIALIZATION_DEBUG_ONLY( DEBUG_PRINT("    iid : %d created", siid); )
+					sprite = createSprite();
+					sprite->iid = siid;
+					updateSpriteIndex(sprite);
+				} else {
+					SERIALIZATION_DEBUG_ONLY( DEBUG_PRINT("    iid : %d not in layer, skipped", siid); )
+					missingSprites = true;
+				}
+			}
+			Sprite::deserializeDelta(deserializer, fields, sprite);
+			count--;
+		}
+		if (apply) {
+			// if we were missing sprites we can't create, ack nothing so the sender
+			// starts over from no baseline and sends create records for everything
+			mLastSnapshotId = (missingSprites) ? 0 : snapshotId;
+		}
+	} else if ( (mSerFlags == ser_Micro) || (mSerFlags == ser_Positions) ) {
 		SERIALIZATION_DEBUG_ONLY( DEBUG_PRINT("SpriteLayer [%p] reading Micro update", this); )
 		// special case, smallest possible update, basically just the sprites
 		// get and write the count
@@ -495,6 +830,7 @@ void SpriteLayer::deserialize(IDeserializer* deserializer) {
 
 	}
 	mSerFlags = oldSerFlags;
+	mSerStreamVers = PDG_SPRITE_LAYER_STREAM_VERSION;
 }
 
 // start and stop animating all sprites
@@ -543,24 +879,28 @@ void	SpriteLayer::fadeOut(ms_delta msDuration, EasingFunc easing) {
 // arrange layers
 void	SpriteLayer::moveBehind( SpriteLayer* inLayer) {
 	SpriteLayer* layer = inLayer;
-	SpriteManager::getSingletonInstance()->removeLayer(this);
+	World* world = mWorld;
+	if (!world) return;
+	if (layer && (layer->mWorld != world)) return;  // can only arrange layers within a world
+	world->removeLayer(this);
+	mWorld = world;
 	if (layer == 0) {
 		// behind everything = in front of list
-		layer = SpriteManager::getSingletonInstance()->mFirstLayer;
+		layer = world->mFirstLayer;
 	}
 	// update the layer before to point to us
 	if (layer && layer->mPrevLayer) {
 		layer->mPrevLayer->mNextLayer = this;
 		this->mPrevLayer = layer->mPrevLayer;
 	} else {
-		SpriteManager::getSingletonInstance()->mFirstLayer = this;
+		world->mFirstLayer = this;
 		this->mPrevLayer = 0;
 	}
 	// update the layer after to point to us
 	if (layer) {
 		layer->mPrevLayer = this;
 	} else {
-		SpriteManager::getSingletonInstance()->mLastLayer = this;
+		world->mLastLayer = this;
 	}
 	mNextLayer = layer;
 }
@@ -568,30 +908,35 @@ void	SpriteLayer::moveBehind( SpriteLayer* inLayer) {
 
 void	SpriteLayer::moveInFrontOf( SpriteLayer* inLayer) {
 	SpriteLayer* layer = inLayer;
-	SpriteManager::getSingletonInstance()->removeLayer(this);
+	World* world = mWorld;
+	if (!world) return;
+	if (layer && (layer->mWorld != world)) return;  // can only arrange layers within a world
+	world->removeLayer(this);
+	mWorld = world;
 	if (layer == 0) {
 		// put after last layer
-		layer = SpriteManager::getSingletonInstance()->mLastLayer;
+		layer = world->mLastLayer;
 	}
 	// update the layer after to point to us
 	if (layer && layer->mNextLayer) {
 		layer->mNextLayer->mPrevLayer = this;
 		this->mNextLayer = layer->mNextLayer;
 	} else {
-		SpriteManager::getSingletonInstance()->mLastLayer = this;
+		world->mLastLayer = this;
 		this->mNextLayer = 0;
 	}
 	// update the layer before to point to us
 	if (layer) {
 		layer->mNextLayer = this;
 	} else {
-		SpriteManager::getSingletonInstance()->mFirstLayer = this;
+		world->mFirstLayer = this;
 	}
 }
 
 int SpriteLayer::getZOrder() {
 	int z = 0;
-	SpriteLayer* layer = SpriteManager::getSingletonInstance()->mFirstLayer;
+	if (!mWorld) return -1;
+	SpriteLayer* layer = mWorld->mFirstLayer;
 	while (layer) {
 		if (layer == this) {
 			return z;
@@ -600,7 +945,7 @@ int SpriteLayer::getZOrder() {
 			layer = layer->mNextLayer;
 		}
 	}
-	return -1; // this shouldn't ever happen, all layers should be in the SpriteManager
+	return -1; // this shouldn't ever happen, all layers should be in a World
 }
 
 void	SpriteLayer::moveWith(SpriteLayer* layer, float moveRatio, float zoomRatio) {
@@ -620,7 +965,16 @@ void	SpriteLayer::moveWith(SpriteLayer* layer, float moveRatio, float zoomRatio)
 
 // find a sprite in the layer by id. Be sure to addRef() the sprite if you hang onto the reference
 Sprite*	SpriteLayer::findSprite(long id) {
-	Sprite* sprite = mFirstSprite;
+	int matches = 0;
+	Sprite* sprite = mSpriteIndex->findById(id, matches);
+	if (matches == 1) {
+		return sprite;
+	} else if ((matches == 0) && (id != 0)) {
+		return 0;
+	}
+	// ids aren't unique (and every sprite starts with id 0), so when there is more than one
+	// we have to look through the layer for the one furthest back
+	sprite = mFirstSprite;
 	while (sprite) {
 		if (sprite->spriteId == id) {
 			return sprite;
@@ -632,45 +986,50 @@ Sprite*	SpriteLayer::findSprite(long id) {
 
 // find a sprite in the layer by internal id (PROTECTED)
 Sprite*	SpriteLayer::findSpriteByInternalId(uint32 iid) const {
+	return mSpriteIndex->findByInternalId(iid);
+}
+
+// refile a sprite whose id has changed
+void SpriteLayer::updateSpriteIndex(Sprite* sprite) {
+	if (!sprite || (sprite->mLayer != this)) return;
+	mSpriteIndex->update(sprite);
+}
+
+// PROTECTED: renumber the sprites if the z-order has changed since the last time
+void SpriteLayer::updateZOrder() {
+	if (mZOrderValid) return;
+	mZOrder.clear();
 	Sprite* sprite = mFirstSprite;
 	while (sprite) {
-		if (sprite->iid == iid) {
-			return sprite;
-		}
+		sprite->mZIndex = (int)mZOrder.size();
+		mZOrder.push_back(sprite);
 		sprite = sprite->mNextSprite;
 	}
-	return 0;
+	mZOrderValid = true;
 }
 
 // get the nth sprite in the layer by z-order, 0 is the one furthest back
 Sprite* SpriteLayer::getNthSprite(int index) {
 	if (index < 0) return 0;
-	Sprite* sprite = mFirstSprite;
-	while (sprite && index) {
-		sprite = sprite->mNextSprite;
-		index--;
-	}
-	return sprite;
+	updateZOrder();
+	if (index >= (int)mZOrder.size()) return 0;
+	return mZOrder[index];
 }
 
 // z-order 0 is furthest back, increment from there
 // return -1 if not in this layer
 int SpriteLayer::getSpriteZOrder(Sprite* sprite) {
-	int z = 0;
-	Sprite* s = mFirstSprite;
-	while (s) {
-		if (s == sprite) {
-			return z;
-		} else {
-			z++;
-			s = s->mNextSprite;
-		}
-	}
-	return -1;
+	if (!sprite || (sprite->mLayer != this)) return -1;
+	updateZOrder();
+	return sprite->mZIndex;
 }
 
 // does otherSprite have higher z-order than sprite?
 bool SpriteLayer::isSpriteBehind(Sprite* sprite, Sprite* otherSprite) {
+	if (sprite && otherSprite && (sprite->mLayer == this) && (otherSprite->mLayer == this)) {
+		updateZOrder();
+		return (sprite->mZIndex < otherSprite->mZIndex);
+	}
 	while (sprite) {
 		if (sprite->mNextSprite == otherSprite) {
 			return true;
@@ -683,16 +1042,102 @@ bool SpriteLayer::isSpriteBehind(Sprite* sprite, Sprite* otherSprite) {
 
 // see if a sprite is in this layer
 bool SpriteLayer::hasSprite(Sprite* inSprite) {
+	return (inSprite && (inSprite->mLayer == this));
+}
+	
+// copy a sprite's state into the spriteState_Size floats at state
+static void getSpriteState(Sprite* sprite, float* state) {
+	Point loc = sprite->getLocation();
+	Vector velocity = sprite->getVelocity();
+	state[spriteState_X] = loc.x;
+	state[spriteState_Y] = loc.y;
+	state[spriteState_VelocityX] = velocity.x;
+	state[spriteState_VelocityY] = velocity.y;
+	state[spriteState_Facing] = sprite->getRotation();
+	state[spriteState_Frame] = (float)sprite->getCurrentFrame();
+}
+
+// apply the spriteState_Size floats at state to a sprite. Fields that are NaN or haven't
+// changed are skipped, so a sprite isn't marked as changed for serialization for nothing
+static void setSpriteState(Sprite* sprite, const float* state) {
+	Point loc = sprite->getLocation();
+	Point newLoc = loc;
+	if (state[spriteState_X] == state[spriteState_X]) newLoc.x = state[spriteState_X];
+	if (state[spriteState_Y] == state[spriteState_Y]) newLoc.y = state[spriteState_Y];
+	if (newLoc != loc) {
+		sprite->setLocation(newLoc);
+	}
+	Vector velocity = sprite->getVelocity();
+	Vector newVelocity = velocity;
+	if (state[spriteState_VelocityX] == state[spriteState_VelocityX]) newVelocity.x = state[spriteState_VelocityX];
+	if (state[spriteState_VelocityY] == state[spriteState_VelocityY]) newVelocity.y = state[spriteState_VelocityY];
+	if (newVelocity != velocity) {
+		sprite->setVelocity(newVelocity);
+	}
+	float facing = state[spriteState_Facing];
+	if ((facing == facing) && (facing != sprite->getRotation())) {
+		sprite->setRotation(facing);
+	}
+	float frame = state[spriteState_Frame];
+	if ((frame == frame) && (frame >= 0) && ((int)frame != sprite->getCurrentFrame())) {
+		sprite->setFrame((int)frame);
+	}
+}
+
+uint32 SpriteLayer::getSpriteStates(float* outStates, uint32 maxSprites, uint32* outIids) {
+	uint32 count = 0;
 	Sprite* sprite = mFirstSprite;
-	while (sprite) {
-		if (inSprite == sprite) {
-			return true;
+	while (sprite && (count < maxSprites)) {
+		getSpriteState(sprite, &outStates[count * spriteState_Size]);
+		if (outIids) {
+			outIids[count] = sprite->iid;
 		}
+		count++;
 		sprite = sprite->mNextSprite;
 	}
-	return false;
+	return count;
 }
-	
+
+uint32 SpriteLayer::getSpriteStates(const uint32* iids, uint32 numIids, float* outStates) {
+	uint32 count = 0;
+	for (uint32 i = 0; i < numIids; i++) {
+		float* state = &outStates[i * spriteState_Size];
+		Sprite* sprite = findSpriteByInternalId(iids[i]);
+		if (sprite) {
+			getSpriteState(sprite, state);
+			count++;
+		} else {
+			for (int j = 0; j < spriteState_Size; j++) {
+				state[j] = std::numeric_limits<float>::quiet_NaN();
+			}
+		}
+	}
+	return count;
+}
+
+uint32 SpriteLayer::setSpriteStates(const float* states, uint32 numSprites) {
+	uint32 count = 0;
+	Sprite* sprite = mFirstSprite;
+	while (sprite && (count < numSprites)) {
+		setSpriteState(sprite, &states[count * spriteState_Size]);
+		count++;
+		sprite = sprite->mNextSprite;
+	}
+	return count;
+}
+
+uint32 SpriteLayer::setSpriteStates(const uint32* iids, uint32 numIids, const float* states) {
+	uint32 count = 0;
+	for (uint32 i = 0; i < numIids; i++) {
+		Sprite* sprite = findSpriteByInternalId(iids[i]);
+		if (sprite) {
+			setSpriteState(sprite, &states[i * spriteState_Size]);
+			count++;
+		}
+	}
+	return count;
+}
+
 // add a sprite to the end of the doubly-linked list, which makes it draw last
 // in front of everything else
 void	SpriteLayer::addSprite(Sprite* newSprite) {
@@ -708,8 +1153,18 @@ void	SpriteLayer::addSprite(Sprite* newSprite) {
 		mLastSprite->mNextSprite = sprite;
 	}
 	mLastSprite = sprite;
+	if (mZOrderValid) {
+		// adding to the end doesn't change anyone else's z-order
+		sprite->mZIndex = (int)mZOrder.size();
+		mZOrder.push_back(sprite);
+	}
 	sprite->mLayer = this;  // sprite now belongs to us
 	sprite->addRef();
+	mSpriteIndex->insert(sprite);
+	sprite->mDirtyFields = Sprite::dirty_All;  // everything is new to clients tracking this layer
+	if (mCollisionGrid) {
+		mCollisionGrid->insert(sprite);
+	}
   #ifdef PDG_USE_CHIPMUNK_PHYSICS
     if (mUseChipmunkPhysics) {
 		sprite->initCpBody();
@@ -723,6 +1178,34 @@ void	SpriteLayer::addSprite(Sprite* newSprite) {
 
 // PROTECTED: swap z order of 2 sprites that are known to be in the same layer
 void SpriteLayer::quickSwapSprites(Sprite* s1, Sprite* s2) {
+	if (s1 == s2) return;
+	if (mZOrderValid) {
+		std::swap(mZOrder[s1->mZIndex], mZOrder[s2->mZIndex]);
+		std::swap(s1->mZIndex, s2->mZIndex);
+	}
+	if (s2->mNextSprite == s1) {
+		std::swap(s1, s2);
+	}
+	if (s1->mNextSprite == s2) {
+		// neighbors, the general case below would link s2 to itself
+		Sprite* before = s1->mPrevSprite;
+		Sprite* after = s2->mNextSprite;
+		s2->mPrevSprite = before;
+		s2->mNextSprite = s1;
+		s1->mPrevSprite = s2;
+		s1->mNextSprite = after;
+		if (before) {
+			before->mNextSprite = s2;
+		} else {
+			mFirstSprite = s2;
+		}
+		if (after) {
+			after->mPrevSprite = s1;
+		} else {
+			mLastSprite = s1;
+		}
+		return;
+	}
 	Sprite* tmp = s1->mNextSprite;
 	s1->mNextSprite = s2->mNextSprite;
 	s2->mNextSprite = tmp;
@@ -782,8 +1265,14 @@ void	SpriteLayer::addSpriteInFrontOf(Sprite* newSprite, Sprite* targetSprite) {
 		// set target sprite
 		targetSprite->mNextSprite = sprite;
 	}
+	invalidateZOrder();
 	sprite->mLayer = this;  // sprite now belongs to us
 	sprite->addRef();
+	mSpriteIndex->insert(sprite);
+	sprite->mDirtyFields = Sprite::dirty_All;  // everything is new to clients tracking this layer
+	if (mCollisionGrid) {
+		mCollisionGrid->insert(sprite);
+	}
   #ifdef PDG_USE_CHIPMUNK_PHYSICS
     if (mUseChipmunkPhysics) {
 		sprite->initCpBody();
@@ -801,6 +1290,12 @@ void	SpriteLayer::removeSprite(Sprite* oldSprite) {
 	Sprite* sprite = oldSprite;
 	if (!sprite) return;
 	if (sprite->mLayer != this) return; // don't remove the sprite unless it belongs to this layer
+	if (mZOrderValid && (sprite == mLastSprite)) {
+		mZOrder.pop_back();
+	} else {
+		invalidateZOrder();
+	}
+	mSpriteIndex->remove(sprite);
 	// update our first and last layers
 	if (sprite == mFirstSprite) {
 		mFirstSprite = sprite->mNextSprite;
@@ -818,6 +1313,28 @@ void	SpriteLayer::removeSprite(Sprite* oldSprite) {
 	// finally, clear out prev and next sprites
 	sprite->mNextSprite = 0;
 	sprite->mPrevSprite = 0;
+	if (mCollisionGrid) {
+		mCollisionGrid->remove(sprite);
+	}
+	if (mSnapshotId != 0) {
+		// snapshots are being taken, so clients will need to hear about this in the next delta
+		RemovedSpriteT removed;
+		removed.iid = sprite->iid;
+		removed.snapshotId = mSnapshotId + 1;
+		mRemovedSprites.push_back(removed);
+		// observers that could see it send the removal too, but it doesn't get an exit event
+		for (size_t i = 0; i < mObservers.size(); i++) {
+			ObserverT* observer = mObservers[i];
+			ObservedSpriteT key;
+			key.iid = sprite->iid;
+			std::vector<ObservedSpriteT>::iterator it = std::lower_bound(observer->visible.begin(), observer->visible.end(), key);
+			if ((it != observer->visible.end()) && (it->iid == sprite->iid)) {
+				it->sprite->release();  // can't be the last reference, we still hold one
+				observer->visible.erase(it);
+				observer->left.push_back(removed);
+			}
+		}
+	}
 	sprite->mLayer = 0; // we are no longer in a layer
 	SPRITELAYER_DEBUG_ONLY( DEBUG_PRINT("Removed Sprite [%p] from layer [%p]", sprite, this); )
 	sprite->release();
@@ -987,29 +1504,32 @@ void    SpriteLayer::collide(ms_delta msElapsed, SpriteLayer* withLayer, bool de
   #endif
     // if we are using chipmunk physics it handles detecting collisions and we just
     // get callbacks to SpriteManager
+	CollisionGrid* grid = withLayer->mCollisionGrid;
+	float dt = ((float)msElapsed) / 1000.0f;
 	Sprite* sprite = mFirstSprite;
 	while (sprite) {
 		Sprite* next = sprite->mNextSprite;
 	    sprite->addRef(); // make sure this won't be deleted by being removed from the layer while we are working with it
-		if (sprite->mDoCollisions) {
+		if (sprite->mDoCollisions && grid) {
+			// broad phase: only check the sprites in the other layer whose bounds overlap ours. The handlers
+			// can remove sprites or query the grid again, so work from our own retained copy of the results
+			std::vector<Sprite*> candidates(grid->query(sprite->getCollisionBounds()));
+			for (size_t i = 0; i < candidates.size(); i++) {
+				candidates[i]->addRef();
+			}
+			for (size_t i = 0; (i < candidates.size()) && (sprite->mLayer == this); i++) {
+				if (candidates[i]->mLayer == withLayer) {
+					sprite->collideWithSprite(candidates[i], dt, !deferEvents);
+				}
+			}
+			for (size_t i = 0; i < candidates.size(); i++) {
+				candidates[i]->release();
+			}
+		} else if (sprite->mDoCollisions) {
 			Sprite* otherSprite = withLayer->mFirstSprite;
-			while (otherSprite) {
+			while (otherSprite && (sprite->mLayer == this)) {
 				Sprite* nextOther = otherSprite->mNextSprite;
-				if (otherSprite->mDoCollisions) {
-					if (sprite->collidesWith(otherSprite)) {
-                        Vector normal;
-                        Vector impulse;
-                        float kineticEnergy;
-                        sprite->impartCollisionImpulse(otherSprite, normal, impulse, kineticEnergy);
-                        float dt = ((float)msElapsed) / 1000.0f;
-                        float force = impulse.vectorLength() / dt;
-						notifyCollisionAction(Sprite::action_CollideSprite, sprite, normal, impulse, force, kineticEnergy, 
-									  #ifdef PDG_USE_CHIPMUNK_PHYSICS
-										0, // need something for the cpArbiter param
-									  #endif // PDG_USE_CHIPMUNK_PHYSICS							
-										otherSprite, !deferEvents);
-					}
-				}
+				sprite->collideWithSprite(otherSprite, dt, !deferEvents);
 				otherSprite = nextOther;
 			}
 		}
@@ -1091,6 +1611,15 @@ SpriteLayer::animateLayer(ms_delta msElapsed) {
     }
 }
 
+bool
+SpriteLayer::postEvent(long inEventType, void* inEventData, EventEmitter* fromEmitter) {
+	if (mWorld && mWorld->mDeferEvents) {
+		// not on the main thread, so the handlers will get it once the tick is done
+		return mWorld->deferEvent(this, inEventType, inEventData);
+	}
+	return EventEmitter::postEvent(inEventType, inEventData, fromEmitter);
+}
+
 void
 SpriteLayer::locationChanged(const Offset& delta) {
   #ifndef PDG_NO_GUI
@@ -1187,12 +1716,30 @@ void SpriteLayer::notifyAnimationAction(int action, Sprite* actingSprite, bool s
 			actingSprite->addRef();
 		}
 		EventManager::getSingletonInstance()->enqueueEvent(eventType_SpriteAnimate, 
-			UserData::makeUserDataViaCopy(&si, sizeof(SpriteAnimateInfo), &SpriteAnimateInfo_ReleaseSprites),
+			UserData::makeUserDataViaPooledCopy(&si, sizeof(SpriteAnimateInfo), &SpriteAnimateInfo_ReleaseSprites),
 			actingSprite);
 	}
   #endif
 }
 
+void SpriteLayer::notifyObserverAction(int action, Sprite* actingSprite, uint32 observerId) {
+	SpriteObserverInfo si;
+	si.action = action;
+	si.actingSprite = actingSprite;
+	si.inLayer = this;
+	si.observerId = observerId;
+	SPRITELAYER_DEBUG_ONLY( DEBUG_PRINT("Sprite [%p] -> observer %d event %d", actingSprite, observerId, action); )
+  #ifndef PDG_NO_EVENT_QUEUE
+	// always deferred, since this happens in the middle of takeSnapshot()
+	actingSprite->addRef();
+	EventManager::getSingletonInstance()->enqueueEvent(eventType_SpriteAnimate,
+		UserData::makeUserDataViaPooledCopy(&si, sizeof(SpriteObserverInfo), &SpriteAnimateInfo_ReleaseSprites),
+		actingSprite);
+  #else
+	actingSprite->postEvent(eventType_SpriteAnimate, &si);
+  #endif
+}
+
 void SpriteLayer::notifyCollisionAction(int action, Sprite* actingSprite, Vector normal, Vector impulse, float force, float kineticEnergy, 
                                     #ifdef PDG_USE_CHIPMUNK_PHYSICS
                                         cpArbiter* arbiter,
@@ -1227,7 +1774,7 @@ void SpriteLayer::notifyCollisionAction(int action, Sprite* actingSprite, Vector
 			targetSprite->addRef();
 		}
 		EventManager::getSingletonInstance()->enqueueEvent(eventType_SpriteCollide, 
-			UserData::makeUserDataViaCopy(&si, sizeof(SpriteCollideInfo), &SpriteCollideInfo_ReleaseSprites),
+			UserData::makeUserDataViaPooledCopy(&si, sizeof(SpriteCollideInfo), &SpriteCollideInfo_ReleaseSprites),
 			actingSprite);
 	}
   #endif
@@ -1246,6 +1793,26 @@ SpriteLayer::disableCollisionsWithLayer(SpriteLayer* otherLayer) {
     }
 }
 
+void
+SpriteLayer::enableCollisionGrid(float cellSize) {
+	if (mCollisionGrid) {
+		if (mCollisionGrid->getCellSize() == cellSize) return;
+		delete mCollisionGrid;
+	}
+	mCollisionGrid = new CollisionGrid(cellSize);
+	Sprite* sprite = mFirstSprite;
+	while (sprite) {
+		mCollisionGrid->insert(sprite);
+		sprite = sprite->mNextSprite;
+	}
+}
+
+void
+SpriteLayer::disableCollisionGrid() {
+	delete mCollisionGrid;
+	mCollisionGrid = 0;
+}
+
 // create sprites
 Sprite* SpriteLayer::createSprite() {
 	Sprite* sprite = new Sprite();
@@ -1254,11 +1821,34 @@ Sprite* SpriteLayer::createSprite() {
 }
 
 
+// the clone shares the original's frame table until one of them changes its frames
+// SCML entities are not copied, so cloning an SCML sprite gives one with no entity
 Sprite* SpriteLayer::cloneSprite(const Sprite* originalSprite) {
-//	Sprite* sprite =  new Sprite(originalSprite);
-//	addSprite(sprite);
-//	return sprite;
-    return 0;
+	if (!originalSprite) return 0;
+	Sprite* sprite = new Sprite();
+	sprite->copyFrom(originalSprite);
+	addSprite(sprite);
+  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+	if (mUseChipmunkPhysics) {
+		// addSprite() just created the body, so bring it up to date with what we copied
+		sprite->locationChanged(Offset());
+		sprite->sizeChanged(0, 0);
+		sprite->rotationChanged(0);
+		sprite->setVelocity(sprite->Animated::getVelocity());
+	}
+  #endif
+	if (originalSprite->mDoCollisions) {
+		sprite->enableCollisions(originalSprite->mDoCollisions);
+	}
+  #ifndef PDG_NO_GUI
+	if (originalSprite->wantsClicks) {
+		sprite->setWantsClickEvents(true);
+	}
+	if (originalSprite->wantsMouseOver) {
+		sprite->setWantsMouseOverEvents(true);
+	}
+  #endif // ! PDG_NO_GUI
+	return sprite;
 }
 
 #ifdef PDG_SCML_SUPPORT
@@ -1365,8 +1955,13 @@ Sprite* SpriteLayer::createSpriteFromSCMLEntity(const char* inEntityName) {
 #ifdef PDG_USE_CHIPMUNK_PHYSICS
 cpSpace*
 SpriteLayer::getSpace() {
-	if (!mUseChipmunkPhysics) return 0;
-    return SpriteManager::getSingletonInstance()->mSpace;
+	if (!mUseChipmunkPhysics || !mWorld) return 0;
+    return mWorld->mSpace;
+}
+
+void
+SpriteLayer::leavingWorldSpace() {
+	// nothing to do, our sprites take their own bodies and shapes with them
 }
 
 void
@@ -1392,6 +1987,41 @@ SpriteLayer::setDamping(float damping) {
 	if (!mUseChipmunkPhysics) return;
     cpSpaceSetDamping(getSpace(), damping);
 }
+
+void
+SpriteLayer::setPhysicsThreads(uint32 numThreads) {
+    if (mWorld) mWorld->setPhysicsThreads(numThreads);
+}
+
+uint32
+SpriteLayer::getPhysicsThreads() {
+    return mWorld ? mWorld->getPhysicsThreads() : 1;
+}
+
+float
+SpriteLayer::getPhysicsStepTime() {
+    return mWorld ? mWorld->mPhysicsStepMs : 0.0f;
+}
+
+void
+SpriteLayer::setFixedPhysicsStep(float stepMs, uint32 maxStepsPerTick) {
+    if (mWorld) mWorld->setFixedPhysicsStep(stepMs, maxStepsPerTick);
+}
+
+float
+SpriteLayer::getFixedPhysicsStep() {
+    return mWorld ? mWorld->mFixedPhysicsStepMs : 0.0f;
+}
+
+void
+SpriteLayer::setPhysicsInterpolation(bool interpolate) {
+    if (mWorld) mWorld->mInterpolatePhysics = interpolate;
+}
+
+float
+SpriteLayer::getPhysicsAlpha() {
+    return mWorld ? mWorld->mPhysicsAlpha : 0.0f;
+}
 #endif // PDG_USE_CHIPMUNK_PHYSICS
 
 void	
@@ -1421,16 +2051,18 @@ SpriteLayer::SpriteLayer(Port* port):
   #ifdef PDG_USE_CHIPMUNK_PHYSICS
     mGravity(0.0), mKeepGravityDownward(false), mUseChipmunkPhysics(false), mIsStaticLayer(false),
   #endif
-	mNextLayer(0), mPrevLayer(0), mFirstSprite(0), mLastSprite(0),
-	mControlledBy(0),
+	mWorld(0), mNextLayer(0), mPrevLayer(0), mFirstSprite(0), mLastSprite(0),
+	mCollisionGrid(0), mSpriteIndex(new SpriteIndex), mZOrderValid(true), mControlledBy(0),
 	mFacingCos(1.0), mFacingSin(0.0),
-	mSerFlags(ser_Full),
-	iid(sUniqueLayerId++)
+	mSerFlags(ser_Full), mSerStreamVers(PDG_SPRITE_LAYER_STREAM_VERSION),
+	mSnapshotId(0), mSerBaseline(0), mLastSnapshotId(0),
+	mNextObserverId(1), mSerObserver(0),
+	iid(PDG_ATOMIC_INC(&sUniqueLayerId) - 1)
 {
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 	INIT_SCRIPT_OBJECT(mSpriteLayerScriptObj);
 #endif
-    layerId = gNextLayerId++;
+    layerId = PDG_ATOMIC_INC(&gNextLayerId) - 1;
 }
 #endif // ! PDG_NO_GUI
 
@@ -1448,20 +2080,31 @@ SpriteLayer::SpriteLayer():
   #ifdef PDG_USE_CHIPMUNK_PHYSICS
     mGravity(0.0), mKeepGravityDownward(false), mUseChipmunkPhysics(false), mIsStaticLayer(false),
   #endif
-	mNextLayer(0), mPrevLayer(0), mFirstSprite(0), mLastSprite(0),
-	mControlledBy(0),
+	mWorld(0), mNextLayer(0), mPrevLayer(0), mFirstSprite(0), mLastSprite(0),
+	mCollisionGrid(0), mSpriteIndex(new SpriteIndex), mZOrderValid(true), mControlledBy(0),
 	mFacingCos(1.0), mFacingSin(0.0),
-	mSerFlags(ser_Full),
-	iid(sUniqueLayerId++)
+	mSerFlags(ser_Full), mSerStreamVers(PDG_SPRITE_LAYER_STREAM_VERSION),
+	mSnapshotId(0), mSerBaseline(0), mLastSnapshotId(0),
+	mNextObserverId(1), mSerObserver(0),
+	iid(PDG_ATOMIC_INC(&sUniqueLayerId) - 1)
 {
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 	INIT_SCRIPT_OBJECT(mSpriteLayerScriptObj);
 #endif
-    layerId = gNextLayerId++;
+    layerId = PDG_ATOMIC_INC(&gNextLayerId) - 1;
 }
 
 SpriteLayer::~SpriteLayer() {
 	SPRITELAYER_DEBUG_ONLY( OS::_DOUT("dt SpriteLayer %p", this); )
+	IDeserializer::unregisterObject(this);  // in case it was registered for serialize_ref()
+	for (size_t i = 0; i < mObservers.size(); i++) {
+		delete mObservers[i];
+	}
+	mObservers.clear();
+	delete mCollisionGrid;
+	mCollisionGrid = 0;
+	delete mSpriteIndex;
+	mSpriteIndex = 0;
 	Sprite* sprite = mFirstSprite;
 	while (sprite) {
 		Sprite* next = sprite->mNextSprite;
@@ -1476,7 +2119,13 @@ SpriteLayer::~SpriteLayer() {
 		delete scmlData;
 	}
   #endif // PDG_SCML_SUPPORT
-	SpriteManager::getSingletonInstance()->removeLayer(this);
+	if (mWorld) {
+		mWorld->removeLayer(this);
+	}
+	if (SpriteManager::hasInstance()) {
+		// don't deliver anything a threaded world posted for us once we're gone
+		SpriteManager::getSingletonInstance()->discardEventsForLayer(this);
+	}
   #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 	CleanupSpriteLayerScriptObject(mSpriteLayerScriptObj);
   #endif
@@ -1486,14 +2135,14 @@ SpriteLayer::~SpriteLayer() {
 SpriteLayer* createSpriteLayer(Port* port) {
 	// create sprite manager singleton instance if necessary
 	SpriteLayer* layer = SpriteManager::createSpriteLayer(port);
-	SpriteManager::getSingletonInstance()->addLayer(layer);
+	getDefaultWorld()->addLayer(layer);
 	return layer;
 }
 #else
 SpriteLayer* createSpriteLayer() {
 	// create sprite manager singleton instance if necessary
 	SpriteLayer* layer = SpriteManager::createSpriteLayer();
-	SpriteManager::getSingletonInstance()->addLayer(layer);
+	getDefaultWorld()->addLayer(layer);
 	return layer;
 }
 #endif // ! PDG_NO_GUI
@@ -1502,7 +2151,7 @@ SpriteLayer* createSpriteLayer() {
 SpriteLayer* createSpriteLayerFromSCMLFile(const char* layerSCMLFile, bool addSprites, Port* port) {
 	// create sprite manager singleton instance if necessary
 	SpriteLayer* layer = SpriteManager::createSpriteLayer(port);
-	SpriteManager::getSingletonInstance()->addLayer(layer);
+	getDefaultWorld()->addLayer(layer);
 	std::string fullPath;
 	if (layerSCMLFile[0] == '/') {
 		fullPath = layerSCMLFile;
@@ -1524,7 +2173,7 @@ SpriteLayer* createSpriteLayerFromSCMLFile(const char* layerSCMLFile, bool addSp
 SpriteLayer* createSpriteLayerFromSCMLFile(const char* layerSCMLFile, bool addSprites) {
 	// create sprite manager singleton instance if necessary
 	SpriteLayer* layer = SpriteManager::createSpriteLayer();
-	SpriteManager::getSingletonInstance()->addLayer(layer);
+	getDefaultWorld()->addLayer(layer);
 	std::string fullPath;
 	if (layerSCMLFile[0] == '/') {
 		fullPath = layerSCMLFile;
@@ -1547,17 +2196,25 @@ SpriteLayer* createSpriteLayerFromSCMLFile(const char* layerSCMLFile, bool addSp
 void cleanupSpriteLayer(SpriteLayer* layer) {
 	SPRITELAYER_DEBUG_ONLY( OS::_DOUT("cleanupSpriteLayer %p", layer); )
 	if (layer) {
-		SpriteManager::getSingletonInstance()->removeLayer(layer);
+		if (layer->mWorld) {
+			layer->mWorld->removeLayer(layer);
+		}
 		SpriteManager::cleanupLayer(layer);
 	}
 }
 
 SpriteLayer* SpriteLayer::getLayer(long id) {
-	SpriteLayer* layer = SpriteManager::getSingletonInstance()->mFirstLayer;
-	while (layer && (id != layer->layerId)) {
-		layer = layer->mNextLayer;
+	std::vector<World*>& worlds = SpriteManager::getSingletonInstance()->mWorlds;
+	for (std::vector<World*>::iterator itr = worlds.begin(); itr != worlds.end(); itr++) {
+		SpriteLayer* layer = (*itr)->mFirstLayer;
+		while (layer && (id != layer->layerId)) {
+			layer = layer->mNextLayer;
+		}
+		if (layer) {
+			return layer;
+		}
 	}
-	return layer;
+	return 0;
 }
 
 	
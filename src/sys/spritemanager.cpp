@@ -33,6 +33,7 @@
 #include "pdg/sys/sprite.h"
 #include "pdg/sys/spritelayer.h"
 #include "pdg/sys/tilelayer.h"
+#include "pdg/sys/world.h"
 #include "pdg/sys/os.h"
 
 #ifndef PDG_NO_GUI
@@ -40,10 +41,13 @@
 #endif
 
 #include "spritemanager.h"
+#include "worldthreads.h"
 
+#include <cmath>
 
-#define SPRITE_LAYER_TIMER_ID -1234031
-#define SPRITE_TIMER_INTERVAL_MS 10  // 100 fps for sprite animation
+
+
+#define SPRITE_TIMER_INTERVAL_MS WORLD_DEFAULT_TICK_INTERVAL_MS
 
 //#define SPRITE_IGNORE_ANIMATION_TIMER_DRIFT
 
@@ -153,45 +157,41 @@ SpriteManager::cleanupLayer(SpriteLayer* layer) {
     delete layer;
 }
 
-// add a layer to the end
-void SpriteManager::addLayer(SpriteLayer* layer) {
-	if (!layer) return;
-	layer->mNextLayer = 0;
-	if (mFirstLayer == 0) {
-		mFirstLayer = layer;
-		layer->mPrevLayer = 0;
-	} else {
-		layer->mPrevLayer = mLastLayer;
-		mLastLayer->mNextLayer = layer;
-	}
-	mLastLayer = layer;  // we are always the new last layer
+World*
+SpriteManager::createWorld(ms_delta tickIntervalMs) {
+	World* world = new World(tickIntervalMs);
+	mWorlds.push_back(world);
+	return world;
 }
 
-void SpriteManager::removeLayer(SpriteLayer* layer) {
-	// update our first and last layers
-	if (layer == mFirstLayer) {
-		mFirstLayer = layer->mNextLayer;
-	}
-	if (layer == mLastLayer) {
-		mLastLayer = layer->mPrevLayer;
+void
+SpriteManager::cleanupWorld(World* world) {
+	if (!world || (world == mDefaultWorld)) return;
+	for (std::vector<World*>::iterator itr = mWorlds.begin(); itr != mWorlds.end(); itr++) {
+		if (*itr == world) {
+			mWorlds.erase(itr);
+			break;
+		}
 	}
-	// now update the previous and next layers to point to one another
-	if (layer->mPrevLayer) {
-		layer->mPrevLayer->mNextLayer = layer->mNextLayer;
+	for (std::vector<World*>::iterator itr = mDueWorlds.begin(); itr != mDueWorlds.end(); itr++) {
+		if (*itr == world) {
+			mDueWorlds.erase(itr);
+			break;
+		}
 	}
-	if (layer->mNextLayer) {
-		layer->mNextLayer->mPrevLayer = layer->mPrevLayer;
+	while (world->mFirstLayer) {
+		// the layer takes itself out of the world as it goes
+		cleanupLayer(world->mFirstLayer);
 	}
-	// finally clear our prev and next layers
-	layer->mNextLayer = 0;
-	layer->mPrevLayer = 0;
+	delete world;
 }
 
 SpriteManager::SpriteManager(EventManager* eventMgr, TimerManager* timerMgr): 
 	mEventMgr(eventMgr), 
 	mTimerMgr(timerMgr),
-	mFirstLayer(0),
-	mLastLayer(0)
+	mDefaultWorld(0),
+	mWorldThreads(new WorldThreadPool()),
+	mDeliveringEvents(0)
 {	
 	// for now we need these
 	DEBUG_ASSERT(mEventMgr, "must have a pdg::EventManager");
@@ -202,103 +202,78 @@ SpriteManager::SpriteManager(EventManager* eventMgr, TimerManager* timerMgr):
 	eventMgr->addHandler(this, eventType_MouseDown);
 	eventMgr->addHandler(this, eventType_MouseUp);
 	eventMgr->addHandler(this, eventType_MouseMove);
-	
-	timerMgr->startTimer(SPRITE_LAYER_TIMER_ID, SPRITE_TIMER_INTERVAL_MS,
-						 timer_Repeating, UserData::makeUserDataFromPointer(this, data_DoNothing) );
-#ifdef PDG_USE_CHIPMUNK_PHYSICS
-    mSpace = cpSpaceNew();
-    cpCollisionHandler* spriteToSpriteHdlr = cpSpaceAddCollisionHandler(mSpace, CP_COLLIDE_TYPE_SPRITE, CP_COLLIDE_TYPE_SPRITE);
-    spriteToSpriteHdlr->beginFunc = ChipmunkSpriteCollisionBeginFunc;
-    spriteToSpriteHdlr->postSolveFunc = ChipmunkSpriteCollisionPostSolveFunc;
-
-    cpCollisionHandler* spriteToWallHdlr = cpSpaceAddCollisionHandler(mSpace, CP_COLLIDE_TYPE_SPRITE, CP_COLLIDE_TYPE_WALL);
-    spriteToWallHdlr->beginFunc = ChipmunkWallCollisionBeginFunc;
-    spriteToWallHdlr->postSolveFunc = ChipmunkWallCollisionPostSolveFunc;
-#endif
-    
+
+	// worlds start their own timers once they have layers to animate
+	mDefaultWorld = createWorld(SPRITE_TIMER_INTERVAL_MS);
 }
 
 SpriteManager::~SpriteManager() {
-#ifdef PDG_USE_CHIPMUNK_PHYSICS
-    cpSpaceFree(mSpace);
-    mSpace = 0;
-#endif
+	delete mWorldThreads;
+	mWorldThreads = 0;
+	mDueWorlds.clear();
+	for (std::vector<World*>::iterator itr = mWorlds.begin(); itr != mWorlds.end(); itr++) {
+		delete *itr;
+	}
+	mWorlds.clear();
+	mDefaultWorld = 0;
 }
 
+
 // return true if completely handled
 bool SpriteManager::handleEvent(EventEmitter* inEmitter, long inEventType, void* inEventData) throw() {
-	if (mFirstLayer == 0) return false;  // we can't do anything if we don't have any sprite layers
 	if (inEventType == eventType_Timer) {
 		pdg::TimerInfo* infoP = static_cast<TimerInfo*>(inEventData);
-		if ((infoP->id == SPRITE_LAYER_TIMER_ID) && (infoP->userData == (void*) this)) {
+		World* world = findWorldForTimer(infoP->id, infoP->userData);
+		if (world) {
 			
 			// time passed since we last animated
           #ifdef SPRITE_IGNORE_ANIMATION_TIMER_DRIFT
-			uint32 elapsedMs = SPRITE_TIMER_INTERVAL_MS; // this is how long we told it to take
+			ms_delta elapsedMs = world->mTickIntervalMs; // this is how long we told it to take
           #else
 			ms_delta elapsedMs = infoP->msElapsed;  // this is the actual time it took
 			if (elapsedMs > 100) { 
 				// 1/10 of a second is more than timer drift. We were probably
 				// paused or in the debugger or something. So use the normal timer interval
-				elapsedMs = SPRITE_TIMER_INTERVAL_MS;
+				elapsedMs = world->mTickIntervalMs;
 			}
           #endif
-  
-			SpriteLayerInfo evntInfo;
-			// Animate all the layers to their position at the next draw loop
-			SpriteLayer* layer = mFirstLayer;
-			evntInfo.actingLayer = mFirstLayer;
-			evntInfo.action = SpriteLayer::action_AnimationStart;
-			evntInfo.millisec = infoP->millisec;
-			mFirstLayer->postEvent(eventType_SpriteLayer, &evntInfo);
-
-          #ifdef PDG_USE_CHIPMUNK_PHYSICS
-            // Chipmunk docs say it is highly recommended we use a regular step amount, 
-            // but when we force the amount to a regular step that doesn't correspond 
-            // to the time it actually took, we get erratic movement. Instead we
-            // try to do a lot of simulations with a small step decoupled from the
-            // drawing loop and that seems to work well
-            cpFloat dt = (float) elapsedMs / 1000.0f;
-            cpSpaceStep(mSpace, dt);
-          #endif
-
-			while (layer) {
-				evntInfo.actingLayer = layer;
-				evntInfo.action = SpriteLayer::action_PreAnimateLayer;
-				layer->postEvent(eventType_SpriteLayer, &evntInfo);
-				layer->animateLayer(elapsedMs);
-				evntInfo.actingLayer = layer;
-				evntInfo.action = SpriteLayer::action_PostAnimateLayer;
-				layer->postEvent(eventType_SpriteLayer, &evntInfo);
-				layer = layer->mNextLayer;
+			if (world->mThreaded) {
+				// runThreadedWorlds() will take care of it along with any others that are due
+				if (!world->mTickDue) {
+					mDueWorlds.push_back(world);
+				}
+				world->tickWhenDue(elapsedMs, infoP->msElapsed, infoP->millisec);
+			} else {
+				world->tick(elapsedMs, infoP->msElapsed, infoP->millisec);
 			}
-			evntInfo.actingLayer = mLastLayer;
-			evntInfo.action = SpriteLayer::action_AnimationComplete;
-			mLastLayer->postEvent(eventType_SpriteLayer, &evntInfo);
-			
 			return true;
 		}
+		return false;
 	}
 
 #ifndef PDG_NO_GUI
 	if (inEventType == eventType_PortDraw) {
 		pdg::PortDrawInfo* infoP = static_cast<PortDrawInfo*>(inEventData);
-		if (infoP->port == mFirstLayer->mPort) {
+		// worlds are drawn in the order they were created, each one over the last
+		for (std::vector<World*>::iterator itr = mWorlds.begin(); itr != mWorlds.end(); itr++) {
+			SpriteLayer* firstLayer = (*itr)->mFirstLayer;
+			SpriteLayer* lastLayer = (*itr)->mLastLayer;
+			if (!firstLayer || (infoP->port != firstLayer->mPort)) continue;
 
 			SpriteLayerInfo evntInfo;
-			SpriteLayer* layer = mFirstLayer;
+			SpriteLayer* layer = firstLayer;
 			// Draw all the layers and their appropriate ports, and time how long it took
-			evntInfo.actingLayer = mFirstLayer;
+			evntInfo.actingLayer = firstLayer;
 			evntInfo.action = SpriteLayer::action_ErasePort;
 			evntInfo.millisec = OS::getMilliseconds();
-			if (mFirstLayer->mPort) {
-				if (!mFirstLayer->postEvent(eventType_SpriteLayer, &evntInfo) ) {
+			if (firstLayer->mPort) {
+				if (!firstLayer->postEvent(eventType_SpriteLayer, &evntInfo) ) {
 				// erase the port to black
-//					mFirstLayer->mPort->fillRect(mFirstLayer->mPort->getDrawingArea(), PDG_BLACK_COLOR );
+//					firstLayer->mPort->fillRect(firstLayer->mPort->getDrawingArea(), PDG_BLACK_COLOR );
 				}
 			}
 
-			layer = mFirstLayer;
+			layer = firstLayer;
 			while (layer) {
 				if (layer->mPort) {
 					evntInfo.actingLayer = layer;
@@ -311,46 +286,50 @@ bool SpriteManager::handleEvent(EventEmitter* inEmitter, long inEventType, void*
 				}
 				layer = layer->mNextLayer;
 			}
-			evntInfo.actingLayer = mLastLayer;
+			evntInfo.actingLayer = lastLayer;
 			evntInfo.action = SpriteLayer::action_DrawPortComplete;
-			if (mLastLayer->mPort) {
-				mLastLayer->postEvent(eventType_SpriteLayer, &evntInfo);
+			if (lastLayer->mPort) {
+				lastLayer->postEvent(eventType_SpriteLayer, &evntInfo);
 			}		
-			return false; // we didn't completely handle this, others may want to draw
 		}
+		return false; // we didn't completely handle this, others may want to draw
 	}
 #endif // !PDG_NO_GUI
 
 	if ( (inEventType == eventType_MouseDown) || (inEventType == eventType_MouseUp)) {
 		Sprite* hitSprite = 0;
 		MouseInfo* mi = static_cast<MouseInfo*>(inEventData);
- 		SpriteLayer* layer = mLastLayer;
-		while (layer) {
-			if (!layer->mHidden && layer->mWantsClicks) {
-				Sprite* sprite = layer->mLastSprite;
-			  #ifndef PDG_NO_GUI
-                Point clickPt = layer->portToLayer(mi->mousePos);
-			  #else 
-                Point clickPt = mi->mousePos;
-			  #endif
-				while (sprite) {
-					if (sprite->wantsClicks) {
-						int collideMode = sprite->mDoCollisions;
-						sprite->mDoCollisions = sprite->mMouseDetectMode;
-						bool didCollide = sprite->collidesWith(clickPt);
-						sprite->mDoCollisions = collideMode;
-						if (didCollide) {
-							hitSprite = sprite;
-							break;
+		SpriteLayer* layer = 0;
+		// top world first, since it was drawn last
+		for (size_t w = mWorlds.size(); (w > 0) && !hitSprite; w--) {
+			layer = mWorlds[w-1]->mLastLayer;
+			while (layer) {
+				if (!layer->mHidden && layer->mWantsClicks) {
+					Sprite* sprite = layer->mLastSprite;
+				  #ifndef PDG_NO_GUI
+                    Point clickPt = layer->portToLayer(mi->mousePos);
+				  #else 
+                    Point clickPt = mi->mousePos;
+				  #endif
+					while (sprite) {
+						if (sprite->wantsClicks) {
+							int collideMode = sprite->mDoCollisions;
+							sprite->mDoCollisions = sprite->mMouseDetectMode;
+							bool didCollide = sprite->collidesWith(clickPt);
+							sprite->mDoCollisions = collideMode;
+							if (didCollide) {
+								hitSprite = sprite;
+								break;
+							}
 						}
+						sprite = sprite->mPrevSprite;
+					}
+					if (hitSprite) {
+						break;
 					}
-					sprite = sprite->mPrevSprite;
-				}
-				if (hitSprite) {
-					break;
 				}
+				layer = layer->mPrevLayer;
 			}
-			layer = layer->mPrevLayer;
 		}
 		if (hitSprite) {
 			static Sprite* sLastHitSprite = 0;
@@ -377,6 +356,85 @@ bool SpriteManager::handleEvent(EventEmitter* inEmitter, long inEventType, void*
 	
 	
 
+World* SpriteManager::findWorldForTimer(long timerId, void* userData) {
+	for (std::vector<World*>::iterator itr = mWorlds.begin(); itr != mWorlds.end(); itr++) {
+		if (((*itr)->mTimerId == timerId) && (userData == (void*) *itr)) {
+			return *itr;
+		}
+	}
+	return 0;
+}
+
+// releases whatever a threaded delivery didn't get to, and puts back the list that was
+// being delivered before, even if a handler throws
+class DeliveringEventsCleanup {
+public:
+	DeliveringEventsCleanup(EventQueueEntryListT& events, EventQueueEntryListT*& delivering)
+		: mEvents(events), mDelivering(delivering), mOuterEvents(delivering) {
+		mDelivering = &mEvents;
+	}
+	~DeliveringEventsCleanup() {
+		for (size_t i = 0; i < mEvents.size(); i++) {
+			if (mEvents[i].userData) {
+				UserData* data = mEvents[i].userData;
+				mEvents[i].userData = 0;
+				data->release();
+			}
+		}
+		mDelivering = mOuterEvents;
+	}
+	EventQueueEntryListT& mEvents;
+	EventQueueEntryListT*& mDelivering;
+	EventQueueEntryListT* mOuterEvents;
+};
+
+void SpriteManager::runThreadedWorlds() {
+	if (mDueWorlds.empty()) return;
+	std::vector<World*> dueWorlds;
+	dueWorlds.swap(mDueWorlds);
+	mWorldThreads->tickWorlds(dueWorlds);
+
+	// now that nothing else is running, hand everything the worlds posted to the handlers,
+	// a world at a time in the order they were created, which is how they would have ticked
+	EventQueueEntryListT events;
+	for (std::vector<World*>::iterator itr = mWorlds.begin(); itr != mWorlds.end(); itr++) {
+		World* world = *itr;
+		if (!world->mDeferredEvents.empty()) {
+			events.insert(events.end(), world->mDeferredEvents.begin(), world->mDeferredEvents.end());
+			world->mDeferredEvents.clear();
+		}
+	}
+	// a handler can delete layers as we go, which discards their events from this list,
+	// or tick a world by hand, which can bring us back in here
+	DeliveringEventsCleanup cleanup(events, mDeliveringEvents);
+	for (size_t i = 0; i < events.size(); i++) {
+		UserData* data = events[i].userData;
+		if (!data) continue;  // discarded
+		long eventType = events[i].eventType;
+		bool wasHandled = events[i].emitter->postEvent(eventType, data->getData());
+	  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+		if (!wasHandled && (eventType == eventType_SpriteBreak) && events[i].userData) {
+			// "unhandled" means go ahead and break it, same as Sprite::doAnimate()
+			SpriteJointBreakInfo* si = static_cast<SpriteJointBreakInfo*>(data->getData());
+			si->actingSprite->disconnect(si->targetSprite);
+		}
+	  #endif
+		if (events[i].userData) {
+			events[i].userData = 0;
+			data->release();
+		}
+	}
+}
+
+void SpriteManager::discardEventsForLayer(SpriteLayer* layer) {
+	for (std::vector<World*>::iterator itr = mWorlds.begin(); itr != mWorlds.end(); itr++) {
+		World::discardEventsForLayer((*itr)->mDeferredEvents, layer);
+	}
+	if (mDeliveringEvents) {
+		World::discardEventsForLayer(*mDeliveringEvents, layer);
+	}
+}
+
 SpriteManager* SpriteManager::createSingletonInstance() {
 	EventManager* evtMgr = EventManager::getSingletonInstance();
 	TimerManager* tmrMgr = TimerManager::getSingletonInstance();
@@ -36,6 +36,7 @@
 #include <vector>
 
 #include "pdg/sys/core.h"
+#include "pdg/sys/eventqueue.h"
 
 // serialization macros for lists of floating point values
 // used by both sprite and sprite layer
@@ -70,6 +71,8 @@ namespace pdg {
 
 class SpriteLayer;
 class TileLayer;
+class World;
+class WorldThreadPool;
 
 #ifndef PDG_NO_GUI
 class Port;
@@ -88,8 +91,6 @@ public:
 	SpriteManager(EventManager* eventMgr, TimerManager* timerMgr);
 	virtual ~SpriteManager();
     
-	void addLayer(SpriteLayer* layer);
-	void removeLayer(SpriteLayer* layer);
     static SpriteLayer* createSpriteLayer();
     static TileLayer* createTileLayer();
   #ifndef PDG_NO_GUI
@@ -97,17 +98,25 @@ public:
     static TileLayer* createTileLayer(Port* port);
   #endif // ! PDG_NO_GUI
     static void cleanupLayer(SpriteLayer* layer);
+	World* createWorld(ms_delta tickIntervalMs);
+	void cleanupWorld(World* world);
+	World* findWorldForTimer(long timerId, void* userData);
+	// tick the threaded worlds whose timers have fired, then deliver their events
+	// called by the main loop right after it checks the timers
+	void runThreadedWorlds();
+	void discardEventsForLayer(SpriteLayer* layer);
 	EventManager* mEventMgr;
 	TimerManager* mTimerMgr;
-	SpriteLayer* mFirstLayer;
-	SpriteLayer* mLastLayer;
+	std::vector<World*> mWorlds;  // in drawing order
+	World* mDefaultWorld;         // where layers go unless put in some other world
+	WorldThreadPool* mWorldThreads;
+	std::vector<World*> mDueWorlds;  // threaded worlds waiting for runThreadedWorlds()
+	EventQueueEntryListT* mDeliveringEvents;  // threaded world events being delivered right now
 	uint32 mLastCallAt;
 
 	static SpriteManager* createSingletonInstance();
     
 #ifdef PDG_USE_CHIPMUNK_PHYSICS
-    cpSpace* mSpace; 
-
     static cpBool  ChipmunkSpriteCollisionBeginFunc(cpArbiter *arb, struct cpSpace *space, void *data);
     static void    ChipmunkSpriteCollisionPostSolveFunc(cpArbiter *arb, cpSpace *space, void *data);
     static cpBool  ChipmunkWallCollisionBeginFunc(cpArbiter *arb, struct cpSpace *space, void *data);
@@ -32,6 +32,7 @@
 
 #include "pdg/sys/os.h"
 #include "pdg/sys/tilelayer.h"
+#include "pdg/sys/world.h"
 #include "pdg/sys/sprite.h"
 #include "pdg/sys/iserializer.h"
 #include "pdg/sys/ideserializer.h"
@@ -40,6 +41,14 @@
 #include "image-impl.h"
 #include "collisiondetection.h"
 
+#ifdef PDG_USE_CHIPMUNK_PHYSICS
+// these aren't pulled in by chipmunk.h, and don't declare themselves extern "C"
+extern "C" {
+#include "chipmunk/cpMarch.h"
+#include "chipmunk/cpPolyline.h"
+}
+#endif
+
 #ifndef PDG_NO_GUI
 #include "include-opengl.h"
 #include "image-opengl.h"
@@ -47,6 +56,8 @@
 #endif // ! PDG_NO_GUI
 
 #include <cstdlib>
+#include <cmath>
+#include <algorithm>
 
 //#define TILING_INTERNAL_DEBUG 1
 
@@ -95,6 +106,11 @@ TileLayer::setWorldSize(long width, long height, bool repeatingX, bool repeating
 	// allocate a datablock for the layer
 	mTileData = (uint8*) std::malloc( mDataSize );
 	std::memset(mTileData, 0, mDataSize);
+  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+	if (mStaticCollisions) {
+		resetStaticChunks();
+	}
+  #endif
 }
 
 Rect
@@ -160,6 +176,9 @@ TileLayer::defineTileSet(int tileWidth, int tileHeight, Image* tiles, bool hasTr
 	mTiles = tiles;
 	mTiles->addRef();
 	mTiles->setEdgeClamping(true);
+  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+	markAllStaticTilesDirty();
+  #endif
 }
 
 void
@@ -176,6 +195,9 @@ TileLayer::loadMapData(uint8* dataPtr, long mapWidth, long mapHeight, long dstX,
 	*/
 	
 	memcpy(mTileData, dataPtr, mapWidth*mapHeight);
+  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+	markAllStaticTilesDirty();
+  #endif
 }
 
 uint8*
@@ -268,12 +290,18 @@ TileLayer::setTileTypeAt(long x, long y, uint8 t, TFacing facing) {
 			mTileData[index] = (t & 0x7F) + (facing & 0x80);
 		}
 	}
+  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+	markStaticTilesDirty(x, y);
+  #endif
 }
 
 uint32    
 TileLayer::checkCollision(Sprite *movingSprite, uint8 alphaThreshold, bool shortCircuit, float *outCollisionMag) const {
 	// get the sprite bounding box
 	Sprite* inSprite = movingSprite;
+	if (inSprite->mNumFrames == 0) {
+		return 0;  // no image to check against
+	}
 	ImageImpl* spriteImage = inSprite->mFrames[inSprite->mCurrFrame].image;
 	ImageImpl* spriteMaskImage = inSprite->mFrames[inSprite->mCurrFrame].collisionMask;
 	if (spriteMaskImage == 0) {
@@ -336,6 +364,266 @@ TileLayer::checkCollision(Sprite *movingSprite, uint8 alphaThreshold, bool short
 	return totalCollisionPts;
 }
 
+#ifdef PDG_USE_CHIPMUNK_PHYSICS
+
+void
+TileLayer::enableStaticCollisions(uint8 alphaThreshold, float tolerance, float radius, float friction, float elasticity, int chunkSize) {
+	mStaticAlphaThreshold = alphaThreshold;
+	mStaticTolerance = tolerance;
+	mStaticRadius = radius;
+	mStaticFriction = friction;
+	mStaticElasticity = elasticity;
+	mStaticChunkSize = (chunkSize < 1) ? 1 : chunkSize;
+	mStaticCollisions = true;
+	resetStaticChunks();
+}
+
+void
+TileLayer::disableStaticCollisions() {
+	for (size_t i = 0; i < mStaticChunks.size(); i++) {
+		freeStaticShapes(mStaticChunks[i]);
+	}
+	mStaticChunks.clear();
+	mStaticChunksX = 0;
+	mStaticChunksY = 0;
+	mStaticSpace = 0;
+	mStaticCollisions = false;
+	mStaticDirty = false;
+}
+
+uint32
+TileLayer::getStaticShapeCount() const {
+	uint32 count = 0;
+	for (size_t i = 0; i < mStaticChunks.size(); i++) {
+		count += mStaticChunks[i].shapes.size();
+	}
+	return count;
+}
+
+void
+TileLayer::updateStaticCollisions() {
+	if (!mStaticCollisions) return;
+	cpSpace* space = getSpace();
+	if (space != mStaticSpace) {
+		// we've changed worlds, or physics was turned on or off, so start over in the new space
+		resetStaticChunks();
+		mStaticSpace = space;
+	}
+	if (!mStaticDirty || !space || !mTileData || !mTiles || (mSrcTileCountX == 0) || (mSrcTileCountY == 0)) {
+		return; // leave things dirty until we have both a map and somewhere to put the shapes
+	}
+	for (int cy = 0; cy < mStaticChunksY; cy++) {
+		for (int cx = 0; cx < mStaticChunksX; cx++) {
+			if (mStaticChunks[cx + cy * mStaticChunksX].dirty) {
+				buildStaticChunk(cx, cy);
+			}
+		}
+	}
+	mStaticDirty = false;
+}
+
+// the space could be freed right after this, so take our shapes out of it now, and trace
+// them again into whatever space we're in the next time the layer animates
+void
+TileLayer::leavingWorldSpace() {
+	for (size_t i = 0; i < mStaticChunks.size(); i++) {
+		freeStaticShapes(mStaticChunks[i]);
+	}
+	mStaticSpace = 0;
+	markAllStaticTilesDirty();
+}
+
+void
+TileLayer::resetStaticChunks() {
+	for (size_t i = 0; i < mStaticChunks.size(); i++) {
+		freeStaticShapes(mStaticChunks[i]);
+	}
+	mStaticChunksX = (mWorldWidth + mStaticChunkSize - 1) / mStaticChunkSize;
+	mStaticChunksY = (mWorldHeight + mStaticChunkSize - 1) / mStaticChunkSize;
+	StaticChunk emptyChunk;
+	emptyChunk.dirty = true;
+	mStaticChunks.assign(mStaticChunksX * mStaticChunksY, emptyChunk);
+	mStaticDirty = true;
+}
+
+void
+TileLayer::markAllStaticTilesDirty() {
+	if (!mStaticCollisions) return;
+	for (size_t i = 0; i < mStaticChunks.size(); i++) {
+		mStaticChunks[i].dirty = true;
+	}
+	mStaticDirty = true;
+}
+
+void
+TileLayer::markStaticTilesDirty(long x, long y) {
+	if (!mStaticCollisions || mStaticChunks.empty()) return;
+	// a tile's outline is traced from samples that reach into the tiles around it, so
+	// a tile on the edge of a chunk changes the shapes of the neighbouring chunks too
+	for (long ty = y - 1; ty <= y + 1; ty++) {
+		long wy = ty;
+		if (mRepeatingY) {
+			wy = (wy + mWorldHeight) % mWorldHeight;
+		} else if ( (wy < 0) || (wy >= mWorldHeight) ) continue;
+		for (long tx = x - 1; tx <= x + 1; tx++) {
+			long wx = tx;
+			if (mRepeatingX) {
+				wx = (wx + mWorldWidth) % mWorldWidth;
+			} else if ( (wx < 0) || (wx >= mWorldWidth) ) continue;
+			mStaticChunks[(wx / mStaticChunkSize) + (wy / mStaticChunkSize) * mStaticChunksX].dirty = true;
+		}
+	}
+	mStaticDirty = true;
+}
+
+void
+TileLayer::freeStaticShapes(StaticChunk& chunk) {
+	for (size_t i = 0; i < chunk.shapes.size(); i++) {
+		cpShape* shape = chunk.shapes[i];
+		cpSpace* space = cpShapeGetSpace(shape);
+		if (space) {
+			cpSpaceRemoveShape(space, shape);
+		}
+		cpShapeFree(shape);
+	}
+	chunk.shapes.clear();
+}
+
+struct TileLayer::StaticSampleContext {
+	const TileLayer* layer;
+	const ImageImpl* tiles;
+	const AlphaMask* mask;
+};
+
+// sample points are pixel centers in layer coordinates, 1 for a solid pixel and 0 for an empty one
+cpFloat
+TileLayer::staticCollisionSample(cpVect point, void* data) {
+	const StaticSampleContext* ctx = static_cast<const StaticSampleContext*>(data);
+	const TileLayer* layer = ctx->layer;
+	const int w = layer->mSrcTileWidth;
+	const int h = layer->mSrcTileHeight;
+	long px = (long)std::floor(point.x);
+	long py = (long)std::floor(point.y);
+	long tx = (long)std::floor(point.x / w);
+	long ty = (long)std::floor(point.y / h);
+	uint8 t = layer->getTileTypeAt(tx, ty);
+	if (t == 0) return 0.0f; // empty tile
+	if (layer->mUseFacing && ((t & 63) == 0)) return 0.0f; // also empty when using facing, same as checkCollision()
+	if (!layer->mHasTransparency) return 1.0f; // every pixel of an opaque tile is solid
+
+	// find the pixel in the tile set image, undoing the facing or flipping the same way drawLayer() applies it
+	int lx = px - tx * w;
+	int ly = py - ty * h;
+	int sx = lx;
+	int sy = ly;
+	bool flipHorizOnly = layer->mUseFlipping &&  layer->mFlipHoriz && !layer->mFlipVert;
+	bool flipVertOnly  = layer->mUseFlipping && !layer->mFlipHoriz &&  layer->mFlipVert;
+	bool flipBoth      = layer->mUseFlipping &&  layer->mFlipHoriz &&  layer->mFlipVert;
+	if (layer->mUseFacing) {
+		int facing = t & 0xC0;
+		t = t & 0x3F;
+		if (facing == facing_South) {
+			sx = w - 1 - lx;
+			sy = h - 1 - ly;
+		} else if (facing == facing_West) {
+			sx = w - 1 - ly;
+			sy = lx;
+		} else if (facing == facing_East) {
+			sx = ly;
+			sy = h - 1 - lx;
+		}
+	} else if (flipBoth) {
+		int flip = t & 0xC0;
+		t = t & 0x3F;
+		if (flip & flipped_Horizontal) {
+			sx = w - 1 - lx;
+		}
+		if (flip & flipped_Vertical) {
+			sy = h - 1 - ly;
+		}
+	} else if (flipHorizOnly || flipVertOnly) {
+		if (t & 0x80) {
+			if (flipHorizOnly) {
+				sx = w - 1 - lx;
+			} else {
+				sy = h - 1 - ly;
+			}
+		}
+		t = t & 0x7F;
+	}
+	int tileRow = (t / layer->mSrcTileCountX) % layer->mSrcTileCountY;
+	int tileCol = t % layer->mSrcTileCountX;
+	int32 ix = tileCol * w + sx;
+	int32 iy = tileRow * h + sy;
+	if (ctx->mask) {
+		return ctx->mask->isSet(ix, iy) ? 1.0f : 0.0f;
+	}
+	return (ctx->tiles->getAlphaValue(ix, iy) > layer->mStaticAlphaThreshold) ? 1.0f : 0.0f;
+}
+
+void
+TileLayer::buildStaticChunk(int chunkX, int chunkY) {
+	StaticChunk& chunk = mStaticChunks[chunkX + chunkY * mStaticChunksX];
+	freeStaticShapes(chunk);
+	chunk.dirty = false;
+	cpSpace* space = getSpace();
+	ImageImpl* tiles = dynamic_cast<ImageImpl*>(mTiles);
+	if (!space || !tiles) return;
+
+	long firstX = chunkX * mStaticChunkSize;
+	long firstY = chunkY * mStaticChunkSize;
+	long lastX = std::min(firstX + mStaticChunkSize, mWorldWidth);
+	long lastY = std::min(firstY + mStaticChunkSize, mWorldHeight);
+	// sample the centers of the chunk's pixels, plus the last column and row of pixels of the chunks before
+	// it, so neighbouring chunks share a row of samples and their outlines meet up. The last chunk of a non
+	// repeating map also takes the empty pixels past the map edge, so the outline is closed off there
+	cpBB bb = cpBBNew(firstX * mSrcTileWidth - 0.5, firstY * mSrcTileHeight - 0.5,
+					  lastX * mSrcTileWidth - 0.5, lastY * mSrcTileHeight - 0.5);
+	unsigned long xSamples = (lastX - firstX) * mSrcTileWidth + 1;
+	unsigned long ySamples = (lastY - firstY) * mSrcTileHeight + 1;
+	if (!mRepeatingX && (lastX == mWorldWidth)) {
+		bb.r += 1.0;
+		xSamples++;
+	}
+	if (!mRepeatingY && (lastY == mWorldHeight)) {
+		bb.t += 1.0;
+		ySamples++;
+	}
+
+	StaticSampleContext ctx;
+	ctx.layer = this;
+	ctx.tiles = tiles;
+	ctx.mask = mHasTransparency ? tiles->getAlphaMask(mStaticAlphaThreshold) : 0;
+
+	cpPolylineSet* lines = cpPolylineSetNew();
+	cpMarchHard(bb, xSamples, ySamples, 0.5, (cpMarchSegmentFunc)cpPolylineSetCollectSegment, lines,
+				staticCollisionSample, &ctx);
+
+	cpBody* staticBody = cpSpaceGetStaticBody(space);
+	for (int i = 0; i < lines->count; i++) {
+		cpPolyline* line = cpPolylineSimplifyCurves(lines->lines[i], mStaticTolerance);
+		bool closed = cpPolylineIsClosed(line);
+		for (int j = 0; j < line->count - 1; j++) {
+			cpVect a = line->verts[j];
+			cpVect b = line->verts[j + 1];
+			cpShape* shape = cpSegmentShapeNew(staticBody, a, b, mStaticRadius);
+			// tell the segment about the ones on either side, so things slide across the joints without catching
+			cpVect prev = (j > 0) ? line->verts[j - 1] : (closed ? line->verts[line->count - 2] : a);
+			cpVect next = (j + 2 < line->count) ? line->verts[j + 2] : (closed ? line->verts[1] : b);
+			cpSegmentShapeSetNeighbors(shape, prev, next);
+			cpShapeSetCollisionType(shape, CP_COLLIDE_TYPE_WALL);
+			cpShapeSetFriction(shape, mStaticFriction);
+			cpShapeSetElasticity(shape, mStaticElasticity);
+			cpSpaceAddShape(space, shape);
+			chunk.shapes.push_back(shape);
+		}
+		cpPolylineFree(line);
+	}
+	cpPolylineSetFree(lines, cpTrue);
+}
+
+#endif // PDG_USE_CHIPMUNK_PHYSICS
+
 //#define ADJUST(n) floor(n)
 //#define ADJUST(n) roundf(n)
 #define ADJUST(n) n
@@ -692,6 +980,10 @@ TileLayer::drawLayer() {
 
 void 
 TileLayer::animateLayer(ms_delta msElapsed) {
+  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+	// get the terrain up to date before the sprites move against it
+	updateStaticCollisions();
+  #endif
 	SpriteLayer::animateLayer(msElapsed);
 }
 	
@@ -721,6 +1013,19 @@ TileLayer::TileLayer(Port* port)
 	mHasTransparency(false),
 	mUseFacing(false),
 	mUseFlipping(false)
+#ifdef PDG_USE_CHIPMUNK_PHYSICS
+	, mStaticSpace(0),
+	mStaticChunkSize(16),
+	mStaticChunksX(0),
+	mStaticChunksY(0),
+	mStaticCollisions(false),
+	mStaticDirty(false),
+	mStaticAlphaThreshold(128),
+	mStaticTolerance(1.0f),
+	mStaticRadius(1.0f),
+	mStaticFriction(1.0f),
+	mStaticElasticity(0.0f)
+#endif
 {
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 	INIT_SCRIPT_OBJECT(mTileLayerScriptObj);
@@ -744,6 +1049,19 @@ TileLayer::TileLayer()
 	mHasTransparency(false),
 	mUseFacing(false),
 	mUseFlipping(false)
+#ifdef PDG_USE_CHIPMUNK_PHYSICS
+	, mStaticSpace(0),
+	mStaticChunkSize(16),
+	mStaticChunksX(0),
+	mStaticChunksY(0),
+	mStaticCollisions(false),
+	mStaticDirty(false),
+	mStaticAlphaThreshold(128),
+	mStaticTolerance(1.0f),
+	mStaticRadius(1.0f),
+	mStaticFriction(1.0f),
+	mStaticElasticity(0.0f)
+#endif
 {
 #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
 	INIT_SCRIPT_OBJECT(mTileLayerScriptObj);
@@ -752,6 +1070,9 @@ TileLayer::TileLayer()
 
 TileLayer::~TileLayer()
 {
+#ifdef PDG_USE_CHIPMUNK_PHYSICS
+	disableStaticCollisions();
+#endif
 	if (mTileData) {
 		std::free(mTileData);
 		mTileData = (uint8*)0xDEADBEEF;
@@ -770,7 +1091,7 @@ TileLayer* createTileLayer(Port* port) {
 //	DEBUG_ASSERT(port, "must have a pdg::Port");
 	// create sprite manager singleton instance if necessary
 	TileLayer* layer = SpriteManager::createTileLayer(port);
-	SpriteManager::getSingletonInstance()->addLayer(layer);
+	getDefaultWorld()->addLayer(layer);
 	return layer;
 }
 #endif // ! PDG_NO_GUI
@@ -778,7 +1099,7 @@ TileLayer* createTileLayer(Port* port) {
 TileLayer* createTileLayer() {
 	// create sprite manager singleton instance if necessary
 	TileLayer* layer = SpriteManager::createTileLayer();
-	SpriteManager::getSingletonInstance()->addLayer(layer);
+	getDefaultWorld()->addLayer(layer);
 	return layer;
 }
 
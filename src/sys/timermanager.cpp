@@ -83,12 +83,7 @@ TimerManager::startTimer(long id, ms_delta delay, bool oneShot, UserData* userDa
 	    t = new Timer;
         CHECK_NEW(t, Timer);
         TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::startTimer created new timer [%p] id [%ld]", t, id); )
-        t->prev = 0;        // creating new timer, must set it up in doubly linked list
-        t->next = timers;
-    	if (timers) {
-    		timers->prev = t;
-    	}
-        timers = t;
+        timers[id] = t;
 	}
 	// this is stuff we do regardless of whether it was a new or reused timer
     t->id = id;
@@ -97,6 +92,10 @@ TimerManager::startTimer(long id, ms_delta delay, bool oneShot, UserData* userDa
     t->interval = delay;
     t->paused = false;
     t->fire = delay + OS::getMilliseconds();
+    if (firing.id != 0) {
+        t->pass = checkPass;  // started from a timer handler, so don't fire till the next checkTimers()
+    }
+    schedule(t);
 }
 
 // make sure a timer waits at an additional delay ms before next time it fires, regardless of current interval
@@ -108,14 +107,11 @@ TimerManager::delayTimer(long id, ms_delta delay) {
         TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::delayTimer [%ld] already firing, save delay", id); )
         addDelay += delay;
     } else {
-        Timer* t = timers;
-        while (t) {
-            if (t->id == id) {
-                t->fire += delay;
-                TIMER_DEBUG_ONLY( OS::_DOUT("Timer [%p] id [%ld] now fires at [%u]", t, t->id, t->fire); )
-                break;  // stop looking
-            }
-            t = t->next;
+        Timer* t = findTimer(id);
+        if (t) {
+            t->fire += delay;
+            TIMER_DEBUG_ONLY( OS::_DOUT("Timer [%p] id [%ld] now fires at [%u]", t, t->id, t->fire); )
+            schedule(t);
         }
     }
 }
@@ -132,17 +128,14 @@ TimerManager::delayTimerUntil(long id, ms_time msTime) {
         delayUntil = msTime;
         addDelay = 0;   // cancel any delay that was previously set
     } else {
-        Timer* t = timers;
-        while (t) {
-            if (t->id == id) {
-                t->paused = false;
-                if (t->fire < msTime) {
-                    t->fire = msTime;
-                    TIMER_DEBUG_ONLY( OS::_DOUT("Timer [%p] id [%ld] now fires at [%u]", t, t->id, t->fire); )
-                }
-                break;  // stop looking
+        Timer* t = findTimer(id);
+        if (t) {
+            t->paused = false;
+            if (t->fire < msTime) {
+                t->fire = msTime;
+                TIMER_DEBUG_ONLY( OS::_DOUT("Timer [%p] id [%ld] now fires at [%u]", t, t->id, t->fire); )
             }
-            t = t->next;
+            schedule(t);
         }
     }
 }
@@ -151,9 +144,9 @@ TimerManager::delayTimerUntil(long id, ms_time msTime) {
 void 
 TimerManager::pause() {
     TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::pause"); )
-    Timer* t = timers;
     ms_time msTime = OS::getMilliseconds();
-    while (t) {
+    for (TimerMapT::iterator it = timers.begin(); it != timers.end(); it++) {
+        Timer* t = it->second;
         if (!t->paused) {
             t->paused = true;
             // convert from absolute ms time to milliseconds remaining
@@ -163,8 +156,11 @@ TimerManager::pause() {
                 t->fire = 0;
             }
         }
-        t = t->next;
+        t->heapIndex = -1;
+        t->parked = false;
     }
+    heap.clear();   // nothing is scheduled anymore
+    parked.clear();
 	allTimersPaused = true;
 }
 
@@ -172,9 +168,9 @@ TimerManager::pause() {
 void 
 TimerManager::unpause() {
     TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::unpause"); )
-    Timer* t = timers;
     ms_time msTime = OS::getMilliseconds();
-    while (t) {
+    for (TimerMapT::iterator it = timers.begin(); it != timers.end(); it++) {
+        Timer* t = it->second;
         if (t->paused) {
             // convert from  milliseconds remaining to absolute ms time
             if (t->fire) {
@@ -183,8 +179,8 @@ TimerManager::unpause() {
                 t->fire = msTime;
             }
             t->paused = false;
+            schedule(t);
         }
-        t = t->next;
     }
 	allTimersPaused = false;
 }
@@ -199,21 +195,17 @@ TimerManager::isPaused() // check to see if all timers are paused
 void 
 TimerManager::pauseTimer(long id) {
     TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::pauseTimer [%ld]", id); )
-    Timer* t = timers;
-    ms_time msTime = OS::getMilliseconds();
-    while (t) {
-        if ((t->id == id) && !t->paused) {
-            // convert from  milliseconds remaining to absolute ms time
-            if (t->fire) {
-                t->fire = msTime + t->fire;
-                TIMER_DEBUG_ONLY( OS::_DOUT("Timer [%p] id [%ld] now fires at [%u]", t, t->id, t->fire); )
-            } else {
-                t->fire = msTime;
-            }
-            t->paused = true;
-            break;
+    Timer* t = findTimer(id);
+    if (t && !t->paused) {
+        ms_time msTime = OS::getMilliseconds();
+        // convert from absolute ms time to milliseconds remaining
+        if (t->fire > msTime) {
+            t->fire = t->fire - msTime;
+        } else {
+            t->fire = 0;
         }
-        t = t->next;
+        unschedule(t);
+        t->paused = true;
     }
 }
 
@@ -221,36 +213,25 @@ TimerManager::pauseTimer(long id) {
 void 
 TimerManager::unpauseTimer(long id) {
     TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::pauseTimer [%ld]", id); )
-    Timer* t = timers;
-    ms_time msTime = OS::getMilliseconds();
-    while (t) {
-        if ((t->id == id) && t->paused) {
-            // convert from  milliseconds remaining to absolute ms time
-            if (t->fire) {
-                t->fire = msTime + t->interval;
-                TIMER_DEBUG_ONLY( OS::_DOUT("Timer [%p] id [%ld] now fires at [%u]", t, t->id, t->fire); )
-            } else {
-                t->fire = msTime;
-            }
-            t->paused = false;
-            break;
+    Timer* t = findTimer(id);
+    if (t && t->paused) {
+        ms_time msTime = OS::getMilliseconds();
+        // convert from  milliseconds remaining to absolute ms time
+        if (t->fire) {
+            t->fire = msTime + t->interval;
+            TIMER_DEBUG_ONLY( OS::_DOUT("Timer [%p] id [%ld] now fires at [%u]", t, t->id, t->fire); )
+        } else {
+            t->fire = msTime;
         }
-        t = t->next;
+        t->paused = false;
+        schedule(t);
     }
 }
 
 bool TimerManager::isTimerPaused(long id) // check to see if a particular timer is paused
 {
-    Timer* t = timers;
-	bool retVal = false;
-    while (t) {
-        if (t->id == id) {
-            retVal = t->paused;
-            break;  // stop looking
-        }
-        t = t->next;
-    } 
-	return retVal;
+    Timer* t = findTimer(id);
+	return t ? t->paused : false;
 }
 
 ms_time
@@ -263,14 +244,9 @@ TimerManager::getWhenTimerFiresNext(long id) {
             return firing.fire + firing.interval + addDelay;  // we are firing a repeating timer, this is when it will fire next 
         }
     } else {
-        Timer* t = timers;
-        while (t) {
-            if (t->paused) {
-                return timer_Never;
-            } else if (t->id == id) {
-                return t->fire;  // found the timer, return when it will next fire
-            }
-            t = t->next;
+        Timer* t = findTimer(id);
+        if (t && !t->paused) {
+            return t->fire;  // found the timer, return when it will next fire
         }
     }
     return timer_Never;
@@ -279,230 +255,278 @@ TimerManager::getWhenTimerFiresNext(long id) {
 void 
 TimerManager::cancelTimer(long id) {
     TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::cancelTimer [%ld]", id); )
-    Timer* t = timers;
-    while (t) {
-        if (t->id == id) {
-            // timer found, remove it
-            if (t == timers) {
-                // we are deleted the list head, replace it
-                timers = t->next;
-            }
-            if (t->prev) {
-                // the previous was point to us, point to next instead
-                t->prev->next = t->next;
-            }
-            if (t->next) {
-                // the next was pointed to us, point to prev instead
-                t->next->prev = t->prev;
-            }
-            if (nextid == id) { // was this the timer that was to fire next
-                next = t->next;  // it was, so update the next ptr and next id
-                nextid = (next) ? next->id : 0;
-            }
-            if ((firing.id == id) && !firing.oneshot) { // was this the timer that was firing?
-                // we don't do this for oneshot timers, because a oneshot timer is removed from
-                // the list before it starts firing. Therefore, even if the ids match, the firing
-                // oneshot is not actually the same timer that we found here
-                TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::cancelTimer [%ld] already firing, setting delete flag", id); )
-                deleted = true;
-                delayUntil = 0;  // don't do any extra delays
-                addDelay = 0;
-            }
-            TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::cancelTimer timer [%p] id [%ld] deleted", t, id); )
-            delete t;
-            break;  // stop looking
-        }
-        t = t->next;
-    } 
+    TimerMapT::iterator it = timers.find(id);
+    if (it == timers.end()) return;
+    Timer* t = it->second;
+    timers.erase(it);
+    unschedule(t);
+    if (t == firingTimer) { // was this the timer that was firing?
+        // we don't do this for oneshot timers, because a oneshot timer is removed from
+        // the timers before it starts firing. Therefore, even if the ids match, the firing
+        // oneshot is not actually the same timer that we found here
+        TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::cancelTimer [%ld] already firing, setting delete flag", id); )
+        deleted = true;
+        firingTimer = 0;
+        delayUntil = 0;  // don't do any extra delays
+        addDelay = 0;
+    }
+    TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::cancelTimer timer [%p] id [%ld] deleted", t, id); )
+    delete t;
 }
 
 // remove all timers
 void 
 TimerManager::cancelAllTimers() {
     TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::cancelAllTimers"); )
-    Timer* t = timers;
-    Timer* nextT = 0;
-    while (t) {
-        nextT = t->next;
-        TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::cancelAllTimers timer [%p] id [%ld] deleted", t, t->id); )
-        delete t;
-        t = nextT;
+    for (TimerMapT::iterator it = timers.begin(); it != timers.end(); it++) {
+        TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::cancelAllTimers timer [%p] id [%ld] deleted", it->second, it->first); )
+        delete it->second;
     }
-    if ((firing.id != 0) && !firing.oneshot) {
-        // we deleted the timer currently firing, except for oneshots, which are already removed from the list
-        // and so we couldn't have deleted it here
+    if (firingTimer) {
+        // we deleted the timer currently firing, except for oneshots, which are already removed from
+        // the timers and so we couldn't have deleted it here
         deleted = true;
-        this->next = 0; // clear the cached value for next so we don't try to use it
+        firingTimer = 0;
         delayUntil = 0; // don't do any extra delays
         addDelay = 0;
     }
-    timers = 0;
+    timers.clear();
+    heap.clear();
+    parked.clear();
 }
 
 void 
 TimerManager::checkTimers() {
-    Timer* t = timers;
     ms_time ms = OS::getMilliseconds();
 //    TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers at ms [%ld]", ms); )
+    checkPass++;
 	try {
-		while (t) {
+		while (!heap.empty() && (ms >= heap[0]->fire)) {
+			Timer* t = heap[0];
+			unschedule(t);
+			if (t->pass == checkPass) {
+				// already fired or was started during this pass, so it has to wait for the next one
+				// even if it is due again, otherwise a zero interval timer would never let us return
+				t->parked = true;
+				parked.push_back(t);
+				continue;
+			}
+			t->pass = checkPass;
 			deleted = false;
 			addDelay = 0;       // we are about to fire this timer, so reset values for delays
 			delayUntil = 0;      // to this timer added while it is firing
-			if (!t->paused && (ms >= t->fire)) {
-				// fire this timer				
-				TimerInfo ti;
-				ti.id = t->id;
-				ti.millisec = ms;
-				ti.msElapsed = (ms - t->fire) + t->interval;
-				if (t->userData) {
-					ti.userData = t->userData->getData();
-				} else {
-					ti.userData = 0;
-				}
-				firing = *t;
-				TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers firing timer [%ld]", ti.id); )
-				DEBUG_ONLY( ms_delta behindMs = ms - t->fire; if (behindMs > 100) OS::_DOUT("TimerMgr::timer fired %ld ms late! Targeted for %u", behindMs, t->fire); )
-				// cache the next timer in case of deletion
-				// the deletion code can update the ptr to next if it deletes the next timer
-				next = t->next;
-				nextid = (next) ? next->id : 0;
-				// if the timer is a one shot, remove it from the timer list immediately
-				if (t->oneshot) {
-					TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers removing oneshot timer [%ld] from list", ti.id); )
-					if (t == timers) {
-						// we are deleted the list head, replace it
-						timers = t->next;
-					}
-					if (t->prev) {
-						// the previous was point to us, point to next instead
-						t->prev->next = t->next;
-					}
-					if (t->next) {
-						// the next was pointed to us, point to prev instead
-						t->next->prev = t->prev;
-					}
-					// now delete it, we will never use this pointer again
-					// but before we delete it, clear the user data so we don't
-					// delete that before it can be used
-					TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers saving off oneshot timer [%p] id [%ld] user data [%p] to avoid deletion", t, t->id, t->userData); )
-					t->userData = 0;
-					TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers deleting oneshot timer [%p] id [%ld]", t, t->id); )
-					delete t;
-					t = 0;
-				}
-				try {
-					if (!postEvent(eventType_Timer, &ti)) {
-					    DEBUG_ONLY( OS::_DOUT("WARNING: TimerMgr::checkTimers timer [%p] id [%ld] unhandled", (void*)t, ti.id); )
-					}
-				}
-				catch (std::exception& e) {
-				    DEBUG_ONLY( OS::_DOUT("Std Exception [%s] in TimerMgr::checkTimers.eventManager.postEvent", e.what()); )
-				    throw TimerException( e, "TimerMgr::checkTimers.eventManager.postEvent", ti.id );
+			// fire this timer				
+			TimerInfo ti;
+			ti.id = t->id;
+			ti.millisec = ms;
+			ti.msElapsed = (ms - t->fire) + t->interval;
+			if (t->userData) {
+				ti.userData = t->userData->getData();
+			} else {
+				ti.userData = 0;
+			}
+			firing = *t;
+			TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers firing timer [%ld]", ti.id); )
+			DEBUG_ONLY( ms_delta behindMs = ms - t->fire; if (behindMs > 100) OS::_DOUT("TimerMgr::timer fired %ld ms late! Targeted for %u", behindMs, t->fire); )
+			// if the timer is a one shot, remove it from the timers immediately
+			if (t->oneshot) {
+				TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers removing oneshot timer [%ld] from timers", ti.id); )
+				timers.erase(t->id);
+				// now delete it, we will never use this pointer again
+				// but before we delete it, clear the user data so we don't
+				// delete that before it can be used
+				TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers saving off oneshot timer [%p] id [%ld] user data [%p] to avoid deletion", t, t->id, t->userData); )
+				t->userData = 0;
+				TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers deleting oneshot timer [%p] id [%ld]", t, t->id); )
+				delete t;
+				t = 0;
+			} else {
+				// repeating timers stay out of the heap until the handler is done with them
+				firingTimer = t;
+			}
+			try {
+				if (!postEvent(eventType_Timer, &ti)) {
+				    DEBUG_ONLY( OS::_DOUT("WARNING: TimerMgr::checkTimers timer [%p] id [%ld] unhandled", (void*)t, ti.id); )
 				}
-				catch (...) {
-					DEBUG_ONLY( OS::_DOUT("Exception in TimerMgr::checkTimers.eventManager.postEvent"); )
-					throw TimerException( "TimerMgr::checkTimers.eventManager.postEvent", ti.id );
+			}
+			catch (std::exception& e) {
+			    DEBUG_ONLY( OS::_DOUT("Std Exception [%s] in TimerMgr::checkTimers.eventManager.postEvent", e.what()); )
+			    firing.id = 0;
+			    firingTimer = 0;
+			    if (t && !deleted) schedule(t);  // leave it where it was, so it tries again next time
+			    throw TimerException( e, "TimerMgr::checkTimers.eventManager.postEvent", ti.id );
+			}
+			catch (...) {
+				DEBUG_ONLY( OS::_DOUT("Exception in TimerMgr::checkTimers.eventManager.postEvent"); )
+			    firing.id = 0;
+			    firingTimer = 0;
+			    if (t && !deleted) schedule(t);
+				throw TimerException( "TimerMgr::checkTimers.eventManager.postEvent", ti.id );
+			}
+			TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers done with Timer Event"); )
+			firing.id = 0;
+			firingTimer = 0;
+			if (firing.oneshot) {
+				// we deleted this already when we removed it from the timers
+				// but we didn't delete the user data, so be sure to take care of that
+				TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers freeing deleted oneshot timer user data [%p]", firing.userData); )
+				firing.freeUserData();
+			} else if (deleted) { // if we deleted the timer while firing it do nothing more with it
+				TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers detected firing timer [%ld] was deleted", ti.id); )
+				// special case where we cancel, reinstall, then delay a timer all within
+				// the firing handler
+				if (delayUntil) {
+					// need to call delayTimerUntil on the new timer
+					delayTimerUntil(ti.id, delayUntil + addDelay);
+				} else if (addDelay) {
+					// need to call delayTimer on the new timer
+					delayTimer(ti.id, addDelay);
 				}
-				TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers done with Timer Event"); )
-				firing.id = 0;
-				nextid = 0;     // the nextid is no longer valid because we are done firing
-				if (firing.oneshot) {
-					// we deleted this already when we removed it from the list
-					// but we didn't delete the user data, so be sure to take care of that
-					TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers freeing deleted oneshot timer user data [%p]", firing.userData); )
-					firing.freeUserData();
-					t = next;
-					continue;   // cycle to the next timer
-				} else if (deleted) { // if we deleted the timer while firing it do nothing more with it
-					TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers detected firing timer [%ld] was deleted", ti.id); )
-					t = next;    // the timer was deleted, so use the cached value for next
-					// special case where we cancel, reinstall, then delay a timer all within
-					// the firing handler
-					if (delayUntil) {
-						// need to call delayTimerUntil on the new timer
-						delayTimerUntil(ti.id, delayUntil + addDelay);
-					} else if (addDelay) {
-						// need to call delayTimer on the new timer
-						delayTimer(ti.id, addDelay);
-					}
-					continue;   // cycle to the next timer
-				} else {
-					TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers resetting timer [%ld]", ti.id); )
-					// repeating timer, reset the timer to fire again after interval
-					// include any additional delay added by the timer's handler
-					t->fire = ms + addDelay + t->interval;
-					// if we have a new firing time from a delayUntil call, we must
-					// see if that would extend the firing time
-					if (t->fire < delayUntil) {
-						// repeating timer, reset the timer to fire at the exact time
-						// specified by delayTimerUntil() any additional delay added by the timer's handler
-						t->fire = delayUntil + addDelay;
-					}
-					TIMER_DEBUG_ONLY( OS::_DOUT("Timer [%p] id [%ld] now fires at [%u]", t, t->id, t->fire); )
+			} else if (t->paused) {
+				// paused from within its handler, so it has a full interval to go once it is unpaused
+				t->fire = t->interval + addDelay;
+			} else {
+				TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers resetting timer [%ld]", ti.id); )
+				// repeating timer, reset the timer to fire again after interval
+				// include any additional delay added by the timer's handler
+				t->fire = ms + addDelay + t->interval;
+				// if we have a new firing time from a delayUntil call, we must
+				// see if that would extend the firing time
+				if (t->fire < delayUntil) {
+					// repeating timer, reset the timer to fire at the exact time
+					// specified by delayTimerUntil() any additional delay added by the timer's handler
+					t->fire = delayUntil + addDelay;
 				}
+				TIMER_DEBUG_ONLY( OS::_DOUT("Timer [%p] id [%ld] now fires at [%u]", t, t->id, t->fire); )
+				schedule(t);
 			}
-			t = t->next;
 		}
 	} catch (std::exception& e) {
 		DEBUG_ONLY( OS::_DOUT("Exception [%s] in TimerMgr::checkTimers", e.what()); )
+		unparkTimers();
 		throw e;
 	} catch (...) {
 		DEBUG_ONLY( OS::_DOUT("Unspecified Exception in TimerMgr::checkTimers"); )
+		unparkTimers();
 		throw;
 	}
+	unparkTimers();
 //    TIMER_DEBUG_ONLY( OS::_DOUT("TimerMgr::checkTimers done"); )
 }
 
 ms_delta
 TimerManager::msTillNextFire() {
  // tells us how long it will be (in milliseconds) till the next timer fires
-    Timer* t = timers;
+    if (!parked.empty()) {
+        return 0;   // only happens if we are asked from within a timer handler
+    }
+    if (heap.empty()) {
+        return LONG_MAX;
+    }
     ms_time ms = OS::getMilliseconds();
-    ms_delta shortestTime = LONG_MAX;
-    while (t) {
-		if (!t->paused && (ms >= t->fire)) {
-            return 0;   // timer is overdue to fire
-        }
-        ms_delta diff = t->fire - ms;
-        if (diff < shortestTime) {
-            shortestTime = diff;
-        }
-        t = t->next;
+    if (ms >= heap[0]->fire) {
+        return 0;   // timer is overdue to fire
     }
-    DEBUG_ASSERT(shortestTime <= LONG_MAX, "ERROR: TimerManager::msTillNextFire() returned possible negative number");
-    return shortestTime;
+    return heap[0]->fire - ms;
 }
 
 TimerManager::Timer* 
 TimerManager::findTimer(long id) {
-    Timer* t = timers;
-    while (t) {
-        if (t->id == id) {
-            // timer found
-			return t;
+    TimerMapT::iterator it = timers.find(id);
+	return (it != timers.end()) ? it->second : 0;
+}
+
+// PROTECTED: put the parked timers back in the heap, called at the end of checkTimers()
+void
+TimerManager::unparkTimers() {
+    for (size_t i = 0; i < parked.size(); i++) {
+        parked[i]->parked = false;
+        schedule(parked[i]);
+    }
+    parked.clear();
+}
+
+// PROTECTED: add a timer to the heap, or move it to the right place if its firing time changed
+void
+TimerManager::schedule(Timer* t) {
+    if (t->paused || t->parked || (t == firingTimer)) return;
+    if (t->heapIndex < 0) {
+        heap.push_back(t);
+        t->heapIndex = (int)heap.size() - 1;
+    }
+    heapSiftUp(t->heapIndex);
+    heapSiftDown(t->heapIndex);
+}
+
+// PROTECTED: remove a timer from the heap and parked list, if it is in either one
+void
+TimerManager::unschedule(Timer* t) {
+    if (t->parked) {
+        for (size_t i = 0; i < parked.size(); i++) {
+            if (parked[i] == t) {
+                parked.erase(parked.begin() + i);
+                break;
+            }
+        }
+        t->parked = false;
+    }
+    int i = t->heapIndex;
+    if (i < 0) return;
+    t->heapIndex = -1;
+    Timer* last = heap.back();
+    heap.pop_back();
+    if (last != t) {
+        // fill the hole with the last timer and let it find its place
+        heapSet(i, last);
+        heapSiftUp(i);
+        heapSiftDown(last->heapIndex);
+    }
+}
+
+void
+TimerManager::heapSiftUp(int i) {
+    Timer* t = heap[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (heap[parent]->fire <= t->fire) break;
+        heapSet(i, heap[parent]);
+        i = parent;
+    }
+    heapSet(i, t);
+}
+
+void
+TimerManager::heapSiftDown(int i) {
+    int n = (int)heap.size();
+    Timer* t = heap[i];
+    while (true) {
+        int child = i * 2 + 1;
+        if (child >= n) break;
+        if ((child + 1 < n) && (heap[child + 1]->fire < heap[child]->fire)) {
+            child++;
         }
-        t = t->next;
+        if (t->fire <= heap[child]->fire) break;
+        heapSet(i, heap[child]);
+        i = child;
     }
-	return 0;
+    heapSet(i, t);
 }
 
 
 TimerManager::~TimerManager() {
     firing.userData = 0;    // make sure no-one tries to free the user data from the firing timer copy
-    Timer* t = timers;
     // delete all the timers
-    while (t) {
-        Timer* nextT = t->next;
-        delete t;
-        t = nextT;
+    for (TimerMapT::iterator it = timers.begin(); it != timers.end(); it++) {
+        delete it->second;
     }
-    timers = 0;
+    timers.clear();
+    heap.clear();
+    parked.clear();
 }
 
 
 TimerManager::Timer::Timer() 
- : userData(0) {
+ : userData(0), paused(false), parked(false), heapIndex(-1), pass(0) {
     // make sure data stuff is set up safely no matter what
 }
 
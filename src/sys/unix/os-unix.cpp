@@ -283,6 +283,19 @@ OS::getMilliseconds() {
     return mstime;
 }
 
+double
+OS::getPreciseMilliseconds() {
+    struct timeval currTime;
+    gettimeofday( &currTime, NULL );
+    return ((double)currTime.tv_sec * 1000.0) + ((double)currTime.tv_usec / 1000.0);
+}
+
+uint32
+OS::getProcessorCount() {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (uint32)count : 1;
+}
+
 } // end namespace pdg 
 
 #ifdef DEBUG
@@ -35,8 +35,12 @@
 #include "pdg/sys/userdata.h"
 #include "pdg/sys/os.h"
 #include "pdg/sys/refcounted.h"
+#include "pdg/sys/mutex.h"
+#include "pdg/sys/atomic.h"
 
 #include <cstdlib>
+#include <cstring>
+#include <new>
 
 #ifdef LEAK_AND_EXCEPTION_CHECKS
 #include "..\LeakCheck\LeakCheck.h"
@@ -47,16 +51,129 @@
 
 namespace pdg {
 
+// a pooled UserData and the data it holds live together in one of these. While the block
+// is on the free list the space for the UserData holds the link to the next free block
+struct UserDataPoolBlock {
+	union {
+		UserDataPoolBlock*	nextFree;
+		double				align;
+		char				userData[sizeof(UserData)];
+	} header;
+	union {
+		double				align;
+		void*				alignPtr;
+		char				bytes[USERDATA_POOL_BLOCK_SIZE];
+	} payload;
+};
+
+// Each thread takes blocks from a free list of its own, and released blocks go onto a shared
+// lock-free stack that a thread takes all at once when its own list runs out. Taking the whole
+// stack rather than popping one block at a time keeps the stack free of ABA problems. Blocks
+// on the list of a thread that exits are not recovered. Without atomics or thread local
+// storage we fall back to a single list guarded by a mutex
+#if defined( PDG_HAS_ATOMICS ) && defined( PDG_THREAD_LOCAL )
+  #define USERDATA_LOCK_FREE_POOL
+static UserDataPoolBlock* volatile sReleasedBlocks = 0;
+static PDG_THREAD_LOCAL UserDataPoolBlock* tFreeBlocks = 0;
+#else
+static Mutex sUserDataMutex;	// guards the pool
+static UserDataPoolBlock* sFreeBlocks = 0;
+#endif
+static uint32 sPooledInUse = 0;
+static MemStats sUserDataStats;	// only changed with PDG_ATOMIC_INC
+
+
+// PRIVATE: adds a chunk of blocks to the given free list. Chunks are never given back to the heap
+static void addPoolChunk(UserDataPoolBlock*& freeList) {
+	UserDataPoolBlock* chunk = new UserDataPoolBlock[USERDATA_POOL_CHUNK_BLOCKS];
+	PDG_ATOMIC_INC(&sUserDataStats.blocksAllocated);
+	for (int i = 0; i < USERDATA_POOL_CHUNK_BLOCKS; i++) {
+		chunk[i].header.nextFree = freeList;
+		freeList = &chunk[i];
+	}
+}
 
 UserData* UserData::makeUserDataViaCopy(void* ptr, long dataSize, UserFreeFuncT freeFunc) {
 	UserData* userData = new UserData();
 	userData->data = std::malloc(dataSize);
+	PDG_ATOMIC_INC(&sUserDataStats.blocksAllocated);
 	std::memcpy(userData->data, ptr, dataSize);
 	userData->freeFunc = freeFunc;
 	userData->freeHow = data_Free;
+	userData->ownsCopy = true;
 	return userData;
 }
 
+UserData* UserData::makeUserDataViaPooledCopy(void* ptr, long dataSize, UserFreeFuncT freeFunc) {
+	if (dataSize > USERDATA_POOL_BLOCK_SIZE) {
+		return makeUserDataViaCopy(ptr, dataSize, freeFunc);
+	}
+	UserDataPoolBlock* block;
+  #ifdef USERDATA_LOCK_FREE_POOL
+	if (!tFreeBlocks) {
+		// take everything that has been released since we last looked
+		UserDataPoolBlock* released;
+		do {
+			released = sReleasedBlocks;
+		} while (released && !PDG_ATOMIC_CAS_PTR(&sReleasedBlocks, released, (UserDataPoolBlock*)0));
+		tFreeBlocks = released;
+		if (!tFreeBlocks) {
+			addPoolChunk(tFreeBlocks);
+		}
+	}
+	block = tFreeBlocks;
+	tFreeBlocks = block->header.nextFree;
+  #else
+	{
+		AutoMutex mutex(&sUserDataMutex);
+		if (!sFreeBlocks) {
+			addPoolChunk(sFreeBlocks);
+		}
+		block = sFreeBlocks;
+		sFreeBlocks = block->header.nextFree;
+	}
+  #endif // USERDATA_LOCK_FREE_POOL
+	PDG_ATOMIC_INC(&sPooledInUse);
+	UserData* userData = new (block->header.userData) UserData(true);
+	userData->data = block->payload.bytes;
+	std::memcpy(userData->data, ptr, dataSize);
+	userData->freeFunc = freeFunc;
+	userData->freeHow = data_DoNothing;	// the data goes back to the pool with the UserData
+	return userData;
+}
+
+void UserData::release() {
+	if (!pooled) {
+		delete this;
+		return;
+	}
+	if (freeFunc != NULL) {
+		freeFunc( data );
+	}
+	// the header is the first thing in the block, so this is the block's address
+	UserDataPoolBlock* block = reinterpret_cast<UserDataPoolBlock*>(this);
+	PDG_ATOMIC_DEC(&sPooledInUse);
+  #ifdef USERDATA_LOCK_FREE_POOL
+	UserDataPoolBlock* next;
+	do {
+		next = sReleasedBlocks;
+		block->header.nextFree = next;
+	} while (!PDG_ATOMIC_CAS_PTR(&sReleasedBlocks, next, block));
+  #else
+	AutoMutex mutex(&sUserDataMutex);
+	block->header.nextFree = sFreeBlocks;
+	sFreeBlocks = block;
+  #endif // USERDATA_LOCK_FREE_POOL
+}
+
+void UserData::getAllocationStats(MemStats& outStats, uint32* outPooledInUse) {
+	// the counters are each read atomically, but not as a set
+	outStats = sUserDataStats;
+	if (outPooledInUse) {
+		*outPooledInUse = sPooledInUse;
+	}
+}
+
 UserData* UserData::makeUserDataWithCustomFree(void* ptr, UserFreeFuncT freeFunc) {
 	UserData* userData = new UserData();
 	userData->data = ptr;
@@ -86,13 +203,24 @@ UserData* UserData::makeUserDataFromPointer(void* ptr, FreeDataT freeHow) {
 	return userData;
 }
 
-UserData::UserData() {
+UserData::UserData(bool inPooled) {
 	freeHow = data_DoNothing;
     freeFunc = NULL;
     data = 0;
+    pooled = inPooled;
+    ownsCopy = false;
+    if (!pooled) {
+		PDG_ATOMIC_INC(&sUserDataStats.cxxObjsAllocated);
+    }
 }
 
 UserData::~UserData() {
+	// pooled ones are never deleted, they go back to the pool in release()
+	PDG_ATOMIC_INC(&sUserDataStats.cxxObjsFreed);
+	if (ownsCopy) {
+		// only count the blocks we counted in makeUserDataViaCopy()
+		PDG_ATOMIC_INC(&sUserDataStats.blocksFreed);
+	}
 	if (freeHow != data_DoNothing) {
 		if (freeFunc != NULL) {
 			freeFunc( data );
@@ -310,6 +310,24 @@ ms_time OS::getMilliseconds() {
     return WinAPI::GetTickCount();
 }
 
+double OS::getPreciseMilliseconds() {
+    static double sMsPerTick = 0.0;
+    WinAPI::LARGE_INTEGER counter;
+    if (sMsPerTick == 0.0) {
+        WinAPI::LARGE_INTEGER freq;
+        WinAPI::QueryPerformanceFrequency(&freq);
+        sMsPerTick = 1000.0 / (double)freq.QuadPart;
+    }
+    WinAPI::QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * sMsPerTick;
+}
+
+uint32 OS::getProcessorCount() {
+    WinAPI::SYSTEM_INFO sysInfo;
+    WinAPI::GetSystemInfo(&sysInfo);
+    return (sysInfo.dwNumberOfProcessors > 0) ? (uint32)sysInfo.dwNumberOfProcessors : 1;
+}
+
 
 #ifdef DEBUG
 
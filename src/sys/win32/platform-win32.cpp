@@ -399,6 +399,7 @@ using std::endl;
 // these should be able to go away
 #include "pdg/sys/graphicsmanager.h"
 #include "pdg/sys/timermanager.h"
+#include "spritemanager.h"
 #include "graphics-win32.h"
 #define RUN_LOOP_DEBUG_ONLY( m ) m
 
@@ -1138,21 +1139,13 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam)
 					// while live resizing, windows doesn't call the normal event dispatcher, so
 					// we do a mini version of main drawing loop here
 					TimerManager::instance().checkTimers();
+					if (SpriteManager::hasInstance()) {
+						SpriteManager::instance().runThreadedWorlds();
+					}
 				#ifndef PDG_NO_EVENT_QUEUE
 					// check of the event queue in case someone put an event in the queue while the
 					// main thread was sleeping
-					long eventType;
-					UserData* eventData;
-					EventEmitter* eventEmitter;
-					int eventCount = 0;
-					while (EventManager::instance().getQueuedEvent(eventType, eventData, eventEmitter)) {
-						EventManager::instance().postEventToEmitter(
-							eventType, eventData->getData(), eventEmitter);
-						eventData->release();
-						eventData = 0;
-						eventEmitter = 0;
-						eventCount++;
-					}
+					EventManager::instance().dispatchQueuedEvents();
 				#endif // NO_EVENT_QUEUE
  					thePortWin->unlockDrawingSurface();
 					thePortWin->mBackBuffer.updateFrontBuffer();
@@ -0,0 +1,534 @@
+// -----------------------------------------------
+// world.cpp
+//
+// independent simulations, each with its own layers,
+// physics space and animation tick
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+
+
+
+#include "pdg_project.h"
+
+#include "pdg/sys/world.h"
+#include "pdg/sys/sprite.h"
+#include "pdg/sys/spritelayer.h"
+#include "pdg/sys/tilelayer.h"
+#include "pdg/sys/timermanager.h"
+#include "pdg/sys/os.h"
+#include "pdg/sys/events.h"
+#include "pdg/sys/userdata.h"
+
+#include "spritemanager.h"
+#include "worldthreads.h"
+
+#include <cmath>
+
+// cpHastySpace needs pthreads, so Chipmunk leaves it out of MSVC builds
+#if defined( PDG_USE_CHIPMUNK_PHYSICS ) && !defined( _MSC_VER )
+extern "C" {
+#include "chipmunk/cpHastySpace.h"
+}
+  #define PDG_USE_HASTY_SPACE
+  #define SPACE_NEW()           cpHastySpaceNew()
+  #define SPACE_FREE(space)     cpHastySpaceFree(space)
+  #define SPACE_STEP(space, dt) cpHastySpaceStep(space, dt)
+#else
+  #define SPACE_NEW()           cpSpaceNew()
+  #define SPACE_FREE(space)     cpSpaceFree(space)
+  #define SPACE_STEP(space, dt) cpSpaceStep(space, dt)
+#endif
+
+// timer ids for worlds count down from here, the default world gets this one
+#define WORLD_FIRST_TIMER_ID -1234031
+
+namespace pdg {
+
+// these release the sprite references held by deferred event data, see spritelayer.cpp
+void SpriteAnimateInfo_ReleaseSprites(void* ptr);
+void SpriteCollideInfo_ReleaseSprites(void* ptr);
+
+#ifdef PDG_USE_CHIPMUNK_PHYSICS
+static void SpriteJointBreakInfo_ReleaseSprites(void* ptr) {
+	if (!ptr) return;
+	SpriteAnimateInfo_ReleaseSprites(ptr);
+	SpriteJointBreakInfo* sji = static_cast<SpriteJointBreakInfo*>(ptr);
+	if (sji->targetSprite) {
+		sji->targetSprite->release();
+		sji->targetSprite = 0;
+	}
+}
+#endif
+
+static long sNextWorldTimerId = WORLD_FIRST_TIMER_ID;
+
+World::World(ms_delta tickIntervalMs)
+ :	mFirstLayer(0),
+	mLastLayer(0),
+	mTimerId(sNextWorldTimerId--),
+	mTickIntervalMs(tickIntervalMs > 0 ? tickIntervalMs : WORLD_DEFAULT_TICK_INTERVAL_MS),
+	mPaused(false),
+	mTimerRunning(false),
+	mThreaded(false),
+	mTickDue(false),
+	mDeferEvents(false),
+	mDueElapsedMs(0),
+	mDueActualElapsedMs(0),
+	mDueMillisec(0)
+{
+  #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
+	INIT_SCRIPT_OBJECT(mWorldScriptObj);
+  #endif
+  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+    // a hasty space steps single threaded, just like a regular space, until
+    // setPhysicsThreads() gives it more threads
+    mSpace = SPACE_NEW();
+    mPhysicsStepMs = 0.0f;
+    mFixedPhysicsStepMs = 0.0f;
+    mMaxPhysicsStepsPerTick = WORLD_DEFAULT_MAX_PHYSICS_STEPS;
+    mPhysicsAccumulatorMs = 0.0;
+    mPhysicsAlpha = 0.0f;
+    mInterpolatePhysics = false;
+    mPhysicsStamp = 1;
+
+    cpCollisionHandler* spriteToSpriteHdlr = cpSpaceAddCollisionHandler(mSpace, CP_COLLIDE_TYPE_SPRITE, CP_COLLIDE_TYPE_SPRITE);
+    spriteToSpriteHdlr->beginFunc = SpriteManager::ChipmunkSpriteCollisionBeginFunc;
+    spriteToSpriteHdlr->postSolveFunc = SpriteManager::ChipmunkSpriteCollisionPostSolveFunc;
+
+    cpCollisionHandler* spriteToWallHdlr = cpSpaceAddCollisionHandler(mSpace, CP_COLLIDE_TYPE_SPRITE, CP_COLLIDE_TYPE_WALL);
+    spriteToWallHdlr->beginFunc = SpriteManager::ChipmunkWallCollisionBeginFunc;
+    spriteToWallHdlr->postSolveFunc = SpriteManager::ChipmunkWallCollisionPostSolveFunc;
+  #endif
+}
+
+World::~World() {
+	if (mTimerRunning) {
+		TimerManager::getSingletonInstance()->cancelTimer(mTimerId);
+		mTimerRunning = false;
+	}
+	for (size_t i = 0; i < mDeferredEvents.size(); i++) {
+		if (mDeferredEvents[i].userData) {
+			mDeferredEvents[i].userData->release();
+		}
+	}
+	mDeferredEvents.clear();
+	// anything still here outlives us, so make sure it doesn't point back at us
+	SpriteLayer* layer = mFirstLayer;
+	while (layer) {
+		SpriteLayer* next = layer->mNextLayer;
+		layer->leavingWorldSpace();  // before we free the space out from under it
+		layer->mWorld = 0;
+		layer->mNextLayer = 0;
+		layer->mPrevLayer = 0;
+		layer = next;
+	}
+	mFirstLayer = 0;
+	mLastLayer = 0;
+  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+    SPACE_FREE(mSpace);
+    mSpace = 0;
+  #endif
+  #ifdef PDG_COMPILING_FOR_SCRIPT_BINDINGS
+	CleanupWorldScriptObject(mWorldScriptObj);
+  #endif
+}
+
+#ifndef PDG_NO_GUI
+SpriteLayer*
+World::createSpriteLayer(Port* port) {
+	SpriteLayer* layer = SpriteManager::createSpriteLayer(port);
+	addLayer(layer);
+	return layer;
+}
+
+TileLayer*
+World::createTileLayer(Port* port) {
+	TileLayer* layer = SpriteManager::createTileLayer(port);
+	addLayer(layer);
+	return layer;
+}
+#else
+SpriteLayer*
+World::createSpriteLayer() {
+	SpriteLayer* layer = SpriteManager::createSpriteLayer();
+	addLayer(layer);
+	return layer;
+}
+
+TileLayer*
+World::createTileLayer() {
+	TileLayer* layer = SpriteManager::createTileLayer();
+	addLayer(layer);
+	return layer;
+}
+#endif // ! PDG_NO_GUI
+
+uint32
+World::getLayerCount() {
+	uint32 count = 0;
+	SpriteLayer* layer = mFirstLayer;
+	while (layer) {
+		count++;
+		layer = layer->mNextLayer;
+	}
+	return count;
+}
+
+// add a layer to the end
+void
+World::addLayer(SpriteLayer* layer) {
+	if (!layer) return;
+	if (layer->mWorld) {
+		layer->mWorld->removeLayer(layer);
+	}
+	layer->mWorld = this;
+	layer->mNextLayer = 0;
+	if (mFirstLayer == 0) {
+		mFirstLayer = layer;
+		layer->mPrevLayer = 0;
+	} else {
+		layer->mPrevLayer = mLastLayer;
+		mLastLayer->mNextLayer = layer;
+	}
+	mLastLayer = layer;  // we are always the new last layer
+	updateTimer();
+}
+
+void
+World::removeLayer(SpriteLayer* layer) {
+	if (!layer || (layer->mWorld != this)) return;
+	// update our first and last layers
+	if (layer == mFirstLayer) {
+		mFirstLayer = layer->mNextLayer;
+	}
+	if (layer == mLastLayer) {
+		mLastLayer = layer->mPrevLayer;
+	}
+	// now update the previous and next layers to point to one another
+	if (layer->mPrevLayer) {
+		layer->mPrevLayer->mNextLayer = layer->mNextLayer;
+	}
+	if (layer->mNextLayer) {
+		layer->mNextLayer->mPrevLayer = layer->mPrevLayer;
+	}
+	// finally clear our prev and next layers
+	layer->mNextLayer = 0;
+	layer->mPrevLayer = 0;
+	layer->leavingWorldSpace();
+	layer->mWorld = 0;
+	updateTimer();
+}
+
+void
+World::setTickInterval(ms_delta msInterval) {
+	if (msInterval <= 0) {
+		msInterval = WORLD_DEFAULT_TICK_INTERVAL_MS;
+	}
+	if (msInterval == mTickIntervalMs) return;
+	mTickIntervalMs = msInterval;
+	if (mTimerRunning) {
+		// restart it with the new interval
+		TimerManager::getSingletonInstance()->cancelTimer(mTimerId);
+		mTimerRunning = false;
+		updateTimer();
+	}
+}
+
+void
+World::pause() {
+	mPaused = true;
+	updateTimer();
+}
+
+void
+World::unpause() {
+	mPaused = false;
+	updateTimer();
+}
+
+void
+World::updateTimer() {
+	bool wantTimer = (mFirstLayer != 0) && !mPaused;
+	if (wantTimer == mTimerRunning) return;
+	TimerManager* timerMgr = TimerManager::getSingletonInstance();
+	if (wantTimer) {
+		timerMgr->startTimer(mTimerId, mTickIntervalMs, timer_Repeating,
+							 UserData::makeUserDataFromPointer(this, data_DoNothing) );
+	} else {
+		timerMgr->cancelTimer(mTimerId);
+	}
+	mTimerRunning = wantTimer;
+}
+
+void
+World::step(ms_delta msElapsed) {
+	tick(msElapsed, msElapsed, OS::getMilliseconds());
+}
+
+void
+World::setThreaded(bool threaded) {
+	mThreaded = threaded;
+}
+
+// the timer fired for a threaded world, so remember to tick it next time
+// SpriteManager::runThreadedWorlds() is called
+void
+World::tickWhenDue(ms_delta elapsedMs, ms_delta actualElapsedMs, ms_time millisec) {
+	if (mTickDue) {
+		// the timer fired more than once before we got to run, so make up for it in one tick
+		mDueElapsedMs += elapsedMs;
+		mDueActualElapsedMs += actualElapsedMs;
+	} else {
+		mDueElapsedMs = elapsedMs;
+		mDueActualElapsedMs = actualElapsedMs;
+	}
+	mDueMillisec = millisec;
+	mTickDue = true;
+}
+
+void
+World::runDueTick() {
+	if (!mTickDue) return;
+	mTickDue = false;
+	mDeferEvents = true;
+	tick(mDueElapsedMs, mDueActualElapsedMs, mDueMillisec);
+	mDeferEvents = false;
+}
+
+// hold onto a copy of an event posted during a threaded tick, for SpriteManager to deliver on
+// the main thread once all the worlds are done. Sprites in the event are retained till then
+bool
+World::deferEvent(EventEmitter* emitter, long inEventType, void* inEventData) {
+	UserData* data = 0;
+	switch (inEventType) {
+		case eventType_SpriteAnimate:
+		{
+			SpriteAnimateInfo* sai = static_cast<SpriteAnimateInfo*>(inEventData);
+			if (sai->actingSprite) {
+				sai->actingSprite->addRef();
+			}
+			if ((sai->action == Sprite::action_EnterObserver) || (sai->action == Sprite::action_ExitObserver)) {
+				data = UserData::makeUserDataViaPooledCopy(inEventData, sizeof(SpriteObserverInfo), &SpriteAnimateInfo_ReleaseSprites);
+			} else {
+				data = UserData::makeUserDataViaPooledCopy(inEventData, sizeof(SpriteAnimateInfo), &SpriteAnimateInfo_ReleaseSprites);
+			}
+			break;
+		}
+		case eventType_SpriteCollide:
+		{
+			SpriteCollideInfo* sci = static_cast<SpriteCollideInfo*>(inEventData);
+			if (sci->actingSprite) {
+				sci->actingSprite->addRef();
+			}
+			if (sci->targetSprite) {
+				sci->targetSprite->addRef();
+			}
+			data = UserData::makeUserDataViaPooledCopy(inEventData, sizeof(SpriteCollideInfo), &SpriteCollideInfo_ReleaseSprites);
+			break;
+		}
+	  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+		case eventType_SpriteBreak:
+		{
+			SpriteJointBreakInfo* sji = static_cast<SpriteJointBreakInfo*>(inEventData);
+			if (sji->actingSprite) {
+				sji->actingSprite->addRef();
+			}
+			if (sji->targetSprite) {
+				sji->targetSprite->addRef();
+			}
+			data = UserData::makeUserDataViaPooledCopy(inEventData, sizeof(SpriteJointBreakInfo), &SpriteJointBreakInfo_ReleaseSprites);
+			break;
+		}
+	  #endif
+		case eventType_SpriteLayer:
+			data = UserData::makeUserDataViaPooledCopy(inEventData, sizeof(SpriteLayerInfo));
+			break;
+		default:
+			DEBUG_PRINT("World [%p] dropped event type [%ld] posted during a threaded tick", this, inEventType);
+			return false;
+	}
+	mDeferredEvents.push_back(EventQueueEntry(inEventType, data, emitter));
+	return true;  // as far as the tick is concerned, it has been taken care of
+}
+
+// a layer is going away, so drop any events that would be delivered to it or that refer to it
+void
+World::discardEventsForLayer(EventQueueEntryListT& events, SpriteLayer* layer) {
+	for (size_t i = 0; i < events.size(); i++) {
+		EventQueueEntry& evt = events[i];
+		if (!evt.userData) continue;
+		bool discard = (evt.emitter == layer);
+		if (!discard) {
+			switch (evt.eventType) {
+				case eventType_SpriteAnimate:
+				case eventType_SpriteCollide:
+			  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+				case eventType_SpriteBreak:
+			  #endif
+					discard = (static_cast<SpriteAnimateInfo*>(evt.userData->getData())->inLayer == layer);
+					break;
+				case eventType_SpriteLayer:
+					discard = (static_cast<SpriteLayerInfo*>(evt.userData->getData())->actingLayer == layer);
+					break;
+			}
+		}
+		if (discard) {
+			// leave the entry in place so anyone going through the list doesn't lose their place
+			evt.userData->release();
+			evt.userData = 0;
+			evt.emitter = 0;
+		}
+	}
+}
+
+void
+World::tick(ms_delta elapsedMs, ms_delta actualElapsedMs, ms_time millisec) {
+	if (mFirstLayer == 0) return;  // nothing to animate
+	SpriteLayerInfo evntInfo;
+	// Animate all the layers to their position at the next draw loop
+	SpriteLayer* layer = mFirstLayer;
+	evntInfo.actingLayer = mFirstLayer;
+	evntInfo.action = SpriteLayer::action_AnimationStart;
+	evntInfo.millisec = millisec;
+	mFirstLayer->postEvent(eventType_SpriteLayer, &evntInfo);
+
+  #ifdef PDG_USE_CHIPMUNK_PHYSICS
+	stepPhysics(elapsedMs, actualElapsedMs);
+  #endif
+
+	while (layer) {
+		evntInfo.actingLayer = layer;
+		evntInfo.action = SpriteLayer::action_PreAnimateLayer;
+		layer->postEvent(eventType_SpriteLayer, &evntInfo);
+		layer->animateLayer(elapsedMs);
+		evntInfo.actingLayer = layer;
+		evntInfo.action = SpriteLayer::action_PostAnimateLayer;
+		layer->postEvent(eventType_SpriteLayer, &evntInfo);
+		layer = layer->mNextLayer;
+	}
+	if (mLastLayer) {
+		evntInfo.actingLayer = mLastLayer;
+		evntInfo.action = SpriteLayer::action_AnimationComplete;
+		mLastLayer->postEvent(eventType_SpriteLayer, &evntInfo);
+	}
+}
+
+#ifdef PDG_USE_CHIPMUNK_PHYSICS
+void
+World::setPhysicsThreads(uint32 numThreads) {
+  #ifdef PDG_USE_HASTY_SPACE
+    // Chipmunk stops the old worker threads and starts the new ones, and
+    // limits this to what it can actually use
+    cpHastySpaceSetThreads(mSpace, numThreads);
+  #endif
+}
+
+uint32
+World::getPhysicsThreads() {
+  #ifdef PDG_USE_HASTY_SPACE
+    return cpHastySpaceGetThreads(mSpace);
+  #else
+    return 1;
+  #endif
+}
+
+void
+World::setFixedPhysicsStep(float stepMs, uint32 maxStepsPerTick) {
+    mFixedPhysicsStepMs = (stepMs > 0.0f) ? stepMs : 0.0f;
+    mMaxPhysicsStepsPerTick = (maxStepsPerTick > 0) ? maxStepsPerTick : 1;
+    mPhysicsAccumulatorMs = 0.0;
+    mPhysicsAlpha = 0.0f;
+    mPhysicsStamp++;  // anything saved for interpolation is stale now
+}
+
+void
+World::SavePhysicsStateFunc(cpBody* body, void* data) {
+    Sprite* sprite = (Sprite*) cpBodyGetUserData(body);
+    if (sprite) {
+        sprite->mPrevPhysicsPos = cpBodyGetPosition(body);
+        sprite->mPrevPhysicsAngle = cpBodyGetAngle(body);
+        sprite->mPrevPhysicsStamp = *(uint32*)data;
+    }
+}
+
+void
+World::stepPhysics(ms_delta elapsedMs, ms_delta actualElapsedMs) {
+    double stepStart = OS::getPreciseMilliseconds();
+    if (mFixedPhysicsStepMs <= 0.0f) {
+        // Chipmunk docs say it is highly recommended we use a regular step amount, 
+        // but when we force the amount to a regular step that doesn't correspond 
+        // to the time it actually took, we get erratic movement. Instead we
+        // try to do a lot of simulations with a small step decoupled from the
+        // drawing loop and that seems to work well
+        cpFloat dt = (float) elapsedMs / 1000.0f;
+        SPACE_STEP(mSpace, dt);
+    } else {
+        // fixed step mode: run however many whole steps of simulation time have built up,
+        // including any time lost to a hitch, and carry the remainder over to the next tick
+        mPhysicsAccumulatorMs += actualElapsedMs;
+        uint32 numSteps = (uint32)(mPhysicsAccumulatorMs / mFixedPhysicsStepMs);
+        if (numSteps > mMaxPhysicsStepsPerTick) {
+            // we've fallen too far behind to catch up without making the next tick take
+            // even longer, so drop the whole steps we can't do rather than spiral
+            numSteps = mMaxPhysicsStepsPerTick;
+            mPhysicsAccumulatorMs = std::fmod(mPhysicsAccumulatorMs, (double)mFixedPhysicsStepMs);
+        } else {
+            mPhysicsAccumulatorMs -= numSteps * (double)mFixedPhysicsStepMs;
+        }
+        cpFloat dt = mFixedPhysicsStepMs / 1000.0f;
+        for (uint32 i = 0; i < numSteps; i++) {
+            if (mInterpolatePhysics && (i == numSteps - 1)) {
+                // sprites are drawn between where the last step starts and where it ends
+                mPhysicsStamp++;
+                cpSpaceEachBody(mSpace, SavePhysicsStateFunc, &mPhysicsStamp);
+            }
+            SPACE_STEP(mSpace, dt);
+        }
+        mPhysicsAlpha = (float)(mPhysicsAccumulatorMs / mFixedPhysicsStepMs);
+    }
+    mPhysicsStepMs = (float)(OS::getPreciseMilliseconds() - stepStart);
+}
+#endif
+
+World* createWorld(ms_delta tickIntervalMs) {
+	return SpriteManager::getSingletonInstance()->createWorld(tickIntervalMs);
+}
+
+World* getDefaultWorld() {
+	return SpriteManager::getSingletonInstance()->mDefaultWorld;
+}
+
+void cleanupWorld(World* world) {
+	SpriteManager::getSingletonInstance()->cleanupWorld(world);
+}
+
+void setWorldThreads(uint32 numThreads) {
+	SpriteManager::getSingletonInstance()->mWorldThreads->setThreadCount(numThreads);
+}
+
+uint32 getWorldThreads() {
+	return SpriteManager::getSingletonInstance()->mWorldThreads->getThreadCount();
+}
+
+} // end namespace pdg
@@ -0,0 +1,231 @@
+// -----------------------------------------------
+// worldthreads.cpp
+//
+// Pool of native threads used to tick threaded worlds
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+// -----------------------------------------------
+
+
+#include "pdg_project.h"
+
+#include "pdg/sys/world.h"
+#include "pdg/sys/os.h"
+#include "pdg/sys/pdgexception.h"
+
+#include "worldthreads.h"
+
+namespace pdg {
+
+WorldThreadPool::WorldThreadPool()
+ :	mRequestedThreads(0)
+{
+  #ifdef PDG_WORLD_THREADS
+	mGeneration = 0;
+	mStartGeneration = 0;
+	mBusyThreads = 0;
+	mQuit = false;
+	mWorlds = 0;
+	mNextWorld = 0;
+	mFailed = false;
+	pthread_mutex_init(&mMutex, 0);
+	pthread_cond_init(&mWorkCond, 0);
+	pthread_cond_init(&mDoneCond, 0);
+  #endif
+}
+
+WorldThreadPool::~WorldThreadPool() {
+  #ifdef PDG_WORLD_THREADS
+	stopThreads();
+	pthread_cond_destroy(&mDoneCond);
+	pthread_cond_destroy(&mWorkCond);
+	pthread_mutex_destroy(&mMutex);
+  #endif
+}
+
+void
+WorldThreadPool::setThreadCount(uint32 numThreads) {
+	mRequestedThreads = numThreads;
+  #ifdef PDG_WORLD_THREADS
+	// tickWorlds() will start the right number next time it needs them
+	if (mThreads.size() != getThreadCount()) {
+		stopThreads();
+	}
+  #endif
+}
+
+uint32
+WorldThreadPool::getThreadCount() {
+  #ifdef PDG_WORLD_THREADS
+	if (mRequestedThreads > 0) {
+		return mRequestedThreads;
+	}
+	return OS::getProcessorCount() - 1;
+  #else
+	return 0;
+  #endif
+}
+
+void
+WorldThreadPool::tickWorlds(std::vector<World*>& worlds) {
+  #ifdef PDG_WORLD_THREADS
+	if (worlds.size() > 1) {
+		if (mThreads.empty()) {
+			startThreads(getThreadCount());
+		}
+		if (!mThreads.empty()) {
+			pthread_mutex_lock(&mMutex);
+			mWorlds = &worlds;
+			mNextWorld = 0;
+			mFailed = false;
+			mBusyThreads = (uint32)mThreads.size();
+			mGeneration++;
+			pthread_cond_broadcast(&mWorkCond);
+			pthread_mutex_unlock(&mMutex);
+			// we take our share of the worlds too
+			tickUntilDone();
+			pthread_mutex_lock(&mMutex);
+			while (mBusyThreads > 0) {
+				pthread_cond_wait(&mDoneCond, &mMutex);
+			}
+			mWorlds = 0;
+			// nobody is using the list any more, so it's safe to let the caller know
+			bool failed = mFailed;
+			std::string failure = mFailure;
+			mFailed = false;
+			mFailure.clear();
+			pthread_mutex_unlock(&mMutex);
+			if (failed) {
+				throw PDGException(failure.c_str());
+			}
+			return;
+		}
+	}
+  #endif
+	// one world, or no threads to help, so don't bother handing anything off
+	for (size_t i = 0; i < worlds.size(); i++) {
+		worlds[i]->runDueTick();
+	}
+}
+
+void
+WorldThreadPool::tickUntilDone() {
+  #ifdef PDG_WORLD_THREADS
+	for (;;) {
+		pthread_mutex_lock(&mMutex);
+		if (!mWorlds || (mNextWorld >= mWorlds->size())) {
+			pthread_mutex_unlock(&mMutex);
+			break;
+		}
+		World* world = (*mWorlds)[mNextWorld++];
+		pthread_mutex_unlock(&mMutex);
+		// an exception can't be allowed out of here, on a pool thread it would end the program,
+		// and on the calling thread it would leave the pool threads working on a list that's gone
+		try {
+			world->runDueTick();
+		} catch (std::exception& e) {
+			noteFailure(e.what());
+		} catch (...) {
+			noteFailure("unknown exception ticking a threaded world");
+		}
+	}
+  #endif
+}
+
+#ifdef PDG_WORLD_THREADS
+
+// keep the first failure for tickWorlds() to pass on once every world is done
+void
+WorldThreadPool::noteFailure(const char* what) {
+	pthread_mutex_lock(&mMutex);
+	if (!mFailed) {
+		mFailed = true;
+		mFailure = what ? what : "";
+		if (mFailure.size() > 255) {
+			mFailure.resize(255);  // all a PDGException can hold
+		}
+	}
+	pthread_mutex_unlock(&mMutex);
+}
+
+void*
+WorldThreadPool::WorkerMain(void* arg) {
+	static_cast<WorldThreadPool*>(arg)->workerLoop();
+	return 0;
+}
+
+void
+WorldThreadPool::workerLoop() {
+	pthread_mutex_lock(&mMutex);
+	// not mGeneration, which may already have moved on to a list we're expected to help with
+	uint32 lastGeneration = mStartGeneration;
+	for (;;) {
+		while (!mQuit && (mGeneration == lastGeneration)) {
+			pthread_cond_wait(&mWorkCond, &mMutex);
+		}
+		if (mQuit) break;
+		lastGeneration = mGeneration;
+		pthread_mutex_unlock(&mMutex);
+		tickUntilDone();
+		pthread_mutex_lock(&mMutex);
+		mBusyThreads--;
+		if (mBusyThreads == 0) {
+			pthread_cond_signal(&mDoneCond);
+		}
+	}
+	pthread_mutex_unlock(&mMutex);
+}
+
+void
+WorldThreadPool::startThreads(uint32 numThreads) {
+	pthread_mutex_lock(&mMutex);
+	mQuit = false;
+	mStartGeneration = mGeneration;
+	pthread_mutex_unlock(&mMutex);
+	for (uint32 i = 0; i < numThreads; i++) {
+		pthread_t thread;
+		if (pthread_create(&thread, 0, &WorkerMain, this) != 0) {
+			DEBUG_PRINT("WorldThreadPool: only able to start %d of %d threads", i, numThreads);
+			break;
+		}
+		mThreads.push_back(thread);
+	}
+}
+
+void
+WorldThreadPool::stopThreads() {
+	if (mThreads.empty()) return;
+	pthread_mutex_lock(&mMutex);
+	mQuit = true;
+	pthread_cond_broadcast(&mWorkCond);
+	pthread_mutex_unlock(&mMutex);
+	for (size_t i = 0; i < mThreads.size(); i++) {
+		pthread_join(mThreads[i], 0);
+	}
+	mThreads.clear();
+}
+
+#endif // PDG_WORLD_THREADS
+
+} // end namespace pdg
@@ -0,0 +1,110 @@
+// -----------------------------------------------
+// worldthreads.h
+//
+// Pool of native threads used to tick threaded worlds
+//
+// Copyright (c) 2016, Dream Rock Studios, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to permit
+// persons to whom the Software is furnished to do so, subject to the
+// following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+// NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+// USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+// -----------------------------------------------
+// -----------------------------------------------
+
+
+#ifndef PDG_WORLDTHREADS_H_INCLUDED
+#define PDG_WORLDTHREADS_H_INCLUDED
+
+#include "pdg_project.h"
+
+#include "pdg/sys/platform.h"
+#include "pdg/sys/global_types.h"
+
+#include <vector>
+#include <string>
+
+// without pthreads the due worlds are just ticked one after another on the main thread
+#if defined( PLATFORM_UNIX ) && !defined( PDG_NO_THREAD_SAFETY )
+  #define PDG_WORLD_THREADS
+  #include <pthread.h>
+#endif
+
+namespace pdg {
+
+class World;
+
+// -----------------------------------------------------------------------------------
+// World Thread Pool
+// Used by SpriteManager to tick all the threaded worlds that are due at once. The
+// calling thread ticks worlds along with the pool threads, and tickWorlds() doesn't
+// return until every world is done, so as far as the rest of the program can tell a
+// threaded world ticks on the main thread just like any other.
+// The pool threads are started the first time there is more than one world to tick
+// -----------------------------------------------------------------------------------
+
+class WorldThreadPool {
+public:
+	WorldThreadPool();
+	~WorldThreadPool();
+
+	// 0 means one per processor core, less one for the calling thread
+	void	setThreadCount(uint32 numThreads);
+	uint32	getThreadCount();  // the number that will actually be used
+
+	// run World::runDueTick() for each of the worlds, returns once they all have. If any of
+	// the ticks throw, the other worlds still tick, and once they are all done the first
+	// exception's description is thrown again as a PDGException on the calling thread
+	void	tickWorlds(std::vector<World*>& worlds);
+
+/// @cond INTERNAL
+private:
+	void	tickUntilDone();  // take worlds from the list and tick them till there are none left
+
+	uint32	mRequestedThreads;
+
+  #ifdef PDG_WORLD_THREADS
+	static void* WorkerMain(void* arg);
+	void	workerLoop();
+	void	startThreads(uint32 numThreads);
+	void	stopThreads();
+	void	noteFailure(const char* what);
+
+	std::vector<pthread_t>	mThreads;
+	pthread_mutex_t			mMutex;
+	pthread_cond_t			mWorkCond;      // signaled when there is a new list of worlds
+	pthread_cond_t			mDoneCond;      // signaled when the last worker finishes with a list
+	uint32					mGeneration;    // incremented for each list of worlds
+	uint32					mStartGeneration;  // mGeneration when the threads were started
+	uint32					mBusyThreads;   // workers that haven't finished with the current list
+	bool					mQuit;
+	std::vector<World*>*	mWorlds;
+	size_t					mNextWorld;
+	bool					mFailed;        // a tick of the current list threw
+	std::string				mFailure;       // what the first one that threw said
+  #endif
+
+	// not copyable
+	WorldThreadPool(const WorldThreadPool&);
+	WorldThreadPool& operator=(const WorldThreadPool&);
+/// @endcond
+};
+
+} // end namespace pdg
+
+#endif // PDG_WORLDTHREADS_H_INCLUDED
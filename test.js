@@ -75,6 +75,7 @@ assert(typeof(pdg.SpriteLayer) === 'function');
 assert(typeof(pdg.TileLayer) === 'function');
 assert(typeof(pdg.TimerManager) === 'function');
 assert(typeof(pdg.Vector) === 'function');
+assert(typeof(pdg.World) === 'function');
 
 if (process.versions['chipmunk']) {
 	console.log('Physics: Chipmunk '+process.versions['chipmunk']);